@@ -0,0 +1,144 @@
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/constants.h"
+#include "common/hash_defs.h"
+#include "common/scoped_timer.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/join_hash_table.h"
+#include "execution/sql/operators/hash_operators.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_projection.h"
+
+namespace noisepage {
+
+/**
+ * This benchmark measures what JoinHashTable::FilterBatch() saves the probe side of a hash join over a table that is
+ * larger than the last-level cache, for probe batches with different fractions of keys that have no join partner.
+ */
+class JoinHashTableBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    exec_ctx_ = std::make_unique<execution::exec::ExecutionContext>(
+        catalog::db_oid_t(0), nullptr, callback_, nullptr, nullptr, exec_settings_, nullptr);
+
+    // Build the table over the keys [0, num_build_)
+    jht_ = std::make_unique<execution::sql::JoinHashTable>(exec_settings_, exec_ctx_.get(), sizeof(BuildTuple));
+    for (uint32_t i = 0; i < num_build_; i++) {
+      const auto key = static_cast<int32_t>(i);
+      *reinterpret_cast<BuildTuple *>(jht_->AllocInputTuple(Hash(key))) = BuildTuple{key, i};
+    }
+    jht_->Build();
+
+    // state.range(0) is the percentage of probe keys that have no join partner
+    std::uniform_int_distribution<int32_t> key_dist(0, static_cast<int32_t>(num_build_) - 1);
+    std::uniform_int_distribution<int64_t> percent_dist(0, 99);
+    probe_keys_.resize(num_probes_);
+    for (auto &key : probe_keys_) {
+      key = key_dist(generator_) + (percent_dist(generator_) < state.range(0) ? static_cast<int32_t>(num_build_) : 0);
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    jht_.reset();
+    exec_ctx_.reset();
+    probe_keys_.clear();
+  }
+
+  // Probe the table with all probe keys, one vector at a time, first filtering every vector if filter is set. Returns
+  // the number of matches.
+  uint64_t ProbeAll(const bool filter) const {
+    const uint32_t key_cols[] = {0};
+    execution::sql::VectorProjection vp;
+    vp.Initialize({execution::sql::TypeId::Integer});
+    execution::sql::TupleIdList tids(VECTOR_SIZE);
+
+    uint64_t num_matches = 0;
+    for (uint32_t start = 0; start < num_probes_; start += VECTOR_SIZE) {
+      vp.Reset(VECTOR_SIZE);
+      std::memcpy(vp.GetColumn(0)->GetData(), &probe_keys_[start], VECTOR_SIZE * sizeof(int32_t));
+      tids.AddAll();
+      if (filter) jht_->FilterBatch(&vp, key_cols, 1, &tids);
+
+      // Probe the remaining tuples one at a time, the way the generated join code does
+      const auto *keys = reinterpret_cast<const int32_t *>(vp.GetColumn(0)->GetData());
+      tids.ForEach([&](const uint64_t i) {
+        for (auto iter = jht_->Lookup<false>(Hash(keys[i])); iter.HasNext();) {
+          if (reinterpret_cast<const BuildTuple *>(iter.GetMatchPayload())->key_ == keys[i]) num_matches++;
+        }
+      });
+    }
+    return num_matches;
+  }
+
+  struct BuildTuple {
+    int32_t key_;
+    uint32_t val_;
+  };
+
+  static common::hash_t Hash(const int32_t key) { return execution::sql::Hash<int32_t>{}(key, false); }
+
+  static constexpr uint32_t VECTOR_SIZE = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+  // Workload
+  const uint32_t num_build_ = 1u << 23;
+  const uint32_t num_probes_ = 1u << 23;
+
+  // Test infrastructure
+  std::default_random_engine generator_;
+  execution::exec::OutputCallback callback_ = nullptr;
+  execution::exec::ExecutionSettings exec_settings_;
+  std::unique_ptr<execution::exec::ExecutionContext> exec_ctx_;
+  std::unique_ptr<execution::sql::JoinHashTable> jht_;
+  std::vector<int32_t> probe_keys_;
+};
+
+// Probe every tuple
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, Probe)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      benchmark::DoNotOptimize(ProbeAll(false));
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_probes_);
+}
+
+// Filter every vector of tuples before probing it
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, FilterAndProbe)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      benchmark::DoNotOptimize(ProbeAll(true));
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_probes_);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, Probe)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Arg(0)->Arg(10)->Arg(20)->Arg(30)->Arg(40)->Arg(50)->Arg(80);
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, FilterAndProbe)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Arg(0)->Arg(10)->Arg(20)->Arg(30)->Arg(40)->Arg(50)->Arg(80);
+// clang-format on
+
+}  // namespace noisepage
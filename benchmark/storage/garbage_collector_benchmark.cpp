@@ -11,9 +11,9 @@ namespace noisepage {
 class GarbageCollectorBenchmark : public benchmark::Fixture {
  public:
   void StartGC(transaction::TimestampManager *const timestamp_manager,
-               transaction::TransactionManager *const txn_manager) {
+               transaction::TransactionManager *const txn_manager, const uint32_t num_gc_workers) {
     gc_ = new storage::GarbageCollector(common::ManagedPointer(timestamp_manager), DISABLED,
-                                        common::ManagedPointer(txn_manager), DISABLED);
+                                        common::ManagedPointer(txn_manager), DISABLED, num_gc_workers);
     run_gc_ = true;
     gc_thread_ = std::thread([this] { GCThreadLoop(); });
   }
@@ -52,16 +52,17 @@ class GarbageCollectorBenchmark : public benchmark::Fixture {
 };
 
 // Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
-// the unlinking stage takes for those txns
+// the unlinking stage takes for those txns, with as many GC workers as the argument of the benchmark
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &state) {
+  const auto num_gc_workers = static_cast<uint32_t>(state.range(0));
   // NOLINTNEXTLINE
   for (auto _ : state) {
     // generate our table and instantiate GC
     LargeDataTableBenchmarkObject tested({8, 8, 8}, initial_table_size_, txn_length_, update_select_ratio_,
                                          &block_store_, &buffer_pool_, &generator_, true);
     gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
-                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED);
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED, num_gc_workers);
 
     // clean up insert txn
     gc_->PerformGarbageCollection();
@@ -89,6 +90,8 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &stat
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
   state.SetItemsProcessed(state.iterations() * num_txns_);
+  state.counters["items_per_gc_worker"] = benchmark::Counter(static_cast<double>(num_txns_) / num_gc_workers,
+                                                             benchmark::Counter::kIsIterationInvariantRate);
 }
 
 // Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
@@ -133,16 +136,18 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ReclaimTime)(benchmark::State &sta
 /**
  * Run a large number of updates on a small table to generate contention with the GC. Measure the number of transactions
  * that the GC managed to free during the workload by subtracting the number of "lagging" transactions that still
- * remained to be cleaned up by the GC after the workload was done running.
+ * remained to be cleaned up by the GC after the workload was done running. The GC uses as many workers as the argument
+ * of the benchmark.
  */
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &state) {
+  const auto num_gc_workers = static_cast<uint32_t>(state.range(0));
   uint64_t lag_count = 0;
   // NOLINTNEXTLINE
   for (auto _ : state) {
     LargeDataTableBenchmarkObject tested({8, 8, 8}, 100, txn_length_, update_select_ratio_, &block_store_,
                                          &buffer_pool_, &generator_, true);
-    StartGC(tested.GetTimestampManager(), tested.GetTxnManager());
+    StartGC(tested.GetTimestampManager(), tested.GetTxnManager(), num_gc_workers);
     uint64_t elapsed_ms;
     {
       common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
@@ -152,9 +157,17 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
   state.SetItemsProcessed(state.iterations() * num_txns_ - lag_count);
+  state.counters["items_per_gc_worker"] =
+      benchmark::Counter(static_cast<double>(state.iterations() * num_txns_ - lag_count) / num_gc_workers,
+                         benchmark::Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)->Unit(benchmark::kMillisecond)->UseManualTime()->MinTime(1);
+BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(1)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
@@ -162,5 +175,7 @@ BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, HighContention)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
-    ->MinTime(2);
+    ->MinTime(2)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
 }  // namespace noisepage
@@ -23,12 +23,36 @@ class RecoveryBenchmark : public benchmark::Fixture {
   const uint32_t num_indexes_ = 5;
   std::default_random_engine generator_;
 
+  /**
+   * @param recovery_manager recovery manager that finished recovery
+   * @return number of committed transactions the recovery manager replayed
+   */
+  static uint32_t RecoveredTxns(const storage::RecoveryManager &recovery_manager) {
+    return recovery_manager.recovered_txns_;
+  }
+
+  /**
+   * Reports the number of replayed transactions per second of recovery time
+   * @param state benchmark state
+   * @param recovered_txns number of transactions replayed over all iterations
+   * @param elapsed_ms recovery time over all iterations
+   */
+  static void ReportRecoveryThroughput(benchmark::State *state, const uint64_t recovered_txns,
+                                       const uint64_t elapsed_ms) {
+    state->counters["RecoveredTxnsPerSecond"] =
+        elapsed_ms == 0 ? 0.0 : static_cast<double>(recovered_txns) * 1000.0 / static_cast<double>(elapsed_ms);
+  }
+
   /**
    * Runs the recovery benchmark with the provided config
    * @param state benchmark state
    * @param config config to use for test object
+   * @param num_replay_threads number of threads the recovery manager replays transactions with
    */
-  void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config) {
+  void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config,
+                    const uint32_t num_replay_threads = 1) {
+    uint64_t total_recovered_txns = 0;
+    uint64_t total_elapsed_ms = 0;
     // NOLINTNEXTLINE
     for (auto _ : *state) {
       // Blow away log file after every benchmark iteration
@@ -72,7 +96,7 @@ class RecoveryBenchmark : public benchmark::Fixture {
       storage::DiskLogProvider log_provider(noisepage::BenchmarkConfig::logfile_path.data());
       storage::RecoveryManager recovery_manager(
           common::ManagedPointer<storage::AbstractLogProvider>(&log_provider), recovery_catalog, recovery_txn_manager,
-          recovery_deferred_action_manager, recovery_thread_registry, recovery_block_store);
+          recovery_deferred_action_manager, recovery_thread_registry, recovery_block_store, num_replay_threads);
 
       uint64_t elapsed_ms;
       {
@@ -82,12 +106,15 @@ class RecoveryBenchmark : public benchmark::Fixture {
       }
 
       state->SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+      total_recovered_txns += RecoveredTxns(recovery_manager);
+      total_elapsed_ms += elapsed_ms;
 
       // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
       // DeferredAction
       db_main->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
     }
     state->SetItemsProcessed(num_txns_ * state->iterations());
+    ReportRecoveryThroughput(state, total_recovered_txns, total_elapsed_ms);
   }
 };
 
@@ -127,6 +154,26 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, HighStress)(benchmark::State &state) {
   RunBenchmark(&state, config);
 }
 
+/**
+ * Read-write workload spread over several tables (5 statements per txn, 50% inserts, 50% updates). The transactions
+ * are replayed with the number of threads given by the benchmark argument, every thread replays the changes to some of
+ * the tables.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, MultiTableWorkload)(benchmark::State &state) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(8)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(initial_table_size_ / 8)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.5, 0.5, 0.0, 0.0})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+
+  RunBenchmark(&state, config, static_cast<uint32_t>(state.range(0)));
+}
+
 /**
  * Similar to high-stress workload, blast a narrow table with inserts (1 statements per txn, 100% inserts), but also
  * recovery indexes built on the table
@@ -138,6 +185,8 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, IndexRecovery)(benchmark::State &state) {
   auto index_name = "testindex";
   auto namespace_name = "testnamespace";
 
+  uint64_t total_recovered_txns = 0;
+  uint64_t total_elapsed_ms = 0;
   // NOLINTNEXTLINE
   for (auto _ : state) {
     // Blow away log file after every benchmark iteration
@@ -234,8 +283,11 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, IndexRecovery)(benchmark::State &state) {
     }
 
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    total_recovered_txns += RecoveredTxns(recovery_manager);
+    total_elapsed_ms += elapsed_ms;
   }
   state.SetItemsProcessed(num_txns_ * state.iterations());
+  ReportRecoveryThroughput(&state, total_recovered_txns, total_elapsed_ms);
 }
 
 // ----------------------------------------------------------------------------
@@ -250,6 +302,13 @@ BENCHMARK_REGISTER_F(RecoveryBenchmark, HighStress)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, MultiTableWorkload)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8);
 BENCHMARK_REGISTER_F(RecoveryBenchmark, IndexRecovery)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
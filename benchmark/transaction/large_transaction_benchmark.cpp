@@ -3,7 +3,10 @@
 #include "benchmark/benchmark.h"
 #include "benchmark_util/benchmark_config.h"
 #include "benchmark_util/data_table_benchmark_util.h"
+#include "common/scoped_timer.h"
 #include "storage/garbage_collector_thread.h"
+#include "test_util/multithread_test_util.h"
+#include "transaction/deferred_action_manager.h"
 
 namespace noisepage {
 
@@ -142,6 +145,46 @@ BENCHMARK_DEFINE_F(LargeTransactionBenchmark, SingleStatementSelect)(benchmark::
   state.SetItemsProcessed(state.iterations() * num_txns_ - abort_count);
 }
 
+/**
+ * Empty transaction throughput, which only measures beginning and committing transactions. Should scale with the
+ * number of threads.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(LargeTransactionBenchmark, BeginCommit)(benchmark::State &state) {
+  common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+  thread_pool.Startup();
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_), true, DISABLED};
+    gc_ = new storage::GarbageCollector(common::ManagedPointer(&timestamp_manager),
+                                        common::ManagedPointer(&deferred_action_manager),
+                                        common::ManagedPointer(&txn_manager), DISABLED);
+    gc_thread_ = new storage::GarbageCollectorThread(common::ManagedPointer(gc_), gc_period_, nullptr);
+
+    auto workload = [&](uint32_t /*unused*/) {
+      for (uint32_t i = 0; i < num_txns_ / BenchmarkConfig::num_threads; i++) {
+        auto *const txn = txn_manager.BeginTransaction();
+        txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      }
+    };
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, BenchmarkConfig::num_threads, workload);
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    delete gc_thread_;
+    deferred_action_manager.FullyPerformGC(common::ManagedPointer(gc_), DISABLED);
+    delete gc_;
+  }
+  state.SetItemsProcessed(state.iterations() * (num_txns_ / BenchmarkConfig::num_threads) *
+                          BenchmarkConfig::num_threads);
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -166,6 +209,10 @@ BENCHMARK_REGISTER_F(LargeTransactionBenchmark, SingleStatementSelect)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(1);
+BENCHMARK_REGISTER_F(LargeTransactionBenchmark, BeginCommit)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(1);
 // clang-format on
 
 }  // namespace noisepage
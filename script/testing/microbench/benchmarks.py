@@ -17,4 +17,5 @@ BENCHMARKS_TO_RUN = {
     "cuckoomap_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "parser_benchmark": 20,
     "slot_iterator_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "join_hash_table_benchmark": DEFAULT_FAILURE_THRESHOLD,
 }
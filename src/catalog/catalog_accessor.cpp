@@ -205,6 +205,8 @@ common::ManagedPointer<execution::functions::FunctionContext> CatalogAccessor::G
   return dbc_->GetFunctionContext(txn_, proc_oid);
 }
 
+transaction::timestamp_t CatalogAccessor::GetCatalogVersion() const { return dbc_->GetCatalogVersion(txn_); }
+
 type_oid_t CatalogAccessor::GetTypeOidFromTypeId(type::TypeId type) { return dbc_->GetTypeOidForType(type); }
 
 common::ManagedPointer<storage::BlockStore> CatalogAccessor::GetBlockStore() const {
@@ -32,6 +32,7 @@ namespace noisepage::catalog {
 DatabaseCatalog::DatabaseCatalog(const db_oid_t oid,
                                  const common::ManagedPointer<storage::GarbageCollector> garbage_collector)
     : write_lock_(transaction::INITIAL_TXN_TIMESTAMP),
+      catalog_version_(transaction::INITIAL_TXN_TIMESTAMP),
       db_oid_(oid),
       garbage_collector_(garbage_collector),
       pg_core_(db_oid_),
@@ -86,14 +87,16 @@ void DatabaseCatalog::Bootstrap(const common::ManagedPointer<transaction::Transa
 
 namespace_oid_t DatabaseCatalog::CreateNamespace(const common::ManagedPointer<transaction::TransactionContext> txn,
                                                  const std::string &name) {
-  if (!TryLock(txn)) return INVALID_NAMESPACE_OID;
+  // Namespaces outside of the search path, e.g., the temporary namespaces of connections, cannot affect plans.
+  if (!TryLock(txn, false)) return INVALID_NAMESPACE_OID;
   const namespace_oid_t ns_oid{next_oid_++};
   return pg_core_.CreateNamespace(txn, name, ns_oid) ? ns_oid : INVALID_NAMESPACE_OID;
 }
 
 bool DatabaseCatalog::DeleteNamespace(const common::ManagedPointer<transaction::TransactionContext> txn,
                                       const namespace_oid_t ns_oid) {
-  if (!TryLock(txn)) return false;
+  // Deleting the objects in the namespace changes the version, an empty namespace does not.
+  if (!TryLock(txn, false)) return false;
   return pg_core_.DeleteNamespace(txn, common::ManagedPointer(this), ns_oid);
 }
 
@@ -358,14 +361,29 @@ common::ManagedPointer<execution::functions::FunctionContext> DatabaseCatalog::G
   return proc_ctx;
 }
 
-bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::TransactionContext> txn) {
+transaction::timestamp_t DatabaseCatalog::GetCatalogVersion(
+    const common::ManagedPointer<transaction::TransactionContext> txn) const {
+  // Some txn (maybe this one) holds the lock. Its commit publishes the new version before releasing the lock, so a
+  // version that is read after a released lock is never older than any change committed before this txn started.
+  if (!transaction::TransactionUtil::Committed(write_lock_.load())) return transaction::INVALID_TXN_TIMESTAMP;
+  const transaction::timestamp_t version = catalog_version_.load();
+  // The last change is not visible to this txn.
+  if (transaction::TransactionUtil::NewerThan(version, txn->StartTime())) return transaction::INVALID_TXN_TIMESTAMP;
+  return version;
+}
+
+bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                              const bool changes_version) {
   auto current_val = write_lock_.load();
 
   const transaction::timestamp_t txn_id = txn->FinishTime();     // this is the uncommitted txn id
   const transaction::timestamp_t start_time = txn->StartTime();  // this is the unchanging start time of the txn
 
   const bool already_hold_lock = current_val == txn_id;
-  if (already_hold_lock) return true;
+  if (already_hold_lock) {
+    lock_changes_version_ = lock_changes_version_ || changes_version;
+    return true;
+  }
 
   const bool owned_by_other_txn = !transaction::TransactionUtil::Committed(current_val);
   const bool newer_committed_version = transaction::TransactionUtil::Committed(current_val) &&
@@ -379,8 +397,14 @@ bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::Transact
 
   if (write_lock_.compare_exchange_strong(current_val, txn_id)) {
     // acquired the lock
+    lock_changes_version_ = changes_version;
     auto *const write_lock = &write_lock_;
-    txn->RegisterCommitAction([=]() -> void { write_lock->store(txn->FinishTime()); });
+    auto *const catalog_version = &catalog_version_;
+    const auto *const lock_changes_version = &lock_changes_version_;
+    txn->RegisterCommitAction([=]() -> void {
+      if (*lock_changes_version) catalog_version->store(txn->FinishTime());
+      write_lock->store(txn->FinishTime());
+    });
     txn->RegisterAbortAction([=]() -> void { write_lock->store(current_val); });
     return true;
   }
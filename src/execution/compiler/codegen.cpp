@@ -205,10 +205,18 @@ ast::Expr *CodeGen::ArrayType(uint64_t num_elems, ast::BuiltinType::Kind kind) {
   return GetFactory()->NewArrayType(position_, Const64(num_elems), BuiltinType(kind));
 }
 
+ast::Expr *CodeGen::ArrayType(uint64_t num_elems, ast::Expr *elem_type) {
+  return GetFactory()->NewArrayType(position_, Const64(num_elems), elem_type);
+}
+
 ast::Expr *CodeGen::ArrayAccess(ast::Identifier arr, uint64_t idx) {
   return GetFactory()->NewIndexExpr(position_, MakeExpr(arr), Const64(idx));
 }
 
+ast::Expr *CodeGen::ArrayAccess(ast::Expr *arr, ast::Expr *idx) {
+  return GetFactory()->NewIndexExpr(position_, arr, idx);
+}
+
 ast::Expr *CodeGen::TplType(sql::TypeId type) {
   switch (type) {
     case sql::TypeId::Boolean:
@@ -413,8 +421,12 @@ ast::Expr *CodeGen::StringToSql(std::string_view str) const {
 
 ast::Expr *CodeGen::IndexIteratorInit(ast::Identifier iter, ast::Expr *exec_ctx_var, uint32_t num_attrs,
                                       uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids) {
-  // @indexIteratorInit(&iter, table_oid, index_oid, execCtx)
-  ast::Expr *iter_ptr = AddressOf(iter);
+  return IndexIteratorInit(AddressOf(iter), exec_ctx_var, num_attrs, table_oid, index_oid, col_oids);
+}
+
+ast::Expr *CodeGen::IndexIteratorInit(ast::Expr *iter_ptr, ast::Expr *exec_ctx_var, uint32_t num_attrs,
+                                      uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids) {
+  // @indexIteratorInit(iter_ptr, table_oid, index_oid, execCtx)
   ast::Expr *num_attrs_expr = Const32(static_cast<int32_t>(num_attrs));
   ast::Expr *table_oid_expr = Const32(static_cast<int32_t>(table_oid));
   ast::Expr *index_oid_expr = Const32(static_cast<int32_t>(index_oid));
@@ -471,6 +483,14 @@ ast::Expr *CodeGen::IndexIteratorScan(ast::Identifier iter, planner::IndexScanTy
   return CallBuiltin(builtin, args);
 }
 
+ast::Expr *CodeGen::IndexIteratorParallelScan(ast::Expr *iter_ptr, ast::Expr *query_state,
+                                              ast::Expr *thread_state_container, ast::Identifier worker_fn) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::IndexIteratorParallelScan,
+                                {iter_ptr, query_state, thread_state_container, MakeExpr(worker_fn)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::PRGet(ast::Expr *pr, type::TypeId type, bool nullable, uint32_t attr_idx) {
   // @indexIteratorGetTypeNull(&iter, attr_idx)
   ast::Builtin builtin;
@@ -892,6 +912,52 @@ ast::Expr *CodeGen::JoinHashTableFree(ast::Expr *join_hash_table) {
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableEnableSpilling(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableEnableSpilling, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableEnableBloomFilter(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableEnableBloomFilter, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableFilterBatch(ast::Expr *join_hash_table, ast::Expr *vector_proj, ast::Expr *tid_list,
+                                             ast::Identifier key_cols) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::JoinHashTableFilterBatch, {join_hash_table, vector_proj, tid_list, MakeExpr(key_cols)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableIsSpilled(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableIsSpilled, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableSpillProbe(ast::Expr *join_hash_table, ast::Expr *hash_val,
+                                            ast::Identifier probe_row_type_name) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::JoinHashTableSpillProbe, {join_hash_table, hash_val, SizeOf(probe_row_type_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+  return PtrCast(probe_row_type_name, call);
+}
+
+ast::Expr *CodeGen::JoinHashTableLoadSpilledPartition(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableLoadSpilledPartition, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableNextSpilledProbe(ast::Expr *join_hash_table, ast::Identifier probe_row_type_name) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableNextSpilledProbe, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+  return PtrCast(probe_row_type_name, call);
+}
+
 ast::Expr *CodeGen::HTEntryIterHasNext(ast::Expr *iter) {
   ast::Expr *call = CallBuiltin(ast::Builtin::HashTableEntryIterHasNext, {iter});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
@@ -1126,6 +1192,24 @@ ast::Expr *CodeGen::SortTopKParallel(ast::Expr *sorter, ast::Expr *tls, ast::Exp
   return call;
 }
 
+ast::Expr *CodeGen::SorterParallelScan(ast::Expr *sorter, ast::Expr *query_state, ast::Expr *thread_state_container,
+                                       ast::Identifier worker_fn) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterParallelScan,
+                                {sorter, query_state, thread_state_container, MakeExpr(worker_fn)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::SorterParallelScanPartitions(ast::Expr *sorter, ast::Expr *query_state,
+                                                 ast::Expr *thread_state_container, ast::Identifier partition_fn,
+                                                 ast::Identifier worker_fn) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::SorterParallelScanPartitions,
+                  {sorter, query_state, thread_state_container, MakeExpr(partition_fn), MakeExpr(worker_fn)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::SorterFree(ast::Expr *sorter) {
   ast::Expr *call = CallBuiltin(ast::Builtin::SorterFree, {sorter});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1227,6 +1311,22 @@ ast::Expr *CodeGen::StorageInterfaceInit(ast::Identifier si, ast::Expr *exec_ctx
   return CallBuiltin(ast::Builtin::StorageInterfaceInit, args);
 }
 
+ast::Expr *CodeGen::StorageInterfaceInitBatched(ast::Expr *si_ptr, ast::Expr *exec_ctx, uint32_t table_oid,
+                                                ast::Identifier col_oids, bool need_indexes) {
+  ast::Expr *table_oid_expr = Const64(static_cast<int64_t>(table_oid));
+  ast::Expr *col_oids_expr = MakeExpr(col_oids);
+  ast::Expr *need_indexes_expr = ConstBool(need_indexes);
+
+  std::vector<ast::Expr *> args{si_ptr, exec_ctx, table_oid_expr, col_oids_expr, need_indexes_expr};
+  return CallBuiltin(ast::Builtin::StorageInterfaceInitBatched, args);
+}
+
+ast::Expr *CodeGen::StorageInterfaceFlush(ast::Expr *si_ptr) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::StorageInterfaceFlush, {si_ptr});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 // ---------------------------------------------------------
 // Extras
 // ---------------------------------------------------------
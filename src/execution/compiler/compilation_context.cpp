@@ -39,6 +39,7 @@
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregation_translator.h"
 #include "execution/compiler/operator/update_translator.h"
+#include "execution/compiler/operator/window_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/exec/execution_settings.h"
 #include "parser/expression/abstract_expression.h"
@@ -67,6 +68,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "self_driving/modeling/operating_unit_recorder.h"
 #include "spdlog/fmt/fmt.h"
 
@@ -258,6 +260,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
       translator = std::make_unique<SortTranslator>(sort, this, pipeline);
       break;
     }
+    case planner::PlanNodeType::WINDOW: {
+      const auto &window = dynamic_cast<const planner::WindowPlanNode &>(plan);
+      translator = std::make_unique<WindowTranslator>(window, this, pipeline);
+      break;
+    }
     case planner::PlanNodeType::PROJECTION: {
       const auto &projection = dynamic_cast<const planner::ProjectionPlanNode &>(plan);
       translator = std::make_unique<ProjectionTranslator>(projection, this, pipeline);
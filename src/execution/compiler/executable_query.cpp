@@ -1,9 +1,11 @@
 #include "execution/compiler/executable_query.h"
 
 #include <algorithm>
+#include <chrono>  // NOLINT
 
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
+#include "common/scoped_timer.h"
 #include "execution/ast/ast_dump.h"
 #include "execution/ast/context.h"
 #include "execution/compiler/compiler.h"
@@ -56,6 +58,10 @@ void ExecutableQuery::Fragment::Run(byte query_state[], vm::ExecutionMode mode)
   }
 }
 
+bool ExecutableQuery::Fragment::IsCompiledToMachineCode() const { return module_->IsCompiledToMachineCode(); }
+
+void ExecutableQuery::Fragment::CompileToMachineCodeAsync() const { module_->CompileToMachineCodeAsync(); }
+
 //===----------------------------------------------------------------------===//
 //
 // Executable Query
@@ -150,7 +156,17 @@ void ExecutableQuery::Setup(std::vector<std::unique_ptr<Fragment>> &&fragments,
                       fragments_.size() > 1 ? "s" : "", query_state_size_);
 }
 
+bool ExecutableQuery::IsCompiledToMachineCode() const {
+  return std::all_of(fragments_.begin(), fragments_.end(),
+                     [](const auto &fragment) { return fragment->IsCompiledToMachineCode(); });
+}
+
 void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ctx, vm::ExecutionMode mode) {
+  // Adaptive runs are interpreted until the compiled fragments are swapped in.
+  const bool adaptive = mode == vm::ExecutionMode::Adaptive;
+  const bool interpret = adaptive && !IsCompiledToMachineCode();
+  if (adaptive) mode = interpret ? vm::ExecutionMode::Interpret : vm::ExecutionMode::Compiled;
+
   // First, allocate the query state and move the execution context into it.
   auto query_state = std::make_unique<byte[]>(query_state_size_);
   *reinterpret_cast<exec::ExecutionContext **>(query_state.get()) = exec_ctx.Get();
@@ -161,13 +177,33 @@ void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ct
   exec_ctx->SetQueryId(query_id_);
 
   // Now run through fragments.
-  for (const auto &fragment : fragments_) {
-    fragment->Run(query_state.get(), mode);
+  uint64_t elapsed_us = 0;
+  {
+    common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+    for (const auto &fragment : fragments_) {
+      // A fragment that was compiled in the meantime runs compiled already.
+      const auto fragment_mode = interpret && fragment->IsCompiledToMachineCode() ? vm::ExecutionMode::Compiled : mode;
+      fragment->Run(query_state.get(), fragment_mode);
+    }
   }
 
   // We do not currently re-use ExecutionContexts. However, this is unset to help ensure
   // we don't *intentionally* retain any dangling pointers.
   exec_ctx->SetQueryState(nullptr);
+
+  if (interpret) {
+    // Tier up once the query ran often enough to amortize the compilation, or its runs are slow enough that the next
+    // ones pay for it on their own. The compiled code only serves later runs, so callers only run queries they keep
+    // around adaptively. Compiling more than once is a no-op.
+    const auto &settings = exec_ctx->GetExecutionSettings();
+    const auto num_runs = num_interpreted_runs_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const auto time_us = interpreted_time_us_.fetch_add(elapsed_us, std::memory_order_relaxed) + elapsed_us;
+    if (num_runs >= settings.GetAdaptiveCompileRuns() || time_us >= settings.GetAdaptiveCompileInterpretTimeUs()) {
+      for (const auto &fragment : fragments_) {
+        fragment->CompileToMachineCodeAsync();
+      }
+    }
+  }
 }
 
 }  // namespace noisepage::execution::compiler
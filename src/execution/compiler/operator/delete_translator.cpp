@@ -15,9 +15,7 @@ namespace noisepage::execution::compiler {
 DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, CompilationContext *compilation_context,
                                    Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DELETE),
-      deleter_(GetCodeGen()->MakeFreshIdentifier("deleter")),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
   // Prepare the child.
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
 
@@ -29,16 +27,22 @@ DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, Compilat
     }
   }
 
+  deleter_ = pipeline->DeclarePipelineStateEntry(
+      "deleter", GetCodeGen()->BuiltinType(ast::BuiltinType::Kind::StorageInterface));
   num_deletes_ = CounterDeclare("num_deletes", pipeline);
 }
 
 void DeleteTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
-  CounterSet(function, num_deletes_, 0);
+  InitializeCounters(pipeline, function);
+  InitDeleter(function);
+}
+
+void DeleteTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  GenDeleterFree(function);
 }
 
 void DeleteTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
   // Delete from table
-  DeclareDeleter(function);
   GenTableDelete(function);
   function->Append(GetCodeGen()->ExecCtxAddRowsAffected(GetExecutionContext(), 1));
 
@@ -48,11 +52,26 @@ void DeleteTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder
   for (const auto &index_oid : indexes) {
     GenIndexDelete(function, context, index_oid);
   }
-
-  GenDeleterFree(function);
 }
 
 void DeleteTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // Every thread of a parallel pipeline flushed its own deletes at the end of its work
+  if (!pipeline.IsParallel()) {
+    GenDeleterFlush(function);
+    RecordCounters(pipeline, function);
+  }
+}
+
+void DeleteTranslator::EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  GenDeleterFlush(function);
+  RecordCounters(pipeline, function);
+}
+
+void DeleteTranslator::InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
+  CounterSet(function, num_deletes_, 0);
+}
+
+void DeleteTranslator::RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::DELETE,
                 selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline, CounterVal(num_deletes_));
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::DELETE,
@@ -60,33 +79,35 @@ void DeleteTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuil
   FeatureArithmeticRecordMul(function, pipeline, GetTranslatorId(), CounterVal(num_deletes_));
 }
 
-void DeleteTranslator::DeclareDeleter(FunctionBuilder *builder) const {
+void DeleteTranslator::InitDeleter(FunctionBuilder *builder) const {
   // var col_oids : [0]uint32
   SetOids(builder);
-  // var deleter : StorageInterface
-  auto *storage_interface_type = GetCodeGen()->BuiltinType(ast::BuiltinType::Kind::StorageInterface);
-  builder->Append(GetCodeGen()->DeclareVarNoInit(deleter_, storage_interface_type));
-  // @storageInterfaceInit(&deleter, execCtx, table_oid, col_oids, true)
+  // @storageInterfaceInitBatched(&pipelineState.deleter, execCtx, table_oid, col_oids, true)
   const auto &op = GetPlanAs<planner::DeletePlanNode>();
-  ast::Expr *deleter_setup = GetCodeGen()->StorageInterfaceInit(deleter_, GetExecutionContext(),
-                                                                op.GetTableOid().UnderlyingValue(), col_oids_, true);
+  ast::Expr *deleter_setup = GetCodeGen()->StorageInterfaceInitBatched(
+      deleter_.GetPtr(GetCodeGen()), GetExecutionContext(), op.GetTableOid().UnderlyingValue(), col_oids_, true);
   builder->Append(GetCodeGen()->MakeStmt(deleter_setup));
 }
 
 void DeleteTranslator::GenDeleterFree(FunctionBuilder *builder) const {
-  // @storageInterfaceFree(&deleter)
+  // @storageInterfaceFree(&pipelineState.deleter)
   ast::Expr *deleter_free =
-      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {GetCodeGen()->AddressOf(deleter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {deleter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->MakeStmt(deleter_free));
 }
 
+void DeleteTranslator::GenDeleterFlush(FunctionBuilder *builder) const {
+  // @storageInterfaceFlush(&pipelineState.deleter)
+  builder->Append(GetCodeGen()->MakeStmt(GetCodeGen()->StorageInterfaceFlush(deleter_.GetPtr(GetCodeGen()))));
+}
+
 void DeleteTranslator::GenTableDelete(FunctionBuilder *builder) const {
   // if (!@tableDelete(&deleter, &slot)) { Abort(); }
   const auto &op = GetPlanAs<planner::DeletePlanNode>();
   const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
   NOISEPAGE_ASSERT(child != nullptr, "delete should have a child");
   const auto &delete_slot = child->GetSlotAddress();
-  std::vector<ast::Expr *> delete_args{GetCodeGen()->AddressOf(deleter_), delete_slot};
+  std::vector<ast::Expr *> delete_args{deleter_.GetPtr(GetCodeGen()), delete_slot};
   auto *delete_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableDelete, delete_args);
   auto *delete_failed = GetCodeGen()->UnaryOp(parsing::Token::Type::BANG, delete_call);
   If check(builder, delete_failed);
@@ -103,7 +124,7 @@ void DeleteTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
                                       const catalog::index_oid_t &index_oid) const {
   // var delete_index_pr = @getIndexPR(&deleter, oid)
   auto delete_index_pr = GetCodeGen()->MakeFreshIdentifier("delete_index_pr");
-  std::vector<ast::Expr *> pr_call_args{GetCodeGen()->AddressOf(deleter_),
+  std::vector<ast::Expr *> pr_call_args{deleter_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
   auto *get_index_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   builder->Append(GetCodeGen()->DeclareVar(delete_index_pr, nullptr, get_index_pr_call));
@@ -126,7 +147,7 @@ void DeleteTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
   }
 
   // @indexDelete(&deleter)
-  std::vector<ast::Expr *> delete_args{GetCodeGen()->AddressOf(deleter_), child->GetSlotAddress()};
+  std::vector<ast::Expr *> delete_args{deleter_.GetPtr(GetCodeGen()), child->GetSlotAddress()};
   auto *index_delete_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexDelete, delete_args);
   builder->Append(GetCodeGen()->MakeStmt(index_delete_call));
 }
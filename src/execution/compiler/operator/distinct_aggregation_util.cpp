@@ -1,5 +1,10 @@
 #include "execution/compiler/operator/distinct_aggregation_util.h"
 
+#include <utility>
+
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/loop.h"
+
 namespace noisepage::execution::compiler {
 
 DistinctAggregationFilter::DistinctAggregationFilter(size_t agg_term_idx, const planner::AggregateTerm &agg_term,
@@ -81,8 +86,10 @@ void DistinctAggregationFilter::AggregateDistinct(CodeGen *codegen, FunctionBuil
   // Hash
   auto hash_keys = ComputeHash(codegen, function, lookup_key);
 
-  // Check for duplicates
-  auto lookup_call = codegen->AggHashTableLookup(ht_.GetPtr(codegen), codegen->MakeExpr(hash_keys), key_check_fn_,
+  // Check for duplicates. In parallel, the thread-local table is partitioned so that it can be merged later.
+  const bool parallel = IsParallel();
+  const auto &ht = parallel ? local_ht_ : ht_;
+  auto lookup_call = codegen->AggHashTableLookup(ht.GetPtr(codegen), codegen->MakeExpr(hash_keys), key_check_fn_,
                                                  codegen->AddressOf(codegen->MakeExpr(lookup_key)), key_type_);
   auto lookup_payload = codegen->MakeFreshIdentifier("lookupPayload");
   function->Append(codegen->DeclareVarWithInit(lookup_payload, lookup_call));
@@ -90,18 +97,110 @@ void DistinctAggregationFilter::AggregateDistinct(CodeGen *codegen, FunctionBuil
   If check_new_key(function, codegen->IsNilPointer(codegen->MakeExpr(lookup_payload)));
   {
     // Insert new agg_val into the filter
-    auto insert_call = codegen->AggHashTableInsert(ht_.GetPtr(codegen), codegen->MakeExpr(hash_keys), false, key_type_);
+    auto insert_call =
+        codegen->AggHashTableInsert(ht.GetPtr(codegen), codegen->MakeExpr(hash_keys), parallel, key_type_);
     function->Append(codegen->Assign(codegen->MakeExpr(lookup_payload), insert_call));
 
     // Initialize the payload
     AssignPayload(codegen, function, lookup_payload, lookup_key);
 
-    // Perform aggregate
-    function->Append(advance_call);
+    // Perform aggregate. In parallel, other threads may see the same value, so it is aggregated after the merge.
+    if (!parallel) {
+      function->Append(advance_call);
+    }
   }
   check_new_key.EndIf();
 }
 
+void DistinctAggregationFilter::DeclareLocalHashTable(CodeGen *codegen, Pipeline *build_pipeline) {
+  build_pipeline_ = build_pipeline;
+  auto *ht_type = codegen->BuiltinType(ast::BuiltinType::AggregationHashTable);
+  local_ht_ = build_pipeline->DeclarePipelineStateEntry("distinctHashTable", ht_type);
+  merge_partitions_fn_ =
+      codegen->MakeFreshIdentifier(build_pipeline->CreatePipelineFunctionName("DistinctMergePartitions"));
+  scan_partition_fn_ =
+      codegen->MakeFreshIdentifier(build_pipeline->CreatePipelineFunctionName("DistinctScanPartition"));
+}
+
+ast::FunctionDecl *DistinctAggregationFilter::GenerateMergePartitionsFunction(
+    CodeGen *codegen, util::RegionVector<ast::FieldDecl *> &&params) const {
+  // (*QueryState, *AggregationHashTable, *AHTOverflowPartitionIterator) -> nil
+  auto agg_ht = codegen->MakeIdentifier("aggHashTable");
+  auto iter = codegen->MakeIdentifier("ahtOvfIter");
+  params.push_back(codegen->MakeField(agg_ht, codegen->PointerType(ast::BuiltinType::AggregationHashTable)));
+  params.push_back(codegen->MakeField(iter, codegen->PointerType(ast::BuiltinType::AHTOverflowPartitionIterator)));
+
+  FunctionBuilder builder(codegen, merge_partitions_fn_, std::move(params), codegen->Nil());
+  {
+    Loop loop(&builder, nullptr, codegen->AggPartitionIteratorHasNext(codegen->MakeExpr(iter)),
+              codegen->MakeStmt(codegen->AggPartitionIteratorNext(codegen->MakeExpr(iter))));
+    {
+      auto hash_val = codegen->MakeFreshIdentifier("hashVal");
+      auto hash_call = codegen->AggPartitionIteratorGetHash(codegen->MakeExpr(iter));
+      builder.Append(codegen->DeclareVarWithInit(hash_val, hash_call));
+
+      auto partial_row = codegen->MakeFreshIdentifier("partialRow");
+      builder.Append(codegen->DeclareVarWithInit(
+          partial_row, codegen->AggPartitionIteratorGetRow(codegen->MakeExpr(iter), key_type_)));
+
+      // Values recorded by several threads are only kept once.
+      auto lookup_call = codegen->AggHashTableLookup(codegen->MakeExpr(agg_ht), codegen->MakeExpr(hash_val),
+                                                     key_check_fn_, codegen->MakeExpr(partial_row), key_type_);
+      If check_new_key(&builder, codegen->IsNilPointer(lookup_call));
+      {
+        auto entry = codegen->AggPartitionIteratorGetRowEntry(codegen->MakeExpr(iter));
+        builder.Append(codegen->AggHashTableLinkEntry(codegen->MakeExpr(agg_ht), entry));
+      }
+      check_new_key.EndIf();
+    }
+    loop.EndLoop();
+  }
+  return builder.Finish();
+}
+
+ast::FunctionDecl *DistinctAggregationFilter::GenerateScanPartitionFunction(CodeGen *codegen,
+                                                                            const AggregateRowFn &aggregate) const {
+  // (*QueryState, *PipelineState, *AggregationHashTable) -> nil
+  auto params = build_pipeline_->PipelineParams();
+  auto agg_ht = codegen->MakeIdentifier("aggHashTable");
+  params.push_back(codegen->MakeField(agg_ht, codegen->PointerType(ast::BuiltinType::AggregationHashTable)));
+
+  FunctionBuilder builder(codegen, scan_partition_fn_, std::move(params), codegen->Nil());
+  {
+    // var iterBase: AHTIterator
+    auto iter_base = codegen->MakeFreshIdentifier("iterBase");
+    builder.Append(codegen->DeclareVarNoInit(iter_base, codegen->BuiltinType(ast::BuiltinType::AHTIterator)));
+
+    // var iter = &iterBase
+    auto iter = codegen->MakeFreshIdentifier("iter");
+    builder.Append(codegen->DeclareVarWithInit(iter, codegen->AddressOf(codegen->MakeExpr(iter_base))));
+
+    Loop loop(&builder,
+              codegen->MakeStmt(codegen->AggHashTableIteratorInit(codegen->MakeExpr(iter), codegen->MakeExpr(agg_ht))),
+              codegen->AggHashTableIteratorHasNext(codegen->MakeExpr(iter)),
+              codegen->MakeStmt(codegen->AggHashTableIteratorNext(codegen->MakeExpr(iter))));
+    {
+      auto distinct_row = codegen->MakeFreshIdentifier("distinctRow");
+      builder.Append(codegen->DeclareVarWithInit(
+          distinct_row, codegen->AggHashTableIteratorGetRow(codegen->MakeExpr(iter), key_type_)));
+      aggregate(&builder, distinct_row);
+    }
+    loop.EndLoop();
+
+    builder.Append(codegen->AggHashTableIteratorClose(codegen->MakeExpr(iter)));
+  }
+  return builder.Finish();
+}
+
+void DistinctAggregationFilter::MergeAndAggregate(CodeGen *codegen, FunctionBuilder *function,
+                                                  ast::Expr *query_state, ast::Expr *thread_state_container) const {
+  // Merge the thread-local tables partition by partition, then aggregate each partition in parallel.
+  function->Append(codegen->AggHashTableMovePartitions(ht_.GetPtr(codegen), thread_state_container,
+                                                       local_ht_.OffsetFromState(codegen), merge_partitions_fn_));
+  function->Append(
+      codegen->AggHashTableParallelScan(ht_.GetPtr(codegen), query_state, thread_state_container, scan_partition_fn_));
+}
+
 ast::Expr *DistinctAggregationFilter::GetAggregateValue(CodeGen *codegen, ast::Expr *row) const {
   auto member = codegen->MakeIdentifier(AGG_VALUE_NAME);
   return codegen->AccessStructMember(row, member);
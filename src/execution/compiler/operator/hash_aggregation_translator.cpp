@@ -41,11 +41,6 @@ HashAggregationTranslator::HashAggregationTranslator(const planner::AggregatePla
     }
   }
 
-  // TODO(ricky): Make it work for parallel pipeline
-  if (!distinct_filters_.empty()) {
-    build_pipeline_.UpdateParallelism(Pipeline::Parallelism::Serial);
-  }
-
   // The produce pipeline begins after the build.
   pipeline->LinkSourcePipeline(&build_pipeline_);
 
@@ -71,9 +66,12 @@ HashAggregationTranslator::HashAggregationTranslator(const planner::AggregatePla
   ast::Expr *agg_ht_type = codegen->BuiltinType(ast::BuiltinType::AggregationHashTable);
   global_agg_ht_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "aggHashTable", agg_ht_type);
 
-  // In parallel mode, declare a local hash table, too.
+  // In parallel mode, declare a local hash table, too. Distinct filters also filter values thread-locally.
   if (build_pipeline_.IsParallel()) {
     local_agg_ht_ = build_pipeline_.DeclarePipelineStateEntry("aggHashTable", agg_ht_type);
+    for (auto &p : distinct_filters_) {
+      p.second.DeclareLocalHashTable(codegen, &build_pipeline_);
+    }
   }
 
   num_agg_inputs_ = CounterDeclare("num_agg_inputs", &build_pipeline_);
@@ -268,6 +266,9 @@ void HashAggregationTranslator::DefineHelperFunctions(util::RegionVector<ast::Fu
   // Generate distinctkey check functions
   for (auto &p : distinct_filters_) {
     decls->push_back(p.second.GenerateDistinctCheckFunction(GetCodeGen(), GetAggPlan().GetGroupByTerms()));
+    if (p.second.IsParallel()) {
+      decls->push_back(p.second.GenerateMergePartitionsFunction(GetCodeGen(), GetCompilationContext()->QueryParams()));
+    }
   }
 }
 
@@ -339,11 +340,27 @@ void HashAggregationTranslator::DefineTLSDependentHelperFunctions(const Pipeline
     decls->push_back(GenerateStartHookFunction());
     decls->push_back(GenerateEndHookFunction());
   }
+
+  // In parallel, the distinct values of every term are aggregated into the thread-local hash tables.
+  if (IsBuildPipeline(pipeline)) {
+    for (auto &[term_idx, filter] : distinct_filters_) {
+      if (!filter.IsParallel()) continue;
+      const auto agg_term_idx = static_cast<uint32_t>(term_idx);
+      const auto &distinct_filter = filter;
+      decls->push_back(filter.GenerateScanPartitionFunction(
+          GetCodeGen(), [&, agg_term_idx](FunctionBuilder *function, ast::Identifier distinct_row) {
+            AdvanceDistinctAggregate(function, distinct_filter, agg_term_idx, distinct_row);
+          }));
+    }
+  }
 }
 
 void HashAggregationTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   if (IsBuildPipeline(pipeline) && build_pipeline_.IsParallel()) {
     InitializeAggregationHashTable(function, local_agg_ht_.GetPtr(GetCodeGen()));
+    for (auto &p : distinct_filters_) {
+      p.second.InitializeLocal(GetCodeGen(), function, GetExecutionContext());
+    }
 
     // agg_count_ cannot be initialized in InitializeCounters.
     // @see HashAggregationTranslator::agg_count_ for reasoning.
@@ -365,6 +382,9 @@ void HashAggregationTranslator::TearDownPipelineState(const Pipeline &pipeline,
   if (IsBuildPipeline(pipeline)) {
     if (build_pipeline_.IsParallel()) {
       TearDownAggregationHashTable(function, local_agg_ht_.GetPtr(GetCodeGen()));
+      for (auto &p : distinct_filters_) {
+        p.second.TearDownLocal(GetCodeGen(), function);
+      }
     }
   }
 }
@@ -545,6 +565,33 @@ void HashAggregationTranslator::AdvanceAggregate(WorkContext *ctx, FunctionBuild
   }
 }
 
+void HashAggregationTranslator::AdvanceDistinctAggregate(FunctionBuilder *function,
+                                                         const DistinctAggregationFilter &filter, uint32_t term_idx,
+                                                         ast::Identifier distinct_row) const {
+  auto *codegen = GetCodeGen();
+
+  // var aggValues : AggValues, with only the grouping terms of the distinct row filled.
+  auto agg_values = codegen->MakeFreshIdentifier("aggValues");
+  function->Append(codegen->DeclareVarNoInit(agg_values, codegen->MakeExpr(agg_values_type_)));
+  for (uint32_t gb_idx = 0; gb_idx < GetAggPlan().GetGroupByTerms().size(); gb_idx++) {
+    auto rhs = filter.GetGroupByValue(codegen, codegen->MakeExpr(distinct_row), gb_idx);
+    function->Append(codegen->Assign(GetGroupByTerm(agg_values, gb_idx), rhs));
+  }
+
+  // Find or create the group in the thread-local table. The partial aggregates are merged with the other partials of
+  // the group when the produce pipeline merges the overflow partitions.
+  auto agg_ht = local_agg_ht_.GetPtr(codegen);
+  auto hash_val = HashInputKeys(function, agg_values);
+  auto agg_payload = PerformLookup(function, agg_ht, hash_val, agg_values);
+
+  If check_new_agg(function, codegen->IsNilPointer(codegen->MakeExpr(agg_payload)));
+  ConstructNewAggregate(function, agg_ht, agg_payload, agg_values, hash_val);
+  check_new_agg.EndIf();
+
+  auto agg_val = codegen->AddressOf(filter.GetAggregateValue(codegen, codegen->MakeExpr(distinct_row)));
+  function->Append(codegen->AggregatorAdvance(GetAggregateTermPtr(agg_payload, term_idx), agg_val));
+}
+
 void HashAggregationTranslator::UpdateAggregates(WorkContext *context, FunctionBuilder *function,
                                                  ast::Expr *agg_ht) const {
   auto *codegen = GetCodeGen();
@@ -627,6 +674,12 @@ void HashAggregationTranslator::FinishPipelineWork(const Pipeline &pipeline, Fun
   if (IsBuildPipeline(pipeline)) {
     if (build_pipeline_.IsParallel()) {
       auto *codegen = GetCodeGen();
+
+      // Aggregate the distinct values of all threads before the thread-local tables are moved.
+      for (auto &p : distinct_filters_) {
+        p.second.MergeAndAggregate(codegen, function, GetQueryStatePtr(), GetThreadStateContainer());
+      }
+
       if (IsPipelineMetricsEnabled()) {
         // Setup the hooks
         auto *exec_ctx = GetExecutionContext();
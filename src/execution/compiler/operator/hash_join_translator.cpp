@@ -1,12 +1,17 @@
 #include "execution/compiler/operator/hash_join_translator.h"
 
+#include <algorithm>
+
 #include "execution/ast/type.h"
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "execution/sql/join_hash_table.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
 #include "planner/plannodes/hash_join_plan_node.h"
 #include "planner/plannodes/output_schema.h"
 
@@ -21,12 +26,16 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     // The ExecutionOperatingUnitType depends on whether it is the build pipeline or probe pipeline.
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
       join_consumer_flag_(false),
+      spillable_(CanSpill(*pipeline)),
+      replaying_spill_(false),
       build_row_var_(GetCodeGen()->MakeFreshIdentifier("buildRow")),
       build_row_type_(GetCodeGen()->MakeFreshIdentifier("BuildRow")),
       build_mark_(GetCodeGen()->MakeFreshIdentifier("buildMark")),
       probe_row_var_(GetCodeGen()->MakeFreshIdentifier("probeRow")),
       probe_row_type_(GetCodeGen()->MakeFreshIdentifier("ProbeRow")),
       join_consumer_(GetCodeGen()->MakeFreshIdentifier("joinConsumer")),
+      spill_replay_fn_(
+          GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("JoinSpilledPartitions"))),
       left_pipeline_(this, Pipeline::Parallelism::Parallel) {
   NOISEPAGE_ASSERT(!plan.GetLeftHashKeys().empty(), "Hash-join must have join keys from left input");
   NOISEPAGE_ASSERT(!plan.GetRightHashKeys().empty(), "Hash-join must have join keys from right input");
@@ -60,6 +69,8 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
   num_probe_rows_ = CounterDeclare("num_probe_rows", pipeline);
   num_match_rows_ = CounterDeclare("num_match_rows", pipeline);
 
+  PushDownBloomFilter(compilation_context, pipeline);
+
   if (left_pipeline_.IsParallel() && IsPipelineMetricsEnabled()) {
     parallel_build_pre_hook_fn_ =
         GetCodeGen()->MakeFreshIdentifier(left_pipeline_.CreatePipelineFunctionName("PreHook"));
@@ -68,6 +79,86 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
   }
 }
 
+bool HashJoinTranslator::CanSpill(const Pipeline &pipeline) const {
+  // Unmatched build rows of left outer joins are collected from the whole table at once
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) return false;
+  // Spilled matches are pushed after the probe pipeline is done, outside of any enclosing loop of a parent.
+  // The operators registered so far are the ones this join pushes to.
+  const auto &translators = pipeline.GetTranslators();
+  return std::none_of(translators.cbegin(), translators.cend(), [](const OperatorTranslator *translator) {
+    return translator->GetPlan().GetPlanNodeType() == planner::PlanNodeType::NESTLOOP;
+  });
+}
+
+void HashJoinTranslator::PushDownBloomFilter(CompilationContext *compilation_context, Pipeline *pipeline) {
+  const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
+
+  // Only joins that drop the probe tuples without a join partner can filter them early.
+  switch (join_plan.GetLogicalJoinType()) {
+    case planner::LogicalJoinType::INNER:
+    case planner::LogicalJoinType::LEFT:
+    case planner::LogicalJoinType::SEMI:
+    case planner::LogicalJoinType::LEFT_SEMI:
+    case planner::LogicalJoinType::RIGHT_SEMI:
+      break;
+    default:
+      return;
+  }
+
+  // The probe side must be a sequential scan.
+  const auto *probe_child = join_plan.GetChild(1);
+  if (probe_child->GetPlanNodeType() != planner::PlanNodeType::SEQSCAN) return;
+  auto *scan = static_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*probe_child));
+
+  // Every probe key must be a column of the scanned table, whose values are hashed the same way
+  // in the scan's vector projection as they are by the probe.
+  std::vector<uint32_t> key_cols;
+  for (const auto &right_hash_key : join_plan.GetRightHashKeys()) {
+    if (right_hash_key->GetExpressionType() != parser::ExpressionType::VALUE_TUPLE) return;
+    auto dve = right_hash_key.CastManagedPointerTo<parser::DerivedValueExpression>();
+    if (dve->GetTupleIdx() != 1) return;
+    const auto &col = probe_child->GetOutputSchema()->GetColumn(dve->GetValueIdx());
+    if (col.GetType() == type::TypeId::DECIMAL || col.GetType() == type::TypeId::VARBINARY) return;
+    if (col.GetExpr()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) return;
+    auto cve = col.GetExpr().CastManagedPointerTo<parser::ColumnValueExpression>();
+    key_cols.push_back(scan->GetColOidIndex(cve->GetColumnOid()));
+  }
+
+  bloom_filter_key_cols_ = std::move(key_cols);
+  bloom_filter_fn_ = GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("BloomFilter"));
+  scan->AddRuntimeFilter(bloom_filter_fn_);
+}
+
+ast::FunctionDecl *HashJoinTranslator::GenerateBloomFilterFunction() const {
+  // Signature: (execCtx: *ExecutionContext, vp: *VectorProjection, tids: *TupleIdList, queryState: *QueryState) -> nil
+  // The filter manager of the scan provides the query state as the context of its filter terms.
+  auto *codegen = GetCodeGen();
+  util::RegionVector<ast::FieldDecl *> params = codegen->MakeFieldList({
+      codegen->MakeField(codegen->MakeIdentifier("execCtx"), codegen->PointerType(ast::BuiltinType::ExecutionContext)),
+      codegen->MakeField(codegen->MakeIdentifier("vp"), codegen->PointerType(ast::BuiltinType::VectorProjection)),
+      codegen->MakeField(codegen->MakeIdentifier("tids"), codegen->PointerType(ast::BuiltinType::TupleIdList)),
+  });
+  auto query_params = GetCompilationContext()->QueryParams();
+  params.insert(params.end(), query_params.begin(), query_params.end());
+  FunctionBuilder builder(codegen, bloom_filter_fn_, std::move(params), codegen->Nil());
+  {
+    ast::Expr *vector_proj = builder.GetParameterByPosition(1);
+    ast::Expr *tid_list = builder.GetParameterByPosition(2);
+
+    // var keyCols: [num_keys]uint32
+    ast::Identifier key_cols = codegen->MakeFreshIdentifier("keyCols");
+    ast::Expr *arr_type = codegen->ArrayType(bloom_filter_key_cols_.size(), ast::BuiltinType::Kind::Uint32);
+    builder.Append(codegen->DeclareVarNoInit(key_cols, arr_type));
+    for (uint32_t i = 0; i < bloom_filter_key_cols_.size(); i++) {
+      builder.Append(codegen->Assign(codegen->ArrayAccess(key_cols, i), codegen->Const32(bloom_filter_key_cols_[i])));
+    }
+
+    // @joinHTFilterBatch(&queryState.jht, vp, tids, keyCols)
+    builder.Append(codegen->JoinHashTableFilterBatch(global_join_ht_.GetPtr(codegen), vector_proj, tid_list, key_cols));
+  }
+  return builder.Finish();
+}
+
 void HashJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
   auto *codegen = GetCodeGen();
 
@@ -81,8 +172,8 @@ void HashJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl
   struct_decl_ = struct_decl;
   decls->push_back(struct_decl);
 
-  /* Probe row declaration - only for left outer joins */
-  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+  /* Probe row declaration - only for left outer joins and joins that can spill */
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT || spillable_) {
     // TODO(abalakum): support mini-runners for this struct as well
     fields = codegen->MakeEmptyFieldList();
     GetAllChildOutputFields(1, row_attr_prefix, &fields);
@@ -112,6 +203,10 @@ void HashJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionD
     join_consumer_flag_ = false;
     decls->push_back(function.Finish());
   }
+
+  if (!bloom_filter_key_cols_.empty()) {
+    decls->push_back(GenerateBloomFilterFunction());
+  }
 }
 
 ast::FunctionDecl *HashJoinTranslator::GenerateStartHookFunction() const {
@@ -156,10 +251,46 @@ void HashJoinTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipel
     decls->push_back(GenerateStartHookFunction());
     decls->push_back(GenerateEndHookFunction());
   }
+  if (IsRightPipeline(pipeline) && spillable_) {
+    decls->push_back(GenerateSpillReplayFunction(pipeline));
+  }
+}
+
+ast::FunctionDecl *HashJoinTranslator::GenerateSpillReplayFunction(const Pipeline &pipeline) {
+  auto *codegen = GetCodeGen();
+  // Matches are pushed from a fresh WorkContext, in the same state as the one in PerformPipelineWork
+  WorkContext context(GetCompilationContext(), pipeline);
+  context.SetSource(this);
+  FunctionBuilder function(codegen, spill_replay_fn_, pipeline.PipelineParams(), codegen->Nil());
+  {
+    replaying_spill_ = true;
+    ast::Expr *jht = global_join_ht_.GetPtr(codegen);
+
+    // while (@joinHTLoadSpilledPartition(jht))
+    Loop partition_loop(&function, codegen->JoinHashTableLoadSpilledPartition(jht));
+    {
+      // var probeRow = @ptrCast(*ProbeRow, @joinHTNextSpilledProbe(jht))
+      // for (; probeRow != nil; probeRow = @ptrCast(*ProbeRow, @joinHTNextSpilledProbe(jht)))
+      ast::Expr *probe_row = codegen->MakeExpr(probe_row_var_);
+      function.Append(
+          codegen->DeclareVarWithInit(probe_row_var_, codegen->JoinHashTableNextSpilledProbe(jht, probe_row_type_)));
+      ast::Expr *has_probe = codegen->Compare(parsing::Token::Type::BANG_EQUAL, probe_row, codegen->Nil());
+      Loop probe_loop(&function, nullptr, has_probe,
+                      codegen->Assign(probe_row, codegen->JoinHashTableNextSpilledProbe(jht, probe_row_type_)));
+      { ProbeJoinHashTable(&context, &function); }
+      probe_loop.EndLoop();
+    }
+    partition_loop.EndLoop();
+    replaying_spill_ = false;
+  }
+  return function.Finish();
 }
 
 void HashJoinTranslator::InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
   function->Append(GetCodeGen()->JoinHashTableInit(jht_ptr, GetExecutionContext(), build_row_type_));
+  if (spillable_) {
+    function->Append(GetCodeGen()->JoinHashTableEnableSpilling(jht_ptr));
+  }
 }
 
 void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
@@ -169,6 +300,9 @@ void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::E
 void HashJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
   InitializeJoinHashTable(function, global_join_ht_.GetPtr(codegen));
+  if (!bloom_filter_key_cols_.empty()) {
+    function->Append(codegen->JoinHashTableEnableBloomFilter(global_join_ht_.GetPtr(codegen)));
+  }
 }
 
 void HashJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
@@ -358,6 +492,20 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
   }
 }
 
+void HashJoinTranslator::SpillProbeRow(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // var hashVal = @hash(...)
+  auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+
+  // var probeRow = @ptrCast(*ProbeRow, @joinHTSpillProbe(...))
+  function->Append(codegen->DeclareVarWithInit(
+      probe_row_var_, codegen->JoinHashTableSpillProbe(global_join_ht_.GetPtr(codegen), hash_val, probe_row_type_)));
+
+  // Fill row.
+  FillProbeRow(ctx, function, codegen->MakeExpr(probe_row_var_));
+}
+
 void HashJoinTranslator::CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const {
   const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
   auto *codegen = GetCodeGen();
@@ -478,7 +626,17 @@ void HashJoinTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *
     InsertIntoJoinHashTable(ctx, function);
   } else {
     NOISEPAGE_ASSERT(IsRightPipeline(ctx->GetPipeline()), "Pipeline is unknown to join translator");
-    ProbeJoinHashTable(ctx, function);
+    if (spillable_) {
+      // Probes of a spilled table are joined once the probe side is done
+      // if (@joinHTIsSpilled(jht)) { spill } else { probe }
+      If spilled(function, GetCodeGen()->JoinHashTableIsSpilled(global_join_ht_.GetPtr(GetCodeGen())));
+      SpillProbeRow(ctx, function);
+      spilled.Else();
+      ProbeJoinHashTable(ctx, function);
+      spilled.EndIf();
+    } else {
+      ProbeJoinHashTable(ctx, function);
+    }
   }
 }
 
@@ -517,6 +675,14 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       CollectUnmatchedLeftRows(function);
     }
 
+    if (spillable_) {
+      // if (@joinHTIsSpilled(jht)) { joinSpilledPartitions(queryState, pipelineState) }
+      If spilled(function, codegen->JoinHashTableIsSpilled(global_join_ht_.GetPtr(codegen)));
+      ast::Expr *pipeline_state = codegen->MakeExpr(GetPipeline()->GetPipelineStateVar());
+      function->Append(codegen->MakeStmt(codegen->Call(spill_replay_fn_, {GetQueryStatePtr(), pipeline_state})));
+      spilled.EndIf();
+    }
+
     if (!pipeline.IsParallel()) {
       RecordCounters(pipeline, function);
     }
@@ -527,13 +693,14 @@ ast::Expr *HashJoinTranslator::GetChildOutput(WorkContext *context, uint32_t chi
   // If the request is in the probe pipeline and for an attribute in the left
   // child, we read it from the probe/materialized build row.
   //
-  // Otherwise if within the joinConsumer function we read from the ProbeRow and if not propagate
+  // Otherwise if within the joinConsumer function or joining spilled partitions we read from the
+  // ProbeRow and if not propagate
   // the request to the correct child
   if (IsRightPipeline(context->GetPipeline()) && child_idx == 0) {
     auto row = GetCodeGen()->MakeExpr(build_row_var_);
     return GetRowAttribute(row, attr_idx);
   }
-  if (IsRightPipeline(context->GetPipeline()) && child_idx == 1 && join_consumer_flag_) {
+  if (IsRightPipeline(context->GetPipeline()) && child_idx == 1 && (join_consumer_flag_ || replaying_spill_)) {
     auto row = GetCodeGen()->MakeExpr(probe_row_var_);
     return GetRowAttribute(row, attr_idx);
   }
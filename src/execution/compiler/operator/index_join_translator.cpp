@@ -1,5 +1,7 @@
 #include "execution/compiler/operator/index_join_translator.h"
 
+#include <algorithm>
+#include <string>
 #include <unordered_map>
 
 #include "catalog/catalog_accessor.h"
@@ -10,12 +12,18 @@
 #include "execution/compiler/loop.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/work_context.h"
+#include "execution/sql/index_iterator.h"
 #include "planner/plannodes/index_join_plan_node.h"
+#include "planner/plannodes/output_schema.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
 
 namespace noisepage::execution::compiler {
 
+namespace {
+const char *outer_row_attr_prefix = "attr";
+}  // namespace
+
 IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
                                          CompilationContext *compilation_context, Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
@@ -29,8 +37,12 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
       lo_index_pr_(GetCodeGen()->MakeFreshIdentifier("lo_index_pr")),
       hi_index_pr_(GetCodeGen()->MakeFreshIdentifier("hi_index_pr")),
       table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
-      slot_(GetCodeGen()->MakeFreshIdentifier("slot")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+      slot_(GetCodeGen()->MakeFreshIdentifier("slot")),
+      batch_lookups_(CanBatchLookups(*pipeline)),
+      outer_row_type_(GetCodeGen()->MakeFreshIdentifier("IndexJoinOuterRow")),
+      outer_row_var_(GetCodeGen()->MakeFreshIdentifier("outerRow")),
+      batch_idx_(GetCodeGen()->MakeFreshIdentifier("batchIdx")),
+      flush_batch_fn_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("IndexJoinFlushBatch"))) {
   if (plan.GetJoinPredicate() != nullptr) {
     compilation_context->Prepare(*plan.GetJoinPredicate());
   }
@@ -46,15 +58,110 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
   index_size_ = CounterDeclare("index_size", pipeline);
   num_scans_index_ = CounterDeclare("num_scans_index", pipeline);
   num_loops_ = CounterDeclare("num_loops", pipeline);
+
+  if (batch_lookups_) {
+    auto *codegen = GetCodeGen();
+    batch_iter_ =
+        pipeline->DeclarePipelineStateEntry("indexIter", codegen->BuiltinType(ast::BuiltinType::IndexIterator));
+    outer_rows_ = pipeline->DeclarePipelineStateEntry(
+        "outerRows", codegen->ArrayType(sql::IndexIterator::BATCH_SIZE, codegen->MakeExpr(outer_row_type_)));
+    num_outer_rows_ =
+        pipeline->DeclarePipelineStateEntry("numOuterRows", codegen->BuiltinType(ast::BuiltinType::Uint32));
+  }
+}
+
+bool IndexJoinTranslator::CanBatchLookups(const Pipeline &pipeline) const {
+  if (GetPlanAs<planner::IndexJoinPlanNode>().GetScanType() != planner::IndexScanType::Exact) return false;
+  // The operators registered so far are the ones this join pushes to
+  const auto &translators = pipeline.GetTranslators();
+  return std::none_of(translators.cbegin(), translators.cend(), [](const OperatorTranslator *translator) {
+    switch (translator->GetPlan().GetPlanNodeType()) {
+      case planner::PlanNodeType::NESTLOOP:
+      case planner::PlanNodeType::INSERT:
+      case planner::PlanNodeType::UPDATE:
+      case planner::PlanNodeType::DELETE:
+        return true;
+      default:
+        return false;
+    }
+  });
+}
+
+void IndexJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+  if (!batch_lookups_) return;
+  // Outer tuple, buffered until the lookup of its key
+  auto fields = GetCodeGen()->MakeEmptyFieldList();
+  GetAllChildOutputFields(0, outer_row_attr_prefix, &fields);
+  decls->push_back(GetCodeGen()->DeclareStruct(outer_row_type_, std::move(fields)));
+}
+
+void IndexJoinTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
+                                                            util::RegionVector<ast::FunctionDecl *> *decls) {
+  if (!batch_lookups_ || &pipeline != GetPipeline()) return;
+  auto *codegen = GetCodeGen();
+  // The matches are pushed from a fresh WorkContext, in the same state as the one in PerformPipelineWork
+  WorkContext context(GetCompilationContext(), pipeline);
+  context.SetSource(this);
+  FunctionBuilder function(codegen, flush_batch_fn_, pipeline.PipelineParams(), codegen->Nil());
+  {
+    consuming_batch_ = true;
+    // @indexIteratorScanBatch(&pipelineState.indexIter)
+    function.Append(codegen->MakeStmt(codegen->CallBuiltin(ast::Builtin::IndexIteratorScanBatch, {IteratorPtr()})));
+
+    // for (var batchIdx: uint32 = 0; batchIdx < pipelineState.numOuterRows; batchIdx = batchIdx + 1)
+    ast::Expr *batch_idx = codegen->MakeExpr(batch_idx_);
+    function.Append(
+        codegen->DeclareVar(batch_idx_, codegen->BuiltinType(ast::BuiltinType::Uint32), codegen->Const32(0)));
+    ast::Expr *has_next = codegen->Compare(parsing::Token::Type::LESS, batch_idx, num_outer_rows_.Get(codegen));
+    ast::Expr *next_idx = codegen->BinaryOp(parsing::Token::Type::PLUS, batch_idx, codegen->Const32(1));
+    Loop loop(&function, nullptr, has_next, codegen->Assign(batch_idx, next_idx));
+    {
+      // var outerRow = &pipelineState.outerRows[batchIdx]
+      function.Append(codegen->DeclareVarWithInit(
+          outer_row_var_, codegen->AddressOf(codegen->ArrayAccess(outer_rows_.Get(codegen), batch_idx))));
+      // @indexIteratorSelectBatchKey(&pipelineState.indexIter, batchIdx)
+      ast::Expr *select_call =
+          codegen->CallBuiltin(ast::Builtin::IndexIteratorSelectBatchKey, {IteratorPtr(), batch_idx});
+      ConsumeMatches(&context, &function, codegen->MakeStmt(select_call));
+    }
+    loop.EndLoop();
+
+    // pipelineState.numOuterRows = 0
+    function.Append(codegen->Assign(num_outer_rows_.Get(codegen), codegen->Const32(0)));
+    CounterSetExpr(&function, index_size_, codegen->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {IteratorPtr()}));
+    consuming_batch_ = false;
+  }
+  decls->push_back(function.Finish());
 }
 
 void IndexJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
-  CounterSet(function, index_size_, 0);
-  CounterSet(function, num_scans_index_, 0);
-  CounterSet(function, num_loops_, 0);
+  InitializeCounters(pipeline, function);
+
+  if (batch_lookups_) {
+    // @indexIteratorInit(&pipelineState.indexIter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
+    SetOids(function);
+    const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
+    ast::Expr *init_call = GetCodeGen()->IndexIteratorInit(
+        IteratorPtr(), GetCompilationContext()->GetExecutionContextPtrFromQueryState(),
+        static_cast<uint32_t>(op.GetLoIndexColumns().size()), op.GetTableOid().UnderlyingValue(),
+        op.GetIndexOid().UnderlyingValue(), col_oids_);
+    function->Append(GetCodeGen()->MakeStmt(init_call));
+    // pipelineState.numOuterRows = 0
+    function->Append(GetCodeGen()->Assign(num_outer_rows_.Get(GetCodeGen()), GetCodeGen()->Const32(0)));
+  }
+}
+
+void IndexJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // @indexIteratorFree(&pipelineState.indexIter)
+  if (batch_lookups_) FreeIterator(function);
 }
 
 void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
+  if (batch_lookups_) {
+    AddToBatch(context, function);
+    return;
+  }
+
   const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
@@ -72,14 +179,65 @@ void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
 
   // @indexIteratorScanKey(&index_iter)
   ast::Expr *scan_call = GetCodeGen()->IndexIteratorScan(index_iter_, op.GetScanType(), 0);
-  ast::Stmt *loop_init = GetCodeGen()->MakeStmt(scan_call);
-  // @indexIteratorAdvance(&index_iter)
-  ast::Expr *advance_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetCodeGen()->AddressOf(index_iter_)});
 
   CounterAdd(function, num_loops_, 1);
 
-  // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
+  // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);) { ... }
+  ConsumeMatches(context, function, GetCodeGen()->MakeStmt(scan_call));
+
+  CounterSetExpr(function, index_size_,
+                 GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {GetCodeGen()->AddressOf(index_iter_)}));
+  // @indexIteratorFree(&index_iter_)
+  FreeIterator(function);
+}
+
+void IndexJoinTranslator::AddToBatch(WorkContext *context, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  // var lo_index_pr = @indexIteratorGetLoPR(&pipelineState.indexIter)
+  ast::Expr *lo_pr_call = codegen->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {IteratorPtr()});
+  function->Append(codegen->DeclareVarWithInit(lo_index_pr_, lo_pr_call));
+  // @prSet(lo_index_pr, ...)
+  FillKey(context, function, lo_index_pr_, GetPlanAs<planner::IndexJoinPlanNode>().GetLoIndexColumns());
+  // @indexIteratorAddBatchKey(&pipelineState.indexIter)
+  function->Append(codegen->MakeStmt(codegen->CallBuiltin(ast::Builtin::IndexIteratorAddBatchKey, {IteratorPtr()})));
+
+  // var outerRow = &pipelineState.outerRows[pipelineState.numOuterRows]
+  // outerRow.attr_i = ...
+  ast::Expr *num_outer_rows = num_outer_rows_.Get(codegen);
+  function->Append(codegen->DeclareVarWithInit(
+      outer_row_var_, codegen->AddressOf(codegen->ArrayAccess(outer_rows_.Get(codegen), num_outer_rows))));
+  const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+  for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+    auto attr_name = codegen->MakeIdentifier(outer_row_attr_prefix + std::to_string(attr_idx));
+    ast::Expr *lhs = codegen->AccessStructMember(codegen->MakeExpr(outer_row_var_), attr_name);
+    function->Append(codegen->Assign(lhs, GetChildOutput(context, 0, attr_idx)));
+  }
+  // pipelineState.numOuterRows = pipelineState.numOuterRows + 1
+  function->Append(codegen->Assign(
+      num_outer_rows_.Get(codegen),
+      codegen->BinaryOp(parsing::Token::Type::PLUS, num_outer_rows_.Get(codegen), codegen->Const32(1))));
+
+  CounterAdd(function, num_loops_, 1);
+
+  // if (pipelineState.numOuterRows == BATCH_SIZE) { flush(queryState, pipelineState) }
+  If full(function, codegen->Compare(parsing::Token::Type::EQUAL_EQUAL, num_outer_rows_.Get(codegen),
+                                     codegen->Const32(sql::IndexIterator::BATCH_SIZE)));
+  FlushBatch(function);
+  full.EndIf();
+}
+
+void IndexJoinTranslator::FlushBatch(FunctionBuilder *function) const {
+  // flush(queryState, pipelineState)
+  auto *codegen = GetCodeGen();
+  ast::Expr *pipeline_state = codegen->MakeExpr(GetPipeline()->GetPipelineStateVar());
+  function->Append(codegen->MakeStmt(codegen->Call(flush_batch_fn_, {GetQueryStatePtr(), pipeline_state})));
+}
+
+void IndexJoinTranslator::ConsumeMatches(WorkContext *context, FunctionBuilder *function, ast::Stmt *loop_init) const {
+  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
+  // @indexIteratorAdvance(&index_iter)
+  ast::Expr *advance_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {IteratorPtr()});
+
   Loop loop(function, loop_init, advance_call, nullptr);
   {
     // var table_pr = @indexIteratorGetTablePR(&index_iter)
@@ -102,14 +260,37 @@ void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
     CounterAdd(function, num_scans_index_, 1);
   }
   loop.EndLoop();
+}
 
-  CounterSetExpr(function, index_size_,
-                 GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {GetCodeGen()->AddressOf(index_iter_)}));
-  // @indexIteratorFree(&index_iter_)
-  FreeIterator(function);
+void IndexJoinTranslator::FlushPendingBatch(FunctionBuilder *function) const {
+  if (!batch_lookups_) return;
+  // if (pipelineState.numOuterRows > 0) { flush(queryState, pipelineState) }
+  If pending(function, GetCodeGen()->Compare(parsing::Token::Type::GREATER, num_outer_rows_.Get(GetCodeGen()),
+                                             GetCodeGen()->Const32(0)));
+  FlushBatch(function);
+  pending.EndIf();
 }
 
 void IndexJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // Every thread flushed its own batch at the end of its parallel work
+  if (!pipeline.IsParallel()) {
+    FlushPendingBatch(function);
+    RecordCounters(pipeline, function);
+  }
+}
+
+void IndexJoinTranslator::EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  FlushPendingBatch(function);
+  RecordCounters(pipeline, function);
+}
+
+void IndexJoinTranslator::InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
+  CounterSet(function, index_size_, 0);
+  CounterSet(function, num_scans_index_, 0);
+  CounterSet(function, num_loops_, 0);
+}
+
+void IndexJoinTranslator::RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
   // To match the models, IDX_SCAN::CARDINALITY is recorded as per-loop num scans.
   // i.e. if num loops > 0, this is recorded as int(num_scans_index_ / num_loops_)
   if (IsCountersEnabled()) {
@@ -177,9 +358,9 @@ void IndexJoinTranslator::DeclareIndexPR(noisepage::execution::compiler::Functio
   // var lo_pr = @indexIteratorGetLoPR(&index_iter)
   // var hi_pr = @indexIteratorGetHiPR(&index_iter)
   ast::Expr *lo_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {IteratorPtr()});
   ast::Expr *hi_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetHiPR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetHiPR, {IteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(lo_index_pr_, nullptr, lo_pr_call));
   builder->Append(GetCodeGen()->DeclareVar(hi_index_pr_, nullptr, hi_pr_call));
 }
@@ -187,14 +368,14 @@ void IndexJoinTranslator::DeclareIndexPR(noisepage::execution::compiler::Functio
 void IndexJoinTranslator::DeclareTablePR(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var table_pr = @indexIteratorGetTablePR(&index_iter)
   ast::Expr *get_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {IteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
 }
 
 void IndexJoinTranslator::DeclareSlot(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var slot = @indexIteratorGetSlot(&index_iter)
   ast::Expr *get_slot_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {IteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(slot_, nullptr, get_slot_call));
 }
 
@@ -213,6 +394,20 @@ void IndexJoinTranslator::FillKey(
   }
 }
 
+ast::Expr *IndexJoinTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
+  // While pushing the matches of a batch, the outer tuple is read from its buffered copy
+  if (consuming_batch_ && child_idx == 0) {
+    auto attr_name = GetCodeGen()->MakeIdentifier(outer_row_attr_prefix + std::to_string(attr_idx));
+    return GetCodeGen()->AccessStructMember(GetCodeGen()->MakeExpr(outer_row_var_), attr_name);
+  }
+  return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+}
+
+ast::Expr *IndexJoinTranslator::IteratorPtr() const {
+  // &pipelineState.indexIter or &index_iter
+  return batch_lookups_ ? batch_iter_.GetPtr(GetCodeGen()) : GetCodeGen()->AddressOf(index_iter_);
+}
+
 ast::Expr *IndexJoinTranslator::GetSlotAddress() const {
   // &slot
   return GetCodeGen()->AddressOf(slot_);
@@ -221,7 +416,7 @@ ast::Expr *IndexJoinTranslator::GetSlotAddress() const {
 void IndexJoinTranslator::FreeIterator(FunctionBuilder *builder) const {
   // @indexIteratorFree(&index_iter_)
   ast::Expr *free_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {IteratorPtr()});
   builder->Append(GetCodeGen()->MakeStmt(free_call));
 }
 
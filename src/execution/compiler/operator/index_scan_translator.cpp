@@ -31,7 +31,8 @@ IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlanNode &plan,
       hi_index_pr_(GetCodeGen()->MakeFreshIdentifier("hi_index_pr")),
       table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
       slot_(GetCodeGen()->MakeFreshIdentifier("slot")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  pipeline->RegisterSource(this, plan.GetScanType() == planner::IndexScanType::Exact ? Pipeline::Parallelism::Serial
+                                                                                     : Pipeline::Parallelism::Parallel);
   if (plan.GetScanPredicate() != nullptr) {
     compilation_context->Prepare(*plan.GetScanPredicate());
   }
@@ -55,7 +56,7 @@ void IndexScanTranslator::InitializePipelineState(const Pipeline &pipeline, Func
   CounterSet(function, num_scans_index_, 0);
 }
 
-void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
+void IndexScanTranslator::PrepareScan(WorkContext *context, FunctionBuilder *function) const {
   const auto &op = GetPlanAs<planner::IndexScanPlanNode>();
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
@@ -75,21 +76,39 @@ void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
     FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
     FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
   }
+}
+
+ast::Expr *IndexScanTranslator::IteratorPtr(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // In a parallel scan, the iterator over the range of results is provided
+  if (pipeline.IsParallel()) {
+    return function->GetParameterByPosition(pipeline.PipelineParams().size());
+  }
+  return GetCodeGen()->AddressOf(index_iter_);
+}
 
-  // @indexIteratorScanKey(&index_iter)
-  ast::Expr *scan_call = GetCodeGen()->IndexIteratorScan(index_iter_, op.GetScanType(), op.GetScanLimit());
-  ast::Stmt *loop_init = GetCodeGen()->MakeStmt(scan_call);
+void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
+  const auto &op = GetPlanAs<planner::IndexScanPlanNode>();
+  const auto &pipeline = context->GetPipeline();
+
+  // In a parallel scan, the index was already scanned when the work was launched
+  ast::Stmt *loop_init = nullptr;
+  if (!pipeline.IsParallel()) {
+    PrepareScan(context, function);
+    // @indexIteratorScanKey(&index_iter)
+    loop_init = GetCodeGen()->MakeStmt(GetCodeGen()->IndexIteratorScan(index_iter_, op.GetScanType(),
+                                                                        op.GetScanLimit()));
+  }
   // @indexIteratorAdvance(&index_iter)
   ast::Expr *advance_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {IteratorPtr(pipeline, function)});
 
   // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
   Loop loop(function, loop_init, advance_call, nullptr);
   {
     // var table_pr = @indexIteratorGetTablePR(&index_iter)
-    DeclareTablePR(function);
+    DeclareTablePR(function, IteratorPtr(pipeline, function));
     // var slot = @indexIteratorGetSlot(&index_iter)
-    DeclareSlot(function);
+    DeclareSlot(function, IteratorPtr(pipeline, function));
 
     bool has_predicate = op.GetScanPredicate() != nullptr;
     if (has_predicate) {
@@ -107,16 +126,38 @@ void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
   }
   loop.EndLoop();
 
-  // @indexIteratorFree(&index_iter_)
-  FreeIterator(function);
-
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::IDX_SCAN,
-                selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, context->GetPipeline(),
-                GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {GetCodeGen()->AddressOf(index_iter_)}));
+                selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline,
+                GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {IteratorPtr(pipeline, function)}));
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::IDX_SCAN,
-                selfdriving::ExecutionOperatingUnitFeatureAttribute::CARDINALITY, context->GetPipeline(),
+                selfdriving::ExecutionOperatingUnitFeatureAttribute::CARDINALITY, pipeline,
                 CounterVal(num_scans_index_));
-  FeatureArithmeticRecordSet(function, context->GetPipeline(), GetTranslatorId(), CounterVal(num_scans_index_));
+  FeatureArithmeticRecordSet(function, pipeline, GetTranslatorId(), CounterVal(num_scans_index_));
+
+  if (!pipeline.IsParallel()) {
+    // @indexIteratorFree(&index_iter_)
+    FreeIterator(function);
+  }
+}
+
+util::RegionVector<ast::FieldDecl *> IndexScanTranslator::GetWorkerParams() const {
+  auto *codegen = GetCodeGen();
+  return codegen->MakeFieldList({codegen->MakeField(codegen->MakeIdentifier("indexIter"),
+                                                    codegen->PointerType(ast::BuiltinType::IndexIterator))});
+}
+
+void IndexScanTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const {
+  auto *codegen = GetCodeGen();
+  const auto &op = GetPlanAs<planner::IndexScanPlanNode>();
+  // The keys are filled in and the index is scanned once, before the results are split among the workers
+  WorkContext context(GetCompilationContext(), *GetPipeline());
+  PrepareScan(&context, function);
+  function->Append(codegen->MakeStmt(codegen->IndexIteratorScan(index_iter_, op.GetScanType(), op.GetScanLimit())));
+  // @indexIteratorParallelScan(&index_iter, queryState, tls, work_fn)
+  function->Append(codegen->IndexIteratorParallelScan(codegen->AddressOf(index_iter_), GetQueryStatePtr(),
+                                                      GetThreadStateContainer(), work_func_name));
+  // @indexIteratorFree(&index_iter_)
+  FreeIterator(function);
 }
 
 ast::Expr *IndexScanTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
@@ -178,17 +219,17 @@ void IndexScanTranslator::DeclareIndexPR(noisepage::execution::compiler::Functio
   }
 }
 
-void IndexScanTranslator::DeclareTablePR(noisepage::execution::compiler::FunctionBuilder *builder) const {
+void IndexScanTranslator::DeclareTablePR(noisepage::execution::compiler::FunctionBuilder *builder,
+                                         ast::Expr *iter) const {
   // var table_pr = @indexIteratorGetTablePR(&index_iter)
-  ast::Expr *get_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {iter});
   builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
 }
 
-void IndexScanTranslator::DeclareSlot(noisepage::execution::compiler::FunctionBuilder *builder) const {
+void IndexScanTranslator::DeclareSlot(noisepage::execution::compiler::FunctionBuilder *builder,
+                                      ast::Expr *iter) const {
   // var slot = @indexIteratorGetSlot(&index_iter)
-  ast::Expr *get_slot_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *get_slot_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {iter});
   builder->Append(GetCodeGen()->DeclareVar(slot_, nullptr, get_slot_call));
 }
 
@@ -19,7 +19,6 @@ namespace noisepage::execution::compiler {
 InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, CompilationContext *compilation_context,
                                    Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::INSERT),
-      inserter_(GetCodeGen()->MakeFreshIdentifier("inserter")),
       insert_pr_(GetCodeGen()->MakeFreshIdentifier("insert_pr")),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")),
       table_schema_(GetCodeGen()->GetCatalogAccessor()->GetSchema(GetPlanAs<planner::InsertPlanNode>().GetTableOid())),
@@ -28,7 +27,12 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
                     ->GetCatalogAccessor()
                     ->GetTable(GetPlanAs<planner::InsertPlanNode>().GetTableOid())
                     ->ProjectionMapForOids(all_oids_)) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  if (plan.GetChildrenSize() > 0) {
+    // INSERT INTO ... SELECT, the child drives the pipeline.
+    compilation_context->Prepare(*plan.GetChild(0), pipeline);
+  } else {
+    pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  }
   for (uint32_t idx = 0; idx < plan.GetBulkInsertCount(); idx++) {
     const auto &node_vals = GetPlanAs<planner::InsertPlanNode>().GetValues(idx);
     for (const auto &node_val : node_vals) {
@@ -44,68 +48,105 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
     }
   }
 
+  inserter_ = pipeline->DeclarePipelineStateEntry(
+      "inserter", GetCodeGen()->BuiltinType(ast::BuiltinType::Kind::StorageInterface));
   num_inserts_ = CounterDeclare("num_inserts", pipeline);
 }
 
 void InsertTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
-  CounterSet(function, num_inserts_, 0);
+  InitializeCounters(pipeline, function);
+  // var col_oids: [num_cols]uint32
+  // col_oids[i] = ...
+  // @storageInterfaceInitBatched(&pipelineState.inserter, execCtx, table_oid, col_oids, true)
+  InitInserter(function);
+}
+
+void InsertTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // @storageInterfaceFree(&pipelineState.inserter)
+  GenInserterFree(function);
 }
 
 void InsertTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
-  // var col_oids: [num_cols]uint32
-  // col_oids[i] = ...
-  // var inserter : StorageInterface
-  // @storageInterfaceInit(inserter, execCtx, table_oid, col_oids, true)
-  DeclareInserter(function);
   // var insert_pr : *ProjectedRow
   DeclareInsertPR(function);
 
-  for (uint32_t idx = 0; idx < GetPlanAs<planner::InsertPlanNode>().GetBulkInsertCount(); idx++) {
-    // var insert_pr = @getTablePR(&inserter)
+  const auto &op = GetPlanAs<planner::InsertPlanNode>();
+  if (op.GetChildrenSize() > 0) {
+    // var insert_pr = @getTablePR(&pipelineState.inserter)
+    GetInsertPR(function);
+    // For each output of the child, @prSet(insert_pr, ...)
+    GenSetTablePRFromChild(function, context);
+    GenInsertRow(function, context);
+    return;
+  }
+
+  for (uint32_t idx = 0; idx < op.GetBulkInsertCount(); idx++) {
+    // var insert_pr = @getTablePR(&pipelineState.inserter)
     GetInsertPR(function);
     // For each attribute, @prSet(insert_pr, ...)
     GenSetTablePR(function, context, idx);
-    // var insert_slot = @tableInsert(&inserter)
-    GenTableInsert(function);
-    function->Append(GetCodeGen()->ExecCtxAddRowsAffected(GetExecutionContext(), 1));
-    const auto &index_oids = GetPlanAs<planner::InsertPlanNode>().GetIndexOids();
-    for (const auto &index_oid : index_oids) {
-      GenIndexInsert(context, function, index_oid);
-    }
+    GenInsertRow(function, context);
+  }
+}
+
+void InsertTranslator::GenInsertRow(FunctionBuilder *builder, WorkContext *context) const {
+  // @tableInsertBatched(&pipelineState.inserter)
+  GenTableInsert(builder);
+  builder->Append(GetCodeGen()->ExecCtxAddRowsAffected(GetExecutionContext(), 1));
+  const auto &index_oids = GetPlanAs<planner::InsertPlanNode>().GetIndexOids();
+  for (const auto &index_oid : index_oids) {
+    GenIndexInsert(context, builder, index_oid);
   }
+}
+
+void InsertTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // Every thread of a parallel pipeline flushed its own inserts at the end of its work
+  if (!pipeline.IsParallel()) {
+    GenInserterFlush(function);
+    RecordCounters(pipeline, function);
+  }
+}
 
+void InsertTranslator::EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  GenInserterFlush(function);
+  RecordCounters(pipeline, function);
+}
+
+void InsertTranslator::InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
+  CounterSet(function, num_inserts_, 0);
+}
+
+void InsertTranslator::RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::INSERT,
-                selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, context->GetPipeline(),
-                CounterVal(num_inserts_));
+                selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline, CounterVal(num_inserts_));
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::INSERT,
-                selfdriving::ExecutionOperatingUnitFeatureAttribute::CARDINALITY, context->GetPipeline(),
-                CounterVal(num_inserts_));
-  FeatureArithmeticRecordMul(function, context->GetPipeline(), GetTranslatorId(), CounterVal(num_inserts_));
-
-  GenInserterFree(function);
+                selfdriving::ExecutionOperatingUnitFeatureAttribute::CARDINALITY, pipeline, CounterVal(num_inserts_));
+  FeatureArithmeticRecordMul(function, pipeline, GetTranslatorId(), CounterVal(num_inserts_));
 }
 
-void InsertTranslator::DeclareInserter(noisepage::execution::compiler::FunctionBuilder *builder) const {
+void InsertTranslator::InitInserter(FunctionBuilder *builder) const {
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
   SetOids(builder);
-  // var inserter : StorageInterface
-  auto *storage_interface_type = GetCodeGen()->BuiltinType(ast::BuiltinType::Kind::StorageInterface);
-  builder->Append(GetCodeGen()->DeclareVar(inserter_, storage_interface_type, nullptr));
-  // @storageInterfaceInit(inserter, execCtx, table_oid, col_oids, true)
-  ast::Expr *inserter_setup = GetCodeGen()->StorageInterfaceInit(
-      inserter_, GetExecutionContext(), GetPlanAs<planner::InsertPlanNode>().GetTableOid().UnderlyingValue(), col_oids_,
-      true);
+  // @storageInterfaceInitBatched(&pipelineState.inserter, execCtx, table_oid, col_oids, true)
+  ast::Expr *inserter_setup = GetCodeGen()->StorageInterfaceInitBatched(
+      inserter_.GetPtr(GetCodeGen()), GetExecutionContext(),
+      GetPlanAs<planner::InsertPlanNode>().GetTableOid().UnderlyingValue(), col_oids_, true);
   builder->Append(GetCodeGen()->MakeStmt(inserter_setup));
 }
 
 void InsertTranslator::GenInserterFree(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // Call @storageInterfaceFree
   ast::Expr *inserter_free =
-      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {GetCodeGen()->AddressOf(inserter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {inserter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->MakeStmt(inserter_free));
 }
 
+void InsertTranslator::GenInserterFlush(FunctionBuilder *builder) const {
+  // @storageInterfaceFlush(&pipelineState.inserter)
+  builder->Append(GetCodeGen()->MakeStmt(GetCodeGen()->StorageInterfaceFlush(inserter_.GetPtr(GetCodeGen()))));
+}
+
 ast::Expr *InsertTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
   NOISEPAGE_ASSERT(child_idx == 0, "Insert plan can only have one child");
 
@@ -140,8 +181,8 @@ void InsertTranslator::DeclareInsertPR(noisepage::execution::compiler::FunctionB
 }
 
 void InsertTranslator::GetInsertPR(noisepage::execution::compiler::FunctionBuilder *builder) const {
-  // var insert_pr = @getTablePR(&inserter)
-  auto *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetTablePR, {GetCodeGen()->AddressOf(inserter_)});
+  // var insert_pr = @getTablePR(&pipelineState.inserter)
+  auto *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetTablePR, {inserter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->Assign(GetCodeGen()->MakeExpr(insert_pr_), get_pr_call));
 }
 
@@ -161,20 +202,34 @@ void InsertTranslator::GenSetTablePR(FunctionBuilder *builder, WorkContext *cont
   }
 }
 
+void InsertTranslator::GenSetTablePRFromChild(FunctionBuilder *builder, WorkContext *context) const {
+  const auto &child = *GetPlan().GetChild(0);
+  for (uint32_t i = 0; i < child.GetOutputSchema()->NumColumns(); i++) {
+    // @prSet(insert_pr, ...)
+    auto *src = GetChildOutput(context, 0, i);
+
+    const auto &table_col_oid = all_oids_[i];
+    const auto &table_col = table_schema_.GetColumn(table_col_oid);
+    const auto &pr_set_call =
+        GetCodeGen()->PRSet(GetCodeGen()->MakeExpr(insert_pr_), table_col.Type(), table_col.Nullable(),
+                            table_pm_.find(table_col_oid)->second, src, true);
+    builder->Append(GetCodeGen()->MakeStmt(pr_set_call));
+  }
+}
+
 void InsertTranslator::GenTableInsert(FunctionBuilder *builder) const {
-  // var insert_slot = @tableInsert(&inserter)
-  const auto &insert_slot = GetCodeGen()->MakeFreshIdentifier("insert_slot");
-  auto *insert_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableInsert, {GetCodeGen()->AddressOf(inserter_)});
-  builder->Append(GetCodeGen()->DeclareVar(insert_slot, nullptr, insert_call));
+  // @tableInsertBatched(&pipelineState.inserter)
+  auto *insert_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableInsertBatched, {inserter_.GetPtr(GetCodeGen())});
+  builder->Append(GetCodeGen()->MakeStmt(insert_call));
 
   CounterAdd(builder, num_inserts_, 1);
 }
 
 void InsertTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *builder,
                                       const catalog::index_oid_t &index_oid) const {
-  // var insert_index_pr = @getIndexPR(&inserter, oid)
+  // var insert_index_pr = @getIndexPR(&pipelineState.inserter, oid)
   const auto &insert_index_pr = GetCodeGen()->MakeFreshIdentifier("insert_index_pr");
-  std::vector<ast::Expr *> pr_call_args{GetCodeGen()->AddressOf(inserter_),
+  std::vector<ast::Expr *> pr_call_args{inserter_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
   auto *get_index_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   builder->Append(GetCodeGen()->DeclareVar(insert_index_pr, nullptr, get_index_pr_call));
@@ -194,9 +249,9 @@ void InsertTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *bui
     builder->Append(GetCodeGen()->MakeStmt(set_key_call));
   }
 
-  // if (!@indexInsert(&inserter)) { Abort(); }
+  // if (!@indexInsert(&pipelineState.inserter)) { Abort(); }
   const auto &builtin = index_schema.Unique() ? ast::Builtin::IndexInsertUnique : ast::Builtin::IndexInsert;
-  auto *index_insert_call = GetCodeGen()->CallBuiltin(builtin, {GetCodeGen()->AddressOf(inserter_)});
+  auto *index_insert_call = GetCodeGen()->CallBuiltin(builtin, {inserter_.GetPtr(GetCodeGen())});
   auto *cond = GetCodeGen()->UnaryOp(parsing::Token::Type::BANG, index_insert_call);
   If success(builder, cond);
   { builder->Append(GetCodeGen()->AbortTxn(GetExecutionContext())); }
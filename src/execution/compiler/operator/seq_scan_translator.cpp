@@ -39,6 +39,15 @@ SeqScanTranslator::SeqScanTranslator(const planner::SeqScanPlanNode &plan, Compi
   num_scans_ = CounterDeclare("num_scans", pipeline);
 }
 
+void SeqScanTranslator::AddRuntimeFilter(ast::Identifier term) {
+  // Scans without a predicate need a filter manager for the runtime filters alone.
+  if (!HasFilter()) {
+    ast::Expr *fm_type = GetCodeGen()->BuiltinType(ast::BuiltinType::FilterManager);
+    local_filter_manager_ = GetPipeline()->DeclarePipelineStateEntry("filterManager", fm_type);
+  }
+  runtime_filters_.push_back(term);
+}
+
 bool SeqScanTranslator::HasPredicate() const {
   return GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate() != nullptr;
 }
@@ -224,7 +233,7 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
     vpi_loop.EndLoop();
   };
   // TODO(Amadou): What if the predicate doesn't filter out anything?
-  gen_vpi_loop(HasPredicate());
+  gen_vpi_loop(HasFilter());
 
   // var vpi_num_tuples = @tableIterGetNumTuples(tvi)
   ast::Identifier vpi_num_tuples = codegen->MakeFreshIdentifier("vpi_num_tuples");
@@ -243,7 +252,7 @@ void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) c
     function->Append(codegen->DeclareVarWithInit(vpi_var_, codegen->TableIterGetVPI(codegen->MakeExpr(tvi_var_))));
 
     // if (predicate)
-    if (HasPredicate()) {
+    if (HasFilter()) {
       auto filter_manager = local_filter_manager_.GetPtr(codegen);
       function->Append(codegen->FilterManagerRunFilters(filter_manager, vpi, GetExecutionContext()));
     }
@@ -257,10 +266,16 @@ void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) c
 
 void SeqScanTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
-  if (HasPredicate()) {
+  if (HasFilter()) {
     function->Append(codegen->FilterManagerInit(local_filter_manager_.GetPtr(codegen), GetExecutionContext()));
+    if (filters_.empty()) {
+      function->Append(codegen->FilterManagerInsert(local_filter_manager_.GetPtr(codegen), runtime_filters_));
+    }
     for (const auto &clause : filters_) {
-      function->Append(codegen->FilterManagerInsert(local_filter_manager_.GetPtr(codegen), clause));
+      // Every clause is conjoined with the runtime filters.
+      std::vector<ast::Identifier> terms(clause);
+      terms.insert(terms.end(), runtime_filters_.begin(), runtime_filters_.end());
+      function->Append(codegen->FilterManagerInsert(local_filter_manager_.GetPtr(codegen), terms));
     }
   }
 
@@ -268,7 +283,7 @@ void SeqScanTranslator::InitializePipelineState(const Pipeline &pipeline, Functi
 }
 
 void SeqScanTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
-  if (HasPredicate()) {
+  if (HasFilter()) {
     auto filter_manager = local_filter_manager_.GetPtr(GetCodeGen());
     function->Append(GetCodeGen()->FilterManagerFree(filter_manager));
   }
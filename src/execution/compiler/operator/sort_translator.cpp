@@ -28,9 +28,11 @@ SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, Compilation
       build_pipeline_(this, Pipeline::Parallelism::Parallel),
       current_row_(CurrentRow::Child) {
   NOISEPAGE_ASSERT(plan.GetChildrenSize() == 1, "Sorts expected to have a single child.");
-  // Register this as the source for the pipeline. It must be serial to maintain
-  // sorted output order.
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  // Register this as the source for the pipeline. The sorted output is scanned
+  // in parallel ranges whose output is emitted in order, unless rows must be
+  // skipped first: an offset is applied to the whole of the sorted output.
+  pipeline->RegisterSource(this, plan.GetOffset() == 0 ? Pipeline::Parallelism::Parallel
+                                                       : Pipeline::Parallelism::Serial);
 
   // The build pipeline must complete before the produce pipeline.
   pipeline->LinkSourcePipeline(&build_pipeline_);
@@ -379,6 +381,24 @@ void SortTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *functio
 void SortTranslator::ScanSorter(WorkContext *ctx, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
 
+  // In a parallel scan, the iterator over the range to scan is provided
+  if (ctx->GetPipeline().IsParallel()) {
+    const auto &pipeline = ctx->GetPipeline();
+    ast::Expr *iter = function->GetParameterByPosition(pipeline.PipelineParams().size());
+    Loop loop(function, nullptr, codegen->SorterIterHasNext(iter), codegen->MakeStmt(codegen->SorterIterNext(iter)));
+    {
+      // var sortRow = @ptrCast(SortRow*, @sorterIterGetRow(sorter))
+      auto row = codegen->SorterIterGetRow(iter, sort_row_type_);
+      function->Append(codegen->DeclareVarWithInit(sort_row_var_, row));
+      // Move along
+      ctx->Push(function);
+
+      CounterAdd(function, num_sort_iterate_rows_, 1);
+    }
+    loop.EndLoop();
+    return;
+  }
+
   // var sorter_base: Sorter
   auto base_iter_name = codegen->MakeFreshIdentifier("iterBase");
   function->Append(codegen->DeclareVarNoInit(base_iter_name, ast::BuiltinType::SorterIterator));
@@ -473,6 +493,18 @@ void SortTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilde
   //  However, due to overhead and engineering complexity, we settle for the size of the sorter.
 }
 
+util::RegionVector<ast::FieldDecl *> SortTranslator::GetWorkerParams() const {
+  auto *codegen = GetCodeGen();
+  return codegen->MakeFieldList({codegen->MakeField(codegen->MakeIdentifier("sorterIter"),
+                                                    codegen->PointerType(ast::BuiltinType::SorterIterator))});
+}
+
+void SortTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const {
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->SorterParallelScan(global_sorter_.GetPtr(codegen), GetQueryStatePtr(),
+                                               GetThreadStateContainer(), work_func_name));
+}
+
 ast::Expr *SortTranslator::GetChildOutput(WorkContext *context, UNUSED_ATTRIBUTE uint32_t child_idx,
                                           uint32_t attr_idx) const {
   if (IsScanPipeline(context->GetPipeline())) {
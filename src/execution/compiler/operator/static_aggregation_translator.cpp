@@ -38,9 +38,6 @@ StaticAggregationTranslator::StaticAggregationTranslator(const planner::Aggregat
     }
   }
 
-  if (!distinct_filters_.empty()) {
-    build_pipeline_.UpdateParallelism(Pipeline::Parallelism::Serial);
-  }
   // The produce-side begins after the build-side.
   pipeline->LinkSourcePipeline(&build_pipeline_);
 
@@ -58,8 +55,12 @@ StaticAggregationTranslator::StaticAggregationTranslator(const planner::Aggregat
   ast::Expr *payload_type = codegen->MakeExpr(agg_payload_type_);
   global_aggs_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "aggs", payload_type);
 
+  // In parallel mode, declare local aggregates and let each thread filter distinct values locally.
   if (build_pipeline_.IsParallel()) {
     local_aggs_ = build_pipeline_.DeclarePipelineStateEntry("aggs", payload_type);
+    for (auto &p : distinct_filters_) {
+      p.second.DeclareLocalHashTable(codegen, &build_pipeline_);
+    }
   }
 
   num_agg_inputs_ = CounterDeclare("num_agg_inputs", &build_pipeline_);
@@ -127,6 +128,30 @@ void StaticAggregationTranslator::DefineHelperFunctions(util::RegionVector<ast::
   // Generate key check functions
   for (auto &p : distinct_filters_) {
     decls->push_back(p.second.GenerateDistinctCheckFunction(GetCodeGen(), {}));
+    if (p.second.IsParallel()) {
+      decls->push_back(p.second.GenerateMergePartitionsFunction(GetCodeGen(), GetCompilationContext()->QueryParams()));
+    }
+  }
+}
+
+void StaticAggregationTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
+                                                                    util::RegionVector<ast::FunctionDecl *> *decls) {
+  if (!IsBuildPipeline(pipeline)) {
+    return;
+  }
+
+  // Every distinct value is advanced into the partial aggregate of the thread that scans it.
+  auto *codegen = GetCodeGen();
+  for (auto &[term_idx, filter] : distinct_filters_) {
+    if (!filter.IsParallel()) continue;
+    const auto agg_term_idx = static_cast<uint32_t>(term_idx);
+    const auto &distinct_filter = filter;
+    decls->push_back(filter.GenerateScanPartitionFunction(
+        codegen, [&, agg_term_idx](FunctionBuilder *function, ast::Identifier distinct_row) {
+          auto agg = GetAggregateTermPtr(local_aggs_.Get(codegen), agg_term_idx);
+          auto val = codegen->AddressOf(distinct_filter.GetAggregateValue(codegen, codegen->MakeExpr(distinct_row)));
+          function->Append(codegen->AggregatorAdvance(agg, val));
+        }));
   }
 }
 
@@ -174,12 +199,23 @@ void StaticAggregationTranslator::InitializePipelineState(const Pipeline &pipeli
   if (IsBuildPipeline(pipeline)) {
     if (build_pipeline_.IsParallel()) {
       InitializeAggregates(function, true);
+      for (auto &p : distinct_filters_) {
+        p.second.InitializeLocal(GetCodeGen(), function, GetExecutionContext());
+      }
     }
   }
 
   InitializeCounters(pipeline, function);
 }
 
+void StaticAggregationTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsBuildPipeline(pipeline) && build_pipeline_.IsParallel()) {
+    for (auto &p : distinct_filters_) {
+      p.second.TearDownLocal(GetCodeGen(), function);
+    }
+  }
+}
+
 void StaticAggregationTranslator::BeginPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
   if (IsBuildPipeline(pipeline)) {
     InitializeAggregates(function, false);
@@ -270,6 +306,11 @@ void StaticAggregationTranslator::FinishPipelineWork(const Pipeline &pipeline, F
 
   if (IsBuildPipeline(pipeline)) {
     if (build_pipeline_.IsParallel()) {
+      // Aggregate the distinct values of all threads into the thread-local aggregates first.
+      for (auto &p : distinct_filters_) {
+        p.second.MergeAndAggregate(codegen, function, GetQueryStatePtr(), GetThreadStateContainer());
+      }
+
       // Merge thread-local aggregates into one.
       ast::Expr *thread_state_container = GetThreadStateContainer();
       ast::Expr *query_state = GetQueryStatePtr();
@@ -17,13 +17,11 @@ namespace noisepage::execution::compiler {
 UpdateTranslator::UpdateTranslator(const planner::UpdatePlanNode &plan, CompilationContext *compilation_context,
                                    Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::UPDATE),
-      updater_(GetCodeGen()->MakeFreshIdentifier("updater")),
       update_pr_(GetCodeGen()->MakeFreshIdentifier("update_pr")),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")),
       table_schema_(GetCodeGen()->GetCatalogAccessor()->GetSchema(plan.GetTableOid())),
       all_oids_(CollectOids(table_schema_)),
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(all_oids_)) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
 
   for (const auto &clause : plan.GetSetClauses()) {
@@ -38,19 +36,25 @@ UpdateTranslator::UpdateTranslator(const planner::UpdatePlanNode &plan, Compilat
     }
   }
 
+  updater_ = pipeline->DeclarePipelineStateEntry(
+      "updater", GetCodeGen()->BuiltinType(ast::BuiltinType::Kind::StorageInterface));
   num_updates_ = CounterDeclare("num_updates", pipeline);
 }
 
 void UpdateTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
-  CounterSet(function, num_updates_, 0);
+  InitializeCounters(pipeline, function);
+  // var col_oids: [num_cols]uint32
+  // col_oids[i] = ...
+  // @storageInterfaceInitBatched(&pipelineState.updater, execCtx, table_oid, col_oids, true)
+  InitUpdater(function);
+}
+
+void UpdateTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // @storageInterfaceFree(&pipelineState.updater)
+  GenUpdaterFree(function);
 }
 
 void UpdateTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
-  // var col_oids: [num_cols]uint32
-  // col_oids[i] = ...
-  // var updater : StorageInterface
-  // @storageInterfaceInit(updater, execCtx, table_oid, col_oids, true)
-  DeclareUpdater(function);
   // var update_pr : *ProjectedRow
   DeclareUpdatePR(function);
 
@@ -71,7 +75,7 @@ void UpdateTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder
 
   if (op.GetIndexedUpdate()) {
     // For indexed updates, we need to re-insert into the table, and then delete-and-insert into every index.
-    // var insert_slot = @tableInsert(&updater_)
+    // @tableInsertBatched(&updater_)
     GenTableInsert(function);
     const auto &indexes = GetPlanAs<planner::UpdatePlanNode>().GetIndexOids();
     for (const auto &index_oid : indexes) {
@@ -85,12 +89,26 @@ void UpdateTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder
   function->Append(GetCodeGen()->ExecCtxAddRowsAffected(GetExecutionContext(), 1));
 
   CounterAdd(function, num_updates_, 1);
-
-  // @storageInterfaceFree(&updater)
-  GenUpdaterFree(function);
 }
 
 void UpdateTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // Every thread of a parallel pipeline flushed its own writes at the end of its work
+  if (!pipeline.IsParallel()) {
+    GenUpdaterFlush(function);
+    RecordCounters(pipeline, function);
+  }
+}
+
+void UpdateTranslator::EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  GenUpdaterFlush(function);
+  RecordCounters(pipeline, function);
+}
+
+void UpdateTranslator::InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
+  CounterSet(function, num_updates_, 0);
+}
+
+void UpdateTranslator::RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
   if (GetPlanAs<planner::UpdatePlanNode>().GetIndexOids().empty()) {
     FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::UPDATE,
                   selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline, CounterVal(num_updates_));
@@ -110,27 +128,29 @@ void UpdateTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuil
   FeatureArithmeticRecordMul(function, pipeline, GetTranslatorId(), CounterVal(num_updates_));
 }
 
-void UpdateTranslator::DeclareUpdater(noisepage::execution::compiler::FunctionBuilder *builder) const {
+void UpdateTranslator::InitUpdater(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
   SetOids(builder);
-  // var updater : StorageInterface
-  auto *storage_interface_type = GetCodeGen()->BuiltinType(ast::BuiltinType::Kind::StorageInterface);
-  builder->Append(GetCodeGen()->DeclareVar(updater_, storage_interface_type, nullptr));
-  // @storageInterfaceInit(updater, execCtx, table_oid, col_oids, true)
-  ast::Expr *updater_setup = GetCodeGen()->StorageInterfaceInit(
-      updater_, GetExecutionContext(), GetPlanAs<planner::UpdatePlanNode>().GetTableOid().UnderlyingValue(), col_oids_,
-      true);
+  // @storageInterfaceInitBatched(&pipelineState.updater, execCtx, table_oid, col_oids, true)
+  ast::Expr *updater_setup = GetCodeGen()->StorageInterfaceInitBatched(
+      updater_.GetPtr(GetCodeGen()), GetExecutionContext(),
+      GetPlanAs<planner::UpdatePlanNode>().GetTableOid().UnderlyingValue(), col_oids_, true);
   builder->Append(GetCodeGen()->MakeStmt(updater_setup));
 }
 
 void UpdateTranslator::GenUpdaterFree(noisepage::execution::compiler::FunctionBuilder *builder) const {
-  // @storageInterfaceFree(&updater)
+  // @storageInterfaceFree(&pipelineState.updater)
   ast::Expr *updater_free =
-      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {GetCodeGen()->AddressOf(updater_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {updater_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->MakeStmt(updater_free));
 }
 
+void UpdateTranslator::GenUpdaterFlush(FunctionBuilder *builder) const {
+  // @storageInterfaceFlush(&pipelineState.updater)
+  builder->Append(GetCodeGen()->MakeStmt(GetCodeGen()->StorageInterfaceFlush(updater_.GetPtr(GetCodeGen()))));
+}
+
 ast::Expr *UpdateTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
   NOISEPAGE_ASSERT(child_idx == 0, "Update plan can only have one child");
   const auto &op = GetPlanAs<planner::UpdatePlanNode>();
@@ -167,7 +187,7 @@ void UpdateTranslator::DeclareUpdatePR(noisepage::execution::compiler::FunctionB
 
 void UpdateTranslator::GetUpdatePR(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var update_pr = @getTablePR(&updater)
-  auto *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetTablePR, {GetCodeGen()->AddressOf(updater_)});
+  auto *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetTablePR, {updater_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->Assign(GetCodeGen()->MakeExpr(update_pr_), get_pr_call));
 }
 
@@ -208,7 +228,7 @@ void UpdateTranslator::GenTableUpdate(FunctionBuilder *builder) const {
   const auto &op = GetPlanAs<planner::UpdatePlanNode>();
   const auto &child_translator = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
   const auto &update_slot = child_translator->GetSlotAddress();
-  std::vector<ast::Expr *> update_args{GetCodeGen()->AddressOf(updater_), update_slot};
+  std::vector<ast::Expr *> update_args{updater_.GetPtr(GetCodeGen()), update_slot};
   auto *update_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableUpdate, update_args);
 
   auto *cond = GetCodeGen()->UnaryOp(parsing::Token::Type::BANG, update_call);
@@ -218,17 +238,16 @@ void UpdateTranslator::GenTableUpdate(FunctionBuilder *builder) const {
 }
 
 void UpdateTranslator::GenTableInsert(FunctionBuilder *builder) const {
-  // var insert_slot = @tableInsert(&updater_)
-  const auto &insert_slot = GetCodeGen()->MakeFreshIdentifier("insert_slot");
-  auto *insert_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableInsert, {GetCodeGen()->AddressOf(updater_)});
-  builder->Append(GetCodeGen()->DeclareVar(insert_slot, nullptr, insert_call));
+  // @tableInsertBatched(&updater_)
+  auto *insert_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableInsertBatched, {updater_.GetPtr(GetCodeGen())});
+  builder->Append(GetCodeGen()->MakeStmt(insert_call));
 }
 
 void UpdateTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *builder,
                                       const catalog::index_oid_t &index_oid) const {
   // var insert_index_pr = @getIndexPR(&updater, oid)
   const auto &insert_index_pr = GetCodeGen()->MakeFreshIdentifier("insert_index_pr");
-  std::vector<ast::Expr *> pr_call_args{GetCodeGen()->AddressOf(updater_),
+  std::vector<ast::Expr *> pr_call_args{updater_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
   auto *get_index_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   builder->Append(GetCodeGen()->DeclareVar(insert_index_pr, nullptr, get_index_pr_call));
@@ -250,7 +269,7 @@ void UpdateTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *bui
 
   // if (!@indexInsert(&updater)) { Abort(); }
   const auto &builtin = index_schema.Unique() ? ast::Builtin::IndexInsertUnique : ast::Builtin::IndexInsert;
-  auto *index_insert_call = GetCodeGen()->CallBuiltin(builtin, {GetCodeGen()->AddressOf(updater_)});
+  auto *index_insert_call = GetCodeGen()->CallBuiltin(builtin, {updater_.GetPtr(GetCodeGen())});
   auto *cond = GetCodeGen()->UnaryOp(parsing::Token::Type::BANG, index_insert_call);
   If success(builder, cond);
   { builder->Append(GetCodeGen()->AbortTxn(GetExecutionContext())); }
@@ -263,7 +282,7 @@ void UpdateTranslator::GenTableDelete(FunctionBuilder *builder) const {
   const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
   NOISEPAGE_ASSERT(child != nullptr, "delete should have a child");
   const auto &delete_slot = child->GetSlotAddress();
-  std::vector<ast::Expr *> delete_args{GetCodeGen()->AddressOf(updater_), delete_slot};
+  std::vector<ast::Expr *> delete_args{updater_.GetPtr(GetCodeGen()), delete_slot};
   auto *delete_call = GetCodeGen()->CallBuiltin(ast::Builtin::TableDelete, delete_args);
   auto *delete_failed = GetCodeGen()->UnaryOp(parsing::Token::Type::BANG, delete_call);
   If check(builder, delete_failed);
@@ -278,7 +297,7 @@ void UpdateTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
                                       const catalog::index_oid_t &index_oid) const {
   // var delete_index_pr = @getIndexPR(&updater, oid)
   auto delete_index_pr = GetCodeGen()->MakeFreshIdentifier("delete_index_pr");
-  std::vector<ast::Expr *> pr_call_args{GetCodeGen()->AddressOf(updater_),
+  std::vector<ast::Expr *> pr_call_args{updater_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
   auto *get_index_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   builder->Append(GetCodeGen()->DeclareVar(delete_index_pr, nullptr, get_index_pr_call));
@@ -301,7 +320,7 @@ void UpdateTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
   }
 
   // @indexDelete(&updater)
-  std::vector<ast::Expr *> delete_args{GetCodeGen()->AddressOf(updater_), child->GetSlotAddress()};
+  std::vector<ast::Expr *> delete_args{updater_.GetPtr(GetCodeGen()), child->GetSlotAddress()};
   auto *index_delete_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexDelete, delete_args);
   builder->Append(GetCodeGen()->MakeStmt(index_delete_call));
 }
@@ -0,0 +1,456 @@
+#include "execution/compiler/operator/window_translator.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/if.h"
+#include "execution/compiler/loop.h"
+#include "execution/compiler/work_context.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/window_plan_node.h"
+
+namespace noisepage::execution::compiler {
+
+namespace {
+constexpr const char SORT_ROW_ATTR_PREFIX[] = "attr";
+}  // namespace
+
+WindowTranslator::WindowTranslator(const planner::WindowPlanNode &plan, CompilationContext *compilation_context,
+                                   Pipeline *pipeline)
+    : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
+      sort_row_var_(GetCodeGen()->MakeFreshIdentifier("sortRow")),
+      sort_row_type_(GetCodeGen()->MakeFreshIdentifier("WindowRow")),
+      struct_decl_(nullptr),
+      lhs_row_(GetCodeGen()->MakeIdentifier("lhs")),
+      rhs_row_(GetCodeGen()->MakeIdentifier("rhs")),
+      group_row_var_(GetCodeGen()->MakeFreshIdentifier("groupRow")),
+      compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("Compare"))),
+      partition_compare_func_(
+          GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("ComparePartition"))),
+      row_number_var_(GetCodeGen()->MakeFreshIdentifier("rowNumber")),
+      rank_var_(GetCodeGen()->MakeFreshIdentifier("rank")),
+      dense_rank_var_(GetCodeGen()->MakeFreshIdentifier("denseRank")),
+      num_peers_var_(GetCodeGen()->MakeFreshIdentifier("numPeers")),
+      new_partition_var_(GetCodeGen()->MakeFreshIdentifier("newPartition")),
+      in_group_var_(GetCodeGen()->MakeFreshIdentifier("inGroup")),
+      build_pipeline_(this, Pipeline::Parallelism::Parallel),
+      current_row_(CurrentRow::Child) {
+  NOISEPAGE_ASSERT(plan.GetChildrenSize() == 1, "Windows expected to have a single child.");
+  // Register this as the source for the pipeline. The sorted rows are scanned in
+  // parallel ranges that never split a partition, and emitted in order.
+  pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
+
+  // The build pipeline must complete before the produce pipeline.
+  pipeline->LinkSourcePipeline(&build_pipeline_);
+
+  // Prepare the child.
+  compilation_context->Prepare(*plan.GetChild(0), &build_pipeline_);
+
+  // Prepare the partition-key, sort-key, and aggregate expressions.
+  for (const auto &expr : plan.GetPartitionKeys()) {
+    compilation_context->Prepare(*expr);
+  }
+  for (const auto &[expr, _] : plan.GetSortKeys()) {
+    (void)_;
+    compilation_context->Prepare(*expr);
+  }
+  for (const auto &term : plan.GetWindowTerms()) {
+    agg_vars_.push_back(GetCodeGen()->MakeFreshIdentifier("windowAgg"));
+    agg_value_vars_.push_back(GetCodeGen()->MakeFreshIdentifier("windowAggValue"));
+    if (term.aggregate_ == nullptr) {
+      continue;
+    }
+    if (term.aggregate_->IsDistinct()) {
+      throw NOT_IMPLEMENTED_EXCEPTION("DISTINCT window aggregates are not supported");
+    }
+    compilation_context->Prepare(*term.aggregate_->GetChild(0));
+  }
+
+  // Register a Sorter instance in the global query state.
+  CodeGen *codegen = compilation_context->GetCodeGen();
+  ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
+  global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "windowSorter", sorter_type);
+
+  // Register another Sorter instance in the pipeline-local state if the
+  // build pipeline is parallel.
+  if (build_pipeline_.IsParallel()) {
+    local_sorter_ = build_pipeline_.DeclarePipelineStateEntry("windowSorter", sorter_type);
+  }
+
+  num_window_build_rows_ = CounterDeclare("num_window_build_rows", &build_pipeline_);
+  num_window_iterate_rows_ = CounterDeclare("num_window_iterate_rows", pipeline);
+}
+
+void WindowTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+  auto fields = codegen->MakeEmptyFieldList();
+  GetAllChildOutputFields(0, SORT_ROW_ATTR_PREFIX, &fields);
+  struct_decl_ = codegen->DeclareStruct(sort_row_type_, std::move(fields));
+  decls->push_back(struct_decl_);
+}
+
+void WindowTranslator::GenerateComparisonFunction(FunctionBuilder *function, bool partition_only) {
+  auto *codegen = GetCodeGen();
+  WorkContext context(GetCompilationContext(), build_pipeline_);
+  context.SetExpressionCacheEnable(false);
+
+  // Rows are ordered by their partition first, then by the sort keys within the partition.
+  const auto &plan = GetPlanAs<planner::WindowPlanNode>();
+  std::vector<planner::SortKey> keys;
+  for (const auto &expr : plan.GetPartitionKeys()) {
+    keys.emplace_back(expr, optimizer::OrderByOrderingType::ASC);
+  }
+  if (!partition_only) {
+    keys.insert(keys.end(), plan.GetSortKeys().begin(), plan.GetSortKeys().end());
+  }
+
+  for (const auto &[expr, sort_order] : keys) {
+    int32_t ret_value = sort_order == optimizer::OrderByOrderingType::ASC ? -1 : 1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      current_row_ = CurrentRow::Lhs;
+      ast::Expr *lhs = context.DeriveValue(*expr, this);
+      current_row_ = CurrentRow::Rhs;
+      ast::Expr *rhs = context.DeriveValue(*expr, this);
+      If check_comparison(function, codegen->Compare(tok, lhs, rhs));
+      {
+        // Return the appropriate value based on ordering.
+        function->Append(codegen->Return(codegen->Const32(ret_value)));
+      }
+      check_comparison.EndIf();
+      ret_value = -ret_value;
+    }
+  }
+  current_row_ = CurrentRow::Child;
+}
+
+void WindowTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+  for (const auto &[name, partition_only] : {std::make_pair(compare_func_, false),
+                                             std::make_pair(partition_compare_func_, true)}) {
+    auto params = codegen->MakeFieldList({
+        codegen->MakeField(lhs_row_, codegen->PointerType(sort_row_type_)),
+        codegen->MakeField(rhs_row_, codegen->PointerType(sort_row_type_)),
+    });
+    FunctionBuilder builder(codegen, name, std::move(params), codegen->Int32Type());
+    {
+      // Generate body.
+      GenerateComparisonFunction(&builder, partition_only);
+    }
+    decls->push_back(builder.Finish(codegen->Const32(0)));
+  }
+}
+
+void WindowTranslator::InitializeQueryState(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  function->Append(
+      codegen->SorterInit(global_sorter_.GetPtr(codegen), GetExecutionContext(), compare_func_, sort_row_type_));
+}
+
+void WindowTranslator::TearDownQueryState(FunctionBuilder *function) const {
+  function->Append(GetCodeGen()->SorterFree(global_sorter_.GetPtr(GetCodeGen())));
+}
+
+void WindowTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  if (IsBuildPipeline(pipeline) && build_pipeline_.IsParallel()) {
+    function->Append(
+        codegen->SorterInit(local_sorter_.GetPtr(codegen), GetExecutionContext(), compare_func_, sort_row_type_));
+  }
+
+  InitializeCounters(pipeline, function);
+}
+
+void WindowTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsBuildPipeline(pipeline) && pipeline.IsParallel()) {
+    function->Append(GetCodeGen()->SorterFree(local_sorter_.GetPtr(GetCodeGen())));
+  }
+}
+
+void WindowTranslator::InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsBuildPipeline(pipeline)) {
+    CounterSet(function, num_window_build_rows_, 0);
+  } else {
+    CounterSet(function, num_window_iterate_rows_, 0);
+  }
+}
+
+void WindowTranslator::RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  if (IsBuildPipeline(pipeline)) {
+    FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::SORT_BUILD,
+                  selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline,
+                  CounterVal(num_window_build_rows_));
+    FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::SORT_BUILD,
+                  selfdriving::ExecutionOperatingUnitFeatureAttribute::CARDINALITY, pipeline,
+                  CounterVal(num_window_build_rows_));
+    FeatureArithmeticRecordMul(function, pipeline, GetTranslatorId(), CounterVal(num_window_build_rows_));
+  } else {
+    ast::Expr *sorter_ptr = global_sorter_.GetPtr(codegen);
+    FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::SORT_ITERATE,
+                  selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline,
+                  CounterVal(num_window_iterate_rows_));
+    FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::SORT_ITERATE,
+                  selfdriving::ExecutionOperatingUnitFeatureAttribute::CARDINALITY, pipeline,
+                  codegen->CallBuiltin(ast::Builtin::SorterGetTupleCount, {sorter_ptr}));
+    FeatureArithmeticRecordMul(function, pipeline, GetTranslatorId(), CounterVal(num_window_iterate_rows_));
+  }
+}
+
+void WindowTranslator::EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  RecordCounters(pipeline, function);
+}
+
+ast::Expr *WindowTranslator::GetSortRowAttribute(ast::Identifier sort_row, uint32_t attr_idx) const {
+  auto *codegen = GetCodeGen();
+  ast::Identifier attr_name = codegen->MakeIdentifier(SORT_ROW_ATTR_PREFIX + std::to_string(attr_idx));
+  return codegen->AccessStructMember(codegen->MakeExpr(sort_row), attr_name);
+}
+
+void WindowTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // Collect correct sorter instance.
+  const auto sorter = ctx->GetPipeline().IsParallel() ? local_sorter_ : global_sorter_;
+  ast::Expr *insert_call = codegen->SorterInsert(sorter.GetPtr(codegen), sort_row_type_);
+  function->Append(codegen->DeclareVarWithInit(sort_row_var_, insert_call));
+
+  // Fill the sort row.
+  const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+  for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+    ast::Expr *lhs = GetSortRowAttribute(sort_row_var_, attr_idx);
+    ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
+    function->Append(codegen->Assign(lhs, rhs));
+  }
+}
+
+void WindowTranslator::AdvanceAggregates(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  // The aggregate inputs are computed from the sort row of the lead iterator, in a scope of their own.
+  WorkContext context(GetCompilationContext(), *GetPipeline());
+  context.SetExpressionCacheEnable(false);
+  const auto &terms = GetPlanAs<planner::WindowPlanNode>().GetWindowTerms();
+  for (uint32_t term_idx = 0; term_idx < terms.size(); term_idx++) {
+    if (terms[term_idx].aggregate_ == nullptr) {
+      continue;
+    }
+    ast::Expr *value = context.DeriveValue(*terms[term_idx].aggregate_->GetChild(0), this);
+    function->Append(codegen->DeclareVarWithInit(agg_value_vars_[term_idx], value));
+    function->Append(codegen->AggregatorAdvance(codegen->AddressOf(agg_vars_[term_idx]),
+                                                codegen->AddressOf(agg_value_vars_[term_idx])));
+  }
+}
+
+void WindowTranslator::ScanSorter(WorkContext *ctx, FunctionBuilder *function, ast::Expr *iter,
+                                  ast::Expr *lead) const {
+  auto *codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::WindowPlanNode>();
+  const auto &terms = plan.GetWindowTerms();
+  auto var = [codegen](ast::Identifier name) { return codegen->MakeExpr(name); };
+  auto increment = [codegen, &var](ast::Identifier name) {
+    return codegen->Assign(var(name), codegen->BinaryOp(parsing::Token::Type::PLUS, var(name), codegen->Const64(1)));
+  };
+
+  // var rowNumber: int64 = 0, etc.
+  for (const auto name : {row_number_var_, rank_var_, dense_rank_var_, num_peers_var_}) {
+    function->Append(codegen->DeclareVar(name, codegen->Int64Type(), codegen->Const64(0)));
+  }
+  function->Append(codegen->DeclareVar(new_partition_var_, codegen->BoolType(), codegen->ConstBool(true)));
+  function->Append(codegen->DeclareVar(in_group_var_, codegen->BoolType(), codegen->ConstBool(true)));
+  for (uint32_t term_idx = 0; term_idx < terms.size(); term_idx++) {
+    if (const auto &agg = terms[term_idx].aggregate_; agg != nullptr) {
+      auto agg_type = codegen->AggregateType(agg->GetExpressionType(), sql::GetTypeId(agg->GetReturnValueType()));
+      function->Append(codegen->DeclareVarNoInit(agg_vars_[term_idx], agg_type));
+    }
+  }
+
+  // Every iteration outputs one peer group, starting at the current row of the main iterator.
+  Loop group_loop(function, codegen->SorterIterHasNext(iter));
+  {
+    function->Append(codegen->DeclareVarWithInit(group_row_var_, codegen->SorterIterGetRow(iter, sort_row_type_)));
+
+    // Reset the window state at the start of every partition.
+    If check_partition(function, var(new_partition_var_));
+    {
+      function->Append(codegen->Assign(var(row_number_var_), codegen->Const64(0)));
+      function->Append(codegen->Assign(var(dense_rank_var_), codegen->Const64(0)));
+      for (uint32_t term_idx = 0; term_idx < terms.size(); term_idx++) {
+        if (terms[term_idx].aggregate_ != nullptr) {
+          function->Append(codegen->AggregatorInit(codegen->AddressOf(agg_vars_[term_idx])));
+        }
+      }
+    }
+    check_partition.EndIf();
+
+    // Run the lead iterator over the peer group, advancing the aggregates with every peer. It stops
+    // at the first row of the next peer group, noting whether that row starts a new partition.
+    function->Append(codegen->Assign(var(num_peers_var_), codegen->Const64(0)));
+    function->Append(codegen->Assign(var(in_group_var_), codegen->ConstBool(true)));
+    function->Append(codegen->Assign(var(new_partition_var_), codegen->ConstBool(true)));
+    Loop peer_loop(function,
+                   codegen->BinaryOp(parsing::Token::Type::AND, var(in_group_var_), codegen->SorterIterHasNext(lead)));
+    {
+      function->Append(codegen->DeclareVarWithInit(sort_row_var_, codegen->SorterIterGetRow(lead, sort_row_type_)));
+      auto differs = [&](ast::Identifier compare_func) {
+        ast::Expr *cmp = codegen->Call(compare_func, {var(group_row_var_), var(sort_row_var_)});
+        return codegen->Compare(parsing::Token::Type::BANG_EQUAL, cmp, codegen->Const32(0));
+      };
+      auto check_peer = [&]() {
+        If check_peer(function, differs(compare_func_));
+        {
+          function->Append(codegen->Assign(var(in_group_var_), codegen->ConstBool(false)));
+          function->Append(codegen->Assign(var(new_partition_var_), codegen->ConstBool(false)));
+        }
+        check_peer.Else();
+        {
+          AdvanceAggregates(function);
+          function->Append(increment(num_peers_var_));
+          function->Append(codegen->MakeStmt(codegen->SorterIterNext(lead)));
+        }
+        check_peer.EndIf();
+      };
+      // Without partition keys, all rows are in the same partition.
+      if (plan.GetPartitionKeys().empty()) {
+        check_peer();
+      } else {
+        If check_same_partition(function, differs(partition_compare_func_));
+        {
+          function->Append(codegen->Assign(var(in_group_var_), codegen->ConstBool(false)));
+        }
+        check_same_partition.Else();
+        check_peer();
+        check_same_partition.EndIf();
+      }
+    }
+    peer_loop.EndLoop();
+
+    function->Append(codegen->Assign(var(rank_var_), codegen->BinaryOp(parsing::Token::Type::PLUS,
+                                                                       var(row_number_var_), codegen->Const64(1))));
+    function->Append(increment(dense_rank_var_));
+
+    // Output the rows of the peer group with the main iterator.
+    Loop output_loop(function, nullptr,
+                     codegen->Compare(parsing::Token::Type::GREATER, var(num_peers_var_), codegen->Const64(0)),
+                     codegen->Assign(var(num_peers_var_), codegen->BinaryOp(parsing::Token::Type::MINUS,
+                                                                            var(num_peers_var_), codegen->Const64(1))));
+    {
+      function->Append(codegen->DeclareVarWithInit(sort_row_var_, codegen->SorterIterGetRow(iter, sort_row_type_)));
+      function->Append(increment(row_number_var_));
+      // Move along
+      ctx->Push(function);
+      CounterAdd(function, num_window_iterate_rows_, 1);
+      function->Append(codegen->MakeStmt(codegen->SorterIterNext(iter)));
+    }
+    output_loop.EndLoop();
+  }
+  group_loop.EndLoop();
+}
+
+void WindowTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  if (IsBuildPipeline(ctx->GetPipeline())) {
+    InsertIntoSorter(ctx, function);
+    CounterAdd(function, num_window_build_rows_, 1);
+    return;
+  }
+
+  NOISEPAGE_ASSERT(IsScanPipeline(ctx->GetPipeline()), "Pipeline is unknown to window translator");
+
+  // In a parallel scan, the iterators over the range to scan are provided
+  if (ctx->GetPipeline().IsParallel()) {
+    const auto num_params = ctx->GetPipeline().PipelineParams().size();
+    ScanSorter(ctx, function, function->GetParameterByPosition(num_params),
+               function->GetParameterByPosition(num_params + 1));
+    return;
+  }
+
+  // var iterBase: SorterIterator, leadBase: SorterIterator
+  // var iter = &iterBase, lead = &leadBase
+  std::vector<ast::Expr *> iters;
+  for (const auto *name : {"iter", "leadIter"}) {
+    auto base_iter_name = codegen->MakeFreshIdentifier(std::string(name) + "Base");
+    function->Append(codegen->DeclareVarNoInit(base_iter_name, ast::BuiltinType::SorterIterator));
+    auto iter_name = codegen->MakeFreshIdentifier(name);
+    function->Append(codegen->DeclareVarWithInit(iter_name, codegen->AddressOf(codegen->MakeExpr(base_iter_name))));
+    iters.push_back(codegen->MakeExpr(iter_name));
+    function->Append(codegen->SorterIterInit(iters.back(), global_sorter_.GetPtr(codegen)));
+  }
+
+  ScanSorter(ctx, function, iters[0], iters[1]);
+
+  for (ast::Expr *iter : iters) {
+    function->Append(codegen->SorterIterClose(iter));
+  }
+}
+
+void WindowTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  ast::Expr *sorter_ptr = global_sorter_.GetPtr(codegen);
+
+  if (IsBuildPipeline(pipeline)) {
+    if (build_pipeline_.IsParallel()) {
+      ast::Expr *offset = local_sorter_.OffsetFromState(codegen);
+      function->Append(codegen->SortParallel(sorter_ptr, GetThreadStateContainer(), offset));
+    } else {
+      function->Append(codegen->SorterSort(sorter_ptr));
+      RecordCounters(pipeline, function);
+    }
+  } else if (!pipeline.IsParallel()) {
+    RecordCounters(pipeline, function);
+  }
+}
+
+util::RegionVector<ast::FieldDecl *> WindowTranslator::GetWorkerParams() const {
+  auto *codegen = GetCodeGen();
+  return codegen->MakeFieldList({
+      codegen->MakeField(codegen->MakeIdentifier("sorterIter"), codegen->PointerType(ast::BuiltinType::SorterIterator)),
+      codegen->MakeField(codegen->MakeIdentifier("leadIter"), codegen->PointerType(ast::BuiltinType::SorterIterator)),
+  });
+}
+
+void WindowTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const {
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->SorterParallelScanPartitions(global_sorter_.GetPtr(codegen), GetQueryStatePtr(),
+                                                         GetThreadStateContainer(), partition_compare_func_,
+                                                         work_func_name));
+}
+
+ast::Expr *WindowTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
+  auto *codegen = GetCodeGen();
+  if (IsScanPipeline(context->GetPipeline())) {
+    if (child_idx == 0) {
+      return GetSortRowAttribute(sort_row_var_, attr_idx);
+    }
+    NOISEPAGE_ASSERT(child_idx == 1, "Window terms are the second input of window outputs");
+    switch (GetPlanAs<planner::WindowPlanNode>().GetWindowTerms()[attr_idx].type_) {
+      case planner::WindowFunctionType::ROW_NUMBER:
+        return codegen->CallBuiltin(ast::Builtin::IntToSql, {codegen->MakeExpr(row_number_var_)});
+      case planner::WindowFunctionType::RANK:
+        return codegen->CallBuiltin(ast::Builtin::IntToSql, {codegen->MakeExpr(rank_var_)});
+      case planner::WindowFunctionType::DENSE_RANK:
+        return codegen->CallBuiltin(ast::Builtin::IntToSql, {codegen->MakeExpr(dense_rank_var_)});
+      case planner::WindowFunctionType::AGGREGATE:
+        return codegen->AggregatorResult(codegen->AddressOf(agg_vars_[attr_idx]));
+      default:
+        UNREACHABLE("Impossible window function type");
+    }
+  }
+
+  NOISEPAGE_ASSERT(IsBuildPipeline(context->GetPipeline()), "Pipeline not known to window");
+  switch (current_row_) {
+    case CurrentRow::Lhs:
+      return GetSortRowAttribute(lhs_row_, attr_idx);
+    case CurrentRow::Rhs:
+      return GetSortRowAttribute(rhs_row_, attr_idx);
+    case CurrentRow::Child: {
+      return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+    }
+  }
+  UNREACHABLE("Impossible output row option");
+}
+
+}  // namespace noisepage::execution::compiler
@@ -276,8 +276,9 @@ ast::FunctionDecl *Pipeline::GeneratePipelineWorkFunction() const {
     (*Begin())->PerformPipelineWork(&context, &builder);
 
     if (IsParallel()) {
-      for (auto *op : steps_) {
-        op->EndParallelPipelineWork(*this, &builder);
+      // Source to sink, so that work an operator flushes at the end reaches operators that have not yet finished.
+      for (auto iter = Begin(), end = End(); iter != end; ++iter) {
+        (*iter)->EndParallelPipelineWork(*this, &builder);
       }
 
       InjectEndResourceTracker(&builder, false);
@@ -35,6 +35,19 @@ uint32_t ExecutionContext::ComputeTupleSize(const planner::OutputSchema *schema)
   return tuple_size;
 }
 
+bool ExecutionContext::TryReserveMemory(const uint64_t bytes) {
+  const uint64_t budget = exec_settings_.GetQueryMemoryBudget();
+  if (budget == 0) {
+    reserved_memory_ += bytes;
+    return true;
+  }
+  uint64_t reserved = reserved_memory_.load();
+  do {
+    if (reserved + bytes > budget) return false;
+  } while (!reserved_memory_.compare_exchange_weak(reserved, reserved + bytes));
+  return true;
+}
+
 void ExecutionContext::RegisterThreadWithMetricsManager() {
   if (noisepage::common::thread_context.metrics_store_ == nullptr && GetMetricsManager()) {
     GetMetricsManager()->RegisterThread();
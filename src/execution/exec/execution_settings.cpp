@@ -10,6 +10,10 @@ void ExecutionSettings::UpdateFromSettingsManager(common::ManagedPointer<setting
     number_of_parallel_execution_threads_ = settings->GetInt(settings::Param::num_parallel_execution_threads);
     is_counters_enabled_ = settings->GetBool(settings::Param::counters_enable);
     is_pipeline_metrics_enabled_ = settings->GetBool(settings::Param::pipeline_metrics_enable);
+    query_memory_budget_ = static_cast<uint64_t>(settings->GetInt64(settings::Param::query_memory_budget));
+    adaptive_compile_runs_ = static_cast<uint64_t>(settings->GetInt64(settings::Param::adaptive_compile_runs));
+    adaptive_compile_interpret_time_us_ =
+        static_cast<uint64_t>(settings->GetInt64(settings::Param::adaptive_compile_interpret_time_us));
   }
 }
 
@@ -1,5 +1,8 @@
 #include "execution/exec/output.h"
 
+#include <algorithm>
+
+#include "execution/exec/execution_context.h"
 #include "execution/sql/value.h"
 #include "loggers/execution_logger.h"
 #include "network/postgres/postgres_packet_writer.h"
@@ -10,10 +13,121 @@ OutputBuffer::~OutputBuffer() { memory_pool_->Deallocate(tuples_, BATCH_SIZE * t
 
 void OutputBuffer::Finalize() {
   if (num_tuples_ > 0) {
+    Flush();
+  }
+}
+
+void OutputBuffer::Flush() {
+  if (!OrderedOutput::Stage(tuples_, num_tuples_, tuple_size_)) {
     callback_(tuples_, num_tuples_, tuple_size_);
-    // Reset to zero.
-    num_tuples_ = 0;
   }
+  // Reset to zero.
+  num_tuples_ = 0;
+}
+
+thread_local OrderedOutput *OrderedOutput::current_output_ = nullptr;
+thread_local uint64_t OrderedOutput::current_range_ = 0;
+
+OrderedOutput::OrderedOutput(ExecutionContext *const exec_ctx, const uint64_t num_ranges,
+                             const OutputCallback &callback)
+    : exec_ctx_(exec_ctx), callback_(callback), ranges_(num_ranges) {}
+
+OrderedOutput::~OrderedOutput() {
+  for (const auto &range : ranges_) {
+    exec_ctx_->ReleaseMemory(range.reserved_);
+  }
+}
+
+void OrderedOutput::Produce(const uint64_t range, const std::function<void(uint64_t)> &produce) {
+  NOISEPAGE_ASSERT(range < ranges_.size(), "Range out of bounds");
+  // Once the staged tuples ran out of the budget, no more ranges are produced in parallel
+  if (over_budget_.load()) return;
+
+  OrderedOutput *const prev_output = current_output_;
+  const uint64_t prev_range = current_range_;
+  current_output_ = this;
+  current_range_ = range;
+  try {
+    produce(range);
+  } catch (...) {
+    current_output_ = prev_output;
+    current_range_ = prev_range;
+    throw;
+  }
+  current_output_ = prev_output;
+  current_range_ = prev_range;
+
+  // Output every range that is ready, in order
+  std::lock_guard<std::mutex> guard(mutex_);
+  ranges_[range].done_ = true;
+  for (; next_range_ < ranges_.size() && ranges_[next_range_].done_; next_range_++) {
+    OutputRange(&ranges_[next_range_]);
+  }
+}
+
+void OrderedOutput::Finish(const std::function<void(uint64_t)> &produce) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (; next_range_ < ranges_.size(); next_range_++) {
+    Range &range = ranges_[next_range_];
+    if (range.done_) {
+      OutputRange(&range);
+      continue;
+    }
+    // The range was deferred. Nothing is staged while it is produced, so its output goes straight to the callback.
+    OrderedOutput *const prev_output = current_output_;
+    current_output_ = nullptr;
+    try {
+      produce(next_range_);
+    } catch (...) {
+      current_output_ = prev_output;
+      throw;
+    }
+    current_output_ = prev_output;
+    range.done_ = true;
+  }
+}
+
+bool OrderedOutput::Stage(const byte *const tuples, const uint32_t num_tuples, const uint32_t tuple_size) {
+  if (current_output_ == nullptr) return false;
+  return current_output_->StageRange(current_range_, tuples, num_tuples, tuple_size);
+}
+
+bool OrderedOutput::StageRange(const uint64_t range_idx, const byte *const tuples, const uint32_t num_tuples,
+                               const uint32_t tuple_size) {
+  Range &range = ranges_[range_idx];
+  if (range.streaming_) return false;
+  NOISEPAGE_ASSERT(range.tuples_.empty() || range.tuple_size_ == tuple_size,
+                   "All output of a range must have the same tuple size");
+
+  const uint64_t size = static_cast<uint64_t>(num_tuples) * tuple_size;
+  if (exec_ctx_->TryReserveMemory(size)) {
+    range.reserved_ += size;
+  } else {
+    over_budget_ = true;
+    // If all earlier ranges have been output, the range no longer needs to stage anything
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (next_range_ == range_idx) {
+      OutputRange(&range);
+      range.streaming_ = true;
+      return false;
+    }
+  }
+  range.tuple_size_ = tuple_size;
+  range.tuples_.insert(range.tuples_.end(), tuples, tuples + size);
+  return true;
+}
+
+void OrderedOutput::OutputRange(Range *const range) {
+  if (range->tuples_.empty()) return;
+  const uint64_t num_tuples = range->tuples_.size() / range->tuple_size_;
+  for (uint64_t i = 0; i < num_tuples; i += OutputBuffer::BATCH_SIZE) {
+    const auto batch_size = static_cast<uint32_t>(std::min<uint64_t>(OutputBuffer::BATCH_SIZE, num_tuples - i));
+    callback_(&range->tuples_[i * range->tuple_size_], batch_size, range->tuple_size_);
+  }
+  // Free the staged tuples
+  std::vector<byte>().swap(range->tuples_);
+  exec_ctx_->ReleaseMemory(range->reserved_);
+  range->reserved_ = 0;
 }
 
 void OutputPrinter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
@@ -757,6 +757,66 @@ void Sema::CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin buil
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableLoadSpilledPartition: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!call_args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      // Third argument must be a 32-bit number representing the probe tuple size
+      if (!call_args[2]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table spill call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   if (!CheckArgCount(call, 3)) {
     return;
@@ -787,6 +847,61 @@ void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::HashTableEntryIterator));
 }
 
+void Sema::CheckBuiltinJoinHashTableBloomFilterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableBloomFilter: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::JoinHashTableFilterBatch: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // Second argument is the vector projection to filter
+      const auto vp_kind = ast::BuiltinType::VectorProjection;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), vp_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(vp_kind)->PointerTo());
+        return;
+      }
+      // Third argument is the list of tuples to filter
+      const auto tid_list_kind = ast::BuiltinType::TupleIdList;
+      if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), tid_list_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(tid_list_kind)->PointerTo());
+        return;
+      }
+      // Fourth argument is the array of key column indexes
+      auto *arr_type = call_args[3]->GetType()->SafeAs<ast::ArrayType>();
+      if (arr_type == nullptr || !arr_type->GetElementType()->IsSpecificBuiltin(ast::BuiltinType::Uint32) ||
+          !arr_type->HasKnownLength()) {
+        ReportIncorrectCallArg(call, 3, "Fourth argument should be a fixed length uint32 array");
+        return;
+      }
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table bloom filter call");
+    }
+  }
+
+  // This call returns nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinJoinHashTableFree(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -2225,6 +2340,52 @@ void Sema::CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin) {
       }
       break;
     }
+    case ast::Builtin::SorterParallelScan: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // Second argument is an opaque context pointer
+      if (!call_args[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      // Third argument is the *ThreadStateContainer
+      const auto tls_kind = ast::BuiltinType::ThreadStateContainer;
+      if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), tls_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(tls_kind)->PointerTo());
+        return;
+      }
+      // Fourth argument is the function scanning a range
+      if (!call_args[3]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Nil));
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::SorterParallelScanPartitions: {
+      if (!CheckArgCount(call, 5)) {
+        return;
+      }
+      // Second argument is an opaque context pointer
+      if (!call_args[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      // Third argument is the *ThreadStateContainer
+      const auto tls_kind = ast::BuiltinType::ThreadStateContainer;
+      if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), tls_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(tls_kind)->PointerTo());
+        return;
+      }
+      // Fourth argument is the function comparing partitions, fifth the function scanning a range
+      for (uint32_t i = 3; i < 5; i++) {
+        if (!call_args[i]->GetType()->IsFunctionType()) {
+          ReportIncorrectCallArg(call, i, GetBuiltinType(ast::BuiltinType::Nil));
+          return;
+        }
+      }
+      break;
+    }
     default: {
       UNREACHABLE("Impossible sorter sort call");
     }
@@ -2388,14 +2549,45 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
 
   switch (builtin) {
     case ast::Builtin::IndexIteratorScanKey:
-    case ast::Builtin::IndexIteratorScanDescending: {
+    case ast::Builtin::IndexIteratorScanDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanBatch: {
       if (!CheckArgCount(call, 1)) return;
       break;
     }
+    case ast::Builtin::IndexIteratorSelectBatchKey: {
+      if (!CheckArgCount(call, 2)) return;
+      // Second argument is the position of the key in the batch
+      if (!call->Arguments()[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      break;
+    }
     case ast::Builtin::IndexIteratorScanAscending: {
       if (!CheckArgCount(call, 3)) return;
       break;
     }
+    case ast::Builtin::IndexIteratorParallelScan: {
+      if (!CheckArgCount(call, 4)) return;
+      // Second argument is an opaque context pointer
+      if (!call->Arguments()[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      // Third argument is the *ThreadStateContainer
+      const auto tls_kind = ast::BuiltinType::ThreadStateContainer;
+      if (!IsPointerToSpecificBuiltin(call->Arguments()[2]->GetType(), tls_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(tls_kind)->PointerTo());
+        return;
+      }
+      // Fourth argument is the function iterating over a range
+      if (!call->Arguments()[3]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Nil));
+        return;
+      }
+      break;
+    }
     case ast::Builtin::IndexIteratorScanLimitDescending: {
       if (!CheckArgCount(call, 2)) return;
       auto uint32_kind = ast::BuiltinType::Uint32;
@@ -2619,7 +2811,8 @@ void Sema::CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin bu
   }
 
   switch (builtin) {
-    case ast::Builtin::StorageInterfaceInit: {
+    case ast::Builtin::StorageInterfaceInit:
+    case ast::Builtin::StorageInterfaceInitBatched: {
       if (!CheckArgCount(call, 5)) {
         return;
       }
@@ -2776,6 +2969,8 @@ void Sema::CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::TableInsertBatched:
+    case ast::Builtin::StorageInterfaceFlush:
     case ast::Builtin::StorageInterfaceFree: {
       if (!CheckArgCount(call, 1)) {
         return;
@@ -3434,6 +3629,19 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinJoinHashTableLookup(call);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableLoadSpilledPartition:
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      CheckBuiltinJoinHashTableSpillCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableBloomFilter:
+    case ast::Builtin::JoinHashTableFilterBatch: {
+      CheckBuiltinJoinHashTableBloomFilterCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       CheckBuiltinJoinHashTableFree(call);
       break;
@@ -3467,7 +3675,9 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     }
     case ast::Builtin::SorterSort:
     case ast::Builtin::SorterSortParallel:
-    case ast::Builtin::SorterSortTopKParallel: {
+    case ast::Builtin::SorterSortTopKParallel:
+    case ast::Builtin::SorterParallelScan:
+    case ast::Builtin::SorterParallelScanPartitions: {
       CheckBuiltinSorterSort(call, builtin);
       break;
     }
@@ -3502,7 +3712,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
-    case ast::Builtin::IndexIteratorScanLimitDescending: {
+    case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanBatch:
+    case ast::Builtin::IndexIteratorSelectBatchKey:
+    case ast::Builtin::IndexIteratorParallelScan: {
       CheckBuiltinIndexIteratorScan(call, builtin);
       break;
     }
@@ -3576,9 +3790,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::StorageInterfaceInit:
+    case ast::Builtin::StorageInterfaceInitBatched:
     case ast::Builtin::GetTablePR:
     case ast::Builtin::StorageInterfaceGetIndexHeapSize:
     case ast::Builtin::TableInsert:
+    case ast::Builtin::TableInsertBatched:
     case ast::Builtin::TableDelete:
     case ast::Builtin::TableUpdate:
     case ast::Builtin::GetIndexPR:
@@ -3587,6 +3803,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
     case ast::Builtin::IndexDelete:
+    case ast::Builtin::StorageInterfaceFlush:
     case ast::Builtin::StorageInterfaceFree: {
       CheckBuiltinStorageInterfaceCall(call, builtin);
       break;
@@ -4,6 +4,8 @@
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -167,7 +169,8 @@ AggregationHashTable::AggregationHashTable(const exec::ExecutionSettings &exec_s
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)),
+      spilling_enabled_(exec_settings.GetQueryMemoryBudget() > 0) {
   hash_table_.SetSize(initial_size, memory_->GetTracker());
   max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
 
@@ -202,13 +205,21 @@ AggregationHashTable::~AggregationHashTable() {
   }
   if (partition_tables_ != nullptr) {
     for (uint32_t i = 0; i < DEFAULT_NUM_PARTITIONS; i++) {
-      if (partition_tables_[i] != nullptr) {
-        partition_tables_[i]->~AggregationHashTable();
-        memory_->Deallocate(partition_tables_[i], sizeof(AggregationHashTable));
-      }
+      FreePartitionTable(i);
     }
     memory_->DeallocateArray(partition_tables_, DEFAULT_NUM_PARTITIONS);
   }
+  if (reserved_memory_ > 0) {
+    exec_ctx_->ReleaseMemory(reserved_memory_);
+  }
+}
+
+void AggregationHashTable::FreePartitionTable(const uint32_t partition_idx) {
+  if (partition_tables_[partition_idx] != nullptr) {
+    partition_tables_[partition_idx]->~AggregationHashTable();
+    memory_->Deallocate(partition_tables_[partition_idx], sizeof(AggregationHashTable));
+    partition_tables_[partition_idx] = nullptr;
+  }
 }
 
 void AggregationHashTable::Grow() {
@@ -297,9 +308,84 @@ void AggregationHashTable::FlushToOverflowPartitions() {
 
   // Update stats
   stats_.num_flushes_++;
+
+  if (spilling_enabled_) {
+    ReserveMemory();
+  }
+}
+
+void AggregationHashTable::ReserveMemory() {
+  const uint64_t size = entries_.size() * entries_.ElementSize();
+  if (size <= reserved_memory_ || spill_pending_) {
+    return;
+  }
+  if (exec_ctx_->TryReserveMemory(size - reserved_memory_)) {
+    reserved_memory_ = size;
+    return;
+  }
+  // Callers may still hold pointers into the entries just flushed, so they
+  // are only spilled when the next tuple is inserted
+  EXECUTION_LOG_TRACE("AHT: Query memory budget exhausted after {} entries. Spilling overflow partitions.",
+                      entries_.size());
+  spill_pending_ = true;
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  NOISEPAGE_ASSERT(hash_table_.GetElementCount() == 0, "All entries must be flushed to the overflow partitions");
+  const std::size_t entry_size = entries_.ElementSize();
+  if (spill_files_.empty()) {
+    spill_files_.reserve(NUM_SPILL_PARTITIONS);
+    for (uint32_t i = 0; i < NUM_SPILL_PARTITIONS; i++) {
+      spill_files_.emplace_back(std::make_unique<SpillFile>(entry_size));
+    }
+  }
+
+  if (partition_heads_ != nullptr) {
+    constexpr uint32_t partitions_per_file = DEFAULT_NUM_PARTITIONS / NUM_SPILL_PARTITIONS;
+    for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+      SpillFile *file = spill_files_[part_idx / partitions_per_file].get();
+      for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+        std::memcpy(file->Append(), entry, entry_size);
+      }
+    }
+    std::memset(partition_heads_, 0, sizeof(HashTableEntry *) * DEFAULT_NUM_PARTITIONS);
+    std::memset(partition_tails_, 0, sizeof(HashTableEntry *) * DEFAULT_NUM_PARTITIONS);
+  }
+
+  ReleaseEntries();
+  spill_pending_ = false;
+}
+
+void AggregationHashTable::ReleaseEntries() {
+  // Assigning a fresh vector hands the chunks back to the memory pool, unlike clear()
+  entries_ = decltype(entries_)(entries_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+  if (reserved_memory_ > 0) {
+    exec_ctx_->ReleaseMemory(reserved_memory_);
+    reserved_memory_ = 0;
+  }
+}
+
+void AggregationHashTable::AdoptSpilledPartitions(AggregationHashTable *source) {
+  if (spilled_partitions_.empty()) {
+    constexpr uint32_t partitions_per_file = DEFAULT_NUM_PARTITIONS / NUM_SPILL_PARTITIONS;
+    spilled_partitions_.resize(NUM_SPILL_PARTITIONS);
+    // Scan the spilled partitions in order, from the back
+    for (uint32_t i = 0; i < NUM_SPILL_PARTITIONS; i++) {
+      auto &partition = spilled_partitions_[NUM_SPILL_PARTITIONS - i - 1];
+      partition.begin_ = i * partitions_per_file;
+      partition.end_ = (i + 1) * partitions_per_file;
+    }
+  }
+  for (uint32_t i = 0; i < source->spill_files_.size(); i++) {
+    spilled_partitions_[NUM_SPILL_PARTITIONS - i - 1].files_.emplace_back(std::move(source->spill_files_[i]));
+  }
+  source->spill_files_.clear();
 }
 
 byte *AggregationHashTable::AllocInputTuplePartitioned(hash_t hash) {
+  if (UNLIKELY(spill_pending_)) {
+    SpillOverflowPartitions();
+  }
   byte *ret = AllocInputTuple(hash);
   if (NeedsToFlushToOverflowPartitions()) {
     FlushToOverflowPartitions();
@@ -508,6 +594,11 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
         std::make_unique<HashToGroupIdMap>());         // The Hash-to-GroupID map
   }
 
+  // Spill the overflow partitions if the previous flush exhausted the budget.
+  if (UNLIKELY(spill_pending_) && partitioned_aggregation) {
+    SpillOverflowPartitions();
+  }
+
   // Reset state for the incoming batch.
   batch_state_->Reset(input_batch);
 
@@ -566,14 +657,37 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
     // partitions contain all partial aggregates
     stats_.num_inserts_ += table->stats_.num_inserts_;
     table->FlushToOverflowPartitions();
+  }
 
-    // Now, move over their memory
-    owned_entries_.emplace_back(std::move(table->entries_));
+  // If any table ran out of memory, all tables spill their overflow partitions
+  // and we take over their files instead.
+  const auto needs_spill = [](const AggregationHashTable *table) {
+    return table->IsSpilled() || table->spill_pending_;
+  };
+  const bool spill = needs_spill(this) || std::any_of(tl_agg_ht.begin(), tl_agg_ht.end(), needs_spill);
+  if (spill) {
+    SpillOverflowPartitions();
+    AdoptSpilledPartitions(this);
+  }
 
+  for (auto *table : tl_agg_ht) {
     NOISEPAGE_ASSERT(table->owned_entries_.empty(),
                      "A thread-local aggregation table should not have any owned "
                      "entries themselves. Nested/recursive aggregations not supported.");
 
+    if (spill) {
+      table->SpillOverflowPartitions();
+      AdoptSpilledPartitions(table);
+      for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+        partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
+      }
+      continue;
+    }
+
+    // Now, move over their memory
+    owned_entries_.emplace_back(std::move(table->entries_));
+    reserved_memory_ += std::exchange(table->reserved_memory_, 0);
+
     // Now, move over their overflow partitions list
     for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
       if (table->partition_heads_[part_idx] != nullptr) {
@@ -633,6 +747,11 @@ void AggregationHashTable::ExecutePartitionedScan(void *query_state, Aggregation
                    "No overflow partitions allocated, or no merging function allocated. Did you call "
                    "TransferMemoryAndPartitions() before issuing the partitioned scan?");
 
+  if (IsSpilled()) {
+    ScanSpilledPartitions(query_state, nullptr, scan_fn);
+    return;
+  }
+
   // Determine the non-empty overflow partitions.
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
     if (partition_heads_[part_idx] != nullptr) {
@@ -658,6 +777,11 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
                    "No overflow partitions allocated, or no merging function allocated. Did you call "
                    "TransferMemoryAndPartitions() before issuing the partitioned scan?");
 
+  if (IsSpilled()) {
+    ScanSpilledPartitions(query_state, thread_states, scan_fn);
+    return;
+  }
+
   // Determine the non-empty overflow partitions
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
@@ -667,15 +791,21 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
     }
   }
 
+  ScanPartitionsParallel(query_state, thread_states, nonempty_parts, scan_fn);
+}
+
+void AggregationHashTable::ScanPartitionsParallel(void *query_state, ThreadStateContainer *thread_states,
+                                                  const std::vector<uint32_t> &partitions,
+                                                  const AggregationHashTable::ScanPartitionFn scan_fn) {
   util::Timer<std::milli> timer;
   timer.Start();
 
   size_t num_threads = tbb::task_scheduler_init::default_num_threads();
-  size_t num_tasks = nonempty_parts.size();
+  size_t num_tasks = partitions.size();
   size_t concurrent_estimate = std::min(num_threads, num_tasks);
   exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
 
-  tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
+  tbb::parallel_for_each(partitions, [&](const uint32_t part_idx) {
     // TODO(wz2): Resource trackers are started and stopped within scan_fn. It might be more correct
     // to start the trackers here manually -- or have TransferMemoryAndPartitions build all the tables
     // over each partition (but that would require storing the agg table pointers).
@@ -694,16 +824,117 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   timer.Stop();
 
   const uint64_t tuple_count =
-      std::accumulate(nonempty_parts.begin(), nonempty_parts.end(), uint64_t{0},
+      std::accumulate(partitions.begin(), partitions.end(), uint64_t{0},
                       [&](const auto curr, const auto idx) { return curr + partition_tables_[idx]->GetTupleCount(); });
 
   UNUSED_ATTRIBUTE double tps = (tuple_count / timer.GetElapsed()) / 1000.0;
-  EXECUTION_LOG_TRACE("Built and scanned {} tables totalling {} tuples in {:.2f} ms ({:.2f} mtps)",
-                      nonempty_parts.size(), tuple_count, timer.GetElapsed(), tps);
+  EXECUTION_LOG_TRACE("Built and scanned {} tables totalling {} tuples in {:.2f} ms ({:.2f} mtps)", partitions.size(),
+                      tuple_count, timer.GetElapsed(), tps);
+}
+
+void AggregationHashTable::RepartitionSpilled(SpilledPartition *partition) {
+  const uint32_t num_parts = partition->end_ - partition->begin_;
+  const uint32_t num_ranges = std::min(NUM_SPILL_PARTITIONS, num_parts);
+  const uint32_t parts_per_range = num_parts / num_ranges;
+  EXECUTION_LOG_TRACE("AHT: Splitting overflow partitions [{}, {}) into {} spilled partitions.", partition->begin_,
+                      partition->end_, num_ranges);
+
+  std::vector<SpilledPartition> ranges(num_ranges);
+  for (uint32_t i = 0; i < num_ranges; i++) {
+    ranges[i].files_.emplace_back(std::make_unique<SpillFile>(entries_.ElementSize()));
+    ranges[i].begin_ = partition->begin_ + i * parts_per_range;
+    ranges[i].end_ = ranges[i].begin_ + parts_per_range;
+  }
+
+  for (auto &file : partition->files_) {
+    file->Rewind();
+    for (const byte *record = file->Next(); record != nullptr; record = file->Next()) {
+      const hash_t hash = reinterpret_cast<const HashTableEntry *>(record)->hash_;
+      const uint64_t part_idx = hash >> partition_shift_bits_;
+      SpillFile *target = ranges[(part_idx - partition->begin_) / parts_per_range].files_[0].get();
+      std::memcpy(target->Append(), record, entries_.ElementSize());
+    }
+    // Remove the file from disk as soon as it has been split
+    file.reset();
+  }
+
+  // Scan the ranges in order, from the back
+  std::move(ranges.rbegin(), ranges.rend(), std::back_inserter(spilled_partitions_));
+}
+
+void AggregationHashTable::ScanSpilledPartitions(void *query_state, ThreadStateContainer *thread_states,
+                                                 const AggregationHashTable::ScanPartitionFn scan_fn) {
+  if (partition_tables_ == nullptr) {
+    partition_tables_ = memory_->AllocateArray<AggregationHashTable *>(DEFAULT_NUM_PARTITIONS, true);
+  }
+
+  const std::size_t entry_size = entries_.ElementSize();
+  while (!spilled_partitions_.empty()) {
+    SpilledPartition partition = std::move(spilled_partitions_.back());
+    spilled_partitions_.pop_back();
+
+    uint64_t num_entries = 0;
+    for (const auto &file : partition.files_) num_entries += file->GetRecordCount();
+    if (num_entries == 0) {
+      continue;
+    }
+
+    // The loaded entries, and at worst as many entries in the tables built over
+    // them. Split ranges that don't fit. Single overflow partitions are loaded
+    // over the budget.
+    const uint64_t size = 2 * num_entries * entry_size;
+    if (exec_ctx_->TryReserveMemory(size)) {
+      reserved_memory_ += size;
+    } else if (partition.end_ - partition.begin_ > 1) {
+      RepartitionSpilled(&partition);
+      continue;
+    }
+
+    // Load the entries back into their overflow partitions
+    for (auto &file : partition.files_) {
+      file->Rewind();
+      for (const byte *record = file->Next(); record != nullptr; record = file->Next()) {
+        auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+        std::memcpy(entry, record, entry_size);
+        const uint64_t part_idx = entry->hash_ >> partition_shift_bits_;
+        entry->next_ = partition_heads_[part_idx];
+        partition_heads_[part_idx] = entry;
+        if (partition_tails_[part_idx] == nullptr) {
+          partition_tails_[part_idx] = entry;
+        }
+      }
+    }
+    partition.files_.clear();
+
+    std::vector<uint32_t> nonempty_parts;
+    for (uint32_t part_idx = partition.begin_; part_idx < partition.end_; part_idx++) {
+      if (partition_heads_[part_idx] != nullptr) {
+        nonempty_parts.push_back(part_idx);
+      }
+    }
+
+    // Merge and scan the loaded overflow partitions
+    if (thread_states != nullptr) {
+      ScanPartitionsParallel(query_state, thread_states, nonempty_parts, scan_fn);
+    } else {
+      for (const uint32_t part_idx : nonempty_parts) {
+        scan_fn(query_state, nullptr, GetOrBuildTableOverPartition(query_state, part_idx));
+      }
+    }
+
+    // Free them before loading the next spilled partition
+    for (const uint32_t part_idx : nonempty_parts) {
+      FreePartitionTable(part_idx);
+      partition_heads_[part_idx] = nullptr;
+      partition_tails_[part_idx] = nullptr;
+    }
+    ReleaseEntries();
+  }
 }
 
 void AggregationHashTable::BuildAllPartitions(void *query_state) {
   NOISEPAGE_ASSERT(partition_tables_ == nullptr, "Should not have built aggregation hash tables already");
+  NOISEPAGE_ASSERT(!IsSpilled(), "Spilled partitions can only be scanned");
   partition_tables_ = memory_->AllocateArray<AggregationHashTable *>(DEFAULT_NUM_PARTITIONS, true);
 
   // Find non-empty partitions.
@@ -747,11 +978,13 @@ void AggregationHashTable::Repartition() {
 
     // Move partitioned hash table memory into this main hash table.
     owned_entries_.emplace_back(std::move(table->entries_));
+    reserved_memory_ += std::exchange(table->reserved_memory_, 0);
   }
 }
 
 void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *query_state,
                                            AggregationHashTable::MergePartitionFn merge_func) {
+  NOISEPAGE_ASSERT(!IsSpilled() && !target->IsSpilled(), "Spilled partitions can only be scanned");
   if (target->partition_tables_ == nullptr) {
     target->partition_tables_ = memory_->AllocateArray<AggregationHashTable *>(DEFAULT_NUM_PARTITIONS, true);
   }
@@ -777,6 +1010,7 @@ void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *q
 
   // Move our memory to the target.
   target->owned_entries_.emplace_back(std::move(entries_));
+  target->reserved_memory_ += std::exchange(reserved_memory_, 0);
 }
 
 }  // namespace noisepage::execution::sql
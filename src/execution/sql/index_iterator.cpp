@@ -1,8 +1,19 @@
 #include "execution/sql/index_iterator.h"
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <cstring>
+
 #include "catalog/catalog_accessor.h"
+#include "common/math_util.h"
+#include "execution/sql/thread_state_container.h"
 #include "execution/sql/value.h"
+#include "execution/util/timer.h"
+#include "loggers/execution_logger.h"
 #include "storage/sql_table.h"
+#include "storage/storage_util.h"
 
 namespace noisepage::execution::sql {
 
@@ -14,6 +25,16 @@ IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attr
       index_(exec_ctx_->GetAccessor()->GetIndex(catalog::index_oid_t(index_oid))),
       table_(exec_ctx_->GetAccessor()->GetTable(catalog::table_oid_t(table_oid))) {}
 
+IndexIterator::IndexIterator(const IndexIterator &source, const uint64_t begin, const uint64_t end)
+    : exec_ctx_(source.exec_ctx_),
+      num_attrs_(source.num_attrs_),
+      col_oids_(source.col_oids_),
+      index_(source.index_),
+      table_(source.table_),
+      tuples_(source.tuples_.cbegin() + begin, source.tuples_.cbegin() + end) {
+  Init();
+}
+
 void IndexIterator::Init() {
   // Initialize projected rows for the index and the table
   NOISEPAGE_ASSERT(!col_oids_.empty(), "There must be at least one col oid!");
@@ -59,6 +80,75 @@ void IndexIterator::ScanLimitDescending(uint32_t limit) {
   index_->ScanLimitDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
 }
 
+void IndexIterator::AddBatchKey() {
+  NOISEPAGE_ASSERT(num_batch_keys_ < BATCH_SIZE, "Batch of keys is full.");
+  if (batch_buffer_ == nullptr) {
+    batch_key_size_ = storage::StorageUtil::PadUpToSize(alignof(uint64_t), index_pr_->Size());
+    batch_buffer_ = exec_ctx_->GetMemoryPool()->AllocateAligned(BATCH_SIZE * batch_key_size_, alignof(uint64_t), false);
+  }
+  std::memcpy(reinterpret_cast<byte *>(batch_buffer_) + num_batch_keys_ * batch_key_size_, index_pr_,
+              index_pr_->Size());
+  num_batch_keys_++;
+}
+
+void IndexIterator::ScanBatch() {
+  // Scan the index
+  std::vector<const storage::ProjectedRow *> keys;
+  keys.reserve(num_batch_keys_);
+  for (uint32_t i = 0; i < num_batch_keys_; i++) {
+    keys.emplace_back(reinterpret_cast<const storage::ProjectedRow *>(reinterpret_cast<byte *>(batch_buffer_) +
+                                                                      i * batch_key_size_));
+  }
+  batch_tuples_.clear();
+  batch_offsets_.clear();
+  index_->ScanKeys(*exec_ctx_->GetTxn(), keys, &batch_tuples_, &batch_offsets_);
+  num_batch_keys_ = 0;
+}
+
+void IndexIterator::SelectBatchKey(uint32_t key_idx) {
+  NOISEPAGE_ASSERT(key_idx + 1 < batch_offsets_.size(), "Key is not part of the last scanned batch.");
+  tuples_.assign(batch_tuples_.cbegin() + batch_offsets_[key_idx],
+                 batch_tuples_.cbegin() + batch_offsets_[key_idx + 1]);
+  curr_index_ = 0;
+}
+
+void IndexIterator::ParallelScan(void *const query_state, ThreadStateContainer *const thread_states,
+                                 const IndexIterator::ScanRangeFn scan_fn) const {
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const uint64_t num_tuples = tuples_.size();
+  const uint64_t num_ranges = common::MathUtil::DivRoundUp(num_tuples, PARALLEL_SCAN_RANGE_SIZE);
+  size_t num_threads = std::max(exec_ctx_->GetExecutionSettings().GetNumberOfParallelExecutionThreads(), 0);
+  size_t concurrent_estimate = std::min(num_threads, num_ranges);
+  exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
+
+  // Output produced by a range is held back until the ranges before it have been output
+  exec::OrderedOutput output(exec_ctx_, num_ranges, exec_ctx_->GetOutputCallback());
+  const auto produce_range = [&](const uint64_t range) {
+    const uint64_t begin = range * PARALLEL_SCAN_RANGE_SIZE;
+    const uint64_t end = std::min(begin + PARALLEL_SCAN_RANGE_SIZE, num_tuples);
+    IndexIterator iter(*this, begin, end);
+    scan_fn(query_state, thread_states->AccessCurrentThreadState(), &iter);
+  };
+  auto scan_range = [&](const uint64_t range) { output.Produce(range, produce_range); };
+
+  tbb::task_arena limited_arena(num_threads);
+  const bool is_static_partitioned = exec_ctx_->GetExecutionSettings().GetIsStaticPartitionerEnabled();
+  limited_arena.execute([num_ranges, &scan_range, is_static_partitioned] {
+    is_static_partitioned ? tbb::parallel_for(uint64_t{0}, num_ranges, scan_range, tbb::static_partitioner())
+                          : tbb::parallel_for(uint64_t{0}, num_ranges, scan_range);
+  });
+  output.Finish(produce_range);
+
+  exec_ctx_->SetNumConcurrentEstimate(0);
+  timer.Stop();
+
+  UNUSED_ATTRIBUTE double tps = (num_tuples / timer.GetElapsed()) / 1000.0;
+  EXECUTION_LOG_TRACE("Scanned {} index ranges totalling {} tuples in {:.2f} ms ({:.2f} mtps)", num_ranges,
+                      num_tuples, timer.GetElapsed(), tps);
+}
+
 bool IndexIterator::Advance() {
   if (curr_index_ < tuples_.size()) {
     ++curr_index_;
@@ -77,5 +167,6 @@ IndexIterator::~IndexIterator() {
   exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(index_buffer_, index_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(hi_index_buffer_, hi_index_pr_->Size());
+  if (batch_buffer_ != nullptr) exec_ctx_->GetMemoryPool()->Deallocate(batch_buffer_, BATCH_SIZE * batch_key_size_);
 }
 }  // namespace noisepage::execution::sql
@@ -1,20 +1,28 @@
 #include "execution/sql/join_hash_table.h"
 
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MathExtras.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector.h"
-#include "execution/sql/vector_operations/unary_operation_executor.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql/vector_projection.h"
 #include "execution/util/cpu_info.h"
 #include "execution/util/memory.h"
 #include "execution/util/timer.h"
@@ -32,15 +40,24 @@ JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings, exec:
       hll_estimator_(libcount::HLL::Create(DEFAULT_HLL_PRECISION)),
       built_(false),
       use_concise_ht_(use_concise_ht),
+      prefetch_threshold_(CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE)),
       tracker_(exec_ctx->GetMemoryPool()->GetTracker()) {}
 
-// Needed because we forward-declared HLL from libcount
-JoinHashTable::~JoinHashTable() = default;
+JoinHashTable::~JoinHashTable() {
+  if (reserved_memory_ > 0) {
+    exec_ctx_->ReleaseMemory(reserved_memory_);
+  }
+}
 
 byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   // Add to unique_count estimation
   hll_estimator_->Update(hash);
 
+  // Make sure the tuple is covered by the memory reservation, or spill it
+  if (UNLIKELY(entries_.size() == reserved_tuples_) && !ReserveMemory()) {
+    return AllocSpilledInputTuple(hash);
+  }
+
   // Allocate space for a new tuple
   auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
   entry->hash_ = hash;
@@ -48,6 +65,198 @@ byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   return entry->payload_;
 }
 
+void JoinHashTable::EnableSpilling() {
+  NOISEPAGE_ASSERT(entries_.empty(), "Spilling must be enabled before any tuple is inserted");
+  if (UsingConciseHashTable() || exec_ctx_->GetExecutionSettings().GetQueryMemoryBudget() == 0) {
+    return;
+  }
+  reserved_tuples_ = 0;
+}
+
+bool JoinHashTable::ReserveMemory() {
+  if (spilled_) {
+    return false;
+  }
+
+  const uint64_t num_tuples = std::max(uint64_t{1}, MEMORY_RESERVATION_SIZE / entries_.ElementSize());
+  const uint64_t size = num_tuples * entries_.ElementSize();
+  if (exec_ctx_->TryReserveMemory(size)) {
+    reserved_memory_ += size;
+    reserved_tuples_ += num_tuples;
+    return true;
+  }
+
+  EXECUTION_LOG_TRACE("JHT: Query memory budget exhausted after {} tuples. Spilling to disk.", entries_.size());
+  SpillBufferedEntries();
+  return false;
+}
+
+byte *JoinHashTable::AllocSpilledInputTuple(const hash_t hash) {
+  auto *entry = reinterpret_cast<HashTableEntry *>(spilled_build_[SpillPartitionIndex(hash, 0)]->Append());
+  entry->hash_ = hash;
+  entry->next_ = nullptr;
+  return entry->payload_;
+}
+
+void JoinHashTable::SpillBufferedEntries() {
+  const std::size_t entry_size = entries_.ElementSize();
+  if (spilled_build_.empty()) {
+    spilled_build_.reserve(1u << SPILL_RADIX_BITS);
+    for (uint32_t i = 0; i < (1u << SPILL_RADIX_BITS); i++) {
+      spilled_build_.emplace_back(std::make_unique<SpillFile>(entry_size));
+    }
+  }
+
+  for (const byte *entry : entries_) {
+    const hash_t hash = reinterpret_cast<const HashTableEntry *>(entry)->hash_;
+    std::memcpy(spilled_build_[SpillPartitionIndex(hash, 0)]->Append(), entry, entry_size);
+  }
+
+  ReleaseBufferedEntries();
+  reserved_tuples_ = 0;
+  spilled_ = true;
+}
+
+void JoinHashTable::ReleaseBufferedEntries() {
+  // Assigning a fresh vector hands the chunks back to the memory pool, unlike clear()
+  entries_ = decltype(entries_)(entries_.ElementSize(), MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+  if (reserved_memory_ > 0) {
+    exec_ctx_->ReleaseMemory(reserved_memory_);
+    reserved_memory_ = 0;
+  }
+}
+
+void JoinHashTable::AdoptSpilledBuild(JoinHashTable *source) {
+  if (spilled_partitions_.empty()) {
+    spilled_partitions_.resize(1u << SPILL_RADIX_BITS);
+  }
+  for (uint32_t i = 0; i < source->spilled_build_.size(); i++) {
+    spilled_partitions_[i].build_.emplace_back(std::move(source->spilled_build_[i]));
+  }
+  source->spilled_build_.clear();
+}
+
+byte *JoinHashTable::AllocSpilledProbeTuple(const hash_t hash, const uint32_t probe_size) {
+  NOISEPAGE_ASSERT(IsBuilt() && IsSpilled(), "Probes are only spilled once the spilled table is built");
+  auto &files = spilled_probes_.local();
+  if (UNLIKELY(files.empty())) {
+    const uint64_t record_size =
+        common::MathUtil::AlignTo(SPILLED_PROBE_HEADER_SIZE + probe_size, SPILLED_PROBE_HEADER_SIZE);
+    files.reserve(1u << SPILL_RADIX_BITS);
+    for (uint32_t i = 0; i < (1u << SPILL_RADIX_BITS); i++) {
+      files.emplace_back(std::make_unique<SpillFile>(record_size));
+    }
+  }
+
+  byte *record = files[SpillPartitionIndex(hash, 0)]->Append();
+  *reinterpret_cast<hash_t *>(record) = hash;
+  return record + SPILLED_PROBE_HEADER_SIZE;
+}
+
+void JoinHashTable::RepartitionSpilled(SpilledPartition *partition) {
+  const uint32_t level = partition->level_ + 1;
+  std::vector<SpilledPartition> children(1u << SPILL_RADIX_BITS);
+
+  // Scatter the records of the given files into the files of the children, creating them on demand
+  const auto scatter = [&](std::vector<std::unique_ptr<SpillFile>> *files, const bool probe) {
+    for (auto &file : *files) {
+      file->Rewind();
+      for (byte *record = file->Next(); record != nullptr; record = file->Next()) {
+        const hash_t hash = probe ? *reinterpret_cast<const hash_t *>(record)
+                                  : reinterpret_cast<const HashTableEntry *>(record)->hash_;
+        auto &child = children[SpillPartitionIndex(hash, level)];
+        auto &child_files = probe ? child.probe_ : child.build_;
+        if (child_files.empty()) {
+          child_files.emplace_back(std::make_unique<SpillFile>(file->GetRecordSize()));
+        }
+        std::memcpy(child_files[0]->Append(), record, file->GetRecordSize());
+      }
+    }
+    files->clear();
+  };
+  scatter(&partition->build_, false);
+  scatter(&partition->probe_, true);
+
+  // Join the children next, in order
+  for (auto iter = children.rbegin(); iter != children.rend(); ++iter) {
+    iter->level_ = level;
+    spilled_partitions_.emplace_back(std::move(*iter));
+  }
+}
+
+bool JoinHashTable::LoadNextSpilledPartition() {
+  NOISEPAGE_ASSERT(IsBuilt() && IsSpilled(), "Only built spilled tables have spilled partitions");
+
+  // Once the probe side is done, hand the thread-local probe files over to the partitions
+  if (!spilled_probes_collected_) {
+    for (auto &files : spilled_probes_) {
+      for (uint32_t i = 0; i < files.size(); i++) {
+        spilled_partitions_[i].probe_.emplace_back(std::move(files[i]));
+      }
+    }
+    spilled_probes_.clear();
+    std::reverse(spilled_partitions_.begin(), spilled_partitions_.end());
+    spilled_probes_collected_ = true;
+  }
+
+  // Release the previous partition
+  ReleaseBufferedEntries();
+  loaded_probes_.clear();
+  loaded_probe_idx_ = 0;
+
+  const auto count_records = [](const std::vector<std::unique_ptr<SpillFile>> &files) {
+    uint64_t count = 0;
+    for (const auto &file : files) count += file->GetRecordCount();
+    return count;
+  };
+
+  while (!spilled_partitions_.empty()) {
+    SpilledPartition partition = std::move(spilled_partitions_.back());
+    spilled_partitions_.pop_back();
+
+    // Build tuples that nothing probes never need to be loaded
+    if (count_records(partition.probe_) == 0) {
+      continue;
+    }
+
+    // Partition further if the build tuples don't fit. Past the last level, the
+    // tuples likely share their hash values and are loaded over the budget.
+    const uint64_t size = count_records(partition.build_) * entries_.ElementSize();
+    if (exec_ctx_->TryReserveMemory(size)) {
+      reserved_memory_ = size;
+    } else if (partition.level_ + 1 < MAX_SPILL_LEVELS) {
+      RepartitionSpilled(&partition);
+      continue;
+    }
+
+    for (auto &file : partition.build_) {
+      file->Rewind();
+      for (const byte *record = file->Next(); record != nullptr; record = file->Next()) {
+        std::memcpy(entries_.Append(), record, entries_.ElementSize());
+      }
+    }
+    BuildChainingHashTable();
+
+    loaded_probes_ = std::move(partition.probe_);
+    for (auto &file : loaded_probes_) {
+      file->Rewind();
+    }
+    return true;
+  }
+
+  return false;
+}
+
+byte *JoinHashTable::NextSpilledProbeTuple() {
+  while (loaded_probe_idx_ < loaded_probes_.size()) {
+    if (byte *record = loaded_probes_[loaded_probe_idx_]->Next(); record != nullptr) {
+      return record + SPILLED_PROBE_HEADER_SIZE;
+    }
+    loaded_probe_idx_++;
+  }
+  return nullptr;
+}
+
 void JoinHashTable::BuildChainingHashTable() {
   // Perfectly size the generic hash table in preparation for bulk-load.
   chaining_hash_table_.SetSize(GetTupleCount(), tracker_);
@@ -497,9 +706,21 @@ void JoinHashTable::Build() {
 
   EXECUTION_LOG_DEBUG("Unique estimate: {}", hll_estimator_->Estimate());
 
+  // Tuples are built into the table one spilled partition at a time, while joining
+  if (IsSpilled()) {
+    AdoptSpilledBuild(this);
+    built_ = true;
+    return;
+  }
+
   util::Timer<> timer;
   timer.Start();
 
+  // The bloom filter is populated before building reorders the tuples of a concise table
+  if (use_bloom_filter_) {
+    BuildBloomFilter();
+  }
+
   // Build
   if (UsingConciseHashTable()) {
     BuildConciseHashTable();
@@ -514,18 +735,144 @@ void JoinHashTable::Build() {
   built_ = true;
 }
 
-// TODO(pmenon): Vectorized bloom filter pre-filtering.
-// TODO(pmenon): Implement prefetching.
+void JoinHashTable::BuildBloomFilter() {
+  const uint64_t num_tuples = GetTupleCount();
+  if (num_tuples == 0) {
+    return;
+  }
+
+  bloom_filter_.Init(exec_ctx_->GetMemoryPool(), static_cast<uint32_t>(num_tuples));
 
+  const auto add_hashes = [this](const decltype(entries_) &entries) {
+    for (const byte *entry : entries) {
+      bloom_filter_.Add(reinterpret_cast<const HashTableEntry *>(entry)->hash_);
+    }
+  };
+
+  // The tuples of a table built in parallel were taken over from the thread-local tables
+  if (owned_.empty()) {
+    add_hashes(entries_);
+  } else {
+    for (const auto &entries : owned_) {
+      add_hashes(entries);
+    }
+  }
+
+  EXECUTION_LOG_DEBUG("JHT: {}", bloom_filter_.DebugString());
+}
+
+void JoinHashTable::FilterBatch(VectorProjection *input, const uint32_t key_cols[], const uint32_t num_key_cols,
+                                TupleIdList *tid_list) const {
+  NOISEPAGE_ASSERT(IsBuilt(), "Cannot filter a batch before table is built!");
+  // The tuples of a spilled table are only built into the table one partition at a time.
+  const bool lookup = !IsSpilled() && GetJoinIndexMemoryUsage() > prefetch_threshold_ && FilterLookupPaysOff();
+  if ((!HasBloomFilter() && !lookup) || tid_list->IsEmpty()) {
+    return;
+  }
+
+  // Hash the keys of the tuples in the list the way @hash() does on the probe side: the first key
+  // is hashed with a zero seed, and every other key is combined with the hash of the keys before.
+  Vector hashes(TypeId::Hash, true, false);
+  for (uint32_t i = 0; i < num_key_cols; i++) {
+    Vector *key = input->GetColumn(key_cols[i]);
+    Vector::TempFilterScope filter(key, tid_list, tid_list->GetTupleCount());
+    if (i == 0) {
+      VectorOps::Hash(*key, &hashes);
+    } else {
+      VectorOps::HashCombine(*key, &hashes);
+    }
+  }
+
+  // Keep the tuples whose hash may be in the filter
+  const auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+  if (HasBloomFilter()) {
+    tid_list->Filter([&](const uint64_t i) { return bloom_filter_.Contains(raw_hashes[i]); });
+  }
+
+  // If the table is out of cache, look up the remaining tuples in a batch and keep the ones that
+  // found a bucket chain. The batched lookup prefetches the chains, so they're in the cache by the
+  // time the tuples are probed one at a time. Count how many tuples the lookup removes, since the
+  // tuples it keeps pay for a second lookup when they're probed.
+  if (lookup && !tid_list->IsEmpty()) {
+    const uint64_t num_looked_up = tid_list->GetTupleCount();
+    Vector entries(TypeId::Pointer, true, false);
+    hashes.SetFilteredTupleIdList(tid_list, tid_list->GetTupleCount());
+    LookupBatch(hashes, &entries);
+    const auto *RESTRICT raw_entries = reinterpret_cast<const HashTableEntry *const *>(entries.GetData());
+    tid_list->Filter([&](const uint64_t i) { return raw_entries[i] != nullptr; });
+    num_filter_lookups_.fetch_add(num_looked_up, std::memory_order_relaxed);
+    num_filter_lookups_removed_.fetch_add(num_looked_up - tid_list->GetTupleCount(), std::memory_order_relaxed);
+  }
+}
+
+bool JoinHashTable::FilterLookupPaysOff() const {
+  const uint64_t num_lookups = num_filter_lookups_.load(std::memory_order_relaxed);
+  if (num_lookups < FILTER_LOOKUP_SAMPLE_SIZE) {
+    return true;
+  }
+  const uint64_t num_removed = num_filter_lookups_removed_.load(std::memory_order_relaxed);
+  return static_cast<double>(num_removed) >= FILTER_LOOKUP_MIN_REMOVED_FRACTION * static_cast<double>(num_lookups);
+}
+
+namespace {
+
+// Look up all active hashes in the input vector with the provided function, and store the found
+// entries in the results vector. The hashes are processed in groups: the directory slots of all
+// hashes in a group are prefetched first, and then every entry that's found is prefetched for the
+// key check that follows. The cache misses within a group are thus overlapped.
+template <bool PrefetchIndex, bool PrefetchEntries, typename P, typename F>
+void GroupPrefetchLookup(const Vector &hashes, Vector *results, P &&prefetch_index, F &&find) {
+  NOISEPAGE_ASSERT(!hashes.IsConstant(), "Batched lookups expect a full vector of hashes");
+  NOISEPAGE_ASSERT(hashes.GetSize() <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Hash vector too large");
+  auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+  auto *RESTRICT raw_results = reinterpret_cast<const HashTableEntry **>(results->GetData());
+
+  results->Resize(hashes.GetSize());
+  results->GetMutableNullMask()->Copy(hashes.GetNullMask());
+  results->SetFilteredTupleIdList(hashes.GetFilteredTupleIdList(), hashes.GetCount());
+
+  // The positions of the active hashes.
+  alignas(common::Constants::CACHELINE_SIZE) sel_t sel_vector[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  uint64_t size = hashes.GetSize();
+  if (const TupleIdList *tid_list = hashes.GetFilteredTupleIdList(); tid_list != nullptr) {
+    size = tid_list->ToSelectionVector(sel_vector);
+  } else {
+    std::iota(sel_vector, sel_vector + size, 0);
+  }
+
+  for (uint64_t group = 0; group < size; group += common::Constants::K_PREFETCH_DISTANCE) {
+    const uint64_t group_end = std::min(size, group + common::Constants::K_PREFETCH_DISTANCE);
+    if constexpr (PrefetchIndex) {  // NOLINT
+      for (uint64_t idx = group; idx < group_end; idx++) {
+        prefetch_index(raw_hashes[sel_vector[idx]]);
+      }
+    }
+    for (uint64_t idx = group; idx < group_end; idx++) {
+      const HashTableEntry *entry = find(raw_hashes[sel_vector[idx]]);
+      if constexpr (PrefetchEntries) {  // NOLINT
+        if (entry != nullptr) {
+          util::Memory::Prefetch<true, Locality::Low>(entry);
+        }
+      }
+      raw_results[sel_vector[idx]] = entry;
+    }
+  }
+}
+
+}  // namespace
+
+template <bool PrefetchIndex, bool PrefetchEntries>
 void JoinHashTable::LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const {
-  UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
-      exec_settings_, hashes,
-      results, [&](const hash_t hash_val) noexcept { return chaining_hash_table_.FindChainHead(hash_val); });
+  GroupPrefetchLookup<PrefetchIndex, PrefetchEntries>(
+      hashes, results, [&](const hash_t hash_val) { ChainingTableFor(hash_val).PrefetchChainHead<true>(hash_val); },
+      [&](const hash_t hash_val) { return ChainingTableFor(hash_val).FindChainHead(hash_val); });
 }
 
+template <bool PrefetchIndex, bool PrefetchEntries>
 void JoinHashTable::LookupBatchInConciseHashTable(const Vector &hashes, Vector *results) const {
-  UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
-      exec_settings_, hashes, results, [&](const hash_t hash_val) noexcept {
+  GroupPrefetchLookup<PrefetchIndex, PrefetchEntries>(
+      hashes, results, [&](const hash_t hash_val) { concise_hash_table_.PrefetchSlotGroup<true>(hash_val); },
+      [&](const hash_t hash_val) {
         const auto [found, entry_idx] = concise_hash_table_.Lookup(hash_val);
         return (found ? EntryAt(entry_idx) : nullptr);
       });
@@ -533,10 +880,30 @@ void JoinHashTable::LookupBatchInConciseHashTable(const Vector &hashes, Vector *
 
 void JoinHashTable::LookupBatch(const Vector &hashes, Vector *results) const {
   NOISEPAGE_ASSERT(IsBuilt(), "Cannot perform lookup before table is built!");
+
+  // Dispatch to internal function based on prefetching requirements, like the
+  // build of a concise table: if the join index is larger than the L3 cache,
+  // prefetch from both the index and the build tuples. If the index fits in
+  // cache, it's still possible that build tuples do not.
+  const bool prefetch_index = GetJoinIndexMemoryUsage() > prefetch_threshold_;
+  const bool prefetch_entries = GetTupleCount() * entries_.ElementSize() > prefetch_threshold_;
+
   if (UsingConciseHashTable()) {
-    LookupBatchInConciseHashTable(hashes, results);
+    if (prefetch_index) {
+      LookupBatchInConciseHashTable<true, true>(hashes, results);
+    } else if (prefetch_entries) {
+      LookupBatchInConciseHashTable<false, true>(hashes, results);
+    } else {
+      LookupBatchInConciseHashTable<false, false>(hashes, results);
+    }
   } else {
-    LookupBatchInChainingHashTable(hashes, results);
+    if (prefetch_index) {
+      LookupBatchInChainingHashTable<true, true>(hashes, results);
+    } else if (prefetch_entries) {
+      LookupBatchInChainingHashTable<false, true>(hashes, results);
+    } else {
+      LookupBatchInChainingHashTable<false, false>(hashes, results);
+    }
   }
 }
 
@@ -553,6 +920,96 @@ void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
   owned_.emplace_back(std::move(source->entries_));
 }
 
+uint32_t JoinHashTable::ComputeRadixBits(const uint64_t num_elem_estimate) const {
+  // A build that fits in the last-level cache gains nothing from partitioning.
+  // Otherwise, use enough partitions for the directory and tuples of each one
+  // to fit in the L2 cache.
+  const uint64_t l2_cache_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+  const uint64_t l3_cache_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
+  const float load_factor = TaggedChainingHashTable::DEFAULT_LOAD_FACTOR;
+  const auto directory_size = static_cast<uint64_t>(num_elem_estimate * sizeof(HashTableEntry *) / load_factor);
+  const uint64_t build_size = directory_size + num_elem_estimate * entries_.ElementSize();
+  if (l2_cache_size == 0 || build_size <= l3_cache_size) {
+    return 0;
+  }
+  const uint64_t num_partitions =
+      common::MathUtil::PowerOf2Ceil(common::MathUtil::DivRoundUp(build_size, l2_cache_size));
+  return std::min(MAX_RADIX_BITS, static_cast<uint32_t>(llvm::Log2_64(num_partitions)));
+}
+
+void JoinHashTable::MergePartitioned(ThreadStateContainer *thread_state_container,
+                                     const std::vector<JoinHashTable *> &sources, const uint32_t radix_bits) {
+  const uint64_t num_partitions = uint64_t{1} << radix_bits;
+  const uint64_t num_sources = sources.size();
+
+  partitions_.clear();
+  partitions_.reserve(num_partitions);
+  for (uint64_t part = 0; part < num_partitions; part++) {
+    partitions_.emplace_back(std::make_unique<TaggedChainingHashTable>());
+  }
+
+  // Step 1: Count the entries of each source falling into each partition.
+  std::vector<uint64_t> offsets(num_sources * num_partitions, 0);
+  tbb::parallel_for(uint64_t{0}, num_sources, [&](const uint64_t src) {
+    uint64_t *const counts = &offsets[src * num_partitions];
+    const auto &entries = sources[src]->entries_;
+    for (uint64_t idx = 0; idx < entries.size(); idx++) {
+      counts[PartitionIndex(reinterpret_cast<const HashTableEntry *>(entries[idx])->hash_)]++;
+    }
+  });
+
+  // Step 2: Turn the counts into write offsets. Partitions are laid out one
+  // after the other, and each source writes its own slice of every partition.
+  std::vector<uint64_t> partition_begin(num_partitions + 1, 0);
+  for (uint64_t part = 0, total = 0; part < num_partitions; part++) {
+    partition_begin[part] = total;
+    for (uint64_t src = 0; src < num_sources; src++) {
+      const uint64_t count = offsets[src * num_partitions + part];
+      offsets[src * num_partitions + part] = total;
+      total += count;
+    }
+    partition_begin[part + 1] = total;
+  }
+
+  // Step 3: Scatter the entries of each source into their partitions.
+  std::vector<HashTableEntry *> partitioned(partition_begin[num_partitions]);
+  tbb::parallel_for(uint64_t{0}, num_sources, [&](const uint64_t src) {
+    uint64_t *const write_offsets = &offsets[src * num_partitions];
+    auto &entries = sources[src]->entries_;
+    for (uint64_t idx = 0; idx < entries.size(); idx++) {
+      auto *entry = reinterpret_cast<HashTableEntry *>(entries[idx]);
+      partitioned[write_offsets[PartitionIndex(entry->hash_)]++] = entry;
+    }
+  });
+
+  // Step 4: Build each partition's table independently. Each is sized exactly
+  // and only touched by one thread, so no synchronization is needed.
+  const uint64_t num_threads = tbb::task_scheduler_init::default_num_threads();
+  exec_ctx_->SetNumConcurrentEstimate(static_cast<uint32_t>(std::min(num_threads, num_partitions)));
+  tbb::parallel_for(uint64_t{0}, num_partitions, [&](const uint64_t part) {
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+    auto *tls = thread_state_container->AccessCurrentThreadState();
+    exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+    const uint64_t size = partition_begin[part + 1] - partition_begin[part];
+    TaggedChainingHashTable *table = partitions_[part].get();
+    table->SetSize(size, tracker_);
+    for (uint64_t idx = partition_begin[part]; idx < partition_begin[part + 1]; idx++) {
+      table->Insert<false>(partitioned[idx]);
+    }
+
+    exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
+  });
+  exec_ctx_->SetNumConcurrentEstimate(0);
+
+  // Finally, take ownership of all source tables' memory
+  common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
+  for (auto *source : sources) {
+    owned_.emplace_back(std::move(source->entries_));
+  }
+}
+
 void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container, const std::size_t jht_offset) {
   // Collect thread-local hash tables
   std::vector<JoinHashTable *> tl_join_tables;
@@ -563,9 +1020,26 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
     hll_estimator_->Merge(jht->hll_estimator_.get());
   }
 
-  // Size the global hash table
   uint64_t num_elem_estimate = hll_estimator_->Estimate();
-  chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
+
+  // If any thread-local table ran out of memory, spill all of them. Tuples are
+  // built into the table one spilled partition at a time, while joining.
+  if (std::any_of(tl_join_tables.cbegin(), tl_join_tables.cend(), [](auto *jht) { return jht->IsSpilled(); })) {
+    EXECUTION_LOG_TRACE("JHT: Thread-local tables exceeded the query memory budget. Spilling all to disk.");
+    for (auto *source : tl_join_tables) {
+      source->SpillBufferedEntries();
+      AdoptSpilledBuild(source);
+    }
+    spilled_ = true;
+    built_ = true;
+    return;
+  }
+
+  // The global table takes over the memory reserved for the thread-local tuples
+  for (auto *source : tl_join_tables) {
+    reserved_memory_ += source->reserved_memory_;
+    source->reserved_memory_ = 0;
+  }
 
   // Resize the owned entries vector now to avoid resizing concurrently during
   // merge. All the thread-local join table data will get placed into our owned
@@ -576,11 +1050,19 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
   timer.Start();
 
   const bool use_serial_build = num_elem_estimate < DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE;
-  if (use_serial_build) {
+  const uint32_t radix_bits = use_serial_build ? 0 : ComputeRadixBits(num_elem_estimate);
+  if (radix_bits > 0) {
+    EXECUTION_LOG_TRACE("JHT: Estimated {} elements exceed the cache. Using {}-way partitioned merge.",
+                        num_elem_estimate, 1u << radix_bits);
+    MergePartitioned(thread_state_container, tl_join_tables, radix_bits);
+  } else if (use_serial_build) {
     // TODO(pmenon): Switch to parallel-mode if estimate is wrong.
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements < {} element parallel threshold. Using serial merge.",
                         num_elem_estimate, DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE);
 
+    // Size the global hash table
+    chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
+
     auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
     auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
     auto *tls = thread_state_container->AccessCurrentThreadState();
@@ -593,6 +1075,9 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements >= {} element parallel threshold. Using parallel merge.",
                         num_elem_estimate, DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE);
 
+    // Size the global hash table
+    chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
+
     size_t num_threads = tbb::task_scheduler_init::default_num_threads();
     size_t num_tasks = tl_join_tables.size();
     auto estimate = std::min(num_threads, num_tasks);
@@ -612,10 +1097,15 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
 
   timer.Stop();
 
-  UNUSED_ATTRIBUTE const double tps = (chaining_hash_table_.GetElementCount() / timer.GetElapsed()) / 1000.0;
+  UNUSED_ATTRIBUTE const uint64_t num_merged = GetTupleCount();
+  UNUSED_ATTRIBUTE const double tps = (num_merged / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("JHT: {} merged {} JHTs. Estimated {}, actual {}. Time: {:.2f} ms ({:.2f} mtps)",
-                      use_serial_build ? "Serial" : "Parallel", tl_join_tables.size(), num_elem_estimate,
-                      chaining_hash_table_.GetElementCount(), timer.GetElapsed(), tps);
+                      radix_bits > 0 ? "Partitioned" : (use_serial_build ? "Serial" : "Parallel"),
+                      tl_join_tables.size(), num_elem_estimate, num_merged, timer.GetElapsed(), tps);
+
+  if (use_bloom_filter_) {
+    BuildBloomFilter();
+  }
 
   built_ = true;
 }
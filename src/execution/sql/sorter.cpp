@@ -1,17 +1,22 @@
 #include "execution/sql/sorter.h"
 
 #include <llvm/ADT/STLExtras.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
+#include "execution/util/timer.h"
 #include "ips4o/ips4o.hpp"
 #include "loggers/execution_logger.h"
 #include "self_driving/modeling/operating_unit.h"
@@ -32,17 +37,97 @@ Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint
       owned_tuples_(exec_ctx->GetMemoryPool()),
       cmp_fn_(cmp_fn),
       tuples_(exec_ctx->GetMemoryPool()),
-      sorted_(false) {}
+      sorted_(false) {
+  if (exec_ctx->GetExecutionSettings().GetQueryMemoryBudget() > 0) {
+    reserved_tuples_ = 0;
+  }
+}
 
-Sorter::~Sorter() = default;
+Sorter::~Sorter() {
+  if (reserved_memory_ > 0) {
+    exec_ctx_->ReleaseMemory(reserved_memory_);
+  }
+}
 
 byte *Sorter::AllocInputTuple() {
+  // Make sure the tuple is covered by the memory reservation
+  if (UNLIKELY(tuples_.size() == reserved_tuples_)) {
+    ReserveMemory();
+  }
+  return AllocBufferedTuple();
+}
+
+byte *Sorter::AllocBufferedTuple() {
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+void Sorter::ReserveMemory() {
+  // Buffered tuples take up their storage and an entry in the vector that's sorted
+  const uint64_t tuple_size = tuple_storage_.ElementSize() + sizeof(const byte *);
+  const uint64_t num_tuples = std::max(uint64_t{1}, MEMORY_RESERVATION_SIZE / tuple_size);
+  const uint64_t size = num_tuples * tuple_size;
+
+  if (!exec_ctx_->TryReserveMemory(size)) {
+    EXECUTION_LOG_TRACE("Sorter: Query memory budget exhausted after {} tuples. Spilling a run.", tuples_.size());
+    SpillRun();
+    // Every run buffers at least one reservation's worth of tuples, even when
+    // other operators hold the entire budget
+    if (!exec_ctx_->TryReserveMemory(size)) {
+      reserved_tuples_ += num_tuples;
+      return;
+    }
+  }
+
+  reserved_memory_ += size;
+  reserved_tuples_ += num_tuples;
+}
+
+void Sorter::SpillRun() {
+  if (tuples_.empty()) {
+    return;
+  }
+
+  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+
+  const std::size_t tuple_size = tuple_storage_.ElementSize();
+  auto run = std::make_unique<SpillFile>(tuple_size);
+  for (const byte *tuple : tuples_) {
+    std::memcpy(run->Append(), tuple, tuple_size);
+  }
+  num_spilled_tuples_ += tuples_.size();
+  runs_.emplace_back(std::move(run));
+
+  ReleaseBufferedTuples();
+}
+
+void Sorter::ReleaseBufferedTuples() {
+  // Assigning a fresh vector hands the chunks back to the memory pool, unlike clear()
+  tuple_storage_ = decltype(tuple_storage_)(tuple_storage_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+  tuples_.clear();
+  tuples_.shrink_to_fit();
+  reserved_tuples_ = 0;
+  if (reserved_memory_ > 0) {
+    exec_ctx_->ReleaseMemory(reserved_memory_);
+    reserved_memory_ = 0;
+  }
+}
+
+void Sorter::AdoptSpilledRuns(Sorter *source) {
+  for (auto &run : source->runs_) {
+    runs_.emplace_back(std::move(run));
+  }
+  source->runs_.clear();
+  num_spilled_tuples_ += source->num_spilled_tuples_;
+  source->num_spilled_tuples_ = 0;
+}
+
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) {
+  // Top-K only ever buffers K tuples, so it is never spilled
+  return AllocBufferedTuple();
+}
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done.
@@ -113,6 +198,14 @@ void Sorter::Sort() {
     return;
   }
 
+  // Write out the remaining tuples as the final run. Iterators merge the runs.
+  if (IsSpilled()) {
+    SpillRun();
+    EXECUTION_LOG_DEBUG("Sorted {} tuples into {} runs on disk", num_spilled_tuples_, runs_.size());
+    sorted_ = true;
+    return;
+  }
+
   // Exit if there are no input tuples
   if (tuples_.empty()) {
     return;
@@ -167,6 +260,12 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
     return;
   }
 
+  // If any thread-local sorter ran out of memory, all of them write out runs
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(), [](const Sorter *sorter) { return sorter->IsSpilled(); })) {
+    SortParallelSpilled(thread_state_container, tl_sorters);
+    return;
+  }
+
   const uint64_t num_tuples =
       std::accumulate(tl_sorters.begin(), tl_sorters.end(), uint64_t(0),
                       [](const auto partial, const auto *sorter) { return partial + sorter->GetTupleCount(); });
@@ -190,6 +289,7 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
       tuples_.insert(tuples_.end(), tl_sorter->tuples_.begin(), tl_sorter->tuples_.end());
       owned_tuples_.emplace_back(std::move(tl_sorter->tuple_storage_));
       tl_sorter->tuples_.clear();
+      reserved_memory_ += std::exchange(tl_sorter->reserved_memory_, 0);
     }
 
     // Single-threaded sort
@@ -404,6 +504,7 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   for (auto *tl_sorter : tl_sorters) {
     owned_tuples_.emplace_back(std::move(tl_sorter->tuple_storage_));
     tl_sorter->tuples_.clear();
+    reserved_memory_ += std::exchange(tl_sorter->reserved_memory_, 0);
   }
 
   timer.ExitStage();
@@ -421,9 +522,49 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   }
 }
 
+void Sorter::SortParallelSpilled(ThreadStateContainer *thread_state_container,
+                                 const std::vector<Sorter *> &tl_sorters) {
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  // Sort and write out the buffered tuples of every thread-local sorter in parallel
+  tbb::task_scheduler_init sched;
+  {
+    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+    size_t num_tasks = tl_sorters.size();
+    size_t num_concurrent = std::min(num_threads, num_tasks);
+    exec_ctx_->SetNumConcurrentEstimate(num_concurrent);
+  }
+
+  tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
+    auto *tls = thread_state_container->AccessCurrentThreadState();
+    auto *exec_ctx = this->exec_ctx_;
+    exec_ctx->InvokeHook(pre_hook, tls, nullptr);
+
+    sorter->SpillRun();
+
+    exec_ctx->InvokeHook(post_hook, tls, nullptr);
+  });
+
+  exec_ctx_->SetNumConcurrentEstimate(0);
+
+  // Take ownership of all runs. They are merged when iterated.
+  for (auto *tl_sorter : tl_sorters) {
+    AdoptSpilledRuns(tl_sorter);
+  }
+  sorted_ = true;
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Sorted {} tuples into {} runs on disk in {} ms", num_spilled_tuples_, runs_.size(),
+                      timer.GetElapsed());
+}
+
 void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k) {
   // Parallel sort
   SortParallel(thread_state_container, sorter_offset);
+  NOISEPAGE_ASSERT(!IsSpilled(), "Top-K sorters are never spilled");
 
   // Trim to top-K
   if (top_k < GetTupleCount()) {
@@ -431,15 +572,159 @@ void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint
   }
 }
 
+void Sorter::ParallelScan(void *const query_state, ThreadStateContainer *const thread_states,
+                          const Sorter::ScanRangeFn scan_fn) const {
+  NOISEPAGE_ASSERT(IsSorted() || IsEmpty(), "Sorter must be sorted before it is scanned");
+
+  // The merge of spilled runs cannot be split, so it's done on this thread
+  if (IsSpilled()) {
+    SorterIterator iter(*this);
+    scan_fn(query_state, thread_states->AccessCurrentThreadState(), &iter);
+    return;
+  }
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const uint64_t num_tuples = tuples_.size();
+  const uint64_t num_ranges = common::MathUtil::DivRoundUp(num_tuples, PARALLEL_SCAN_RANGE_SIZE);
+  size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+  size_t concurrent_estimate = std::min(num_threads, num_ranges);
+  exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
+
+  // Output produced by a range is held back until the ranges before it have been output
+  exec::OrderedOutput output(exec_ctx_, num_ranges, exec_ctx_->GetOutputCallback());
+  const auto scan_range = [&](const uint64_t range) {
+    const uint64_t begin = range * PARALLEL_SCAN_RANGE_SIZE;
+    const uint64_t end = std::min(begin + PARALLEL_SCAN_RANGE_SIZE, num_tuples);
+    SorterIterator iter(*this, begin, end);
+    scan_fn(query_state, thread_states->AccessCurrentThreadState(), &iter);
+  };
+  tbb::parallel_for(uint64_t{0}, num_ranges, [&](const uint64_t range) { output.Produce(range, scan_range); });
+  output.Finish(scan_range);
+
+  exec_ctx_->SetNumConcurrentEstimate(0);
+  timer.Stop();
+
+  UNUSED_ATTRIBUTE double tps = (num_tuples / timer.GetElapsed()) / 1000.0;
+  EXECUTION_LOG_TRACE("Scanned {} ranges totalling {} tuples in {:.2f} ms ({:.2f} mtps)", num_ranges, num_tuples,
+                      timer.GetElapsed(), tps);
+}
+
+void Sorter::ParallelScanPartitions(void *const query_state, ThreadStateContainer *const thread_states,
+                                    const Sorter::ComparisonFunction partition_fn,
+                                    const Sorter::ScanPartitionsFn scan_fn) const {
+  NOISEPAGE_ASSERT(IsSorted() || IsEmpty(), "Sorter must be sorted before it is scanned");
+
+  // The merge of spilled runs cannot be split, so it's done on this thread
+  if (IsSpilled()) {
+    SorterIterator iter(*this), lead(*this);
+    scan_fn(query_state, thread_states->AccessCurrentThreadState(), &iter, &lead);
+    return;
+  }
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  // Find the range boundaries. Every range ends at the first partition boundary at or after its
+  // nominal size.
+  const uint64_t num_tuples = tuples_.size();
+  std::vector<uint64_t> bounds{0};
+  for (uint64_t end = PARALLEL_SCAN_RANGE_SIZE; end < num_tuples; end = bounds.back() + PARALLEL_SCAN_RANGE_SIZE) {
+    while (end < num_tuples && partition_fn(tuples_[end - 1], tuples_[end]) == 0) {
+      end++;
+    }
+    if (end == num_tuples) {
+      break;
+    }
+    bounds.push_back(end);
+  }
+  bounds.push_back(num_tuples);
+
+  const uint64_t num_ranges = bounds.size() - 1;
+  size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+  size_t concurrent_estimate = std::min(num_threads, num_ranges);
+  exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
+
+  // Output produced by a range is held back until the ranges before it have been output
+  exec::OrderedOutput output(exec_ctx_, num_ranges, exec_ctx_->GetOutputCallback());
+  const auto scan_range = [&](const uint64_t range) {
+    SorterIterator iter(*this, bounds[range], bounds[range + 1]), lead(*this, bounds[range], bounds[range + 1]);
+    scan_fn(query_state, thread_states->AccessCurrentThreadState(), &iter, &lead);
+  };
+  tbb::parallel_for(uint64_t{0}, num_ranges, [&](const uint64_t range) { output.Produce(range, scan_range); });
+  output.Finish(scan_range);
+
+  exec_ctx_->SetNumConcurrentEstimate(0);
+  timer.Stop();
+
+  UNUSED_ATTRIBUTE double tps = (num_tuples / timer.GetElapsed()) / 1000.0;
+  EXECUTION_LOG_TRACE("Scanned {} partition ranges totalling {} tuples in {:.2f} ms ({:.2f} mtps)", num_ranges,
+                      num_tuples, timer.GetElapsed(), tps);
+}
+
 //===----------------------------------------------------------------------===//
 //
 // Sorter Iterator
 //
 //===----------------------------------------------------------------------===//
 
-SorterIterator::SorterIterator(const Sorter &sorter) : iter_(sorter.tuples_.begin()), end_(sorter.tuples_.end()) {}
+SorterIterator::SorterIterator(const Sorter &sorter)
+    : iter_(sorter.tuples_.begin()),
+      end_(sorter.tuples_.end()),
+      merging_(sorter.IsSpilled()),
+      cmp_fn_(sorter.cmp_fn_) {
+  if (!merging_) {
+    return;
+  }
+
+  NOISEPAGE_ASSERT(sorter.IsSorted(), "Spilled sorters must be sorted before they are iterated");
+  readers_.reserve(sorter.runs_.size());
+  heap_.reserve(sorter.runs_.size());
+  for (const auto &run : sorter.runs_) {
+    run->Finish();
+    auto &reader = readers_.emplace_back(std::make_unique<SpillFile::Reader>(*run));
+    if (const byte *row = reader->Next(); row != nullptr) {
+      heap_.push_back(MergeEntry{row, reader.get()});
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), [this](const MergeEntry &l, const MergeEntry &r) {
+    return cmp_fn_(l.row_, r.row_) > 0;
+  });
+  num_merge_remaining_ = sorter.num_spilled_tuples_;
+}
+
+SorterIterator::SorterIterator(const Sorter &sorter, const uint64_t begin, const uint64_t end)
+    : iter_(sorter.tuples_.begin() + begin),
+      end_(sorter.tuples_.begin() + end),
+      merging_(false),
+      cmp_fn_(sorter.cmp_fn_) {
+  NOISEPAGE_ASSERT(!sorter.IsSpilled(), "Spilled sorters can only be iterated as a whole");
+  NOISEPAGE_ASSERT(begin <= end && end <= sorter.tuples_.size(), "Invalid range");
+}
+
+void SorterIterator::NextMerged() {
+  const auto heap_cmp = [this](const MergeEntry &l, const MergeEntry &r) { return cmp_fn_(l.row_, r.row_) > 0; };
+
+  // Replace the smallest row with the next row of its run
+  std::pop_heap(heap_.begin(), heap_.end(), heap_cmp);
+  MergeEntry &entry = heap_.back();
+  entry.row_ = entry.run_->Next();
+  if (entry.row_ == nullptr) {
+    heap_.pop_back();
+  } else {
+    std::push_heap(heap_.begin(), heap_.end(), heap_cmp);
+  }
+  num_merge_remaining_--;
+}
 
 void SorterIterator::AdvanceBy(uint64_t n) {
+  if (merging_) {
+    for (n = std::min(n, num_merge_remaining_); n > 0; n--) {
+      NextMerged();
+    }
+    return;
+  }
   if (n > NumRemaining()) {
     iter_ = end_;
     return;
@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/sql/sorter.h"
@@ -11,9 +14,21 @@ namespace noisepage::execution::sql {
 SorterVectorIterator::SorterVectorIterator(const Sorter &sorter,
                                            const std::vector<const catalog::Schema::Column *> &column_info,
                                            const SorterVectorIterator::TransposeFn transpose_fn)
+    : SorterVectorIterator(sorter, SorterIterator(sorter), column_info, transpose_fn) {}
+
+SorterVectorIterator::SorterVectorIterator(const Sorter &sorter, const uint64_t begin, const uint64_t end,
+                                           const std::vector<const catalog::Schema::Column *> &column_info,
+                                           const SorterVectorIterator::TransposeFn transpose_fn)
+    : SorterVectorIterator(sorter, SorterIterator(sorter, begin, end), column_info, transpose_fn) {}
+
+SorterVectorIterator::SorterVectorIterator(const Sorter &sorter, SorterIterator iter,
+                                           const std::vector<const catalog::Schema::Column *> &column_info,
+                                           const SorterVectorIterator::TransposeFn transpose_fn)
     : memory_(sorter.memory_),
-      iter_(sorter),
+      iter_(std::move(iter)),
       temp_rows_(memory_->AllocateArray<const byte *>(common::Constants::K_DEFAULT_VECTOR_SIZE, false)),
+      tuple_size_(sorter.tuple_storage_.ElementSize()),
+      row_buffer_(nullptr),
       vector_projection_(std::make_unique<VectorProjection>()),
       vector_projection_iterator_(std::make_unique<VectorProjectionIterator>()) {
   // First, initialize the vector projection
@@ -24,6 +39,11 @@ SorterVectorIterator::SorterVectorIterator(const Sorter &sorter,
   }
   vector_projection_->Initialize(col_types);
 
+  if (sorter.IsSpilled()) {
+    const std::size_t buffer_size = common::Constants::K_DEFAULT_VECTOR_SIZE * tuple_size_;
+    row_buffer_ = memory_->AllocateArray<byte>(buffer_size, alignof(std::max_align_t), false);
+  }
+
   // Now, move the iterator to the next valid position
   Next(transpose_fn);
 }
@@ -34,6 +54,9 @@ SorterVectorIterator::SorterVectorIterator(const Sorter &sorter, const catalog::
 
 SorterVectorIterator::~SorterVectorIterator() {
   memory_->DeallocateArray(temp_rows_, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  if (row_buffer_ != nullptr) {
+    memory_->DeallocateArray(row_buffer_, common::Constants::K_DEFAULT_VECTOR_SIZE * tuple_size_);
+  }
 }
 
 bool SorterVectorIterator::HasNext() const { return vector_projection_->GetSelectedTupleCount() > 0; }
@@ -41,8 +64,17 @@ bool SorterVectorIterator::HasNext() const { return vector_projection_->GetSelec
 void SorterVectorIterator::Next(const SorterVectorIterator::TransposeFn transpose_fn) {
   // Pull rows into temporary array
   uint32_t size = std::min(iter_.NumRemaining(), static_cast<uint64_t>(common::Constants::K_DEFAULT_VECTOR_SIZE));
-  for (uint32_t i = 0; i < size; ++i, ++iter_) {
-    temp_rows_[i] = iter_.GetRow();
+  if (row_buffer_ != nullptr) {
+    // Merged rows are only valid until the iterator advances, so copy them out
+    for (uint32_t i = 0; i < size; ++i, ++iter_) {
+      byte *row = row_buffer_ + i * tuple_size_;
+      std::memcpy(row, iter_.GetRow(), tuple_size_);
+      temp_rows_[i] = row;
+    }
+  } else {
+    for (uint32_t i = 0; i < size; ++i, ++iter_) {
+      temp_rows_[i] = iter_.GetRow();
+    }
   }
 
   // Setup vector projection
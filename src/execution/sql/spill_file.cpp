@@ -0,0 +1,113 @@
+#include "execution/sql/spill_file.h"
+
+#include <algorithm>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+
+namespace noisepage::execution::sql {
+
+SpillFile::SpillFile(const std::size_t record_size)
+    : record_size_(record_size),
+      buffer_capacity_(std::max(std::size_t{1}, BUFFER_SIZE / record_size)),
+      buffer_(buffer_capacity_ * record_size) {
+  NOISEPAGE_ASSERT(record_size > 0, "Records cannot be empty");
+}
+
+byte *SpillFile::Append() {
+  NOISEPAGE_ASSERT(writing_, "Cannot append to a spill file that has been rewound");
+  if (buffered_records_ == buffer_capacity_) {
+    FlushBuffer();
+  }
+  num_records_++;
+  return &buffer_[buffered_records_++ * record_size_];
+}
+
+void SpillFile::FlushBuffer() {
+  if (!file_.IsOpen()) {
+    file_.CreateTemp(true);
+    if (file_.HasError()) {
+      throw EXECUTION_EXCEPTION("Unable to create a temporary file to spill to.", common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+  }
+  const std::size_t len = buffered_records_ * record_size_;
+  if (file_.WriteFull(buffer_.data(), len) != static_cast<int32_t>(len)) {
+    throw EXECUTION_EXCEPTION("Unable to write to spill file.", common::ErrorCode::ERRCODE_DISK_FULL);
+  }
+  buffered_records_ = 0;
+}
+
+void SpillFile::Finish() {
+  if (!writing_) {
+    return;
+  }
+  writing_ = false;
+  // Records that never left the buffer are read straight from it
+  if (file_.IsOpen()) {
+    FlushBuffer();
+  }
+}
+
+void SpillFile::Rewind() {
+  Finish();
+  if (file_.IsOpen()) {
+    file_.Seek(util::File::Whence::FROM_BEGIN, 0);
+    buffered_records_ = 0;
+  }
+  buffer_cursor_ = 0;
+  num_read_ = 0;
+}
+
+void SpillFile::FillBuffer() {
+  const auto num_records = static_cast<std::size_t>(std::min<uint64_t>(buffer_capacity_, num_records_ - num_read_));
+  const std::size_t len = num_records * record_size_;
+  if (file_.ReadFull(buffer_.data(), len) != static_cast<int32_t>(len)) {
+    throw EXECUTION_EXCEPTION("Unable to read from spill file.", common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+  buffered_records_ = num_records;
+  buffer_cursor_ = 0;
+}
+
+byte *SpillFile::Next() {
+  NOISEPAGE_ASSERT(!writing_, "Spill file must be rewound before it is read");
+  if (num_read_ == num_records_) {
+    return nullptr;
+  }
+  if (buffer_cursor_ == buffered_records_) {
+    FillBuffer();
+  }
+  num_read_++;
+  return &buffer_[buffer_cursor_++ * record_size_];
+}
+
+SpillFile::Reader::Reader(const SpillFile &file) : file_(file) {
+  NOISEPAGE_ASSERT(!file.writing_, "Spill file must be done being written before it is read");
+  if (file.IsOnDisk()) {
+    buffer_.resize(file.buffer_capacity_ * file.record_size_);
+  }
+}
+
+const byte *SpillFile::Reader::Next() {
+  if (num_read_ == file_.num_records_) {
+    return nullptr;
+  }
+  // Records that never left the buffer of the file are read straight from it
+  if (!file_.IsOnDisk()) {
+    return &file_.buffer_[num_read_++ * file_.record_size_];
+  }
+  if (buffer_cursor_ == buffered_records_) {
+    const auto num_records =
+        static_cast<std::size_t>(std::min<uint64_t>(file_.buffer_capacity_, file_.num_records_ - num_read_));
+    const std::size_t len = num_records * file_.record_size_;
+    if (file_.file_.ReadFullFromPosition(num_read_ * file_.record_size_, buffer_.data(), len) !=
+        static_cast<int32_t>(len)) {
+      throw EXECUTION_EXCEPTION("Unable to read from spill file.", common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+    buffered_records_ = num_records;
+    buffer_cursor_ = 0;
+  }
+  num_read_++;
+  return &buffer_[buffer_cursor_++ * file_.record_size_];
+}
+
+}  // namespace noisepage::execution::sql
@@ -1,9 +1,13 @@
 #include "execution/sql/storage_interface.h"
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "common/error/exception.h"
+#include "common/math_util.h"
 #include "execution/exec/execution_context.h"
 #include "execution/util/execution_common.h"
 #include "storage/index/index.h"
@@ -12,13 +16,14 @@
 namespace noisepage::execution::sql {
 
 StorageInterface::StorageInterface(exec::ExecutionContext *exec_ctx, catalog::table_oid_t table_oid, uint32_t *col_oids,
-                                   uint32_t num_oids, bool need_indexes)
+                                   uint32_t num_oids, bool need_indexes, bool batched)
     : table_oid_{table_oid},
       table_(exec_ctx->GetAccessor()->GetTable(table_oid)),
       exec_ctx_(exec_ctx),
       col_oids_(col_oids, col_oids + num_oids),
       need_indexes_(need_indexes),
-      pri_(num_oids > 0 ? table_->InitializerForProjectedRow(col_oids_) : storage::ProjectedRowInitializer()) {
+      pri_(num_oids > 0 ? table_->InitializerForProjectedRow(col_oids_) : storage::ProjectedRowInitializer()),
+      batched_(batched) {
   // Initialize the index projected row if needed.
   if (need_indexes_) {
     // Get index pr size
@@ -26,25 +31,53 @@ StorageInterface::StorageInterface(exec::ExecutionContext *exec_ctx, catalog::ta
     auto index_oids = exec_ctx->GetAccessor()->GetIndexOids(table_oid);
     for (auto index_oid : index_oids) {
       auto index_ptr = exec_ctx->GetAccessor()->GetIndex(index_oid);
+      indexes_.emplace_back(index_oid, index_ptr);
       max_pr_size_ = std::max(max_pr_size_, index_ptr->GetProjectedRowInitializer().ProjectedRowSize());
     }
     // Allocate pr buffer.
     index_pr_buffer_ = exec_ctx->GetMemoryPool()->AllocateAligned(max_pr_size_, alignof(uint64_t), false);
   }
+
+  // Allocate the buffer rows are filled in, if rows are written at all.
+  if (batched_ && num_oids > 0) {
+    row_size_ = static_cast<uint32_t>(common::MathUtil::AlignTo(pri_.ProjectedRowSize(), alignof(uint64_t)));
+    row_buffer_ = reinterpret_cast<byte *>(
+        exec_ctx->GetMemoryPool()->AllocateAligned(row_size_ * BATCH_SIZE, alignof(uint64_t), false));
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+      rows_.push_back(reinterpret_cast<storage::ProjectedRow *>(row_buffer_ + i * row_size_));
+    }
+    insert_rows_.resize(BATCH_SIZE);
+    insert_slots_.resize(BATCH_SIZE);
+  }
 }
 
 StorageInterface::~StorageInterface() {
   if (need_indexes_) exec_ctx_->GetMemoryPool()->Deallocate(index_pr_buffer_, max_pr_size_);
+  if (row_buffer_ != nullptr) exec_ctx_->GetMemoryPool()->Deallocate(row_buffer_, row_size_ * BATCH_SIZE);
 }
 
 storage::ProjectedRow *StorageInterface::GetTablePR() {
+  if (batched_) {
+    // The row is only staged in the transaction when the batch is flushed.
+    if (table_writes_.size() >= BATCH_SIZE) Flush();
+    return pri_.InitializeRow(rows_[num_rows_]);
+  }
   auto txn = exec_ctx_->GetTxn();
   table_redo_ = txn->StageWrite(exec_ctx_->DBOid(), table_oid_, pri_);
   return table_redo_->Delta();
 }
 
+common::ManagedPointer<storage::index::Index> StorageInterface::LookupIndex(catalog::index_oid_t index_oid) {
+  for (const auto &[oid, index] : indexes_) {
+    if (oid == index_oid) return index;
+  }
+  auto index = exec_ctx_->GetAccessor()->GetIndex(index_oid);
+  if (index != nullptr) indexes_.emplace_back(index_oid, index);
+  return index;
+}
+
 storage::ProjectedRow *StorageInterface::GetIndexPR(catalog::index_oid_t index_oid) {
-  curr_index_ = exec_ctx_->GetAccessor()->GetIndex(index_oid);
+  curr_index_ = LookupIndex(index_oid);
   // index is created after the initialization of storage interface
   if (curr_index_ != nullptr && !need_indexes_) {
     max_pr_size_ = curr_index_->GetProjectedRowInitializer().ProjectedRowSize();
@@ -55,7 +88,16 @@ storage::ProjectedRow *StorageInterface::GetIndexPR(catalog::index_oid_t index_o
   return index_pr_;
 }
 
-storage::TupleSlot StorageInterface::TableInsert() { return table_->Insert(exec_ctx_->GetTxn(), table_redo_); }
+storage::TupleSlot StorageInterface::TableInsert() {
+  NOISEPAGE_ASSERT(!batched_, "A batched storage interface only knows the slot of a row once it is flushed");
+  return table_->Insert(exec_ctx_->GetTxn(), table_redo_);
+}
+
+void StorageInterface::TableInsertBatched() {
+  NOISEPAGE_ASSERT(batched_, "Only a batched storage interface buffers inserts");
+  last_insert_ = static_cast<uint32_t>(table_writes_.size());
+  table_writes_.push_back({BufferedWriteType::INSERT, num_rows_++, storage::TupleSlot()});
+}
 
 uint32_t StorageInterface::GetIndexHeapSize() {
   NOISEPAGE_ASSERT(curr_index_ != nullptr, "Index must have been loaded");
@@ -63,12 +105,21 @@ uint32_t StorageInterface::GetIndexHeapSize() {
 }
 
 bool StorageInterface::TableDelete(storage::TupleSlot table_tuple_slot) {
+  if (batched_) {
+    if (table_writes_.size() >= BATCH_SIZE) Flush();
+    table_writes_.push_back({BufferedWriteType::DELETE, 0, table_tuple_slot});
+    return true;
+  }
   auto txn = exec_ctx_->GetTxn();
   txn->StageDelete(exec_ctx_->DBOid(), table_oid_, table_tuple_slot);
   return table_->Delete(exec_ctx_->GetTxn(), table_tuple_slot);
 }
 
 bool StorageInterface::TableUpdate(storage::TupleSlot table_tuple_slot) {
+  if (batched_) {
+    table_writes_.push_back({BufferedWriteType::UPDATE, num_rows_++, table_tuple_slot});
+    return true;
+  }
   table_redo_->SetTupleSlot(table_tuple_slot);
   return table_->Update(exec_ctx_->GetTxn(), table_redo_);
 }
@@ -77,25 +128,124 @@ uint64_t StorageInterface::IndexGetSize() const { return curr_index_->GetSize();
 
 bool StorageInterface::IndexInsert() {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
+  if (batched_) {
+    NOISEPAGE_ASSERT(last_insert_ != NO_WRITE || last_insert_slot_ != storage::TupleSlot(),
+                     "Keys are inserted after their row");
+    BufferIndexWrite(true, last_insert_, last_insert_slot_);
+    return true;
+  }
   return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
 }
 
 bool StorageInterface::IndexInsertUnique() {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
+  if (batched_) {
+    // A violation has to be found at the row that causes it, so the key is inserted right away. The buffered writes go
+    // first, which gives the row its slot.
+    common::SpinLatch::ScopedSpinLatch guard(exec_ctx_->GetTxnLatch());
+    ApplyBufferedWrites();
+    NOISEPAGE_ASSERT(last_insert_slot_ != storage::TupleSlot(), "Keys are inserted after their row");
+    return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, last_insert_slot_);
+  }
   return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
 }
 
 void StorageInterface::IndexDelete(storage::TupleSlot table_tuple_slot) {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
+  if (batched_) {
+    BufferIndexWrite(false, NO_WRITE, table_tuple_slot);
+    return;
+  }
   curr_index_->Delete(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
 }
 
 bool StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique) {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
+  if (batched_) {
+    if (!unique) {
+      BufferIndexWrite(true, NO_WRITE, table_tuple_slot);
+      return true;
+    }
+    // As in IndexInsertUnique, the key is inserted right away, after the buffered writes.
+    common::SpinLatch::ScopedSpinLatch guard(exec_ctx_->GetTxnLatch());
+    ApplyBufferedWrites();
+    return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+  }
   if (unique) {
     return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
   }
   return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
 }
 
+void StorageInterface::BufferIndexWrite(bool insert, uint32_t table_write, storage::TupleSlot slot) {
+  const uint32_t key_size = index_pr_->Size();
+  const std::size_t key_offset = key_buffer_.size();
+  key_buffer_.resize(key_offset + common::MathUtil::DivRoundUp(key_size, sizeof(uint64_t)));
+  std::memcpy(&key_buffer_[key_offset], index_pr_, key_size);
+  index_writes_.push_back({curr_index_.Get(), insert, table_write, slot, key_offset});
+}
+
+void StorageInterface::Flush() {
+  if (table_writes_.empty() && index_writes_.empty()) return;
+  common::SpinLatch::ScopedSpinLatch guard(exec_ctx_->GetTxnLatch());
+  ApplyBufferedWrites();
+}
+
+void StorageInterface::ApplyBufferedWrites() {
+  auto txn = exec_ctx_->GetTxn();
+
+  // Insert the new rows into the table together, claiming runs of slots rather than one slot per row.
+  uint32_t num_inserts = 0;
+  for (const auto &write : table_writes_) {
+    if (write.type_ == BufferedWriteType::INSERT) insert_rows_[num_inserts++] = rows_[write.row_];
+  }
+  if (num_inserts > 0) table_->InsertBatch(txn, insert_rows_.data(), num_inserts, insert_slots_.data());
+
+  // Log the table writes and apply the others in the order they were made.
+  bool success = true;
+  uint32_t next_insert = 0;
+  for (auto &write : table_writes_) {
+    if (write.type_ == BufferedWriteType::DELETE) {
+      txn->StageDelete(exec_ctx_->DBOid(), table_oid_, write.slot_);
+      success = table_->Delete(txn, write.slot_);
+    } else {
+      if (write.type_ == BufferedWriteType::INSERT) write.slot_ = insert_slots_[next_insert++];
+      auto *redo = txn->StageWrite(exec_ctx_->DBOid(), table_oid_, pri_);
+      std::memcpy(redo->Delta(), rows_[write.row_], pri_.ProjectedRowSize());
+      redo->SetTupleSlot(write.slot_);
+      if (write.type_ == BufferedWriteType::UPDATE) success = table_->Update(txn, redo);
+    }
+    if (!success) break;
+  }
+  if (last_insert_ != NO_WRITE) {
+    last_insert_slot_ = table_writes_[last_insert_].slot_;
+    last_insert_ = NO_WRITE;
+  }
+
+  // Update the indexes one after the other.
+  std::stable_sort(index_writes_.begin(), index_writes_.end(),
+                   [](const BufferedIndexWrite &a, const BufferedIndexWrite &b) {
+                     return std::less<storage::index::Index *>()(a.index_, b.index_);
+                   });
+  for (auto write = index_writes_.cbegin(); success && write != index_writes_.cend(); write++) {
+    const auto &key = *reinterpret_cast<const storage::ProjectedRow *>(&key_buffer_[write->key_offset_]);
+    const auto slot = write->table_write_ == NO_WRITE ? write->slot_ : table_writes_[write->table_write_].slot_;
+    if (write->insert_) {
+      success = write->index_->Insert(txn, key, slot);
+    } else {
+      write->index_->Delete(txn, key, slot);
+    }
+  }
+
+  table_writes_.clear();
+  num_rows_ = 0;
+  index_writes_.clear();
+  key_buffer_.clear();
+
+  if (!success) {
+    txn->SetMustAbort();
+    throw ABORT_EXCEPTION("transaction aborted");
+  }
+}
+
 }  // namespace noisepage::execution::sql
@@ -90,7 +90,14 @@ void VectorProjection::CopySelectionsTo(TupleIdList *tid_list) const {
   tid_list->AssignFrom(owned_tid_list_);
 }
 
+void VectorProjection::InPlaceReadReleaser::operator()(storage::RawBlock *block) const {
+  block->controller_.ReleaseInPlaceRead();
+}
+
 void VectorProjection::Reset(uint64_t num_tuples) {
+  // Child vectors are about to stop referencing any block read in place
+  in_place_block_.reset();
+
   // Reset the cached TID list to NULL indicating all TIDs are active
   filter_ = nullptr;
 
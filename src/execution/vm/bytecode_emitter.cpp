@@ -326,6 +326,11 @@ void BytecodeEmitter::EmitAggHashTableProcessBatch(LocalVar agg_ht, LocalVar vpi
           partitioned);
 }
 
+void BytecodeEmitter::EmitJoinHashTableFilterBatch(LocalVar join_hash_table, LocalVar vector_projection,
+                                                   LocalVar tid_list, LocalVar key_cols, uint32_t num_key_cols) {
+  EmitAll(Bytecode::JoinHashTableFilterBatch, join_hash_table, vector_projection, tid_list, key_cols, num_key_cols);
+}
+
 void BytecodeEmitter::EmitAggHashTableMovePartitions(LocalVar agg_ht, LocalVar tls, LocalVar aht_offset,
                                                      FunctionId merge_part_fn) {
   EmitAll(Bytecode::AggregationHashTableTransferPartitions, agg_ht, tls, aht_offset, merge_part_fn);
@@ -341,6 +346,21 @@ void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVa
   EmitAll(bytecode, sorter, exec_ctx, cmp_fn, tuple_size);
 }
 
+void BytecodeEmitter::EmitSorterParallelScan(LocalVar sorter, LocalVar context, LocalVar tls,
+                                             FunctionId scan_range_fn) {
+  EmitAll(Bytecode::SorterParallelScan, sorter, context, tls, scan_range_fn);
+}
+
+void BytecodeEmitter::EmitSorterParallelScanPartitions(LocalVar sorter, LocalVar context, LocalVar tls,
+                                                       FunctionId partition_fn, FunctionId scan_partitions_fn) {
+  EmitAll(Bytecode::SorterParallelScanPartitions, sorter, context, tls, partition_fn, scan_partitions_fn);
+}
+
+void BytecodeEmitter::EmitIndexIteratorParallelScan(LocalVar iter, LocalVar context, LocalVar tls,
+                                                    FunctionId scan_range_fn) {
+  EmitAll(Bytecode::IndexIteratorParallelScan, iter, context, tls, scan_range_fn);
+}
+
 #if 0
 void BytecodeEmitter::EmitCSVReaderInit(LocalVar reader, LocalVar file_name, uint32_t file_name_len) {
   EmitAll(Bytecode::CSVReaderInit, reader, file_name, file_name_len);
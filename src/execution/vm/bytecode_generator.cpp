@@ -533,6 +533,8 @@ void BytecodeGenerator::VisitSqlConversionCall(ast::CallExpr *call, ast::Builtin
         if (!fits_in_int) {
           bytecode = Bytecode::InitInteger64;
         }
+      } else if (arg->GetType()->GetSize() == sizeof(int64_t)) {
+        bytecode = Bytecode::InitInteger64;
       }
       auto input = VisitExpressionForRValue(arg);
       GetEmitter()->Emit(bytecode, dest, input);
@@ -1397,6 +1399,48 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::JoinHashTableFree, join_hash_table);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableSpilling, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableBloomFilter: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableBloomFilter, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableFilterBatch: {
+      LocalVar vector_projection = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar tid_list = VisitExpressionForRValue(call->Arguments()[2]);
+      uint32_t num_key_cols = call->Arguments()[3]->GetType()->As<ast::ArrayType>()->GetLength();
+      LocalVar key_cols = VisitExpressionForLValue(call->Arguments()[3]);
+      GetEmitter()->EmitJoinHashTableFilterBatch(join_hash_table, vector_projection, tid_list, key_cols, num_key_cols);
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsSpilled: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableIsSpilled, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar probe_size = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableAllocSpilledProbeTuple, dest, join_hash_table, hash, probe_size);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableLoadSpilledPartition: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableLoadSpilledPartition, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableNextSpilledProbeTuple, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
     default: {
       UNREACHABLE("Impossible join hash table call");
     }
@@ -1524,6 +1568,23 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
       GetEmitter()->Emit(Bytecode::SorterSortTopKParallel, sorter, tls, sorter_offset, top_k);
       break;
     }
+    case ast::Builtin::SorterParallelScan: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar tls = VisitExpressionForRValue(call->Arguments()[2]);
+      auto scan_range_fn = LookupFuncIdByName(call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().GetData());
+      GetEmitter()->EmitSorterParallelScan(sorter, ctx, tls, scan_range_fn);
+      break;
+    }
+    case ast::Builtin::SorterParallelScanPartitions: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar tls = VisitExpressionForRValue(call->Arguments()[2]);
+      auto partition_fn = LookupFuncIdByName(call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().GetData());
+      auto scan_partitions_fn = LookupFuncIdByName(call->Arguments()[4]->As<ast::IdentifierExpr>()->Name().GetData());
+      GetEmitter()->EmitSorterParallelScanPartitions(sorter, ctx, tls, partition_fn, scan_partitions_fn);
+      break;
+    }
     case ast::Builtin::SorterFree: {
       LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
       GetEmitter()->Emit(Bytecode::SorterFree, sorter);
@@ -2259,15 +2320,18 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
   LocalVar storage_interface = VisitExpressionForRValue(call->Arguments()[0]);
 
   switch (builtin) {
-    case ast::Builtin::StorageInterfaceInit: {
+    case ast::Builtin::StorageInterfaceInit:
+    case ast::Builtin::StorageInterfaceInitBatched: {
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
       auto table_oid = VisitExpressionForRValue(call->Arguments()[2]);
       auto *arr_type = call->Arguments()[3]->GetType()->As<ast::ArrayType>();
       auto num_oids = static_cast<uint32_t>(arr_type->GetLength());
       LocalVar col_oids = VisitExpressionForLValue(call->Arguments()[3]);
       LocalVar is_index_key_update = VisitExpressionForRValue(call->Arguments()[4]);
-      GetEmitter()->EmitStorageInterfaceInit(Bytecode::StorageInterfaceInit, storage_interface, exec_ctx, table_oid,
-                                             col_oids, num_oids, is_index_key_update);
+      const Bytecode bytecode = builtin == ast::Builtin::StorageInterfaceInit ? Bytecode::StorageInterfaceInit
+                                                                              : Bytecode::StorageInterfaceInitBatched;
+      GetEmitter()->EmitStorageInterfaceInit(bytecode, storage_interface, exec_ctx, table_oid, col_oids, num_oids,
+                                             is_index_key_update);
       break;
     }
     case ast::Builtin::GetTablePR: {
@@ -2281,6 +2345,10 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
       GetEmitter()->Emit(Bytecode::StorageInterfaceTableInsert, tuple_slot, storage_interface);
       break;
     }
+    case ast::Builtin::TableInsertBatched: {
+      GetEmitter()->Emit(Bytecode::StorageInterfaceTableInsertBatched, storage_interface);
+      break;
+    }
     case ast::Builtin::TableDelete: {
       LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       LocalVar tuple_slot = VisitExpressionForRValue(call->Arguments()[1]);
@@ -2339,7 +2407,10 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
       GetEmitter()->Emit(Bytecode::StorageInterfaceIndexDelete, storage_interface, tuple_slot);
       break;
     }
-
+    case ast::Builtin::StorageInterfaceFlush: {
+      GetEmitter()->Emit(Bytecode::StorageInterfaceFlush, storage_interface);
+      break;
+    }
     case ast::Builtin::StorageInterfaceFree: {
       GetEmitter()->Emit(Bytecode::StorageInterfaceFree, storage_interface);
       break;
@@ -2791,7 +2862,14 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel:
     case ast::Builtin::JoinHashTableLookup:
-    case ast::Builtin::JoinHashTableFree: {
+    case ast::Builtin::JoinHashTableFree:
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableLoadSpilledPartition:
+    case ast::Builtin::JoinHashTableNextSpilledProbe:
+    case ast::Builtin::JoinHashTableEnableBloomFilter:
+    case ast::Builtin::JoinHashTableFilterBatch: {
       VisitBuiltinJoinHashTableCall(call, builtin);
       break;
     }
@@ -2816,6 +2894,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::SorterSort:
     case ast::Builtin::SorterSortParallel:
     case ast::Builtin::SorterSortTopKParallel:
+    case ast::Builtin::SorterParallelScan:
+    case ast::Builtin::SorterParallelScanPartitions:
     case ast::Builtin::SorterFree: {
       VisitBuiltinSorterCall(call, builtin);
       break;
@@ -2852,6 +2932,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanBatch:
+    case ast::Builtin::IndexIteratorSelectBatchKey:
+    case ast::Builtin::IndexIteratorParallelScan:
     case ast::Builtin::IndexIteratorAdvance:
     case ast::Builtin::IndexIteratorFree:
     case ast::Builtin::IndexIteratorGetPR:
@@ -2945,8 +3029,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::StorageInterfaceInit:
+    case ast::Builtin::StorageInterfaceInitBatched:
     case ast::Builtin::GetTablePR:
     case ast::Builtin::TableInsert:
+    case ast::Builtin::TableInsertBatched:
     case ast::Builtin::TableDelete:
     case ast::Builtin::TableUpdate:
     case ast::Builtin::GetIndexPR:
@@ -2956,6 +3042,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
     case ast::Builtin::IndexDelete:
+    case ast::Builtin::StorageInterfaceFlush:
     case ast::Builtin::StorageInterfaceFree: {
       VisitBuiltinStorageInterfaceCall(call, builtin);
       break;
@@ -3102,6 +3189,26 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::IndexIteratorScanLimitDescending, iterator, limit);
       break;
     }
+    case ast::Builtin::IndexIteratorAddBatchKey: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorAddBatchKey, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanBatch: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorScanBatch, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorSelectBatchKey: {
+      auto key_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::IndexIteratorSelectBatchKey, iterator, key_idx);
+      break;
+    }
+    case ast::Builtin::IndexIteratorParallelScan: {
+      LocalVar query_state = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar tls = VisitExpressionForRValue(call->Arguments()[2]);
+      auto scan_range_fn = LookupFuncIdByName(call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().GetData());
+      GetEmitter()->EmitIndexIteratorParallelScan(iterator, query_state, tls, scan_range_fn);
+      break;
+    }
     case ast::Builtin::IndexIteratorAdvance: {
       LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       GetEmitter()->Emit(Bytecode::IndexIteratorAdvance, cond, iterator);
@@ -48,8 +48,10 @@ void OpVPIFree(noisepage::execution::sql::VectorProjectionIterator *vpi) { vpi->
 // ---------------------------------------------------------
 
 void OpFilterManagerInit(noisepage::execution::sql::FilterManager *filter_manager,
-                         const noisepage::execution::exec::ExecutionSettings &exec_settings) {
-  new (filter_manager) noisepage::execution::sql::FilterManager(exec_settings);
+                         noisepage::execution::exec::ExecutionContext *exec_ctx) {
+  // Filter terms receive the query state as their context
+  new (filter_manager)
+      noisepage::execution::sql::FilterManager(exec_ctx->GetExecutionSettings(), true, exec_ctx->GetQueryState());
 }
 
 void OpFilterManagerStartNewClause(noisepage::execution::sql::FilterManager *filter_manager) {
@@ -91,6 +93,25 @@ void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_tab
   join_hash_table->~JoinHashTable();
 }
 
+void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableSpilling();
+}
+
+void OpJoinHashTableEnableBloomFilter(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableBloomFilter();
+}
+
+void OpJoinHashTableFilterBatch(const noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                noisepage::execution::sql::VectorProjection *vector_projection,
+                                noisepage::execution::sql::TupleIdList *tid_list, const uint32_t *key_cols,
+                                const uint32_t num_key_cols) {
+  join_hash_table->FilterBatch(vector_projection, key_cols, num_key_cols, tid_list);
+}
+
+void OpJoinHashTableLoadSpilledPartition(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->LoadNextSpilledPartition();
+}
+
 void OpJoinHashTableIteratorInit(noisepage::execution::sql::JoinHashTableIterator *iter,
                                  noisepage::execution::sql::JoinHashTable *join_hash_table) {
   NOISEPAGE_ASSERT(join_hash_table != nullptr, "Null hash table");
@@ -173,6 +194,19 @@ void OpSorterSortTopKParallel(noisepage::execution::sql::Sorter *sorter,
   sorter->SortTopKParallel(thread_state_container, sorter_offset, top_k);
 }
 
+void OpSorterParallelScan(noisepage::execution::sql::Sorter *sorter, void *query_state,
+                          noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                          noisepage::execution::sql::Sorter::ScanRangeFn scan_range_fn) {
+  sorter->ParallelScan(query_state, thread_state_container, scan_range_fn);
+}
+
+void OpSorterParallelScanPartitions(noisepage::execution::sql::Sorter *sorter, void *query_state,
+                                    noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                    noisepage::execution::sql::Sorter::ComparisonFunction partition_fn,
+                                    noisepage::execution::sql::Sorter::ScanPartitionsFn scan_partitions_fn) {
+  sorter->ParallelScanPartitions(query_state, thread_state_container, partition_fn, scan_partitions_fn);
+}
+
 void OpSorterFree(noisepage::execution::sql::Sorter *sorter) { sorter->~Sorter(); }
 
 void OpSorterIteratorInit(noisepage::execution::sql::SorterIterator *iter, noisepage::execution::sql::Sorter *sorter) {
@@ -207,6 +241,16 @@ void OpStorageInterfaceInit(noisepage::execution::sql::StorageInterface *storage
       exec_ctx, noisepage::catalog::table_oid_t(table_oid), col_oids, num_oids, need_indexes);
 }
 
+void OpStorageInterfaceInitBatched(noisepage::execution::sql::StorageInterface *storage_interface,
+                                   noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t table_oid,
+                                   uint32_t *col_oids, uint32_t num_oids, bool need_indexes) {
+  // The threads of a parallel pipeline construct their interfaces concurrently, and the catalog lookups fill the
+  // accessor's cache, which is not thread-safe.
+  noisepage::common::SpinLatch::ScopedSpinLatch guard(exec_ctx->GetTxnLatch());
+  new (storage_interface) noisepage::execution::sql::StorageInterface(
+      exec_ctx, noisepage::catalog::table_oid_t(table_oid), col_oids, num_oids, need_indexes, true);
+}
+
 void OpStorageInterfaceGetTablePR(noisepage::storage::ProjectedRow **pr_result,
                                   noisepage::execution::sql::StorageInterface *storage_interface) {
   *pr_result = storage_interface->GetTablePR();
@@ -227,6 +271,10 @@ void OpStorageInterfaceTableInsert(noisepage::storage::TupleSlot *tuple_slot,
   *tuple_slot = storage_interface->TableInsert();
 }
 
+void OpStorageInterfaceTableInsertBatched(noisepage::execution::sql::StorageInterface *storage_interface) {
+  storage_interface->TableInsertBatched();
+}
+
 void OpStorageInterfaceGetIndexPR(noisepage::storage::ProjectedRow **pr_result,
                                   noisepage::execution::sql::StorageInterface *storage_interface, uint32_t index_oid) {
   *pr_result = storage_interface->GetIndexPR(noisepage::catalog::index_oid_t(index_oid));
@@ -258,6 +306,10 @@ void OpStorageInterfaceIndexDelete(noisepage::execution::sql::StorageInterface *
   storage_interface->IndexDelete(*tuple_slot);
 }
 
+void OpStorageInterfaceFlush(noisepage::execution::sql::StorageInterface *storage_interface) {
+  storage_interface->Flush();
+}
+
 void OpStorageInterfaceFree(noisepage::execution::sql::StorageInterface *storage_interface) {
   storage_interface->~StorageInterface();
 }
@@ -278,6 +330,12 @@ void OpIndexIteratorGetSize(uint32_t *index_size, noisepage::execution::sql::Ind
 
 void OpIndexIteratorPerformInit(noisepage::execution::sql::IndexIterator *iter) { iter->Init(); }
 
+void OpIndexIteratorParallelScan(noisepage::execution::sql::IndexIterator *iter, void *query_state,
+                                 noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                 noisepage::execution::sql::IndexIterator::ScanRangeFn scan_range_fn) {
+  iter->ParallelScan(query_state, thread_state_container, scan_range_fn);
+}
+
 void OpIndexIteratorFree(noisepage::execution::sql::IndexIterator *iter) { iter->~IndexIterator(); }
 
 void OpExecutionContextRegisterHook(noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t hook_idx,
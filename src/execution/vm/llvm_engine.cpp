@@ -1,9 +1,11 @@
 #include "execution/vm/llvm_engine.h"
 
+#include <fcntl.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/RuntimeDyld.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/IR/IRBuilder.h>
@@ -12,6 +14,8 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/MCContext.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/TargetRegistry.h>
@@ -20,7 +24,11 @@
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
@@ -32,6 +40,8 @@
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/bytecode_traits.h"
 #include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
+#include "xxHash/xxh3.h"
 
 extern void *__dso_handle __attribute__((__visibility__("hidden")));  // NOLINT
 
@@ -49,6 +59,109 @@ bool FunctionHasDirectReturn(const ast::FunctionType *func_type) {
   return (!ret_type->IsNilType() && ret_type->GetSize() <= sizeof(int64_t));
 }
 
+// The directory of the object cache, set once when the engine is initialized.
+std::string &ObjectCacheDirectory() {
+  static std::string directory;
+  return directory;
+}
+
+// The most bytes the entries of the object cache may take up, set once when the engine is initialized.
+uint64_t &ObjectCacheMaxSize() {
+  static uint64_t max_size = LLVMEngine::DEFAULT_OBJECT_CACHE_MAX_SIZE;
+  return max_size;
+}
+
+// Identifies object cache entries. Change it when the format of entries or what their key covers changes.
+constexpr uint64_t OBJECT_CACHE_MAGIC = 0x31304a424f4c5054;  // "TPLOBJ01"
+
+// The file extension of object cache entries.
+constexpr const char OBJECT_CACHE_EXTENSION[] = ".to";
+
+// Check that only the user running the process can change the object cache directory, since code is loaded from it.
+bool IsObjectCacheDirectorySafe(const std::string &directory) {
+  struct stat status;
+  if (::stat(directory.c_str(), &status) != 0 || !S_ISDIR(status.st_mode)) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Object cache directory '{}' is not a directory", directory);
+    return false;
+  }
+  if (status.st_uid != ::geteuid()) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Object cache directory '{}' is not owned by the user running the process",
+                        directory);
+    return false;
+  }
+  if ((status.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Object cache directory '{}' is writable by other users", directory);
+    return false;
+  }
+  return true;
+}
+
+// Evict the least recently used entries of the object cache until they take up at most max_size bytes. Loading an
+// entry touches it, so the modification time of an entry is when it was last used.
+void PruneObjectCache(const std::string &directory, const uint64_t max_size) {
+  struct Entry {
+    std::string path_;
+    llvm::sys::TimePoint<> last_used_;
+    uint64_t size_;
+  };
+  std::vector<Entry> entries;
+  uint64_t total_size = 0;
+  std::error_code error;
+  for (llvm::sys::fs::directory_iterator iter(directory, error), end; !error && iter != end; iter.increment(error)) {
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::path::extension(iter->path()) != OBJECT_CACHE_EXTENSION ||
+        llvm::sys::fs::status(iter->path(), status)) {
+      continue;
+    }
+    entries.push_back({iter->path(), status.getLastModificationTime(), status.getSize()});
+    total_size += status.getSize();
+  }
+  if (total_size <= max_size) {
+    return;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return a.last_used_ < b.last_used_; });
+  for (auto iter = entries.begin(); iter != entries.end() && total_size > max_size; ++iter) {
+    if (std::error_code remove_error = llvm::sys::fs::remove(iter->path_)) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Could not evict object cache entry '{}': {}", iter->path_,
+                          remove_error.message());
+      continue;
+    }
+    EXECUTION_LOG_TRACE("LLVMEngine: Evicted object cache entry '{}'", iter->path_);
+    total_size -= iter->size_;
+  }
+}
+
+template <typename T>
+void HashValue(XXH3_state_t *state, const T &value) {
+  XXH3_128bits_update(state, &value, sizeof(value));
+}
+
+void HashString(XXH3_state_t *state, const llvm::StringRef str) {
+  HashValue(state, static_cast<uint64_t>(str.size()));
+  XXH3_128bits_update(state, str.data(), str.size());
+}
+
+void HashLocal(XXH3_state_t *state, const LocalInfo &local) {
+  HashValue(state, local.GetOffset());
+  HashValue(state, local.GetSize());
+  HashValue(state, local.IsParameter());
+  HashString(state, ast::Type::ToString(local.GetType()));
+}
+
+// The bytecode handlers do not change while the process runs, so they are only hashed once.
+uint64_t BytecodeHandlersHash(const std::string &path) {
+  static const uint64_t hash = [&path]() -> uint64_t {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (buffer.getError()) {
+      return 0;
+    }
+    return XXH3_64bits((*buffer)->getBufferStart(), (*buffer)->getBufferSize());
+  }();
+  return hash;
+}
+
 }  // namespace
 
 // ---------------------------------------------------------
@@ -351,6 +464,186 @@ llvm::Value *LLVMEngine::FunctionLocalsMap::GetArgumentById(LocalVar var) {
   return nullptr;
 }
 
+// ---------------------------------------------------------
+// Object Cache
+// ---------------------------------------------------------
+
+/**
+ * A cache of the object code of compiled modules in a directory that outlives the process. Entries are keyed by a hash
+ * of everything the object code depends on: the LLVM version, the bytecode handlers, the host CPU and its features, the
+ * compiler options and the bytecode module. The names of the module and its functions are left out, since they embed
+ * identifiers that are only unique within one run of the process. Each entry holds the function names the object code
+ * was compiled with, followed by the object code and its checksum.
+ *
+ * Loading an entry updates its modification time. Storing an entry evicts the least recently used entries until the
+ * cache fits in its maximum size again.
+ */
+class LLVMEngine::ObjectCache {
+ public:
+  ObjectCache(const CompilerOptions &options, const BytecodeModule &tpl_module);
+
+  // No copying or moving this class
+  DISALLOW_COPY_AND_MOVE(ObjectCache);
+
+  // Load the compiled module from the cache. Returns null if it is not cached or cannot be loaded.
+  std::unique_ptr<CompiledModule> Load() const;
+
+  // Add the object code of the module to the cache.
+  void Store(const llvm::MemoryBuffer &object_code) const;
+
+ private:
+  const BytecodeModule &tpl_module_;
+  std::string directory_;
+  uint64_t max_size_;
+  std::string path_;
+};
+
+LLVMEngine::ObjectCache::ObjectCache(const CompilerOptions &options, const BytecodeModule &tpl_module)
+    : tpl_module_(tpl_module),
+      directory_(options.GetObjectCacheDirectory()),
+      max_size_(options.GetObjectCacheMaxSize()) {
+  XXH3_state_t state;
+  XXH3_128bits_reset(&state);
+  HashValue(&state, OBJECT_CACHE_MAGIC);
+
+  // The code generator and the machine it generates code for.
+  HashString(&state, LLVM_VERSION_STRING);
+  HashValue(&state, BytecodeHandlersHash(options.GetBytecodeHandlersBcPath()));
+  HashString(&state, llvm::sys::getProcessTriple());
+  HashString(&state, llvm::sys::getHostCPUName());
+  llvm::StringMap<bool> feature_map;
+  llvm::sys::getHostCPUFeatures(feature_map);
+  std::vector<std::string> features;
+  for (const auto &entry : feature_map) {
+    features.emplace_back((entry.getValue() ? "+" : "-") + entry.getKey().str());
+  }
+  std::sort(features.begin(), features.end());
+  for (const auto &feature : features) {
+    HashString(&state, feature);
+  }
+  HashValue(&state, options.IsDebug());
+
+  // The module.
+  HashString(&state, llvm::StringRef(reinterpret_cast<const char *>(tpl_module.code_.data()), tpl_module.code_.size()));
+  HashString(&state, llvm::StringRef(reinterpret_cast<const char *>(tpl_module.data_.data()), tpl_module.data_.size()));
+  HashValue(&state, static_cast<uint64_t>(tpl_module.GetStaticLocalsCount()));
+  for (const auto &local : tpl_module.GetStaticLocalsInfo()) {
+    HashLocal(&state, local);
+  }
+  HashValue(&state, static_cast<uint64_t>(tpl_module.GetFunctionCount()));
+  for (const auto &func_info : tpl_module.GetFunctionsInfo()) {
+    HashString(&state, ast::Type::ToString(func_info.GetFuncType()));
+    HashValue(&state, static_cast<uint64_t>(func_info.GetBytecodeRange().first));
+    HashValue(&state, static_cast<uint64_t>(func_info.GetBytecodeRange().second));
+    HashValue(&state, static_cast<uint64_t>(func_info.GetFrameSize()));
+    HashValue(&state, static_cast<uint64_t>(func_info.GetParamsStartPos()));
+    HashValue(&state, static_cast<uint64_t>(func_info.GetParamsSize()));
+    HashValue(&state, func_info.GetParamsCount());
+    HashValue(&state, static_cast<uint64_t>(func_info.GetLocals().size()));
+    for (const auto &local : func_info.GetLocals()) {
+      HashLocal(&state, local);
+    }
+  }
+
+  const XXH128_hash_t hash = XXH3_128bits_digest(&state);
+  llvm::SmallString<128> path(directory_);
+  llvm::sys::path::append(path, fmt::format("{:016x}{:016x}{}", hash.high64, hash.low64, OBJECT_CACHE_EXTENSION));
+  path_ = path.str().str();
+}
+
+std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::ObjectCache::Load() const {
+  auto file_buffer = llvm::MemoryBuffer::getFile(path_);
+  if (file_buffer.getError()) {
+    EXECUTION_LOG_TRACE("LLVMEngine: Module '{}' is not in the object cache", tpl_module_.GetName());
+    return nullptr;
+  }
+
+  // Read the function names and the object code, making sure that the entry is intact.
+  llvm::StringRef entry = (*file_buffer)->getBuffer();
+  const auto read = [&entry](auto *value) {
+    if (entry.size() < sizeof(*value)) {
+      return false;
+    }
+    std::memcpy(value, entry.data(), sizeof(*value));
+    entry = entry.drop_front(sizeof(*value));
+    return true;
+  };
+
+  uint64_t magic;
+  uint64_t num_functions;
+  bool intact = read(&magic) && magic == OBJECT_CACHE_MAGIC && read(&num_functions) &&
+                num_functions == tpl_module_.GetFunctionCount();
+  std::vector<std::string> symbol_names;
+  for (uint64_t i = 0; intact && i < num_functions; i++) {
+    uint64_t length;
+    intact = read(&length) && entry.size() >= length;
+    if (intact) {
+      symbol_names.emplace_back(entry.take_front(length).str());
+      entry = entry.drop_front(length);
+    }
+  }
+  uint64_t checksum;
+  intact = intact && read(&checksum) && checksum == XXH3_64bits(entry.data(), entry.size());
+  if (!intact) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Ignoring corrupt object cache entry '{}'", path_);
+    return nullptr;
+  }
+
+  auto compiled_module = std::make_unique<CompiledModule>(llvm::MemoryBuffer::getMemBufferCopy(entry, path_),
+                                                          std::move(symbol_names));
+  compiled_module->Load(tpl_module_);
+  if (!compiled_module->IsLoaded()) {
+    return nullptr;
+  }
+
+  // Mark the entry as recently used, so that it is evicted last.
+  if (::utimensat(AT_FDCWD, path_.c_str(), nullptr, 0) != 0) {
+    EXECUTION_LOG_TRACE("LLVMEngine: Could not touch object cache entry '{}'", path_);
+  }
+  EXECUTION_LOG_DEBUG("LLVMEngine: Loaded module '{}' from the object cache", tpl_module_.GetName());
+  return compiled_module;
+}
+
+void LLVMEngine::ObjectCache::Store(const llvm::MemoryBuffer &object_code) const {
+  // Write a temporary file and rename it, so that concurrent readers and writers never see a partial entry.
+  int fd;
+  llvm::SmallString<128> temp_path;
+  if (std::error_code error = llvm::sys::fs::createUniqueFile(path_ + "-%%%%%%.tmp", fd, temp_path)) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Could not create object cache entry: {}", error.message());
+    return;
+  }
+
+  {
+    llvm::raw_fd_ostream dest(fd, true);
+    const auto write = [&dest](const auto &value) {
+      dest.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    write(OBJECT_CACHE_MAGIC);
+    write(static_cast<uint64_t>(tpl_module_.GetFunctionCount()));
+    for (const auto &func_info : tpl_module_.GetFunctionsInfo()) {
+      write(static_cast<uint64_t>(func_info.GetName().size()));
+      dest << func_info.GetName();
+    }
+    write(XXH3_64bits(object_code.getBufferStart(), object_code.getBufferSize()));
+    dest.write(object_code.getBufferStart(), object_code.getBufferSize());
+    dest.close();
+    if (dest.has_error()) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Could not write object cache entry '{}'", temp_path.str().str());
+      dest.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      return;
+    }
+  }
+
+  if (std::error_code error = llvm::sys::fs::rename(temp_path, path_)) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Could not add object cache entry: {}", error.message());
+    llvm::sys::fs::remove(temp_path);
+    return;
+  }
+
+  PruneObjectCache(directory_, max_size_);
+}
+
 // ---------------------------------------------------------
 // Compiled Module Builder
 // ---------------------------------------------------------
@@ -383,8 +676,8 @@ class LLVMEngine::CompiledModuleBuilder {
   // Optimize the generate code
   void Optimize();
 
-  // Perform finalization logic and create a compiled module
-  std::unique_ptr<CompiledModule> Finalize();
+  // Perform finalization logic and create a compiled module, adding its object code to the object cache if given
+  std::unique_ptr<CompiledModule> Finalize(const ObjectCache *object_cache);
 
   // Print the contents of the module to a string and return it
   std::string DumpModuleIR();
@@ -973,13 +1266,18 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   module_passes.run(*llvm_module_);
 }
 
-std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize() {
+std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize(
+    const ObjectCache *const object_cache) {
   std::unique_ptr<llvm::MemoryBuffer> obj = EmitObject();
 
   if (options_.ShouldPersistObjectFile()) {
     PersistObjectToFile(*obj);
   }
 
+  if (object_cache != nullptr && obj != nullptr) {
+    object_cache->Store(*obj);
+  }
+
   return std::make_unique<CompiledModule>(std::move(obj));
 }
 
@@ -1047,9 +1345,11 @@ std::string LLVMEngine::CompiledModuleBuilder::DumpModuleAsm() {
 // Compiled Module
 // ---------------------------------------------------------
 
-LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code)
+LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code,
+                                           std::vector<std::string> symbol_names)
     : loaded_(false),
       object_code_(std::move(object_code)),
+      symbol_names_(std::move(symbol_names)),
       memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {}
 
 // This destructor is needed to address a bug with LLVM's RuntimeDyldElf.
@@ -1121,11 +1421,14 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
   // all module functions into a handy cache.
   //
 
+  NOISEPAGE_ASSERT(symbol_names_.empty() || symbol_names_.size() == module.GetFunctionCount(),
+                   "Symbol names do not match the functions of the module");
   for (const auto &func : module.GetFunctionsInfo()) {
-    auto symbol = loader.getSymbol(func.GetName());
+    const std::string &symbol_name = symbol_names_.empty() ? func.GetName() : symbol_names_[func.GetId()];
+    auto symbol = loader.getSymbol(symbol_name);
     if (symbol.getAddress() == 0) {
       // for Mac portability
-      symbol = loader.getSymbol("_" + func.GetName());
+      symbol = loader.getSymbol("_" + symbol_name);
     }
     functions_[func.GetName()] = reinterpret_cast<void *>(symbol.getAddress());
     NOISEPAGE_ASSERT(symbol.getAddress() != 0, "symbol came out to be badly defined or missing");
@@ -1139,7 +1442,7 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
 // LLVM Engine
 // ---------------------------------------------------------
 
-void LLVMEngine::Initialize() {
+void LLVMEngine::Initialize(const std::string &object_cache_directory, const uint64_t object_cache_max_size) {
   // Global LLVM initialization
   llvm::InitializeNativeTarget();
   llvm::InitializeNativeTargetAsmPrinter();
@@ -1147,12 +1450,42 @@ void LLVMEngine::Initialize() {
 
   // Make all exported TPL symbols available to JITed code
   llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+
+  // Set up the object cache, if requested. Its directory is private to the user running the process, since the code in
+  // it is loaded into the process.
+  ObjectCacheDirectory() = object_cache_directory;
+  ObjectCacheMaxSize() = object_cache_max_size;
+  if (!object_cache_directory.empty()) {
+    if (std::error_code error =
+            llvm::sys::fs::create_directories(object_cache_directory, true, llvm::sys::fs::owner_all)) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Could not create object cache directory '{}': {}", object_cache_directory,
+                          error.message());
+      ObjectCacheDirectory().clear();
+    } else if (!IsObjectCacheDirectorySafe(object_cache_directory)) {
+      ObjectCacheDirectory().clear();
+    } else {
+      PruneObjectCache(object_cache_directory, object_cache_max_size);
+    }
+  }
 }
 
+const std::string &LLVMEngine::GetObjectCacheDirectory() { return ObjectCacheDirectory(); }
+
+uint64_t LLVMEngine::GetObjectCacheMaxSize() { return ObjectCacheMaxSize(); }
+
 void LLVMEngine::Shutdown() { llvm::llvm_shutdown(); }
 
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule &module,
                                                                 const CompilerOptions &options) {
+  // Modules that were compiled before, possibly by an earlier run of the process, are loaded from the object cache.
+  std::unique_ptr<ObjectCache> object_cache;
+  if (!options.GetObjectCacheDirectory().empty()) {
+    object_cache = std::make_unique<ObjectCache>(options, module);
+    if (auto compiled_module = object_cache->Load(); compiled_module != nullptr) {
+      return compiled_module;
+    }
+  }
+
   CompiledModuleBuilder builder(options, module);
 
   builder.DeclareStaticLocals();
@@ -1167,7 +1500,7 @@ std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeMo
 
   builder.Optimize();
 
-  auto compiled_module = builder.Finalize();
+  auto compiled_module = builder.Finalize(object_cache.get());
 
   compiled_module->Load(module);
 
@@ -2,6 +2,8 @@
 
 #include <tbb/task.h>  // NOLINT
 
+#include <condition_variable>  // NOLINT
+#include <exception>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
@@ -18,22 +20,48 @@ namespace noisepage::execution::vm {
 // Async Compile Task
 // ---------------------------------------------------------
 
+// The progress of a background compilation. It is shared by the module and its task, so that a module destroyed
+// before the task started can cancel it instead of waiting for it.
+struct Module::AsyncCompileState {
+  enum class Status : uint8_t { Pending, Running, Cancelled, Done };
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  Status status_{Status::Pending};
+};
+
 // This class encapsulates the ability to asynchronously JIT compile a module.
 class Module::AsyncCompileTask : public tbb::task {
  public:
   // Construct an asynchronous compilation task to compile the the module
-  explicit AsyncCompileTask(Module *module) : module_(module) {}
+  AsyncCompileTask(Module *module, std::shared_ptr<AsyncCompileState> state)
+      : module_(module), state_(std::move(state)) {}
 
   // Execute
   tbb::task *execute() override {
-    // This simply invokes Module::CompileToMachineCode() asynchronously.
-    module_->CompileToMachineCode();
+    {
+      // The module is gone if the compilation was cancelled.
+      std::lock_guard<std::mutex> guard(state_->mutex_);
+      if (state_->status_ == AsyncCompileState::Status::Cancelled) return nullptr;
+      state_->status_ = AsyncCompileState::Status::Running;
+    }
+    // This simply invokes Module::CompileToMachineCode() asynchronously. A failure leaves the module interpreted.
+    try {
+      module_->CompileToMachineCode();
+    } catch (const std::exception &e) {
+      EXECUTION_LOG_ERROR("Background compilation of module failed: {}", e.what());
+    }
+    // The module may be destroyed from here on. Notify while holding the latch, so that a waiting module cannot be
+    // destroyed in between.
+    std::lock_guard<std::mutex> guard(state_->mutex_);
+    state_->status_ = AsyncCompileState::Status::Done;
+    state_->cv_.notify_all();
     // Done. There's no next task, so return null.
     return nullptr;
   }
 
  private:
   Module *module_;
+  std::shared_ptr<AsyncCompileState> state_;
 };
 
 // ---------------------------------------------------------
@@ -65,7 +93,20 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
       auto func_info = bytecode_module_->GetFuncInfoById(idx);
       functions_[idx] = jit_module_->GetFunctionPointer(func_info->GetName());
     }
+    compiled_ = true;
+  }
+}
+
+Module::~Module() {
+  if (!async_compile_requested_.load()) return;
+  // A compilation that has not started is cancelled, one that is running is waited for.
+  std::unique_lock<std::mutex> lock(async_compile_state_->mutex_);
+  if (async_compile_state_->status_ == AsyncCompileState::Status::Pending) {
+    async_compile_state_->status_ = AsyncCompileState::Status::Cancelled;
+    return;
   }
+  async_compile_state_->cv_.wait(lock,
+                                 [this] { return async_compile_state_->status_ == AsyncCompileState::Status::Done; });
 }
 
 namespace {
@@ -270,8 +311,10 @@ void Module::CompileToMachineCode() {
       return;
     }
 
-    // JIT the module.
+    // JIT the module, or load it from the object cache if it was compiled before.
     LLVMEngine::CompilerOptions options;
+    options.SetObjectCacheDirectory(LLVMEngine::GetObjectCacheDirectory());
+    options.SetObjectCacheMaxSize(LLVMEngine::GetObjectCacheMaxSize());
     jit_module_ = LLVMEngine::Compile(*bytecode_module_, options);
 
     // JIT completed successfully. For each function in the module, pull out its
@@ -282,11 +325,17 @@ void Module::CompileToMachineCode() {
       NOISEPAGE_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
       functions_[func_info.GetId()].store(jit_function, std::memory_order_relaxed);
     }
+    compiled_.store(true, std::memory_order_release);
   });
 }
 
 void Module::CompileToMachineCodeAsync() {
-  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
+  // Only one background compilation per module, and none if the machine code is there already.
+  if (IsCompiledToMachineCode() || async_compile_requested_.exchange(true)) {
+    return;
+  }
+  async_compile_state_ = std::make_shared<AsyncCompileState>();
+  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this, async_compile_state_);
   tbb::task::enqueue(*compile_task);
 }
 
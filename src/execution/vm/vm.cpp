@@ -892,7 +892,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   OP(FilterManagerInit) : {
     auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
     auto *exec_context = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
-    OpFilterManagerInit(filter_manager, exec_context->GetExecutionSettings());
+    OpFilterManagerInit(filter_manager, exec_context);
     DISPATCH_NEXT();
   }
 
@@ -1600,6 +1600,58 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableEnableSpilling) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableSpilling(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEnableBloomFilter) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableBloomFilter(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableFilterBatch) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto *tid_list = frame->LocalAt<sql::TupleIdList *>(READ_LOCAL_ID());
+    auto *key_cols = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_key_cols = READ_UIMM4();
+    OpJoinHashTableFilterBatch(join_hash_table, vector_projection, tid_list, key_cols, num_key_cols);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableIsSpilled) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableIsSpilled(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableAllocSpilledProbeTuple) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    auto probe_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpJoinHashTableAllocSpilledProbeTuple(result, join_hash_table, hash, probe_size);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableLoadSpilledPartition) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableLoadSpilledPartition(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableNextSpilledProbeTuple) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableNextSpilledProbeTuple(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
   OP(HashTableEntryIteratorHasNext) : {
     auto *has_next = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *ht_entry_iter = frame->LocalAt<sql::HashTableEntryIterator *>(READ_LOCAL_ID());
@@ -1714,6 +1766,31 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(SorterParallelScan) : {
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto *thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
+    auto scan_range_fn_id = READ_FUNC_ID();
+
+    auto scan_range_fn = reinterpret_cast<sql::Sorter::ScanRangeFn>(module_->GetRawFunctionImpl(scan_range_fn_id));
+    OpSorterParallelScan(sorter, query_state, thread_state_container, scan_range_fn);
+    DISPATCH_NEXT();
+  }
+
+  OP(SorterParallelScanPartitions) : {
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto *thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
+    auto partition_fn_id = READ_FUNC_ID();
+    auto scan_partitions_fn_id = READ_FUNC_ID();
+
+    auto partition_fn = reinterpret_cast<sql::Sorter::ComparisonFunction>(module_->GetRawFunctionImpl(partition_fn_id));
+    auto scan_partitions_fn =
+        reinterpret_cast<sql::Sorter::ScanPartitionsFn>(module_->GetRawFunctionImpl(scan_partitions_fn_id));
+    OpSorterParallelScanPartitions(sorter, query_state, thread_state_container, partition_fn, scan_partitions_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(SorterFree) : {
     auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
     OpSorterFree(sorter);
@@ -1892,6 +1969,37 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorAddBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorAddBatchKey(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanBatch) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorScanBatch(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorSelectBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    auto key_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpIndexIteratorSelectBatchKey(iter, key_idx);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorParallelScan) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto *thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
+    auto scan_range_fn_id = READ_FUNC_ID();
+
+    auto scan_range_fn =
+        reinterpret_cast<sql::IndexIterator::ScanRangeFn>(module_->GetRawFunctionImpl(scan_range_fn_id));
+    OpIndexIteratorParallelScan(iter, query_state, thread_state_container, scan_range_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorFree) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorFree(iter);
@@ -2037,6 +2145,18 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(StorageInterfaceInitBatched) : {
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto *col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_oids = READ_UIMM4();
+    auto need_indexes = frame->LocalAt<bool>(READ_LOCAL_ID());
+
+    OpStorageInterfaceInitBatched(storage_interface, exec_ctx, table_oid, col_oids, num_oids, need_indexes);
+    DISPATCH_NEXT();
+  }
+
   OP(StorageInterfaceGetTablePR) : {
     auto *pr_result = frame->LocalAt<storage::ProjectedRow **>(READ_LOCAL_ID());
     auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
@@ -2053,6 +2173,12 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(StorageInterfaceTableInsertBatched) : {
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    OpStorageInterfaceTableInsertBatched(storage_interface);
+    DISPATCH_NEXT();
+  }
+
   OP(StorageInterfaceTableDelete) : {
     auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
@@ -2124,6 +2250,12 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(StorageInterfaceFlush) : {
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    OpStorageInterfaceFlush(storage_interface);
+    DISPATCH_NEXT();
+  }
+
   OP(StorageInterfaceFree) : {
     auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
     OpStorageInterfaceFree(storage_interface);
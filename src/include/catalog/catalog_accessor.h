@@ -10,6 +10,7 @@
 #include "catalog/postgres/pg_proc.h"
 #include "catalog/schema.h"
 #include "common/managed_pointer.h"
+#include "transaction/transaction_defs.h"
 #include "type/type_id.h"
 
 namespace noisepage::storage {
@@ -362,6 +363,12 @@ class EXPORT CatalogAccessor {
    */
   type_oid_t GetTypeOidFromTypeId(type::TypeId type);
 
+  /**
+   * @return version of the database's catalog seen by the transaction, or INVALID_TXN_TIMESTAMP if there is none
+   * @see DatabaseCatalog::GetCatalogVersion
+   */
+  transaction::timestamp_t GetCatalogVersion() const;
+
   /**
    * @return BlockStore to be used for CREATE operations
    */
@@ -19,6 +19,7 @@ class TransactionContext;
 
 namespace noisepage::storage {
 class GarbageCollector;
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 namespace index {
@@ -175,6 +176,15 @@ class DatabaseCatalog {
   common::ManagedPointer<execution::functions::FunctionContext> GetFunctionContext(
       common::ManagedPointer<transaction::TransactionContext> txn, proc_oid_t proc_oid);
 
+  /**
+   * @brief Get the version of this database's catalog that the transaction sees, which is the commit time of the last
+   *        DDL change in the database other than creating or dropping an empty namespace. Anything derived from the
+   *        catalog, e.g., a physical plan, is valid for as long as the version does not change.
+   * @param txn         The transaction to get the version for.
+   * @return The version, or INVALID_TXN_TIMESTAMP if a DDL change is in progress or was committed after txn started.
+   */
+  transaction::timestamp_t GetCatalogVersion(common::ManagedPointer<transaction::TransactionContext> txn) const;
+
  private:
   /**
    * The maximum number of tuples to be read out at a time when scanning tables during teardown.
@@ -197,9 +207,13 @@ class DatabaseCatalog {
   friend class postgres::Builder;         ///< Initializes DatabaseCatalog's tables.
   friend class storage::RecoveryManager;  ///< Directly modifies DatabaseCatalog's tables.
 
+  friend class storage::CheckpointManager;  ///< Reads the tables to write them to checkpoints.
+
   // Miscellaneous state.
   std::atomic<uint32_t> next_oid_;                    ///< The next OID, shared across different pg tables.
   std::atomic<transaction::timestamp_t> write_lock_;  ///< Used to prevent concurrent DDL change.
+  std::atomic<transaction::timestamp_t> catalog_version_;  ///< Commit time of the last DDL change that is versioned.
+  bool lock_changes_version_ = false;  ///< Whether the holder of write_lock_ changes the version, guarded by it.
   const db_oid_t db_oid_;  ///< The OID of the database that this DatabaseCatalog is established in.
   const common::ManagedPointer<storage::GarbageCollector> garbage_collector_;  ///< The garbage collector used.
 
@@ -232,12 +246,14 @@ class DatabaseCatalog {
    *
    * @param txn     Requesting transaction.
    *                Used to inspect the timestamp and register commit/abort events to release the lock if acquired.
+   * @param changes_version False if the change cannot invalidate anything derived from the catalog, in which case the
+   *                catalog version is left as is unless other changes of the txn do change it.
    * @return        True if the lock was acquired. False otherwise.
    *
    * @warning       This requires that commit actions be performed after the commit time is stored
    *                in the TransactionContext's FinishTime.
    */
-  bool TryLock(common::ManagedPointer<transaction::TransactionContext> txn);
+  bool TryLock(common::ManagedPointer<transaction::TransactionContext> txn, bool changes_version = true);
 
   /**
    * @brief Atomically update the next oid counter to the max of the current count and the provided next oid.
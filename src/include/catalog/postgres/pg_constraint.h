@@ -6,6 +6,7 @@
 #include "catalog/catalog_defs.h"
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 }  // namespace noisepage::storage
 
@@ -16,6 +17,7 @@ class PgConstraintImpl;
 /** The OIDs used by the NoisePage version of pg_constraint. */
 class PgConstraint {
  private:
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   friend class Builder;
   friend class PgConstraintImpl;
@@ -11,6 +11,7 @@ class AbstractExpression;
 }  // namespace noisepage::parser
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 
@@ -74,6 +75,7 @@ class PgConstraintImpl {
 
  private:
   friend class Builder;
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
 
   const db_oid_t db_oid_;
@@ -22,6 +22,7 @@ class FunctionContext;
 
 namespace noisepage::storage {
 class GarbageCollector;
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 
@@ -44,6 +45,8 @@ class PgCoreImpl {
   friend class catalog::DatabaseCatalog;  ///< DatabaseCatalog sets up and owns the core catalog tables.
   friend class storage::RecoveryManager;  ///< The RM accesses tables and indexes without going through the catalog.
 
+  friend class storage::CheckpointManager;  ///< Reads the tables to write them to checkpoints.
+
   /**
    * @brief Prepare to create the core catalog tables: pg_namespace, pg_class, pg_index, and pg_attribute.
    *
@@ -11,6 +11,7 @@ class DatabaseCatalog;
 }  // namespace noisepage::catalog
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 }  // namespace noisepage::storage
 
@@ -21,6 +22,7 @@ class Builder;
 class PgDatabase {
  private:
   friend class catalog::Catalog;
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   friend class Builder;
 
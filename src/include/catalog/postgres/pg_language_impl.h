@@ -8,6 +8,7 @@
 #include "storage/storage_defs.h"
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 
@@ -30,6 +31,8 @@ class PgLanguageImpl {
   friend class storage::RecoveryManager;  ///< The RM accesses tables and indexes without going through the catalog.
   friend class catalog::DatabaseCatalog;  ///< DatabaseCatalog sets up and owns pg_language.
 
+  friend class storage::CheckpointManager;  ///< Reads the tables to write them to checkpoints.
+
   /**
    * @brief Prepare to create pg_language.
    *
@@ -15,6 +15,7 @@ class FunctionContext;
 }  // namespace noisepage::execution::functions
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 }  // namespace noisepage::storage
 
@@ -41,6 +42,7 @@ class PgProc {
   };
 
  private:
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   friend class Builder;
   friend class PgProcImpl;
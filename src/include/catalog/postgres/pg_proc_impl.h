@@ -18,6 +18,7 @@ class FunctionContext;
 }  // namespace noisepage::execution::functions
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 
@@ -40,6 +41,8 @@ class PgProcImpl {
   friend class storage::RecoveryManager;  ///< The RM accesses tables and indexes without going through the catalog.
   friend class catalog::DatabaseCatalog;  ///< DatabaseCatalog sets up and owns pg_proc.
 
+  friend class storage::CheckpointManager;  ///< Reads the tables to write them to checkpoints.
+
   /**
    * @brief Prepare to create pg_proc.
    *
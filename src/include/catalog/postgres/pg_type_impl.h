@@ -8,6 +8,7 @@
 #include "storage/storage_defs.h"
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 class SqlTable;
 
@@ -75,6 +76,7 @@ class PgTypeImpl {
 
  private:
   friend class Builder;
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
 
   /** @brief Bootstrap all the builtin types in pg_type. */
@@ -110,6 +110,26 @@ struct Constants {
    */
   static constexpr const int NUM_PARALLEL_EXECUTION_THREADS = -1;
 
+  /**
+   * Memory (in bytes) a query may use for the tuples buffered by operators that can spill to disk.
+   * Zero means the memory use of a query is not limited.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t QUERY_MEMORY_BUDGET = 0;
+
+  /**
+   * Number of interpreted runs after which an adaptively executed query is compiled to machine code.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t ADAPTIVE_COMPILE_RUNS = 3;
+
+  /**
+   * Total time (in microseconds) of interpreted runs after which an adaptively executed query is compiled to machine
+   * code, so that long-running queries are compiled before they reach ADAPTIVE_COMPILE_RUNS.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t ADAPTIVE_COMPILE_INTERPRET_TIME_US = 50000;
+
   /**
    * Flag indicating if counters is enabled
    * This value will be overwritten by the SettingsManager (if enabled).
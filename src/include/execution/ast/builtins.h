@@ -171,6 +171,13 @@ namespace noisepage::execution::ast {
   F(JoinHashTableGetTupleCount, joinHTGetTupleCount)                    \
   F(JoinHashTableLookup, joinHTLookup)                                  \
   F(JoinHashTableFree, joinHTFree)                                      \
+  F(JoinHashTableEnableSpilling, joinHTEnableSpilling)                  \
+  F(JoinHashTableIsSpilled, joinHTIsSpilled)                            \
+  F(JoinHashTableSpillProbe, joinHTSpillProbe)                          \
+  F(JoinHashTableLoadSpilledPartition, joinHTLoadSpilledPartition)      \
+  F(JoinHashTableNextSpilledProbe, joinHTNextSpilledProbe)              \
+  F(JoinHashTableEnableBloomFilter, joinHTEnableBloomFilter)            \
+  F(JoinHashTableFilterBatch, joinHTFilterBatch)                        \
                                                                         \
   /* Hash Table Entry Iterator (for hash joins) */                      \
   F(HashTableEntryIterHasNext, htEntryIterHasNext)                      \
@@ -191,6 +198,8 @@ namespace noisepage::execution::ast {
   F(SorterSort, sorterSort)                                             \
   F(SorterSortParallel, sorterSortParallel)                             \
   F(SorterSortTopKParallel, sorterSortTopKParallel)                     \
+  F(SorterParallelScan, sorterParallelScan)                             \
+  F(SorterParallelScanPartitions, sorterParallelScanPartitions)         \
   F(SorterFree, sorterFree)                                             \
   F(SorterIterInit, sorterIterInit)                                     \
   F(SorterIterHasNext, sorterIterHasNext)                               \
@@ -212,6 +221,10 @@ namespace noisepage::execution::ast {
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
+  F(IndexIteratorAddBatchKey, indexIteratorAddBatchKey)                 \
+  F(IndexIteratorScanBatch, indexIteratorScanBatch)                     \
+  F(IndexIteratorSelectBatchKey, indexIteratorSelectBatchKey)           \
+  F(IndexIteratorParallelScan, indexIteratorParallelScan)               \
   F(IndexIteratorAdvance, indexIteratorAdvance)                         \
   F(IndexIteratorGetPR, indexIteratorGetPR)                             \
   F(IndexIteratorGetLoPR, indexIteratorGetLoPR)                         \
@@ -270,9 +283,11 @@ namespace noisepage::execution::ast {
                                                                         \
   /* SQL Table Calls */                                                 \
   F(StorageInterfaceInit, storageInterfaceInit)                         \
+  F(StorageInterfaceInitBatched, storageInterfaceInitBatched)           \
   F(StorageInterfaceGetIndexHeapSize, storageInterfaceGetIndexHeapSize) \
   F(GetTablePR, getTablePR)                                             \
   F(TableInsert, tableInsert)                                           \
+  F(TableInsertBatched, tableInsertBatched)                             \
   F(TableDelete, tableDelete)                                           \
   F(TableUpdate, tableUpdate)                                           \
   F(GetIndexPR, getIndexPR)                                             \
@@ -281,6 +296,7 @@ namespace noisepage::execution::ast {
   F(IndexInsertUnique, indexInsertUnique)                               \
   F(IndexInsertWithSlot, indexInsertWithSlot)                           \
   F(IndexDelete, indexDelete)                                           \
+  F(StorageInterfaceFlush, storageInterfaceFlush)                       \
   F(StorageInterfaceFree, storageInterfaceFree)                         \
   /* Trig */                                                            \
   F(ACos, acos)                                                         \
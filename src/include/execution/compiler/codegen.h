@@ -215,9 +215,17 @@ class CodeGen {
    */
   ast::Expr *ArrayType(uint64_t num_elems, ast::BuiltinType::Kind kind);
 
+  /**
+   * @return A type representation expression that is "[num_elems]elem_type".
+   */
+  ast::Expr *ArrayType(uint64_t num_elems, ast::Expr *elem_type);
+
   /** @return An expression representing "arr[idx]". */
   ast::Expr *ArrayAccess(ast::Identifier arr, uint64_t idx);
 
+  /** @return An expression representing "arr[idx]". */
+  ast::Expr *ArrayAccess(ast::Expr *arr, ast::Expr *idx);
+
   /**
    * Convert a SQL type into a type representation expression.
    * @param type The SQL type.
@@ -608,6 +616,19 @@ class CodeGen {
   [[nodiscard]] ast::Expr *IndexIteratorInit(ast::Identifier iter, ast::Expr *exec_ctx_var, uint32_t num_attrs,
                                              uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids);
 
+  /**
+   * Call \@indexIteratorInit(iter_ptr, execCtx, table_oid, index_oid, col_oids)
+   * @param iter_ptr A pointer to the index iterator.
+   * @param exec_ctx_var The execution context variable.
+   * @param num_attrs Number of attributes
+   * @param table_oid The oid of the index's table.
+   * @param index_oid The oid the index.
+   * @param col_oids The identifier of the array of column oids to read.
+   * @return The expression corresponding to the builtin call.
+   */
+  [[nodiscard]] ast::Expr *IndexIteratorInit(ast::Expr *iter_ptr, ast::Expr *exec_ctx_var, uint32_t num_attrs,
+                                             uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids);
+
   /**
    * Call \@indexIteratorScanType(&iter[, limit])
    * @param iter The identifier of the index iterator.
@@ -617,6 +638,18 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *IndexIteratorScan(ast::Identifier iter, planner::IndexScanType scan_type, uint32_t limit);
 
+  /**
+   * Call \@indexIteratorParallelScan(). Iterates over the results of the last scan of an index
+   * iterator in parallel, using the provided worker function as a callback.
+   * @param iter_ptr A pointer to the index iterator.
+   * @param query_state A pointer to the query state.
+   * @param thread_state_container A pointer to the thread state.
+   * @param worker_fn The name of the function used to iterate over a range of the results.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *IndexIteratorParallelScan(ast::Expr *iter_ptr, ast::Expr *query_state,
+                                                     ast::Expr *thread_state_container, ast::Identifier worker_fn);
+
   // -------------------------------------------------------
   //
   // VPI stuff
@@ -927,6 +960,71 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *JoinHashTableFree(ast::Expr *join_hash_table);
 
+  /**
+   * Call \@joinHTEnableSpilling(). Let the provided join hash table spill to disk once its build
+   * side exceeds the query memory budget.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableSpilling(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTEnableBloomFilter(). Let the provided join hash table populate a bloom filter over
+   * its build keys when it is built.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableBloomFilter(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTFilterBatch(). Remove the tuples from the TID list whose join key, made up of the
+   * key columns of the vector projection, has no partner in the join hash table, as determined by
+   * its bloom filter and a batched, prefetching lookup.
+   * @param join_hash_table The join hash table.
+   * @param vector_proj The vector projection of probe tuples.
+   * @param tid_list The TID list of the tuples to filter.
+   * @param key_cols The name of the array holding the indexes of the key columns.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableFilterBatch(ast::Expr *join_hash_table, ast::Expr *vector_proj,
+                                                    ast::Expr *tid_list, ast::Identifier key_cols);
+
+  /**
+   * Call \@joinHTIsSpilled(). Determine if the build side of the join hash table was spilled.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableIsSpilled(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTSpillProbe(). Allocates a probe tuple with the given hash value in the spilled
+   * partition of the join hash table it falls into. The returned value is a pointer to an element
+   * with the given type.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe tuple.
+   * @param probe_row_type_name The name of the struct type representing the probe tuple.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableSpillProbe(ast::Expr *join_hash_table, ast::Expr *hash_val,
+                                                   ast::Identifier probe_row_type_name);
+
+  /**
+   * Call \@joinHTLoadSpilledPartition(). Load and build the next spilled partition of the join hash
+   * table that has probe tuples.
+   * @param join_hash_table The join hash table.
+   * @return The call, evaluating to false once all partitions were joined.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableLoadSpilledPartition(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTNextSpilledProbe(). Read the next probe tuple of the loaded spilled partition.
+   * @param join_hash_table The join hash table.
+   * @param probe_row_type_name The name of the struct type representing the probe tuple.
+   * @return The call, evaluating to nil once the probe tuples of the partition are exhausted.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableNextSpilledProbe(ast::Expr *join_hash_table,
+                                                         ast::Identifier probe_row_type_name);
+
   /**
    * Call \@htEntryIterHasNext(). Determine if the provided iterator has more entries. Entries
    * @param iter The iterator.
@@ -1243,6 +1341,32 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *SortTopKParallel(ast::Expr *sorter, ast::Expr *tls, ast::Expr *offset, std::size_t top_k);
 
+  /**
+   * Call \@sorterParallelScan(). Performs a parallel scan over the ranges of a sorted sorter, using
+   * the provided worker function as a callback.
+   * @param sorter A pointer to the sorter.
+   * @param query_state A pointer to the query state.
+   * @param thread_state_container A pointer to the thread state.
+   * @param worker_fn The name of the function used to scan over a range of the sorter.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *SorterParallelScan(ast::Expr *sorter, ast::Expr *query_state,
+                                              ast::Expr *thread_state_container, ast::Identifier worker_fn);
+
+  /**
+   * Call \@sorterParallelScanPartitions(). Performs a parallel scan over ranges of whole partitions
+   * of a sorted sorter, using the provided worker function as a callback.
+   * @param sorter A pointer to the sorter.
+   * @param query_state A pointer to the query state.
+   * @param thread_state_container A pointer to the thread state.
+   * @param partition_fn The name of the function comparing the partitions of two rows.
+   * @param worker_fn The name of the function used to scan over a range of the sorter.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *SorterParallelScanPartitions(ast::Expr *sorter, ast::Expr *query_state,
+                                                        ast::Expr *thread_state_container,
+                                                        ast::Identifier partition_fn, ast::Identifier worker_fn);
+
   /**
    * Call \@sorterFree(). Destroy the provided sorter instance.
    * @param sorter The sorter instance.
@@ -1362,6 +1486,25 @@ class CodeGen {
   ast::Expr *StorageInterfaceInit(ast::Identifier si, ast::Expr *exec_ctx, uint32_t table_oid, ast::Identifier col_oids,
                                   bool need_indexes);
 
+  /**
+   * Call storageInterfaceInitBatched(storage_interface, execCtx, table_oid, col_oids, need_indexes)
+   * @param si_ptr A pointer to the storage interface to initialize, one of the thread-local interfaces of a pipeline.
+   * @param exec_ctx The execution context that we are running in.
+   * @param table_oid The oid of the table being accessed.
+   * @param col_oids The identifier of the array of column oids to access.
+   * @param need_indexes Whether the storage interface will need to use indexes
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *StorageInterfaceInitBatched(ast::Expr *si_ptr, ast::Expr *exec_ctx, uint32_t table_oid,
+                                         ast::Identifier col_oids, bool need_indexes);
+
+  /**
+   * Call storageInterfaceFlush(storage_interface). Write the inserts buffered by a batched storage interface.
+   * @param si_ptr A pointer to the storage interface.
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *StorageInterfaceFlush(ast::Expr *si_ptr);
+
   // ---------------------------------------------------------------------------
   //
   // Identifiers
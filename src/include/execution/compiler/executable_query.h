@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -87,6 +88,16 @@ class ExecutableQuery {
      */
     bool IsCompiled() const { return module_ != nullptr; }
 
+    /**
+     * @return True if the machine code of this fragment is available.
+     */
+    bool IsCompiledToMachineCode() const;
+
+    /**
+     * Compile this fragment to machine code in the background.
+     */
+    void CompileToMachineCodeAsync() const;
+
    private:
     // The functions that must be run (in the provided order) to execute this
     // query fragment.
@@ -127,7 +138,9 @@ class ExecutableQuery {
              std::unique_ptr<selfdriving::PipelineOperatingUnits> pipeline_operating_units);
 
   /**
-   * Execute the query.
+   * Execute the query. In adaptive mode, the query is interpreted until it ran often or long enough according to the
+   * execution settings of the context, after which it is compiled in the background. Once the machine code of a
+   * fragment is available, the fragment runs compiled.
    * @param exec_ctx The context in which to execute the query.
    * @param mode The execution mode to use when running the query. By default, its interpreted.
    */
@@ -161,6 +174,12 @@ class ExecutableQuery {
   /** @return The SQL query string */
   common::ManagedPointer<const std::string> GetQueryText() { return query_text_; }
 
+  /** @return The number of adaptive runs of this query that were interpreted. */
+  uint64_t GetNumInterpretedRuns() const { return num_interpreted_runs_.load(std::memory_order_relaxed); }
+
+  /** @return True if the machine code of all fragments of this query is available. */
+  bool IsCompiledToMachineCode() const;
+
  private:
   // The plan.
   const planner::AbstractPlanNode &plan_;
@@ -180,6 +199,10 @@ class ExecutableQuery {
   // The pipeline operating units that were generated as part of this query.
   std::unique_ptr<selfdriving::PipelineOperatingUnits> pipeline_operating_units_;
 
+  // The interpreted runs of this query in adaptive mode, which may run concurrently in different connections.
+  std::atomic<uint64_t> num_interpreted_runs_{0};
+  std::atomic<uint64_t> interpreted_time_us_{0};
+
   // For mini_runners.cpp
 
   /** Legacy constructor that creates a hardcoded fragment with main(ExecutionContext*)->int32. */
@@ -18,6 +18,9 @@ namespace noisepage::execution::compiler {
 
 /**
  * Delete Translator
+ *
+ * Deletes run in parallel if the pipeline of the child producing the tuples to delete does. Every thread deletes
+ * through its own storage interface in the pipeline state.
  */
 class DeleteTranslator : public OperatorTranslator, public PipelineDriver {
  public:
@@ -37,10 +40,15 @@ class DeleteTranslator : public OperatorTranslator, public PipelineDriver {
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override {}
 
   /**
-   * Initialize the counters.
+   * Initialize the counters and the storage interface.
    */
   void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+  /**
+   * Free the storage interface.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * Implement deletion logic where it fills in the delete PR obtained from the StorageInterface struct
    * with values from the child and then deletes using this from the table and all concerned indexes.
@@ -49,9 +57,15 @@ class DeleteTranslator : public OperatorTranslator, public PipelineDriver {
    */
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
-  /** Record the counters. */
+  /** Record the counters of a serial pipeline. */
   void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+  /** Record the counters of the thread. */
+  void EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  void InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+  void RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * Unreachable.
    * @param col_oid Column oid to return a value for.
@@ -59,21 +73,26 @@ class DeleteTranslator : public OperatorTranslator, public PipelineDriver {
    */
   ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override { UNREACHABLE("Delete doesn't provide values"); }
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Delete is serial."); };
+  /** @return Throw an error, the pipeline is driven by the child. */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
+    UNREACHABLE("Delete does not drive its pipeline.");
+  };
 
-  /** @return Throw an error, this is serial for now. */
+  /** @return Throw an error, the pipeline is driven by the child. */
   void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Delete is serial.");
+    UNREACHABLE("Delete does not drive its pipeline.");
   };
 
  private:
-  // Declare the deleter storage interface.
-  void DeclareDeleter(FunctionBuilder *builder) const;
+  // Initialize the deleter storage interface.
+  void InitDeleter(FunctionBuilder *builder) const;
 
   // Free the delete storage interface.
   void GenDeleterFree(FunctionBuilder *builder) const;
 
+  // Applies the deletes buffered by the storage interface struct.
+  void GenDeleterFlush(FunctionBuilder *builder) const;
+
   // Sets the oids that we are inserting, using the schema from the delete plan node.
   void SetOids(FunctionBuilder *builder) const;
 
@@ -84,8 +103,8 @@ class DeleteTranslator : public OperatorTranslator, public PipelineDriver {
   void GenIndexDelete(FunctionBuilder *builder, WorkContext *context, const catalog::index_oid_t &index_oid) const;
 
  private:
-  // Deleter storage interface struct.
-  ast::Identifier deleter_;
+  // Deleter storage interface struct, in the pipeline state.
+  StateDescriptor::Entry deleter_;
 
   // Column oids of the table we are deleting from.
   ast::Identifier col_oids_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "execution/compiler/compilation_context.h"
@@ -76,18 +77,71 @@ class DistinctAggregationFilter {
   }
 
   /**
-   * Advance a aggregate update to the underlying aggregate accumulator only if the current value
-   * has not existed in the hash table.
+   * Declare a thread-local hash table in the build pipeline, so that the filter can run in parallel. Each thread then
+   * only records the distinct values it sees in its own table; the values are aggregated once the thread-local tables
+   * are merged at the end of the pipeline (see MergeAndAggregate()). This is called in the translator's constructor,
+   * if the build pipeline is parallel.
+   * @param codegen CodeGen object
+   * @param build_pipeline The pipeline the values to aggregate come from
+   */
+  void DeclareLocalHashTable(CodeGen *codegen, Pipeline *build_pipeline);
+
+  /** @return True if the filter records distinct values in thread-local hash tables. */
+  bool IsParallel() const { return build_pipeline_ != nullptr && build_pipeline_->IsParallel(); }
+
+  /**
+   * Initialize the thread-local hash table. This is called at InitializePipelineState() of the build pipeline.
    * @param codegen CodeGen object
    * @param function Function builder
-   * @param advance_call AST call that advance the aggregation
-   * @param agg_val Aggregate value converted to ast::Expr
-   * @param group_bys List of group by values converted to ast::Expr
+   * @param exec_ctx execution context
    */
-  void AggregateDistinct(CodeGen *codegen, FunctionBuilder *function, ast::Expr *advance_call, ast::Expr *agg_val,
-                         const std::vector<ast::Expr *> &group_bys) const;
+  void InitializeLocal(CodeGen *codegen, FunctionBuilder *function, ast::Expr *exec_ctx) const {
+    function->Append(codegen->AggHashTableInit(local_ht_.GetPtr(codegen), exec_ctx, key_type_));
+  }
+
+  /**
+   * Tear down the thread-local hash table. This is called at TearDownPipelineState() of the build pipeline.
+   * @param codegen CodeGen object
+   * @param function Function builder
+   */
+  void TearDownLocal(CodeGen *codegen, FunctionBuilder *function) const {
+    function->Append(codegen->AggHashTableFree(local_ht_.GetPtr(codegen)));
+  }
+
+  /**
+   * Generate the function merging the overflow partitions of the thread-local hash tables, which drops the values
+   * recorded by more than one thread.
+   * @param codegen CodeGen object
+   * @param params The query parameters
+   * @return function declaration pointer
+   */
+  ast::FunctionDecl *GenerateMergePartitionsFunction(CodeGen *codegen,
+                                                     util::RegionVector<ast::FieldDecl *> &&params) const;
+
+  /** Callback aggregating one distinct row, given the name of the (pointer to the) KeyType row. */
+  using AggregateRowFn = std::function<void(FunctionBuilder *function, ast::Identifier distinct_row)>;
+
+  /**
+   * Generate the function scanning one merged partition of distinct values. It runs with the build pipeline's thread
+   * state, and calls the aggregate callback for every distinct row, which must only update thread-local aggregates.
+   * @param codegen CodeGen object
+   * @param aggregate Callback generating the code aggregating a distinct row
+   * @return function declaration pointer
+   */
+  ast::FunctionDecl *GenerateScanPartitionFunction(CodeGen *codegen, const AggregateRowFn &aggregate) const;
+
+  /**
+   * Merge the thread-local hash tables into the global one, and aggregate every distinct value into the thread-local
+   * aggregates of the build pipeline. This is called at FinishPipelineWork() of the build pipeline, before the
+   * thread-local aggregates are merged.
+   * @param codegen CodeGen object
+   * @param function Function builder
+   * @param query_state The query state
+   * @param thread_state_container The build pipeline's thread state container
+   */
+  void MergeAndAggregate(CodeGen *codegen, FunctionBuilder *function, ast::Expr *query_state,
+                         ast::Expr *thread_state_container) const;
 
- private:
   /**
    * Get the value to be aggregated from the KeyType payload
    * @param codegen CodeGen
@@ -105,6 +159,19 @@ class DistinctAggregationFilter {
    */
   ast::Expr *GetGroupByValue(CodeGen *codegen, ast::Expr *row, uint32_t idx) const;
 
+  /**
+   * Advance a aggregate update to the underlying aggregate accumulator only if the current value
+   * has not existed in the hash table. In parallel, the value is only recorded in the thread-local hash table.
+   * @param codegen CodeGen object
+   * @param function Function builder
+   * @param advance_call AST call that advance the aggregation
+   * @param agg_val Aggregate value converted to ast::Expr
+   * @param group_bys List of group by values converted to ast::Expr
+   */
+  void AggregateDistinct(CodeGen *codegen, FunctionBuilder *function, ast::Expr *advance_call, ast::Expr *agg_val,
+                         const std::vector<ast::Expr *> &group_bys) const;
+
+ private:
   /**
    * Compute the hash of a hashtable key
    * @param codegen Codegen object
@@ -143,6 +210,15 @@ class DistinctAggregationFilter {
   // Hash table
   compiler::StateDescriptor::Entry ht_;
 
+  // The build pipeline, if the filter may run in parallel
+  Pipeline *build_pipeline_{nullptr};
+  // Thread-local hash table in parallel mode
+  compiler::StateDescriptor::Entry local_ht_;
+  // Function merging the overflow partitions of the thread-local hash tables
+  ast::Identifier merge_partitions_fn_;
+  // Function aggregating the distinct values of a merged partition
+  ast::Identifier scan_partition_fn_;
+
   // Number of GroupBy
   uint32_t num_group_by_;
 };
@@ -167,6 +167,10 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
   void AdvanceAggregate(WorkContext *ctx, FunctionBuilder *function, ast::Identifier agg_payload,
                         ast::Identifier agg_values) const;
 
+  // In parallel, advance the distinct aggregate term with a row of merged distinct values of the given filter.
+  void AdvanceDistinctAggregate(FunctionBuilder *function, const DistinctAggregationFilter &filter, uint32_t term_idx,
+                                ast::Identifier distinct_row) const;
+
   // Merge the input row into the aggregation hash table.
   void UpdateAggregates(WorkContext *context, FunctionBuilder *function, ast::Expr *agg_ht) const;
 
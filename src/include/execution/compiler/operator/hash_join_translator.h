@@ -23,6 +23,18 @@ class FunctionBuilder;
 
 /**
  * A translator for hash joins.
+ *
+ * Unless the join is a left outer join or runs inside a nested loop join, its hash table spills to
+ * disk once the build side exceeds the query memory budget. Probe tuples of a spilled table are
+ * then materialized into the spilled partitions, and joined once the probe pipeline is done, one
+ * partition at a time.
+ *
+ * If the probe side is a sequential scan and the probe keys are plain columns of the scanned table,
+ * a filter term is pushed down into the scan's filter manager which probes the join hash table with
+ * whole vectors of keys: through a bloom filter over the hashes of the build rows, and, if the
+ * table is out of cache, through a batched lookup that prefetches the bucket chains. Probe tuples
+ * without a join partner are thus dropped before they reach the join, and the remaining ones find
+ * their bucket chains in the cache.
  */
 class HashJoinTranslator : public OperatorTranslator {
  public:
@@ -47,13 +59,13 @@ class HashJoinTranslator : public OperatorTranslator {
 
   /**
    * Only for left outer joins - declare a function joinConsumer which encapsulates the parent translator's
-   * functionality
+   * functionality. If the bloom filter is pushed down, declare the filter term running it.
    * @param decls
    */
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
 
   /**
-   * Define all hook functions
+   * Define all hook functions, and the function joining the spilled partitions in the probe pipeline.
    * @param pipeline Pipeline that helper functions are being generated for.
    * @param decls Query-level declarations.
    */
@@ -61,7 +73,7 @@ class HashJoinTranslator : public OperatorTranslator {
                                          util::RegionVector<ast::FunctionDecl *> *decls) override;
 
   /**
-   * Initialize the global hash table.
+   * Initialize the global hash table, and enable its bloom filter if it's pushed down.
    */
   void InitializeQueryState(FunctionBuilder *function) const override;
 
@@ -129,6 +141,23 @@ class HashJoinTranslator : public OperatorTranslator {
   // Is the given pipeline this join's right pipeline?
   bool IsRightPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
 
+  // Can the join hash table spill, given the operators the probe pipeline pushes to?
+  bool CanSpill(const Pipeline &pipeline) const;
+
+  // Materialize the input tuple into the spilled partition of the join hash table.
+  void SpillProbeRow(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // Generate the function joining the spilled partitions of the join hash table.
+  ast::FunctionDecl *GenerateSpillReplayFunction(const Pipeline &pipeline);
+
+  // Push the bloom filter of the join hash table down into the probe-side scan, if possible. The
+  // filter term also probes tables that are out of cache with a batched lookup.
+  void PushDownBloomFilter(CompilationContext *compilation_context, Pipeline *pipeline);
+
+  // Generate the filter term that runs the probe-side scan's input through the bloom filter and,
+  // if the table is out of cache, a batched lookup.
+  ast::FunctionDecl *GenerateBloomFilterFunction() const;
+
   // Initialize the given join hash table instance, provided as a *JHT.
   void InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const;
 
@@ -177,6 +206,11 @@ class HashJoinTranslator : public OperatorTranslator {
   // Flag to indicate whether or not we are in the joinConsumer function
   bool join_consumer_flag_;
 
+  // Can the join hash table spill to disk?
+  bool spillable_;
+  // Flag to indicate whether or not we are in the function joining spilled partitions
+  bool replaying_spill_;
+
   // The name of the materialized row when inserting into join hash table.
   ast::Identifier build_row_var_;
   ast::Identifier build_row_type_;
@@ -190,6 +224,14 @@ class HashJoinTranslator : public OperatorTranslator {
   // The name of the function which encapuslates the join conumser
   ast::Identifier join_consumer_;
 
+  // The name of the function which joins the spilled partitions
+  ast::Identifier spill_replay_fn_;
+
+  // The name of the filter term pushed into the probe-side scan, and the indexes of the probe keys
+  // in the scan's vector projection. Empty if the bloom filter isn't pushed down.
+  ast::Identifier bloom_filter_fn_;
+  std::vector<uint32_t> bloom_filter_key_cols_;
+
   // The left build-side pipeline.
   Pipeline left_pipeline_;
 
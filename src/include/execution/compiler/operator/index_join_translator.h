@@ -23,6 +23,15 @@ namespace noisepage::execution::compiler {
 
 /**
  * Index join translator.
+ *
+ * Exact index lookups are batched: the keys of up to IndexIterator::BATCH_SIZE outer tuples are collected along with
+ * the outer tuples themselves in the pipeline state, and looked up in the index at once. The matches of every buffered
+ * outer tuple are then pushed to the next operator from a helper function. Lookups are not batched if an operator
+ * further up the pipeline relies on seeing every match right away (a nested loop join, or DML that may change the
+ * index).
+ *
+ * The join runs in parallel whenever the pipeline of its outer child does: every thread looks up the keys of its own
+ * outer tuples, with the batch of lookups kept in its thread-local pipeline state.
  */
 class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
  public:
@@ -33,15 +42,34 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   /** This class cannot be copied or moved. */
   DISALLOW_COPY_AND_MOVE(IndexJoinTranslator);
 
+  void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override {}
 
+  void DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
+                                         util::RegionVector<ast::FunctionDecl *> *decls) override;
+
   void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
   void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
-  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *func) const override {}
+  /**
+   * Flush the lookups still buffered by the thread, then record its counters.
+   */
+  void EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  void InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+  void RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *func) const override;
+
+  /**
+   * @return The value of the given child's attribute, read from the buffered outer tuple while the matches of a batch
+   *         of lookups are pushed.
+   */
+  ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
 
   /**
    * @return The value (or value vector) of the column with the provided column OID in the table
@@ -51,12 +79,14 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
 
   ast::Expr *GetSlotAddress() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Index join is serial."); };
+  /** @return Throw an error, the pipeline is driven by the outer child. */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
+    UNREACHABLE("Index join does not drive its pipeline.");
+  };
 
-  /** @return Throw an error, this is serial for now. */
+  /** @return Throw an error, the pipeline is driven by the outer child. */
   void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Index join is serial.");
+    UNREACHABLE("Index join does not drive its pipeline.");
   };
 
  private:
@@ -68,6 +98,18 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   void DeclareIndexPR(FunctionBuilder *builder) const;
   void DeclareTablePR(FunctionBuilder *builder) const;
   void DeclareSlot(FunctionBuilder *builder) const;
+  // Pointer to the iterator, which lives in the pipeline state if lookups are batched
+  ast::Expr *IteratorPtr() const;
+  // Whether the lookups of this join can be batched in the given pipeline
+  bool CanBatchLookups(const Pipeline &pipeline) const;
+  // Buffers the key and the outer tuple, and flushes the batch once it is full
+  void AddToBatch(WorkContext *context, FunctionBuilder *function) const;
+  // Calls the function that looks up the buffered keys and pushes the matches
+  void FlushBatch(FunctionBuilder *function) const;
+  // Flushes the batch if any keys are buffered
+  void FlushPendingBatch(FunctionBuilder *function) const;
+  // Loops over the matches of the iterator after running loop_init, and pushes them to the next operator
+  void ConsumeMatches(WorkContext *context, FunctionBuilder *function, ast::Stmt *loop_init) const;
 
  private:
   std::vector<catalog::col_oid_t> input_oids_;
@@ -90,5 +132,18 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   StateDescriptor::Entry num_scans_index_;
   // The number of outer loop iterations.
   StateDescriptor::Entry num_loops_;
+
+  // Batched lookups
+  bool batch_lookups_;
+  // True while generating the function that pushes the matches of a batch
+  bool consuming_batch_ = false;
+  ast::Identifier outer_row_type_;
+  ast::Identifier outer_row_var_;
+  ast::Identifier batch_idx_;
+  ast::Identifier flush_batch_fn_;
+  // The iterator, the buffered outer tuples, and the number of buffered outer tuples
+  StateDescriptor::Entry batch_iter_;
+  StateDescriptor::Entry outer_rows_;
+  StateDescriptor::Entry num_outer_rows_;
 };
 }  // namespace noisepage::execution::compiler
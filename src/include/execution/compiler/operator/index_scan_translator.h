@@ -22,7 +22,9 @@ class IndexScanPlanNode;
 namespace noisepage::execution::compiler {
 
 /**
- * Index scan translator.
+ * Index scan translator. Range scans are parallel: the index is scanned once for the matching slots, and the slots
+ * are then split into contiguous ranges that are materialized and pushed up the pipeline on separate threads. Exact
+ * scans are point lookups and are serial.
  */
 class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
  public:
@@ -52,23 +54,31 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
 
   ast::Expr *GetSlotAddress() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Index scan is serial."); };
+  /**
+   * @return The pipeline work function parameters. Just the *IndexIterator over the range of results to process.
+   */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Index scan is serial.");
-  };
+  /**
+   * Scan the index, then launch a parallel iteration over the results.
+   * @param function The pipeline generating function.
+   * @param work_func_name The name of the work function that implements the pipeline logic.
+   */
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override;
 
  private:
+  // Pointer to the index iterator the work function iterates over
+  ast::Expr *IteratorPtr(const Pipeline &pipeline, FunctionBuilder *function) const;
+  // Declare the index iterator and fill in its keys
+  void PrepareScan(WorkContext *context, FunctionBuilder *function) const;
   void DeclareIterator(FunctionBuilder *builder) const;
   void SetOids(FunctionBuilder *builder) const;
   void FillKey(WorkContext *context, FunctionBuilder *builder, ast::Identifier pr,
                const std::unordered_map<catalog::indexkeycol_oid_t, planner::IndexExpression> &index_exprs) const;
   void FreeIterator(FunctionBuilder *builder) const;
   void DeclareIndexPR(FunctionBuilder *builder) const;
-  void DeclareTablePR(FunctionBuilder *builder) const;
-  void DeclareSlot(FunctionBuilder *builder) const;
+  void DeclareTablePR(FunctionBuilder *builder, ast::Expr *iter) const;
+  void DeclareSlot(FunctionBuilder *builder, ast::Expr *iter) const;
 
  private:
   std::vector<catalog::col_oid_t> input_oids_;
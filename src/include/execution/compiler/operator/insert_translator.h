@@ -19,6 +19,10 @@ namespace noisepage::execution::compiler {
 
 /**
  * InsertTranslator
+ *
+ * Inserts either the rows of values in the plan, in a serial pipeline it drives, or the output of its child. Inserting
+ * the output of the child (INSERT INTO ... SELECT) runs in parallel if the child's pipeline does. Every thread inserts
+ * through its own batched storage interface in the pipeline state, which is flushed at the end of the thread's work.
  */
 class InsertTranslator : public OperatorTranslator, public PipelineDriver {
  public:
@@ -38,12 +42,19 @@ class InsertTranslator : public OperatorTranslator, public PipelineDriver {
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override {}
 
   /**
-   * Initialize the counters.
+   * Initialize the counters and the storage interface.
    * @param pipeline The current pipeline.
    * @param function The pipeline generating function.
    */
   void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+  /**
+   * Free the storage interface.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * Implement insertion logic where it fills in the insert PR obtained from the StorageInterface struct
    * with values from the child.
@@ -52,6 +63,23 @@ class InsertTranslator : public OperatorTranslator, public PipelineDriver {
    */
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
+  /**
+   * Flush the inserts of a serial pipeline and record the counters.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Flush the inserts of the thread and record its counters.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  void InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+  void RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * @return The child's output at the given index.
    */
@@ -62,21 +90,29 @@ class InsertTranslator : public OperatorTranslator, public PipelineDriver {
    */
   ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override;
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Insert is serial."); };
+  /** @return Throw an error, inserting values is serial. */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
+    UNREACHABLE("Inserting values is serial.");
+  };
 
-  /** @return Throw an error, this is serial for now. */
+  /** @return Throw an error, inserting values is serial. */
   void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Insert is serial.");
+    UNREACHABLE("Inserting values is serial.");
   };
 
  private:
-  // Declare storage interface.
-  void DeclareInserter(FunctionBuilder *builder) const;
+  // Initialize the storage interface.
+  void InitInserter(FunctionBuilder *builder) const;
 
   // Free the storage interface.
   void GenInserterFree(FunctionBuilder *builder) const;
 
+  // Write the buffered inserts.
+  void GenInserterFlush(FunctionBuilder *builder) const;
+
+  // Insert the row in the projected row into the table and its indexes.
+  void GenInsertRow(FunctionBuilder *builder, WorkContext *context) const;
+
   // Sets the oids that we are inserting on, using the schema from the insert plan node.
   void SetOids(FunctionBuilder *builder) const;
 
@@ -89,6 +125,9 @@ class InsertTranslator : public OperatorTranslator, public PipelineDriver {
   // Sets the values in the projected row which we will use to insert into the table.
   void GenSetTablePR(FunctionBuilder *builder, WorkContext *context, uint32_t idx) const;
 
+  // Sets the values in the projected row to the output of the child.
+  void GenSetTablePRFromChild(FunctionBuilder *builder, WorkContext *context) const;
+
   // Insert into the table.
   void GenTableInsert(FunctionBuilder *builder) const;
 
@@ -98,8 +137,8 @@ class InsertTranslator : public OperatorTranslator, public PipelineDriver {
   // Gets all the column oids in a schema.
   static std::vector<catalog::col_oid_t> AllColOids(const catalog::Schema &table_schema);
 
-  // Storage interface inserter struct which we use to insert.
-  ast::Identifier inserter_;
+  // Storage interface inserter struct which we use to insert, in the pipeline state.
+  StateDescriptor::Entry inserter_;
 
   // Projected row that the inserter spits out for us to insert with.
   ast::Identifier insert_pr_;
@@ -92,10 +92,24 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   /** @return The expression representing the current VPI. */
   ast::Expr *GetVPI() const;
 
+  /**
+   * Add a filter term that is only known at runtime, e.g., the bloom filter of a hash join whose
+   * probe side this scan feeds. The term is added to every clause of the scan's filter manager.
+   * @param term The name of the function implementing the term. It must have the signature of a
+   *             filter clause function, and receives the query state as its context.
+   */
+  void AddRuntimeFilter(ast::Identifier term);
+
+  /** @return The index of the given column OID inside the col_oids that the plan is scanning over. */
+  uint32_t GetColOidIndex(catalog::col_oid_t col_oid) const;
+
  private:
   // Does the scan have a predicate?
   bool HasPredicate() const;
 
+  // Does the scan filter its input, either with a predicate or with runtime filters?
+  bool HasFilter() const { return HasPredicate() || !runtime_filters_.empty(); }
+
   // Get the OID of the table being scanned.
   catalog::table_oid_t GetTableOid() const;
 
@@ -126,9 +140,6 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   static std::vector<catalog::col_oid_t> MakeInputOids(const catalog::Schema &schema,
                                                        const planner::SeqScanPlanNode &op);
 
-  /** @return The index of the given column OID inside the col_oids that the plan is scanning over. */
-  uint32_t GetColOidIndex(catalog::col_oid_t col_oid) const;
-
   // The name of the declared TVI and VPI.
   ast::Identifier tvi_var_;
   ast::Identifier vpi_var_;
@@ -144,6 +155,9 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   // definition, but only if there's a predicate.
   std::vector<std::vector<ast::Identifier>> filters_;
 
+  // The filter terms added by other operators, which are part of every clause.
+  std::vector<ast::Identifier> runtime_filters_;
+
   // The version of col_oids that we use for translation. See MakeInputOids for justification.
   std::vector<catalog::col_oid_t> col_oids_;
 
@@ -91,16 +91,16 @@ class SortTranslator : public OperatorTranslator, public PipelineDriver {
   void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
   /**
-   * Sorters are never launched in parallel, so this should never occur..
+   * @return The pipeline work function parameters. Just the *SorterIterator over the range to scan.
    */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Impossible"); }
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
 
   /**
-   * Sorters are never launched in parallel, so this should never occur.
+   * Launch a parallel scan over the ranges of the sorter.
+   * @param function The pipeline generating function.
+   * @param work_func_name The name of the work function that implements the pipeline logic.
    */
-  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Impossible");
-  }
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override;
 
   /**
    * @return The value (vector) of the attribute at the given index (@em attr_idx) produced by the
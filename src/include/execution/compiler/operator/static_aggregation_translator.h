@@ -43,6 +43,14 @@ class StaticAggregationTranslator : public OperatorTranslator, public PipelineDr
    */
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
 
+  /**
+   * When parallel, generate the functions aggregating the merged distinct values into the partial aggregates.
+   * @param pipeline Pipeline that helper functions are being generated for.
+   * @param decls Query-level declarations.
+   */
+  void DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
+                                         util::RegionVector<ast::FunctionDecl *> *decls) override;
+
   /**
    * If the provided pipeline is the build-side, initialize the declare partial aggregate.
    * @param pipeline The pipeline whose state is being initialized.
@@ -50,6 +58,13 @@ class StaticAggregationTranslator : public OperatorTranslator, public PipelineDr
    */
   void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+  /**
+   * If the provided pipeline is the build-side, destroy the thread-local distinct hash tables.
+   * @param pipeline The pipeline whose state is being destroyed.
+   * @param function The function being built.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * Initialize the global aggregation hash table.
    */
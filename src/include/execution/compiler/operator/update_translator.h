@@ -19,6 +19,10 @@ namespace noisepage::execution::compiler {
 
 /**
  * Update Translator
+ *
+ * Updates run in parallel if the pipeline of the child producing the tuples to update does. Every thread updates
+ * through its own batched storage interface in the pipeline state, so the new versions of tuples moved by an indexed
+ * update are inserted in batches, flushed at the end of the thread's work.
  */
 class UpdateTranslator : public OperatorTranslator, public PipelineDriver {
  public:
@@ -38,12 +42,19 @@ class UpdateTranslator : public OperatorTranslator, public PipelineDriver {
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override {}
 
   /**
-   * Initialize the counters.
+   * Initialize the counters and the storage interface.
    * @param pipeline The current pipeline.
    * @param function The pipeline generating function.
    */
   void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+  /**
+   * Free the storage interface.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * Implement update logic where it fills in the update PR obtained from the StorageInterface struct
    * with values from the child and then updates using this the table and all concerned indexes.
@@ -53,9 +64,15 @@ class UpdateTranslator : public OperatorTranslator, public PipelineDriver {
    */
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
-  /** Record the counters for Lin's models. */
+  /** Flush the inserts of a serial pipeline and record the counters for Lin's models. */
   void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
+  /** Flush the inserts of the thread and record its counters. */
+  void EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  void InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+  void RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * @return The value (vector) of the attribute at the given index (@em attr_idx) produced by the
    *         child at the given index (@em child_idx).
@@ -67,24 +84,29 @@ class UpdateTranslator : public OperatorTranslator, public PipelineDriver {
    */
   ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override;
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Update is serial."); };
+  /** @return Throw an error, the pipeline is driven by the child. */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
+    UNREACHABLE("Update does not drive its pipeline.");
+  };
 
-  /** @return Throw an error, this is serial for now. */
+  /** @return Throw an error, the pipeline is driven by the child. */
   void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Update is serial.");
+    UNREACHABLE("Update does not drive its pipeline.");
   };
 
  private:
   // Generates the update on the table.
   void GenTableUpdate(FunctionBuilder *builder) const;
 
-  // Declares the storage interface struct used to update.
-  void DeclareUpdater(FunctionBuilder *builder) const;
+  // Initializes the storage interface struct used to update.
+  void InitUpdater(FunctionBuilder *builder) const;
 
   // Frees the storage interface struct used to update.
   void GenUpdaterFree(FunctionBuilder *builder) const;
 
+  // Applies the writes buffered by the storage interface struct.
+  void GenUpdaterFlush(FunctionBuilder *builder) const;
+
   // Sets the columns oids that we are updating on.
   void SetOids(FunctionBuilder *builder) const;
 
@@ -112,8 +134,8 @@ class UpdateTranslator : public OperatorTranslator, public PipelineDriver {
   static std::vector<catalog::col_oid_t> CollectOids(const catalog::Schema &schema);
 
  private:
-  // Storage interface struct that we are updating with.
-  ast::Identifier updater_;
+  // Storage interface struct that we are updating with, in the pipeline state.
+  StateDescriptor::Entry updater_;
 
   // Projected row that we use to update.
   ast::Identifier update_pr_;
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
+#include "execution/compiler/pipeline_driver.h"
+
+namespace noisepage::planner {
+class WindowPlanNode;
+}  // namespace noisepage::planner
+
+namespace noisepage::execution::compiler {
+
+class FunctionBuilder;
+
+/**
+ * A translator for window plans. The build side materializes the input rows into a sorter, ordered
+ * by the partition keys followed by the sort keys. The produce side scans the sorted rows one peer
+ * group at a time: a lead iterator runs over the peer group first to advance the window aggregates
+ * and to find where the group ends, after which the rows of the group are output with the window
+ * values. The produce side runs in parallel over ranges of whole partitions.
+ */
+class WindowTranslator : public OperatorTranslator, public PipelineDriver {
+ public:
+  /**
+   * Create a translator for the given window plan node.
+   * @param plan The plan.
+   * @param compilation_context The context this translator belongs to.
+   * @param pipeline The pipeline this translator is participating in.
+   */
+  WindowTranslator(const planner::WindowPlanNode &plan, CompilationContext *compilation_context, Pipeline *pipeline);
+
+  /**
+   * Define the sort-row structure that's materialized in the sorter.
+   * @param decls The top-level declarations.
+   */
+  void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
+  /**
+   * Define the functions comparing the order and the partitions of sort rows.
+   * @param decls The top-level declarations.
+   */
+  void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
+
+  /**
+   * Initialize the sorter instance.
+   */
+  void InitializeQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * Tear-down the sorter instance.
+   */
+  void TearDownQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is for the build-side and is parallel, initialize the thread-local sorter.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is for the build-side and is parallel, destroy the thread-local sorter.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Implement either the build-side or the produce-side of the window depending on the pipeline
+   * this context contains.
+   * @param ctx The context of the work.
+   * @param function The pipeline function generator.
+   */
+  void PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is for the build-side, sort the materialized rows.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * @return The pipeline work function parameters. The two *SorterIterator over the range to scan.
+   */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
+
+  /**
+   * Launch a parallel scan over ranges of whole partitions of the sorter.
+   * @param function The pipeline generating function.
+   * @param work_func_name The name of the work function that implements the pipeline logic.
+   */
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override;
+
+  /**
+   * @return The value of the attribute at the given index (@em attr_idx) of the child at index 0,
+   *         or the value of the window term at the given index if @em child_idx is 1.
+   */
+  ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
+  /**
+   * Window operators do not produce columns from base tables.
+   */
+  ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
+    UNREACHABLE("Window operators do not produce columns from base tables");
+  }
+
+  void InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+  void RecordCounters(const Pipeline &pipeline, FunctionBuilder *function) const override;
+  void EndParallelPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+ private:
+  friend class selfdriving::OperatingUnitRecorder;
+
+  // Check if the given pipelines are build or scan
+  bool IsBuildPipeline(const Pipeline &pipeline) const { return &build_pipeline_ == &pipeline; }
+  bool IsScanPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
+
+  // For minirunners.
+  ast::StructDecl *GetStructDecl() const { return struct_decl_; }
+
+  // Access the attribute at the given index within the provided sort row.
+  ast::Expr *GetSortRowAttribute(ast::Identifier sort_row, uint32_t attr_idx) const;
+
+  // Generate the body of a comparison function, over the partition keys only or over all keys.
+  void GenerateComparisonFunction(FunctionBuilder *function, bool partition_only);
+
+  // Called to insert the tuple in the context into the sorter instance.
+  void InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // Called to scan the sorted rows with the provided iterators and compute the window terms.
+  void ScanSorter(WorkContext *ctx, FunctionBuilder *function, ast::Expr *iter, ast::Expr *lead) const;
+
+  // Advance the aggregates of the window terms with the sort row.
+  void AdvanceAggregates(FunctionBuilder *function) const;
+
+ private:
+  // The name of the materialized sort row when inserting into sorter or pulling
+  // from an iterator.
+  ast::Identifier sort_row_var_;
+  ast::Identifier sort_row_type_;
+  ast::StructDecl *struct_decl_;
+  ast::Identifier lhs_row_, rhs_row_;
+  // The first row of the current peer group.
+  ast::Identifier group_row_var_;
+  ast::Identifier compare_func_;
+  ast::Identifier partition_compare_func_;
+
+  // The running state of the window terms.
+  ast::Identifier row_number_var_, rank_var_, dense_rank_var_, num_peers_var_;
+  ast::Identifier new_partition_var_, in_group_var_;
+  std::vector<ast::Identifier> agg_vars_;
+  std::vector<ast::Identifier> agg_value_vars_;
+
+  // Build-side pipeline.
+  Pipeline build_pipeline_;
+
+  // Where the global and thread-local sorter instances are.
+  StateDescriptor::Entry global_sorter_;
+  StateDescriptor::Entry local_sorter_;
+
+  enum class CurrentRow { Child, Lhs, Rhs };
+  CurrentRow current_row_;
+
+  // The number of rows that are inserted into the sorter.
+  StateDescriptor::Entry num_window_build_rows_;
+  // The number of rows that are output by the window.
+  StateDescriptor::Entry num_window_iterate_rows_;
+};
+
+}  // namespace noisepage::execution::compiler
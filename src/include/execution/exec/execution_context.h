@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/exec/output.h"
 #include "execution/exec_defs.h"
@@ -98,12 +100,23 @@ class EXPORT ExecutionContext {
    */
   common::ManagedPointer<transaction::TransactionContext> GetTxn() { return txn_; }
 
+  /**
+   * @return The latch parallel DML pipelines take around their writes to the transaction, since the transaction's
+   *         undo and redo buffers are not thread-safe.
+   */
+  common::SpinLatch *GetTxnLatch() { return &txn_latch_; }
+
   /**
    * Constructs a new Output Buffer for outputting query results to consumers
    * @return newly created output buffer
    */
   OutputBuffer *OutputBufferNew();
 
+  /**
+   * @return The callback query output is passed to.
+   */
+  const OutputCallback &GetOutputCallback() const { return callback_; }
+
   /**
    * @return The thread state container.
    */
@@ -133,6 +146,23 @@ class EXPORT ExecutionContext {
   /** @return The execution settings. */
   const exec::ExecutionSettings &GetExecutionSettings() const { return exec_settings_; }
 
+  /**
+   * Reserve memory for tuples an operator buffers, within the query memory budget of the execution settings.
+   * Operators that cannot get a reservation spill the tuples they buffer to disk.
+   * @param bytes The number of bytes to reserve.
+   * @return True if the memory was reserved; false if the reservation would exceed the query memory budget.
+   */
+  bool TryReserveMemory(uint64_t bytes);
+
+  /**
+   * Release memory reserved through TryReserveMemory().
+   * @param bytes The number of bytes to release.
+   */
+  void ReleaseMemory(uint64_t bytes) { reserved_memory_ -= bytes; }
+
+  /** @return The number of bytes currently reserved by the operators of the query. */
+  uint64_t GetReservedMemory() const { return reserved_memory_.load(); }
+
   /**
    * Start the resource tracker
    */
@@ -186,6 +216,11 @@ class EXPORT ExecutionContext {
    */
   void SetExecutionMode(uint8_t mode) { execution_mode_ = mode; }
 
+  /**
+   * @return the integer value of the recorded execution mode
+   */
+  uint8_t GetExecutionMode() const { return execution_mode_; }
+
   /**
    * Set the accessor
    * @param accessor The catalog accessor.
@@ -210,7 +245,7 @@ class EXPORT ExecutionContext {
    * INSERT, UPDATE, and DELETE queries return a number for the rows affected, so this should be incremented in the root
    * nodes of the query
    */
-  uint32_t &RowsAffected() { return rows_affected_; }
+  uint32_t RowsAffected() const { return rows_affected_.load(); }
 
   /**
    * Set the PipelineOperatingUnits
@@ -227,8 +262,8 @@ class EXPORT ExecutionContext {
     return pipeline_operating_units_;
   }
 
-  /** Increment or decrement the number of rows affected. */
-  void AddRowsAffected(int64_t num_rows) { rows_affected_ += num_rows; }
+  /** Increment or decrement the number of rows affected. Parallel DML pipelines may call this concurrently. */
+  void AddRowsAffected(int64_t num_rows) { rows_affected_.fetch_add(static_cast<uint32_t>(num_rows)); }
 
   /**
    * If the calling thread is not registered with any metrics manager, this function
@@ -283,6 +318,11 @@ class EXPORT ExecutionContext {
    */
   void SetQueryState(void *query_state) { query_state_ = query_state; }
 
+  /**
+   * @return The opaque query state pointer of the current query invocation; null if no query is running.
+   */
+  void *GetQueryState() const { return query_state_; }
+
   /**
    * Sets the estimated concurrency of a parallel operation.
    * This value is used when initializing an ExecOUFeatureVector
@@ -323,6 +363,7 @@ class EXPORT ExecutionContext {
   exec::ExecutionSettings exec_settings_;
   catalog::db_oid_t db_oid_;
   common::ManagedPointer<transaction::TransactionContext> txn_;
+  common::SpinLatch txn_latch_;
   std::unique_ptr<sql::MemoryTracker> mem_tracker_;
   std::unique_ptr<sql::MemoryPool> mem_pool_;
   std::unique_ptr<OutputBuffer> buffer_ = nullptr;
@@ -339,12 +380,13 @@ class EXPORT ExecutionContext {
   common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
   common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> params_;
   uint8_t execution_mode_;
-  uint32_t rows_affected_ = 0;
+  std::atomic<uint32_t> rows_affected_{0};
 
   bool memory_use_override_ = false;
   uint32_t memory_use_override_value_ = 0;
   uint32_t num_concurrent_estimate_ = 0;
+  std::atomic<uint64_t> reserved_memory_{0};
   std::vector<HookFn> hooks_{};
-  void *query_state_;
+  void *query_state_{nullptr};
 };
 }  // namespace noisepage::execution::exec
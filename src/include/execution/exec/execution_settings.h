@@ -70,6 +70,18 @@ class EXPORT ExecutionSettings {
   /** @return number of threads used for parallel execution. */
   int GetNumberOfParallelExecutionThreads() const { return number_of_parallel_execution_threads_; }
 
+  /**
+   * @return The memory (in bytes) a query may use for the tuples buffered by operators that can spill to disk, or zero
+   *         if memory use is not limited.
+   */
+  uint64_t GetQueryMemoryBudget() const { return query_memory_budget_; }
+
+  /** @return The number of interpreted runs after which an adaptively executed query is compiled. */
+  uint64_t GetAdaptiveCompileRuns() const { return adaptive_compile_runs_; }
+
+  /** @return The total time (us) of interpreted runs after which an adaptively executed query is compiled. */
+  uint64_t GetAdaptiveCompileInterpretTimeUs() const { return adaptive_compile_interpret_time_us_; }
+
   /** @return True if static partitioner is enabled. */
   constexpr bool GetIsStaticPartitionerEnabled() const { return is_static_partitioner_enabled_; }
 
@@ -83,6 +95,9 @@ class EXPORT ExecutionSettings {
   bool is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
   int number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
   bool is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+  uint64_t query_memory_budget_{common::Constants::QUERY_MEMORY_BUDGET};
+  uint64_t adaptive_compile_runs_{common::Constants::ADAPTIVE_COMPILE_RUNS};
+  uint64_t adaptive_compile_interpret_time_us_{common::Constants::ADAPTIVE_COMPILE_INTERPRET_TIME_US};
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
   friend class noisepage::runner::MiniRunners;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,6 +11,7 @@
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/macros.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/util/execution_common.h"
 #include "network/network_defs.h"
@@ -23,6 +27,8 @@ class OutputSchema;
 
 namespace noisepage::execution::exec {
 
+class ExecutionContext;
+
 // Callback function
 // Params(): tuples, num_tuples, tuple_size;
 using OutputCallback = std::function<void(byte *, uint32_t, uint32_t)>;
@@ -58,8 +64,7 @@ class EXPORT OutputBuffer {
    */
   byte *AllocOutputSlot() {
     if (num_tuples_ == BATCH_SIZE) {
-      callback_(tuples_, num_tuples_, tuple_size_);
-      num_tuples_ = 0;
+      Flush();
     }
     // Return the current slot and advance to the to the next one.
     num_tuples_++;
@@ -86,6 +91,10 @@ class EXPORT OutputBuffer {
    */
   uint32_t GetTupleSize() const { return tuple_size_; }
 
+ private:
+  // Pass the buffered tuples on to the callback, or to the ordered output of the range being produced
+  void Flush();
+
  private:
   sql::MemoryPool *memory_pool_;
   uint32_t num_tuples_;
@@ -102,6 +111,96 @@ class EXPORT OutputBuffer {
   const OutputCallback &callback_;
 };
 
+/**
+ * Restores the order of query output that is produced in parallel over ordered ranges of the input, such as the ranges
+ * of a sorter. The output of every range is produced by Produce(). Output buffers flushed while a range is produced on
+ * the current thread stage their tuples with the range instead of passing them to the callback, and the staged tuples
+ * of a range are passed to the callback once all earlier ranges have been output.
+ *
+ * Staged tuples are charged to the query memory budget. Once a reservation fails, ranges that have not started yet are
+ * deferred to Finish(), which produces them one after the other on the calling thread, straight to the callback. A
+ * range that cannot reserve memory for its tuples passes them to the callback directly if all earlier ranges have been
+ * output, and otherwise stages them without a reservation, so the budget is exceeded by at most the ranges in flight.
+ */
+class EXPORT OrderedOutput {
+ public:
+  /**
+   * Constructor
+   * @param exec_ctx execution context whose query memory budget the staged tuples are charged to
+   * @param num_ranges number of ranges the output is produced over
+   * @param callback upper layer callback
+   */
+  OrderedOutput(ExecutionContext *exec_ctx, uint64_t num_ranges, const OutputCallback &callback);
+
+  /**
+   * Destructor. Releases the memory reserved for tuples that were never output.
+   */
+  ~OrderedOutput();
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(OrderedOutput);
+
+  /**
+   * Produce the output of a range, then output all ranges that are ready. If the staged tuples ran out of the memory
+   * budget, the range is deferred to Finish() instead. Every range must be passed to Produce exactly once.
+   * @param range index of the range
+   * @param produce function producing the output of the given range on the current thread
+   */
+  void Produce(uint64_t range, const std::function<void(uint64_t)> &produce);
+
+  /**
+   * Produce the deferred ranges and output all remaining ranges, in order. Must be called once all ranges have been
+   * passed to Produce().
+   * @param produce function producing the output of the given range on the current thread
+   */
+  void Finish(const std::function<void(uint64_t)> &produce);
+
+  /**
+   * Stage a batch of tuples with the range being produced on the current thread, if any.
+   * @param tuples batch of tuples
+   * @param num_tuples number of tuples
+   * @param tuple_size size of tuples
+   * @return true if the tuples were staged; false if they are to be passed to the callback right away
+   */
+  static bool Stage(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size);
+
+ private:
+  struct Range {
+    // The staged tuples
+    std::vector<byte> tuples_;
+    // The size of the staged tuples
+    uint32_t tuple_size_{0};
+    // The number of bytes reserved for the staged tuples
+    uint64_t reserved_{0};
+    // Whether the range has been produced
+    bool done_{false};
+    // Whether the range passes its tuples to the callback directly, because all earlier ranges have been output
+    bool streaming_{false};
+  };
+
+  // Stage a batch of tuples with the given range
+  bool StageRange(uint64_t range, const byte *tuples, uint32_t num_tuples, uint32_t tuple_size);
+
+  // Pass the staged tuples of a range to the callback, and free them. The mutex must be held.
+  void OutputRange(Range *range);
+
+  // The output the range being produced on the current thread belongs to, if any, and the index of that range
+  static thread_local OrderedOutput *current_output_;
+  static thread_local uint64_t current_range_;
+
+  ExecutionContext *exec_ctx_;
+  const OutputCallback &callback_;
+  std::vector<Range> ranges_;
+  // Latch for outputting ranges
+  std::mutex mutex_;
+  // The first range that has not been output
+  uint64_t next_range_{0};
+  // Whether a reservation for staged tuples failed, from which point on ranges are deferred
+  std::atomic<bool> over_budget_{false};
+};
+
 /**
  * Only For Debugging.
  * A OutputCallback that prints tuples to standard out.
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "execution/util/cpu_info.h"
@@ -16,10 +17,13 @@ class ExecutionUtil {
 
   /**
    * Initialize all TPL subsystems
+   * @param jit_object_cache_directory directory in which JIT-compiled object code is cached across runs, empty for none
+   * @param jit_object_cache_size maximum size of the JIT-compiled object code cache in bytes
    */
-  static void InitTPL() {
+  static void InitTPL(const std::string &jit_object_cache_directory = "",
+                      uint64_t jit_object_cache_size = vm::LLVMEngine::DEFAULT_OBJECT_CACHE_MAX_SIZE) {
     execution::CpuInfo::Instance();
-    execution::vm::LLVMEngine::Initialize();
+    execution::vm::LLVMEngine::Initialize(jit_object_cache_directory, jit_object_cache_size);
   }
 
   /**
@@ -9,6 +9,7 @@
 #include "common/managed_pointer.h"
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_projection.h"
 #include "execution/util/chunked_vector.h"
@@ -41,6 +42,14 @@ class AHTOverflowPartitionIterator;
 
 /**
  * The hash table used when performing aggregations.
+ *
+ * In partitioned mode, when the query has a memory budget, the table reserves memory for its
+ * entries from the budget of the execution context every time it flushes to its overflow
+ * partitions. Once a reservation is refused, the overflow partitions are written out to temporary
+ * files, grouped into a fixed number of spill partitions, and their memory is freed. The partitioned
+ * scans then load one spill partition at a time, re-aggregate and scan its overflow partitions, and
+ * free them before moving to the next. Spill partitions that exceed the budget when loaded are split
+ * into smaller ranges of overflow partitions first.
  */
 class EXPORT AggregationHashTable {
  public:
@@ -64,6 +73,9 @@ class EXPORT AggregationHashTable {
   /** The default precision used to configure the HyperLogLog instances. Set to optimize accuracy and space manually. */
   static constexpr uint32_t DEFAULT_HLL_PRECISION = 10;
 
+  /** The number of files overflow partitions are spilled to. Each covers a range of overflow partitions. */
+  static constexpr uint32_t NUM_SPILL_PARTITIONS = 16;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -280,6 +292,11 @@ class EXPORT AggregationHashTable {
    */
   const Stats *GetStatistics() const { return &stats_; }
 
+  /**
+   * @return True if overflow partitions of this table have been spilled to disk; false otherwise.
+   */
+  bool IsSpilled() const noexcept { return !spill_files_.empty() || !spilled_partitions_.empty(); }
+
   // Specialized hash table mapping hash values to group IDs
   class HashToGroupIdMap;
 
@@ -287,6 +304,15 @@ class EXPORT AggregationHashTable {
   friend class AHTIterator;
   friend class AHTVectorIterator;
 
+  // The spilled entries of a range of overflow partitions.
+  struct SpilledPartition {
+    // The files holding the entries
+    std::vector<std::unique_ptr<SpillFile>> files_;
+    // The range of overflow partitions the entries fall into
+    uint32_t begin_;
+    uint32_t end_;
+  };
+
   // Does the hash table need to grow?
   bool NeedsToGrow() const noexcept { return hash_table_.GetElementCount() >= max_fill_; }
 
@@ -309,6 +335,35 @@ class EXPORT AggregationHashTable {
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Reserve memory for all entries after a flush, or mark the overflow
+  // partitions to be spilled before the next insertion if the budget is
+  // exhausted
+  void ReserveMemory();
+
+  // Write all overflow partitions out to the spill files and free their memory
+  void SpillOverflowPartitions();
+
+  // Free all entries and release their memory reservation
+  void ReleaseEntries();
+
+  // Move the spill files of another table into this table's spilled partitions
+  void AdoptSpilledPartitions(AggregationHashTable *source);
+
+  // Split a spilled range of overflow partitions into smaller ranges
+  void RepartitionSpilled(SpilledPartition *partition);
+
+  // Load, merge, and scan the spilled partitions one after the other. The
+  // scan is parallel if a thread state container is provided.
+  void ScanSpilledPartitions(void *query_state, ThreadStateContainer *thread_states, ScanPartitionFn scan_fn);
+
+  // Build tables over and scan the given non-empty overflow partitions in
+  // parallel
+  void ScanPartitionsParallel(void *query_state, ThreadStateContainer *thread_states,
+                              const std::vector<uint32_t> &partitions, ScanPartitionFn scan_fn);
+
+  // Destroy the table built over an overflow partition
+  void FreePartitionTable(uint32_t partition_idx);
+
   // Called from ProcessBatch() to compute hash values for tuples in batch.
   void ComputeHash(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes);
 
@@ -428,6 +483,22 @@ class EXPORT AggregationHashTable {
   // partition an entry is linked into.
   uint64_t partition_shift_bits_;
 
+  // -------------------------------------------------------
+  // Spilling
+  // -------------------------------------------------------
+
+  // Whether entries are reserved from the query memory budget.
+  bool spilling_enabled_;
+  // The memory reserved from the query memory budget, in bytes.
+  uint64_t reserved_memory_{0};
+  // Whether the overflow partitions must be spilled before the next insertion.
+  bool spill_pending_{false};
+  // The files this table spilled its overflow partitions to, one per spill
+  // partition.
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+  // The spilled partitions left to scan, the next one at the back.
+  std::vector<SpilledPartition> spilled_partitions_;
+
   // Runtime stats.
   Stats stats_;
 
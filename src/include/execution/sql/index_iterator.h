@@ -13,11 +13,36 @@ class SqlTable;
 }  // namespace noisepage::storage
 
 namespace noisepage::execution::sql {
+
+class ThreadStateContainer;
+
 /**
  * Allows iteration for indices from TPL.
+ *
+ * The results of a scan can also be iterated in parallel with ParallelScan(), which splits them into contiguous ranges
+ * of the key order that are handed to a scan function on separate threads, each through an iterator of its own.
  */
 class EXPORT IndexIterator {
  public:
+  /** Maximum number of keys in a batch, see AddBatchKey. */
+  static constexpr uint32_t BATCH_SIZE = 256;
+
+  /**
+   * The number of results in each range of a parallel scan. We use a smaller value in DEBUG mode so that tests exercise
+   * multiple ranges without requiring large tables.
+   */
+#ifndef NDEBUG
+  static constexpr uint64_t PARALLEL_SCAN_RANGE_SIZE = 256;
+#else
+  static constexpr uint64_t PARALLEL_SCAN_RANGE_SIZE = 4096;
+#endif
+
+  /**
+   * Function to scan one range of the results of a scan. Receives the query state, the thread-local state of the
+   * executing thread, and an iterator over the range.
+   */
+  using ScanRangeFn = void (*)(void *, void *, IndexIterator *);
+
   /**
    * Constructor
    * @param exec_ctx execution containing of this query
@@ -62,6 +87,34 @@ class EXPORT IndexIterator {
    */
   void ScanLimitDescending(uint32_t limit);
 
+  /**
+   * Adds the key in the index PR to the batch of keys looked up by the next ScanBatch. At most BATCH_SIZE keys can be
+   * added between two calls to ScanBatch.
+   */
+  void AddBatchKey();
+
+  /**
+   * Looks up all keys of the batch at once, and empties the batch. The results of every key are iterated over after
+   * selecting the key with SelectBatchKey.
+   */
+  void ScanBatch();
+
+  /**
+   * Positions the iterator before the results of a key of the last scanned batch
+   * @param key_idx position of the key in the batch, in the order the keys were added
+   */
+  void SelectBatchKey(uint32_t key_idx);
+
+  /**
+   * Iterates over the results of the last scan in parallel. The results are split into contiguous ranges of
+   * PARALLEL_SCAN_RANGE_SIZE, and @em scan_fn is invoked once per range with an iterator over the range. Query output
+   * produced while iterating over a range is emitted in range order, so output stays in key order.
+   * @param query_state The (opaque) query state.
+   * @param thread_states The container holding the thread-local state of all threads.
+   * @param scan_fn The function to iterate over a range with.
+   */
+  void ParallelScan(void *query_state, ThreadStateContainer *thread_states, ScanRangeFn scan_fn) const;
+
   /**
    * Advances the iterator. Return true if successful
    * @return whether the iterator was advanced or not.
@@ -100,6 +153,10 @@ class EXPORT IndexIterator {
    */
   uint32_t GetIndexSize() const { return index_->GetSize(); }
 
+ private:
+  // Create an initialized iterator over the results at positions [begin, end) of the last scan of another iterator
+  IndexIterator(const IndexIterator &source, uint64_t begin, uint64_t end);
+
  private:
   exec::ExecutionContext *exec_ctx_;
   uint32_t num_attrs_;
@@ -115,6 +172,14 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *hi_index_pr_;
   storage::ProjectedRow *table_pr_;
   std::vector<storage::TupleSlot> tuples_{};
+
+  // Keys of the current batch, laid out back to back and allocated on the first AddBatchKey
+  void *batch_buffer_ = nullptr;
+  uint32_t batch_key_size_ = 0;
+  uint32_t num_batch_keys_ = 0;
+  // Results of the last scanned batch, the results of key i are at [batch_offsets_[i], batch_offsets_[i + 1])
+  std::vector<storage::TupleSlot> batch_tuples_{};
+  std::vector<uint32_t> batch_offsets_{};
 };
 
 }  // namespace noisepage::execution::sql
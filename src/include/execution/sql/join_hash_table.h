@@ -1,8 +1,14 @@
 #pragma once
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/spin_latch.h"
@@ -10,6 +16,7 @@
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/concise_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -24,7 +31,9 @@ class ExecutionContext;
 namespace noisepage::execution::sql {
 
 class ThreadStateContainer;
+class TupleIdList;
 class Vector;
+class VectorProjection;
 
 /**
  * The main class used to for hash joins. JoinHashTables are bulk-loaded through calls to
@@ -45,7 +54,28 @@ class Vector;
  *
  * In parallel mode, thread-local join hash tables are lazily built and merged in parallel into a
  * global join hash table through a call to JoinHashTable::MergeParallel(). After this call, the
- * global table takes ownership of all thread-local allocated memory and hash index.
+ * global table takes ownership of all thread-local allocated memory and hash index. When the
+ * estimated size of the build side exceeds the last-level cache, the merge radix-partitions tuples
+ * on their hash value instead and builds one cache-sized chaining table per partition, without
+ * any synchronization. Probes are routed to the table of the partition their hash falls into.
+ *
+ * Join hash tables that have spilling enabled through JoinHashTable::EnableSpilling() reserve the
+ * memory for buffered build tuples from the query memory budget of the execution context. Once a
+ * reservation is refused, the table turns into a grace hash join: all build tuples are partitioned
+ * on their hash value into temporary files, probe tuples are written to the matching partition
+ * through JoinHashTable::AllocSpilledProbeTuple(), and once the probe side is exhausted, partitions
+ * are loaded and joined one at a time:
+ *
+ * @code
+ * while (jht.LoadNextSpilledPartition()) {
+ *   for (auto probe = jht.NextSpilledProbeTuple(); probe != nullptr; probe = jht.NextSpilledProbeTuple()) {
+ *     // Lookup and join the probe tuple as usual
+ *   }
+ * }
+ * @endcode
+ *
+ * Partitions that still exceed the budget are partitioned again on further hash bits, up to a fixed
+ * number of levels, after which they are loaded regardless.
  */
 class EXPORT JoinHashTable {
  public:
@@ -63,6 +93,28 @@ class EXPORT JoinHashTable {
   /** Minimum number of expected elements to merge before triggering a parallel merge. */
   static constexpr uint32_t DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE = 1024;
 
+  /** Maximum number of hash bits used to radix-partition a parallel build. */
+  static constexpr uint32_t MAX_RADIX_BITS = 10;
+
+  /** Number of hash bits used to partition spilled tuples at every level. */
+  static constexpr uint32_t SPILL_RADIX_BITS = 4;
+
+  /** Maximum number of times spilled tuples are partitioned. */
+  static constexpr uint32_t MAX_SPILL_LEVELS = 3;
+
+  /** The amount of memory reserved from the query memory budget at a time, in bytes. */
+  static constexpr uint64_t MEMORY_RESERVATION_SIZE = 1024 * 1024;
+
+  /** Number of tuples FilterBatch() looks up before it decides whether its lookups pay off. */
+  static constexpr uint64_t FILTER_LOOKUP_SAMPLE_SIZE = 4 * common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+  /**
+   * Fraction of the tuples looked up that FilterBatch() has to remove for its lookups to pay off.
+   * Every tuple that is kept looks its bucket chain up again when it is probed, so a lookup that
+   * removes few tuples costs more than its prefetching saves.
+   */
+  static constexpr double FILTER_LOOKUP_MIN_REMOVED_FRACTION = 0.25;
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the injected @em memory,
    * and thus, are ephemeral.
@@ -94,6 +146,48 @@ class EXPORT JoinHashTable {
    */
   byte *AllocInputTuple(hash_t hash);
 
+  /**
+   * Enable spilling to disk when the buffered build tuples exceed the query memory budget. Must be
+   * called before any tuple is inserted. Tables using a concise hash table never spill.
+   */
+  void EnableSpilling();
+
+  /**
+   * @return True if the build side of this table has been spilled to disk, and probes must be
+   *         written to JoinHashTable::AllocSpilledProbeTuple() instead of looked up.
+   */
+  bool IsSpilled() const noexcept { return spilled_; }
+
+  /**
+   * Populate a bloom filter over the hash values of all build tuples when the table is built, so
+   * that probe-side tuples can be filtered through JoinHashTable::FilterBatch() before they
+   * probe the table. Must be called before the table is built. Spilled tables have no bloom filter.
+   */
+  void EnableBloomFilter() { use_bloom_filter_ = true; }
+
+  /**
+   * Allocate a record for a probe tuple whose hash value is @em hash in the spilled partition the
+   * hash falls into. Safe to call concurrently from multiple threads.
+   * @pre The table is built and spilled.
+   * @param hash The hash value of the probe tuple.
+   * @param probe_size The size of the probe tuple. Must be the same for all probe tuples.
+   * @return A memory region where the caller can materialize the probe tuple.
+   */
+  byte *AllocSpilledProbeTuple(hash_t hash, uint32_t probe_size);
+
+  /**
+   * Load the next spilled partition that has probe tuples, and build the hash table over it. The
+   * previously loaded partition is released.
+   * @pre The table is built and spilled, and all probe tuples have been allocated.
+   * @return True if a partition was loaded; false if all partitions have been joined.
+   */
+  bool LoadNextSpilledPartition();
+
+  /**
+   * @return The next probe tuple of the loaded spilled partition; null if there are none left.
+   */
+  byte *NextSpilledProbeTuple();
+
   /**
    * Build and finalize the join hash table. After finalization, no new insertions are allowed and
    * the table becomes read-only. Nothing is done if the join hash table has already been finalized.
@@ -118,6 +212,24 @@ class EXPORT JoinHashTable {
    */
   void LookupBatch(const Vector &hashes, Vector *results) const;
 
+  /**
+   * Remove the tuples in @em tid_list that have no join partner in this table. The join key of a
+   * tuple is made up of the columns of @em input at the indexes in @em key_cols, which are hashed
+   * in the same order as the build keys. Tuples are first checked against the bloom filter of the
+   * table, if it has one. If the table is larger than the last-level cache, the remaining tuples
+   * are then looked up in a batch, and the tuples that find no bucket chain are removed. Since the
+   * batched lookup prefetches the chains, they are cached when the tuples are probed one by one.
+   * The lookups stop for good once the first FILTER_LOOKUP_SAMPLE_SIZE tuples looked up show that
+   * they remove less than FILTER_LOOKUP_MIN_REMOVED_FRACTION of the tuples.
+   * @pre The table is built.
+   * @param input The probe-side vector projection.
+   * @param key_cols The indexes of the join key columns in the vector projection.
+   * @param num_key_cols The number of join key columns.
+   * @param tid_list The list of tuples to filter.
+   */
+  void FilterBatch(VectorProjection *input, const uint32_t key_cols[], uint32_t num_key_cols,
+                   TupleIdList *tid_list) const;
+
   /**
    * Merge all thread-local hash tables stored in the state contained into this table. Perform the
    * merge in parallel.
@@ -137,8 +249,14 @@ class EXPORT JoinHashTable {
    *         as the hash table directory), excludes storage for materialized tuple contents.
    */
   uint64_t GetJoinIndexMemoryUsage() const {
-    return UsingConciseHashTable() ? concise_hash_table_.GetTotalMemoryUsage()
-                                   : chaining_hash_table_.GetTotalMemoryUsage();
+    if (UsingConciseHashTable()) {
+      return concise_hash_table_.GetTotalMemoryUsage();
+    }
+    uint64_t size = chaining_hash_table_.GetTotalMemoryUsage();
+    for (const auto &partition : partitions_) {
+      size += partition->GetTotalMemoryUsage();
+    }
+    return size;
   }
 
   /**
@@ -184,6 +302,16 @@ class EXPORT JoinHashTable {
    */
   bool UsingConciseHashTable() const { return use_concise_ht_; }
 
+  /**
+   * @return True if this join hash table was built as radix partitions through MergeParallel().
+   */
+  bool IsPartitioned() const { return !partitions_.empty(); }
+
+  /**
+   * @return The number of radix partitions of this join hash table; zero if it isn't partitioned.
+   */
+  uint32_t GetNumPartitions() const { return static_cast<uint32_t>(partitions_.size()); }
+
   /**
    * @return The underlying bloom filter.
    */
@@ -193,6 +321,25 @@ class EXPORT JoinHashTable {
   friend class JoinHashTableIterator;
   FRIEND_TEST(JoinHashTableTest, LazyInsertionTest);
   FRIEND_TEST(JoinHashTableTest, PerfTest);
+  FRIEND_TEST(JoinHashTableTest, PartitionedParallelBuildTest);
+  FRIEND_TEST(JoinHashTableTest, PrefetchingLookupBatchTest);
+  FRIEND_TEST(JoinHashTableTest, PrefetchingLookupBatchConciseTableTest);
+  FRIEND_TEST(JoinHashTableTest, FilterBatchLookupGateTest);
+
+  // The build and probe tuples of one spilled partition. Probe tuples come in
+  // one file per thread that probed the table.
+  struct SpilledPartition {
+    std::vector<std::unique_ptr<SpillFile>> build_;
+    std::vector<std::unique_ptr<SpillFile>> probe_;
+    uint32_t level_{0};
+  };
+
+  // Spilled probe records start with the hash of the probe tuple.
+  static constexpr std::size_t SPILLED_PROBE_HEADER_SIZE = alignof(std::max_align_t);
+
+  // Hash bits [RADIX_SHIFT, RADIX_SHIFT + MAX_RADIX_BITS) select the partition. They sit below the
+  // tag bits of the chaining table and above the bucket bits of any cache-sized partition table.
+  static constexpr uint32_t RADIX_SHIFT = sizeof(hash_t) * 8 - 4 - MAX_RADIX_BITS;
 
   // Access a stored entry by index
   HashTableEntry *EntryAt(const uint64_t idx) { return reinterpret_cast<HashTableEntry *>(entries_[idx]); }
@@ -216,15 +363,68 @@ class EXPORT JoinHashTable {
   void VerifyMainEntryOrder();
   void VerifyOverflowEntryOrder();
 
+  // Add the hash values of all build tuples to the bloom filter.
+  void BuildBloomFilter();
+
   // Dispatched from LookupBatch() to lookup from either a chaining or concise
-  // hash table in batched manner.
+  // hash table in batched manner, with configurable prefetching.
+  template <bool PrefetchIndex, bool PrefetchEntries>
   void LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const;
+  template <bool PrefetchIndex, bool PrefetchEntries>
   void LookupBatchInConciseHashTable(const Vector &hashes, Vector *results) const;
 
+  // Whether FilterBatch() should still look up the tuples that pass the bloom
+  // filter: until it has seen enough tuples to tell, or while its lookups
+  // remove enough of them.
+  bool FilterLookupPaysOff() const;
+
   // Merge the source hash table (which isn't built yet) into this one
   template <bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // Compute the number of radix bits to partition a parallel build of the given
+  // estimated size with. Zero if the build fits in cache and needn't be partitioned.
+  uint32_t ComputeRadixBits(uint64_t num_elem_estimate) const;
+
+  // Scatter the entries of all source tables into 2^radix_bits partitions and
+  // build one chaining table per partition, all in parallel.
+  void MergePartitioned(ThreadStateContainer *thread_state_container, const std::vector<JoinHashTable *> &sources,
+                        uint32_t radix_bits);
+
+  // The partition the given hash value falls into.
+  uint64_t PartitionIndex(const hash_t hash) const { return (hash >> RADIX_SHIFT) & (partitions_.size() - 1); }
+
+  // The chaining table holding entries with the given hash value.
+  const TaggedChainingHashTable &ChainingTableFor(const hash_t hash) const {
+    return partitions_.empty() ? chaining_hash_table_ : *partitions_[PartitionIndex(hash)];
+  }
+
+  // The spilled partition at the given level the given hash value falls into.
+  static uint32_t SpillPartitionIndex(const hash_t hash, const uint32_t level) {
+    return (hash >> (RADIX_SHIFT - (level + 1) * SPILL_RADIX_BITS)) & ((1u << SPILL_RADIX_BITS) - 1);
+  }
+
+  // Reserve memory for another batch of build tuples. If the budget is exhausted,
+  // spill the buffered build tuples and return false.
+  bool ReserveMemory();
+
+  // Allocate a build tuple straight in its spilled partition.
+  byte *AllocSpilledInputTuple(hash_t hash);
+
+  // Write all buffered build tuples to their spilled partitions, and release
+  // their memory.
+  void SpillBufferedEntries();
+
+  // Free the buffered build tuples, and give back their memory reservation.
+  void ReleaseBufferedEntries();
+
+  // Take over the spilled build tuples of the given table (possibly this one)
+  // into the partitions to be joined.
+  void AdoptSpilledBuild(JoinHashTable *source);
+
+  // Partition the tuples of the given spilled partition on the next hash bits.
+  void RepartitionSpilled(SpilledPartition *partition);
+
  private:
   // The execution context to run with.
   const exec::ExecutionSettings &exec_settings_;
@@ -244,6 +444,10 @@ class EXPORT JoinHashTable {
   // The chaining hash table.
   TaggedChainingHashTable chaining_hash_table_;
 
+  // The chaining hash tables of each radix partition, if the table was built
+  // partitioned. The chaining hash table above is unused in that case.
+  std::vector<std::unique_ptr<TaggedChainingHashTable>> partitions_;
+
   // The concise hash table.
   ConciseHashTable concise_hash_table_;
 
@@ -259,6 +463,43 @@ class EXPORT JoinHashTable {
   // Should we use a concise hash table?
   bool use_concise_ht_;
 
+  // The number of bytes beyond which the join index or the build tuples are
+  // assumed to be out of cache, and batched lookups prefetch them. The size of
+  // the L3 cache, which tests may lower to run the prefetching paths.
+  uint64_t prefetch_threshold_;
+
+  // The number of tuples FilterBatch() looked up, and how many of them it
+  // removed. Updated by all threads probing the table.
+  mutable std::atomic<uint64_t> num_filter_lookups_{0};
+  mutable std::atomic<uint64_t> num_filter_lookups_removed_{0};
+
+  // Should the bloom filter be populated when the table is built?
+  bool use_bloom_filter_{false};
+
+  // Has the build side been spilled to disk?
+  bool spilled_{false};
+
+  // The memory reserved from the query memory budget, and the number of build
+  // tuples it covers.
+  uint64_t reserved_memory_{0};
+  uint64_t reserved_tuples_{std::numeric_limits<uint64_t>::max()};
+
+  // The files build tuples are spilled to, one per partition.
+  std::vector<std::unique_ptr<SpillFile>> spilled_build_;
+
+  // The thread-local files probe tuples are spilled to, one per partition.
+  tbb::enumerable_thread_specific<std::vector<std::unique_ptr<SpillFile>>> spilled_probes_;
+
+  // The spilled partitions left to join, the next one at the back.
+  std::vector<SpilledPartition> spilled_partitions_;
+
+  // Have the thread-local probe files been handed over to the partitions?
+  bool spilled_probes_collected_{false};
+
+  // The probe files of the loaded partition, and the one being read.
+  std::vector<std::unique_ptr<SpillFile>> loaded_probes_;
+  std::size_t loaded_probe_idx_{0};
+
   // MemoryTracker
   common::ManagedPointer<MemoryTracker> tracker_;
 };
@@ -270,7 +511,7 @@ class EXPORT JoinHashTable {
 /** Look up the specified hash, do not use the concise hash table. */
 template <>
 inline HashTableEntryIterator JoinHashTable::Lookup<false>(const hash_t hash) const {
-  HashTableEntry *entry = chaining_hash_table_.FindChainHead(hash);
+  HashTableEntry *entry = ChainingTableFor(hash).FindChainHead(hash);
   while (entry != nullptr && entry->hash_ != hash) {
     entry = entry->next_;
   }
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <vector>
 
 #include "catalog/schema.h"
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace noisepage::execution::exec {
@@ -15,6 +17,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SorterIterator;
 class ThreadStateContainer;
 class VectorProjection;
 class VectorProjectionIterator;
@@ -66,7 +69,19 @@ class VectorProjectionIterator;
  * instances managed by a tpl::sql::ThreadStatesContainer. Each thread will insert into their
  * thread-local Sorter, but <b>without calling</b> Sorter::Sort(). When all insertions are complete
  * across all threads, the primary thread uses Sorter::SortParallel() or Sorter::SortTopKParallel()
- * for parallel sort and parallel Top-K, respectively.
+ * for parallel sort and parallel Top-K, respectively. A sorted sorter can also be scanned in parallel
+ * with Sorter::ParallelScan(), which splits the sorted tuples into contiguous ranges that are handed
+ * to a scan function on separate threads. Query output produced by the scan of a range is held back
+ * until all earlier ranges have been output, so results reach the client in sorted order.
+ * Sorter::ParallelScanPartitions() does the same with ranges that never split a partition of
+ * tuples, for operators such as window functions that process each partition as a whole.
+ *
+ * When the query has a memory budget, sorters reserve the memory for buffered tuples from the
+ * budget of the execution context. Once a reservation is refused, the buffered tuples are sorted
+ * and written out to a temporary file as a sorted run, and buffering starts over. Sorting a sorter
+ * that spilled runs writes out the remaining tuples as a final run, and iterators then stream the
+ * tuples through a k-way merge of the runs instead of reading them from memory. Top-K sorters only
+ * ever buffer K tuples and never spill.
  */
 class EXPORT Sorter {
  public:
@@ -91,11 +106,37 @@ class EXPORT Sorter {
   static constexpr uint64_t DEFAULT_MIN_TUPLES_FOR_PARALLEL_SORT = 10000;
 #endif
 
+  /**
+   * The number of tuples in each range of a parallel scan. We use a smaller value in DEBUG mode so
+   * that tests exercise multiple ranges without requiring large Sorters.
+   */
+#ifndef NDEBUG
+  static constexpr uint64_t PARALLEL_SCAN_RANGE_SIZE = 1000;
+#else
+  static constexpr uint64_t PARALLEL_SCAN_RANGE_SIZE = 16384;
+#endif
+
+  /** The amount of memory reserved from the query memory budget at a time, in bytes. */
+  static constexpr uint64_t MEMORY_RESERVATION_SIZE = 1024 * 1024;
+
   /**
    * The comparison function used to sort tuples in a Sorter.
    */
   using ComparisonFunction = int32_t (*)(const void *lhs, const void *rhs);
 
+  /**
+   * Function to scan one range of the sorted tuples. Receives the query state, the thread-local
+   * state of the executing thread, and an iterator over the range.
+   */
+  using ScanRangeFn = void (*)(void *, void *, SorterIterator *);
+
+  /**
+   * Function to scan one range of whole partitions of the sorted tuples. Receives the query state,
+   * the thread-local state of the executing thread, and two independent iterators positioned at the
+   * start of the range.
+   */
+  using ScanPartitionsFn = void (*)(void *, void *, SorterIterator *, SorterIterator *);
+
   /**
    * Construct a sorter using @em memory as the memory allocator, storing tuples @em tuple_size
    * size in bytes, and using the comparison function @em cmp_fn.
@@ -166,9 +207,35 @@ class EXPORT Sorter {
   void SortTopKParallel(ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k);
 
   /**
-   * @return The number of tuples currently in this sorter.
+   * Scan the sorted tuples of this sorter in parallel. The tuples are split into contiguous ranges
+   * of PARALLEL_SCAN_RANGE_SIZE tuples, and @em scan_fn is invoked once per range with an iterator
+   * over the range. Query output produced while scanning a range is emitted in range order. A sorter
+   * that spilled runs to disk is merged on the calling thread as a single range.
+   * @param query_state The (opaque) query state.
+   * @param thread_states The container holding the thread-local state of all threads.
+   * @param scan_fn The function to scan a range with.
+   */
+  void ParallelScan(void *query_state, ThreadStateContainer *thread_states, ScanRangeFn scan_fn) const;
+
+  /**
+   * Scan the sorted tuples of this sorter in parallel, keeping partitions whole. Tuples belong to
+   * the same partition if @em partition_fn compares them as equal. Ranges start out as in
+   * ParallelScan(), but the end of every range is moved forward to the start of the next partition.
+   * @em scan_fn is invoked once per range with two independent iterators over the range, so that it
+   * can look ahead of the rows it outputs. Query output is emitted in range order. A sorter that
+   * spilled runs to disk is merged on the calling thread as a single range.
+   * @param query_state The (opaque) query state.
+   * @param thread_states The container holding the thread-local state of all threads.
+   * @param partition_fn The function comparing the partitions of two tuples.
+   * @param scan_fn The function to scan a range with.
+   */
+  void ParallelScanPartitions(void *query_state, ThreadStateContainer *thread_states, ComparisonFunction partition_fn,
+                              ScanPartitionsFn scan_fn) const;
+
+  /**
+   * @return The number of tuples currently in this sorter, including tuples spilled to disk.
    */
-  uint64_t GetTupleCount() const noexcept { return tuples_.size(); }
+  uint64_t GetTupleCount() const noexcept { return tuples_.size() + num_spilled_tuples_; }
 
   /**
    * @return True if this sorter contains no tuples; false otherwise.
@@ -180,7 +247,31 @@ class EXPORT Sorter {
    */
   bool IsSorted() const noexcept { return sorted_; }
 
+  /**
+   * @return True if this sorter has written sorted runs to disk; false otherwise.
+   */
+  bool IsSpilled() const noexcept { return !runs_.empty(); }
+
  private:
+  // Allocate a buffered tuple, without checking the memory reservation
+  byte *AllocBufferedTuple();
+
+  // Reserve memory for more buffered tuples, spilling the buffered tuples if
+  // the budget is exhausted
+  void ReserveMemory();
+
+  // Sort the buffered tuples and write them out as a new run
+  void SpillRun();
+
+  // Free the buffered tuples and release their memory reservation
+  void ReleaseBufferedTuples();
+
+  // Move the runs and memory reservation of another sorter into this one
+  void AdoptSpilledRuns(Sorter *source);
+
+  // Perform a parallel sort of thread-local sorters of which some have spilled
+  void SortParallelSpilled(ThreadStateContainer *thread_state_container, const std::vector<Sorter *> &tl_sorters);
+
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
 
@@ -210,10 +301,23 @@ class EXPORT Sorter {
 
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
+
+  // The sorted runs written to disk, if any
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  // The number of tuples in the spilled runs
+  uint64_t num_spilled_tuples_{0};
+
+  // The memory reserved from the query memory budget, in bytes
+  uint64_t reserved_memory_{0};
+  // The number of buffered tuples the reservation covers
+  uint64_t reserved_tuples_{std::numeric_limits<uint64_t>::max()};
 };
 
 /**
- * An iterator over the elements in a sorter instance.
+ * An iterator over the elements in a sorter instance. Iterating over a sorter that spilled runs to
+ * disk merges the runs on the fly. Rows of a spilled sorter are only valid until the iterator is
+ * advanced. Every iterator reads the runs through its own cursors, so several iterators can walk
+ * the same sorter at once.
  */
 class SorterIterator {
   using IteratorType = decltype(Sorter::tuples_)::const_iterator;
@@ -225,15 +329,30 @@ class SorterIterator {
    */
   explicit SorterIterator(const Sorter &sorter);
 
+  /**
+   * Create an iterator over the tuples at positions [begin, end) of the provided sorter. Only valid
+   * for sorters that have not spilled.
+   * @param sorter The sorter instance.
+   * @param begin The position of the first tuple to iterate.
+   * @param end The position one past the last tuple to iterate.
+   */
+  SorterIterator(const Sorter &sorter, uint64_t begin, uint64_t end);
+
   /**
    * @return True if the iterator has more data; false otherwise.
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return merging_ ? !heap_.empty() : iter_ != end_; }
 
   /**
    * Advance the iterator by one tuple.
    */
-  void Next() { ++iter_; }
+  void Next() {
+    if (UNLIKELY(merging_)) {
+      NextMerged();
+      return;
+    }
+    ++iter_;
+  }
 
   /**
    * Advance the iterator by @em n rows. If there are fewer than @em n rows remaining in this
@@ -245,14 +364,16 @@ class SorterIterator {
   /**
    * @return The number of tuples remaining in the iterator.
    */
-  uint64_t NumRemaining() const { return std::distance(iter_, end_); }
+  uint64_t NumRemaining() const {
+    return merging_ ? num_merge_remaining_ : static_cast<uint64_t>(std::distance(iter_, end_));
+  }
 
   /**
    * @return A pointer to the current row. It assumed the called has checked the iterator is valid.
    */
   const byte *GetRow() const {
-    NOISEPAGE_ASSERT(iter_ != end_, "Invalid iterator");
-    return *iter_;
+    NOISEPAGE_ASSERT(HasNext(), "Invalid iterator");
+    return merging_ ? heap_.front().row_ : *iter_;
   }
 
   /**
@@ -281,11 +402,32 @@ class SorterIterator {
     return *this;
   }
 
+ private:
+  // The current row of a spilled run
+  struct MergeEntry {
+    const byte *row_;
+    SpillFile::Reader *run_;
+  };
+
+  // Advance the merge of spilled runs by one tuple
+  void NextMerged();
+
  private:
   // The current iterator position
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+
+  // Whether the tuples are merged from spilled runs
+  const bool merging_;
+  // The function used to compare two tuples
+  const Sorter::ComparisonFunction cmp_fn_;
+  // The cursors over the spilled runs
+  std::vector<std::unique_ptr<SpillFile::Reader>> readers_;
+  // The min-heap of the current rows of all non-exhausted runs
+  std::vector<MergeEntry> heap_;
+  // The number of tuples left in the merge
+  uint64_t num_merge_remaining_{0};
 };
 
 /**
@@ -308,6 +450,13 @@ class SorterVectorIterator {
   SorterVectorIterator(const Sorter &sorter, const catalog::Schema::Column *column_info, uint32_t num_cols,
                        TransposeFn transpose_fn);
 
+  /**
+   * Construct a vector iterator over the tuples at positions [begin, end) of the given sorter
+   * instance. Used to consume the ranges of a sorter in parallel.
+   */
+  SorterVectorIterator(const Sorter &sorter, uint64_t begin, uint64_t end,
+                       const std::vector<const catalog::Schema::Column *> &column_info, TransposeFn transpose_fn);
+
   /**
    * Destructor.
    */
@@ -329,6 +478,9 @@ class SorterVectorIterator {
   VectorProjectionIterator *GetVectorProjectionIterator() { return vector_projection_iterator_.get(); }
 
  private:
+  SorterVectorIterator(const Sorter &sorter, SorterIterator iter,
+                       const std::vector<const catalog::Schema::Column *> &column_info, TransposeFn transpose_fn);
+
   void BuildVectorProjection(TransposeFn transpose_fn);
 
  private:
@@ -341,6 +493,13 @@ class SorterVectorIterator {
   // Temporary array storing the sorter rows
   const byte **temp_rows_;
 
+  // The size of the sorter's tuples
+  const std::size_t tuple_size_;
+
+  // Buffer the rows of a spilled sorter are copied into, as they don't outlive
+  // the next step of the merge; null if the sorter hasn't spilled
+  byte *row_buffer_;
+
   // The vector projections produced by this iterator
   std::unique_ptr<VectorProjection> vector_projection_;
 
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/util/file.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * A SpillFile is a temporary file of fixed-size records that operators write tuples to when they run out of memory.
+ * Records are written and read through an in-memory buffer, and the file is only created once the buffer first fills
+ * up, so files that end up holding few records never touch the disk. The file is deleted when the SpillFile is
+ * destroyed.
+ *
+ * A SpillFile is first written to, then read (possibly several times) from the start:
+ * @code
+ * SpillFile file(sizeof(Tuple));
+ * for (...) {
+ *   auto *tuple = reinterpret_cast<Tuple *>(file.Append());
+ *   tuple->a = ...
+ * }
+ * file.Rewind();
+ * for (byte *r = file.Next(); r != nullptr; r = file.Next()) {
+ *   auto *tuple = reinterpret_cast<Tuple *>(r);
+ *   ...
+ * }
+ * @endcode
+ *
+ * Pointers returned by Append() and Next() are only valid until the next call to either function. A file that is done
+ * being written can also be read by any number of independent SpillFile::Reader cursors at the same time.
+ */
+class SpillFile {
+ public:
+  /**
+   * A read cursor over a spill file that is done being written. Every reader reads the file through its own buffer, so
+   * several readers can read the same file at once without disturbing each other or the file's own cursor.
+   */
+  class Reader {
+   public:
+    /**
+     * Create a reader positioned at the first record of the provided file.
+     * @param file The file to read. Must have finished being written.
+     */
+    explicit Reader(const SpillFile &file);
+
+    /**
+     * This class cannot be copied or moved.
+     */
+    DISALLOW_COPY_AND_MOVE(Reader);
+
+    /**
+     * Read the next record of the file.
+     * @return A pointer to the contents of the next record, valid until the next call; null if all records were read.
+     */
+    const byte *Next();
+
+   private:
+    // The file being read
+    const SpillFile &file_;
+    // The buffer records are read into, if the file is on disk
+    std::vector<byte> buffer_;
+    // The number of records in the buffer
+    std::size_t buffered_records_{0};
+    // The position of the next record to read from the buffer
+    std::size_t buffer_cursor_{0};
+    // The number of records read
+    uint64_t num_read_{0};
+  };
+
+  /** The size of the in-memory buffer records are written and read through. */
+  static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+  /**
+   * Create an empty spill file.
+   * @param record_size The size of the records in the file, in bytes.
+   */
+  explicit SpillFile(std::size_t record_size);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Allocate a new record at the end of the file. Only valid before the file is first rewound.
+   * @return A pointer to the memory the contents of the record are to be written into.
+   */
+  byte *Append();
+
+  /**
+   * Finish writing the file. No more records can be appended afterwards.
+   */
+  void Finish();
+
+  /**
+   * Finish writing, if the file is still being written, and position the read cursor at the first record.
+   */
+  void Rewind();
+
+  /**
+   * Read the next record of the file. Only valid after the file is rewound.
+   * @return A pointer to the contents of the next record; null if all records have been read.
+   */
+  byte *Next();
+
+  /** @return The number of records in the file. */
+  uint64_t GetRecordCount() const noexcept { return num_records_; }
+
+  /** @return The size of the records in the file, in bytes. */
+  std::size_t GetRecordSize() const noexcept { return record_size_; }
+
+  /** @return True if some records were written out to disk; false if all records fit in the buffer. */
+  bool IsOnDisk() const noexcept { return file_.IsOpen(); }
+
+ private:
+  // Write the records in the buffer to the end of the file.
+  void FlushBuffer();
+
+  // Read the next batch of records from the file into the buffer.
+  void FillBuffer();
+
+ private:
+  // The size of every record.
+  const std::size_t record_size_;
+  // The number of records the buffer holds.
+  const std::size_t buffer_capacity_;
+  // The underlying temporary file, created when the buffer is first flushed.
+  util::File file_;
+  // The buffer records are written into and read from.
+  std::vector<byte> buffer_;
+  // The number of records in the buffer.
+  std::size_t buffered_records_{0};
+  // The position of the next record to read from the buffer.
+  std::size_t buffer_cursor_{0};
+  // The number of records in the file.
+  uint64_t num_records_{0};
+  // The number of records read since the last rewind.
+  uint64_t num_read_{0};
+  // Whether the file is still being written.
+  bool writing_{true};
+};
+
+}  // namespace noisepage::execution::sql
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
@@ -27,9 +28,21 @@ namespace sql {
 
 /**
  * Base class to interact with the storage layer (tables and indexes).
+ *
+ * A batched storage interface is one of several thread-local interfaces of a parallel DML pipeline writing in the same
+ * transaction. Since the transaction's undo and redo buffers are not thread-safe, its writes are buffered in
+ * thread-local memory until BATCH_SIZE table writes are buffered or Flush() is called, and then applied with the
+ * execution context's transaction latch taken once for the whole batch. New rows claim runs of slots in the table
+ * rather than one slot per row, and the indexes are updated one after the other. The slot of a new row is only known
+ * once it is flushed, so rows are inserted with TableInsertBatched() rather than TableInsert(). A failed delete or
+ * update aborts the transaction when the batch is flushed. Unique index inserts are not buffered: they flush the batch
+ * and insert the key right away, so that a violation aborts the transaction at the row that causes it.
  */
 class EXPORT StorageInterface {
  public:
+  /** The number of table writes a batched storage interface buffers before applying them. */
+  static constexpr uint32_t BATCH_SIZE = 256;
+
   /**
    * Constructor
    * @param exec_ctx The execution context.
@@ -37,9 +50,10 @@ class EXPORT StorageInterface {
    * @param col_oids Col oids to updated.
    * @param num_oids Number of column oids.
    * @param need_indexes Whether this will use indexes.
+   * @param batched Whether writes are buffered and applied in batches.
    */
   explicit StorageInterface(exec::ExecutionContext *exec_ctx, catalog::table_oid_t table_oid, uint32_t *col_oids,
-                            uint32_t num_oids, bool need_indexes);
+                            uint32_t num_oids, bool need_indexes, bool batched = false);
 
   /**
    * Destructor.
@@ -52,25 +66,31 @@ class EXPORT StorageInterface {
   noisepage::storage::ProjectedRow *GetTablePR();
 
   /**
-   * Delete slot from the table.
+   * Delete slot from the table. In a batched storage interface, the delete is buffered and this always succeeds.
    * @param tuple_slot slot to delete.
    * @return Whether the deletion was successful.
    */
   bool TableDelete(storage::TupleSlot tuple_slot);
 
   /**
-   * Update a tuple in the table.
+   * Update a tuple in the table. In a batched storage interface, the update is buffered and this always succeeds.
    * @param table_tuple_slot tuple slot of the tuple.
    * @return Whether update was successful.
    */
   bool TableUpdate(storage::TupleSlot table_tuple_slot);
 
   /**
-   * Reinsert tuple into table.
+   * Reinsert tuple into table. Not available in a batched storage interface.
    * @return slot where the insertion occurred.
    */
   storage::TupleSlot TableInsert();
 
+  /**
+   * Buffer the tuple filled in since the last GetTablePR() for insertion into the table. Only available in a batched
+   * storage interface. Its index keys are inserted with IndexInsert() and IndexInsertUnique() as usual.
+   */
+  void TableInsertBatched();
+
   /**
    * @param index_oid OID of the index to access.
    * @return PR of the index.
@@ -81,19 +101,19 @@ class EXPORT StorageInterface {
   uint64_t IndexGetSize() const;
 
   /**
-   * Delete item from the current index.
+   * Delete item from the current index. Buffered in a batched storage interface.
    * @param table_tuple_slot slot corresponding to the item.
    */
   void IndexDelete(storage::TupleSlot table_tuple_slot);
 
   /**
-   * Insert into the current index
+   * Insert into the current index. Buffered in a batched storage interface, where this always succeeds.
    * @return Whether insertion was successful.
    */
   bool IndexInsert();
 
   /**
-   * InsertUnique into the current index
+   * InsertUnique into the current index. A batched storage interface flushes its buffered writes first.
    * @return Whether insertion was successful.
    */
   bool IndexInsertUnique();
@@ -111,6 +131,12 @@ class EXPORT StorageInterface {
    */
   uint32_t GetIndexHeapSize();
 
+  /**
+   * Apply the writes buffered by a batched storage interface to the table and the indexes. Aborts the transaction if a
+   * write fails.
+   */
+  void Flush();
+
  protected:
   /**
    * Oid of the table being accessed.
@@ -162,6 +188,73 @@ class EXPORT StorageInterface {
    * Current index being accessed.
    */
   common::ManagedPointer<storage::index::Index> curr_index_{nullptr};
+
+  /**
+   * The indexes of the table, looked up once.
+   */
+  std::vector<std::pair<catalog::index_oid_t, common::ManagedPointer<storage::index::Index>>> indexes_;
+
+ private:
+  // Marks an index write whose slot does not come from a buffered table insert.
+  static constexpr uint32_t NO_WRITE = UINT32_MAX;
+
+  // The kinds of table writes a batched storage interface buffers.
+  enum class BufferedWriteType : uint8_t { INSERT, UPDATE, DELETE };
+
+  // A table write buffered by a batched storage interface.
+  struct BufferedTableWrite {
+    // What the write does.
+    BufferedWriteType type_;
+    // The buffered row inserted or written by an update.
+    uint32_t row_;
+    // The slot updated or deleted, or the slot of an insert once it is applied.
+    storage::TupleSlot slot_;
+  };
+
+  // An index write buffered by a batched storage interface.
+  struct BufferedIndexWrite {
+    // The index to write to.
+    storage::index::Index *index_;
+    // Whether the key is inserted rather than deleted.
+    bool insert_;
+    // The buffered table insert the key belongs to, or NO_WRITE.
+    uint32_t table_write_;
+    // The slot the key belongs to, if it does not belong to a buffered table insert.
+    storage::TupleSlot slot_;
+    // The offset of the key in the key buffer.
+    std::size_t key_offset_;
+  };
+
+  // Look up the given index of the table.
+  common::ManagedPointer<storage::index::Index> LookupIndex(catalog::index_oid_t index_oid);
+
+  // Buffer the current index PR as a key to insert or delete, belonging to the given buffered table insert or slot.
+  void BufferIndexWrite(bool insert, uint32_t table_write, storage::TupleSlot slot);
+
+  // Apply the buffered writes. The transaction latch must be held.
+  void ApplyBufferedWrites();
+
+  // Whether writes are batched.
+  bool batched_;
+  // The size of a buffered row.
+  uint32_t row_size_{0};
+  // The memory rows are buffered in.
+  byte *row_buffer_{nullptr};
+  // The buffered rows, BATCH_SIZE of them.
+  std::vector<storage::ProjectedRow *> rows_;
+  // The number of rows buffered.
+  uint32_t num_rows_{0};
+  // The buffered table writes, in the order they were made.
+  std::vector<BufferedTableWrite> table_writes_;
+  // The rows of the buffered inserts, and the slots they are inserted at, when the batch is applied.
+  std::vector<storage::ProjectedRow *> insert_rows_;
+  std::vector<storage::TupleSlot> insert_slots_;
+  // The buffered table insert of the last row, or NO_WRITE once it is applied and its slot is known.
+  uint32_t last_insert_{NO_WRITE};
+  storage::TupleSlot last_insert_slot_;
+  // The buffered index writes and their keys.
+  std::vector<BufferedIndexWrite> index_writes_;
+  std::vector<uint64_t> key_buffer_;
 };
 }  // namespace sql
 }  // namespace noisepage::execution
@@ -376,6 +376,11 @@ class EXPORT VectorProjection {
   storage::TupleSlot GetTupleSlot(uint32_t row_offset) { return tuple_slots_[row_offset]; }
 
  private:
+  // Releases the in-place read latch on a block whose contents are referenced by this projection.
+  struct InPlaceReadReleaser {
+    void operator()(storage::RawBlock *block) const;
+  };
+
   // Propagate the active TID list to child vectors, if necessary.
   void RefreshFilteredTupleIdList();
 
@@ -408,6 +413,10 @@ class EXPORT VectorProjection {
 
   // The tuple slots in this vector projection.
   std::vector<storage::TupleSlot> tuple_slots_;
+
+  // If the column vectors reference a frozen block's data in place, this is the block whose in-place read latch is
+  // held on behalf of the projection. The latch is dropped when the projection is reset or destroyed.
+  std::unique_ptr<storage::RawBlock, InPlaceReadReleaser> in_place_block_;
 };
 
 }  // namespace noisepage::execution::sql
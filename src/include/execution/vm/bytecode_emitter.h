@@ -342,6 +342,10 @@ class BytecodeEmitter {
   void EmitAggHashTableProcessBatch(LocalVar agg_ht, LocalVar vpi, uint32_t num_keys, LocalVar key_cols,
                                     FunctionId init_agg_fn, FunctionId merge_agg_fn, LocalVar partitioned);
 
+  /** Emit code to filter a batch of probe tuples with the bloom filter of a join hash table. */
+  void EmitJoinHashTableFilterBatch(LocalVar join_hash_table, LocalVar vector_projection, LocalVar tid_list,
+                                    LocalVar key_cols, uint32_t num_key_cols);
+
   /** Emit code to move thread-local data into main agg table. */
   void EmitAggHashTableMovePartitions(LocalVar agg_ht, LocalVar tls, LocalVar aht_offset, FunctionId merge_part_fn);
 
@@ -352,6 +356,16 @@ class BytecodeEmitter {
   /** Initialize a sorter instance. */
   void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn, LocalVar tuple_size);
 
+  /** Emit code to scan a sorter in parallel. */
+  void EmitSorterParallelScan(LocalVar sorter, LocalVar context, LocalVar tls, FunctionId scan_range_fn);
+
+  /** Emit code to scan the partitions of a sorter in parallel. */
+  void EmitSorterParallelScanPartitions(LocalVar sorter, LocalVar context, LocalVar tls, FunctionId partition_fn,
+                                        FunctionId scan_partitions_fn);
+
+  /** Emit code to iterate over the results of an index scan in parallel. */
+  void EmitIndexIteratorParallelScan(LocalVar iter, LocalVar context, LocalVar tls, FunctionId scan_range_fn);
+
   /** Initialize a CSV reader. */
   // void EmitCSVReaderInit(LocalVar creader, LocalVar file_name, uint32_t file_name_len);
 
@@ -500,7 +500,7 @@ VM_OP_HOT void OpHashCombine(noisepage::hash_t *hash_val, noisepage::hash_t new_
 // ---------------------------------------------------------
 
 VM_OP void OpFilterManagerInit(noisepage::execution::sql::FilterManager *filter_manager,
-                               const noisepage::execution::exec::ExecutionSettings &exec_settings);
+                               noisepage::execution::exec::ExecutionContext *exec_ctx);
 
 VM_OP void OpFilterManagerStartNewClause(noisepage::execution::sql::FilterManager *filter_manager);
 
@@ -1282,6 +1282,32 @@ VM_OP_HOT void OpJoinHashTableLookup(noisepage::execution::sql::JoinHashTable *j
 
 VM_OP void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table);
 
+VM_OP void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP void OpJoinHashTableEnableBloomFilter(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP void OpJoinHashTableFilterBatch(const noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                      noisepage::execution::sql::VectorProjection *vector_projection,
+                                      noisepage::execution::sql::TupleIdList *tid_list, const uint32_t *key_cols,
+                                      uint32_t num_key_cols);
+
+VM_OP_HOT void OpJoinHashTableIsSpilled(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->IsSpilled();
+}
+
+VM_OP_HOT void OpJoinHashTableAllocSpilledProbeTuple(noisepage::byte **result,
+                                                     noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                                     noisepage::hash_t hash, uint32_t probe_size) {
+  *result = join_hash_table->AllocSpilledProbeTuple(hash, probe_size);
+}
+
+VM_OP void OpJoinHashTableLoadSpilledPartition(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP_HOT void OpJoinHashTableNextSpilledProbeTuple(noisepage::byte **result,
+                                                    noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->NextSpilledProbeTuple();
+}
+
 VM_OP_HOT void OpHashTableEntryIteratorHasNext(bool *has_next,
                                                noisepage::execution::sql::HashTableEntryIterator *ht_entry_iter) {
   *has_next = ht_entry_iter->HasNext();
@@ -1343,6 +1369,15 @@ VM_OP void OpSorterSortTopKParallel(noisepage::execution::sql::Sorter *sorter,
                                     noisepage::execution::sql::ThreadStateContainer *thread_state_container,
                                     uint32_t sorter_offset, uint64_t top_k);
 
+VM_OP void OpSorterParallelScan(noisepage::execution::sql::Sorter *sorter, void *query_state,
+                                noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                noisepage::execution::sql::Sorter::ScanRangeFn scan_range_fn);
+
+VM_OP void OpSorterParallelScanPartitions(noisepage::execution::sql::Sorter *sorter, void *query_state,
+                                          noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                          noisepage::execution::sql::Sorter::ComparisonFunction partition_fn,
+                                          noisepage::execution::sql::Sorter::ScanPartitionsFn scan_partitions_fn);
+
 VM_OP void OpSorterFree(noisepage::execution::sql::Sorter *sorter);
 
 VM_OP void OpSorterIteratorInit(noisepage::execution::sql::SorterIterator *iter,
@@ -1832,6 +1867,18 @@ VM_OP_WARM void OpIndexIteratorScanLimitDescending(noisepage::execution::sql::In
   iter->ScanLimitDescending(limit);
 }
 
+VM_OP_WARM void OpIndexIteratorAddBatchKey(noisepage::execution::sql::IndexIterator *iter) { iter->AddBatchKey(); }
+
+VM_OP_WARM void OpIndexIteratorScanBatch(noisepage::execution::sql::IndexIterator *iter) { iter->ScanBatch(); }
+
+VM_OP_WARM void OpIndexIteratorSelectBatchKey(noisepage::execution::sql::IndexIterator *iter, uint32_t key_idx) {
+  iter->SelectBatchKey(key_idx);
+}
+
+VM_OP void OpIndexIteratorParallelScan(noisepage::execution::sql::IndexIterator *iter, void *query_state,
+                                       noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                       noisepage::execution::sql::IndexIterator::ScanRangeFn scan_range_fn);
+
 VM_OP_WARM void OpIndexIteratorAdvance(bool *has_more, noisepage::execution::sql::IndexIterator *iter) {
   *has_more = iter->Advance();
 }
@@ -2019,6 +2066,10 @@ VM_OP void OpStorageInterfaceInit(noisepage::execution::sql::StorageInterface *s
                                   noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t table_oid,
                                   uint32_t *col_oids, uint32_t num_oids, bool need_indexes);
 
+VM_OP void OpStorageInterfaceInitBatched(noisepage::execution::sql::StorageInterface *storage_interface,
+                                         noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t table_oid,
+                                         uint32_t *col_oids, uint32_t num_oids, bool need_indexes);
+
 VM_OP void OpStorageInterfaceGetTablePR(noisepage::storage::ProjectedRow **pr_result,
                                         noisepage::execution::sql::StorageInterface *storage_interface);
 
@@ -2031,6 +2082,8 @@ VM_OP void OpStorageInterfaceTableDelete(bool *result, noisepage::execution::sql
 VM_OP void OpStorageInterfaceTableInsert(noisepage::storage::TupleSlot *tuple_slot,
                                          noisepage::execution::sql::StorageInterface *storage_interface);
 
+VM_OP void OpStorageInterfaceTableInsertBatched(noisepage::execution::sql::StorageInterface *storage_interface);
+
 VM_OP void OpStorageInterfaceGetIndexPR(noisepage::storage::ProjectedRow **pr_result,
                                         noisepage::execution::sql::StorageInterface *storage_interface,
                                         uint32_t index_oid);
@@ -2053,6 +2106,8 @@ VM_OP void OpStorageInterfaceIndexInsertWithSlot(bool *result,
 VM_OP void OpStorageInterfaceIndexDelete(noisepage::execution::sql::StorageInterface *storage_interface,
                                          noisepage::storage::TupleSlot *tuple_slot);
 
+VM_OP void OpStorageInterfaceFlush(noisepage::execution::sql::StorageInterface *storage_interface);
+
 VM_OP void OpStorageInterfaceFree(noisepage::execution::sql::StorageInterface *storage_interface);
 
 // ---------------------------------
@@ -458,6 +458,15 @@ namespace noisepage::execution::vm {
   F(JoinHashTableBuildParallel, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(JoinHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local)                                  \
   F(JoinHashTableFree, OperandType::Local)                                                                            \
+  F(JoinHashTableEnableSpilling, OperandType::Local)                                                                  \
+  F(JoinHashTableIsSpilled, OperandType::Local, OperandType::Local)                                                   \
+  F(JoinHashTableAllocSpilledProbeTuple, OperandType::Local, OperandType::Local, OperandType::Local,                  \
+    OperandType::Local)                                                                                               \
+  F(JoinHashTableLoadSpilledPartition, OperandType::Local, OperandType::Local)                                        \
+  F(JoinHashTableNextSpilledProbeTuple, OperandType::Local, OperandType::Local)                                       \
+  F(JoinHashTableEnableBloomFilter, OperandType::Local)                                                               \
+  F(JoinHashTableFilterBatch, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,          \
+    OperandType::UImm4)                                                                                               \
   F(HashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)                                            \
   F(HashTableEntryIteratorGetRow, OperandType::Local, OperandType::Local)                                             \
   F(JoinHashTableIteratorInit, OperandType::Local, OperandType::Local)                                                \
@@ -475,6 +484,9 @@ namespace noisepage::execution::vm {
   F(SorterSort, OperandType::Local)                                                                                   \
   F(SorterSortParallel, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
   F(SorterSortTopKParallel, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)           \
+  F(SorterParallelScan, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId)          \
+  F(SorterParallelScanPartitions, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId, \
+    OperandType::FunctionId)                                                                                          \
   F(SorterFree, OperandType::Local)                                                                                   \
   F(SorterIteratorInit, OperandType::Local, OperandType::Local)                                                       \
   F(SorterIteratorGetRow, OperandType::Local, OperandType::Local)                                                     \
@@ -498,6 +510,10 @@ namespace noisepage::execution::vm {
   F(IndexIteratorScanAscending, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
+  F(IndexIteratorAddBatchKey, OperandType::Local)                                                                     \
+  F(IndexIteratorScanBatch, OperandType::Local)                                                                       \
+  F(IndexIteratorSelectBatchKey, OperandType::Local, OperandType::Local)                                              \
+  F(IndexIteratorParallelScan, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId)   \
   F(IndexIteratorFree, OperandType::Local)                                                                            \
   F(IndexIteratorAdvance, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetPR, OperandType::Local, OperandType::Local)                                                       \
@@ -561,9 +577,12 @@ namespace noisepage::execution::vm {
   /* StorageInterface */                                                                                              \
   F(StorageInterfaceInit, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,             \
     OperandType::UImm4, OperandType::Local)                                                                           \
+  F(StorageInterfaceInitBatched, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,      \
+    OperandType::UImm4, OperandType::Local)                                                                           \
   F(StorageInterfaceGetTablePR, OperandType::Local, OperandType::Local)                                               \
   F(StorageInterfaceTableUpdate, OperandType::Local, OperandType::Local, OperandType::Local)                          \
   F(StorageInterfaceTableInsert, OperandType::Local, OperandType::Local)                                              \
+  F(StorageInterfaceTableInsertBatched, OperandType::Local)                                                           \
   F(StorageInterfaceTableDelete, OperandType::Local, OperandType::Local, OperandType::Local)                          \
   F(StorageInterfaceGetIndexHeapSize, OperandType::Local, OperandType::Local)                                         \
   F(StorageInterfaceGetIndexPR, OperandType::Local, OperandType::Local, OperandType::Local)                           \
@@ -573,6 +592,7 @@ namespace noisepage::execution::vm {
   F(StorageInterfaceIndexInsertWithSlot, OperandType::Local, OperandType::Local, OperandType::Local,                  \
     OperandType::Local)                                                                                               \
   F(StorageInterfaceIndexDelete, OperandType::Local, OperandType::Local)                                              \
+  F(StorageInterfaceFlush, OperandType::Local)                                                                        \
   F(StorageInterfaceFree, OperandType::Local)                                                                         \
                                                                                                                       \
   /* Trig functions */                                                                                                \
@@ -5,7 +5,9 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "common/constants.h"
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
 
@@ -34,15 +36,36 @@ class LLVMEngine {
   class CompilerOptions;
   class CompiledModule;
   class CompiledModuleBuilder;
+  class ObjectCache;
 
   // -------------------------------------------------------
   // Public API
   // -------------------------------------------------------
 
+  /** The default maximum size of the object cache in bytes. */
+  static constexpr uint64_t DEFAULT_OBJECT_CACHE_MAX_SIZE = 256 * common::Constants::MB;
+
   /**
    * Initialize the whole LLVM subsystem
+   * @param object_cache_directory The directory in which the object code of compiled modules is cached across runs of
+   *                               the process, or empty to not cache it. It is created private to the user running
+   *                               the process if it does not exist. The cache is disabled if the directory is not owned
+   *                               by that user, or if other users can write to it.
+   * @param object_cache_max_size The most bytes the object cache may take up. The least recently used entries are
+   *                              evicted beyond that.
+   */
+  static void Initialize(const std::string &object_cache_directory = "",
+                         uint64_t object_cache_max_size = DEFAULT_OBJECT_CACHE_MAX_SIZE);
+
+  /**
+   * @return The directory in which the object code of compiled modules is cached, or empty if it is not cached
+   */
+  static const std::string &GetObjectCacheDirectory();
+
+  /**
+   * @return The most bytes the object cache may take up
    */
-  static void Initialize();
+  static uint64_t GetObjectCacheMaxSize();
 
   /**
    * Shutdown the whole LLVM subsystem
@@ -117,6 +140,38 @@ class LLVMEngine {
      */
     const std::string &GetOutputObjectFileName() const { return output_file_name_; }
 
+    /**
+     * Set the directory in which the object code of compiled modules is cached. A module whose object code is in the
+     * cache is loaded from there rather than compiled.
+     * @param directory the cache directory, or empty to not use the cache
+     * @return the updated object
+     */
+    CompilerOptions &SetObjectCacheDirectory(const std::string &directory) {
+      object_cache_directory_ = directory;
+      return *this;
+    }
+
+    /**
+     * @return the cache directory, or empty if the cache is not used
+     */
+    const std::string &GetObjectCacheDirectory() const { return object_cache_directory_; }
+
+    /**
+     * Set the most bytes the object cache may take up. Storing a module in the cache evicts the least recently used
+     * entries beyond that.
+     * @param max_size the maximum size of the cache in bytes
+     * @return the updated object
+     */
+    CompilerOptions &SetObjectCacheMaxSize(uint64_t max_size) {
+      object_cache_max_size_ = max_size;
+      return *this;
+    }
+
+    /**
+     * @return the maximum size of the cache in bytes
+     */
+    uint64_t GetObjectCacheMaxSize() const { return object_cache_max_size_; }
+
     /**
      * @return the path to the bytecode handlers bitcode file.
      */
@@ -126,6 +181,8 @@ class LLVMEngine {
     bool debug_{false};
     bool write_obj_file_{false};
     std::string output_file_name_;
+    std::string object_cache_directory_;
+    uint64_t object_cache_max_size_{DEFAULT_OBJECT_CACHE_MAX_SIZE};
   };
 
   // -------------------------------------------------------
@@ -148,8 +205,12 @@ class LLVMEngine {
     /**
      * Construct a compiled module using the provided shared object file.
      * @param object_code The object file containing code for this module.
+     * @param symbol_names The names of the module's functions in the object file, in the order of their IDs. If empty,
+     *                     the functions are named as in the bytecode module. Object files that are shared by modules
+     *                     that only differ in their function names name the functions of one of them.
      */
-    explicit CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code);
+    explicit CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code,
+                            std::vector<std::string> symbol_names = {});
 
     /**
      * This class cannot be copied or moved
@@ -187,6 +248,7 @@ class LLVMEngine {
    private:
     bool loaded_;
     std::unique_ptr<llvm::MemoryBuffer> object_code_;
+    std::vector<std::string> symbol_names_;
     std::unique_ptr<TPLMemoryManager> memory_manager_;
     std::unordered_map<std::string, void *> functions_;
   };
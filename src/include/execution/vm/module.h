@@ -47,6 +47,12 @@ class Module {
    */
   DISALLOW_COPY_AND_MOVE(Module);
 
+  /**
+   * Destructor. Cancels a background compilation of this module that has not started yet, or waits for one that is in
+   * progress to finish.
+   */
+  ~Module();
+
   /**
    * Look up a TPL function in this module by its ID
    * @return A pointer to the function's info if it exists; null otherwise
@@ -99,6 +105,19 @@ class Module {
    */
   const BytecodeModule *GetBytecodeModule() const { return bytecode_module_.get(); }
 
+  /**
+   * @return True if the machine code of all functions in this module is available. Functions obtained in compiled mode
+   *         from then on run without waiting on the compiler.
+   */
+  bool IsCompiledToMachineCode() const { return compiled_.load(std::memory_order_acquire); }
+
+  /**
+   * Compile this module into machine code in the background, unless a compilation was already requested. This is a
+   * non-blocking call. As the compiled functions become available, they are swapped in for their bytecode
+   * implementations, so interpreted code that calls them through the module runs mixed with compiled code.
+   */
+  void CompileToMachineCodeAsync();
+
  private:
   friend class VM;                            // For the VM to access raw bytecode.
   friend class test::BytecodeTrampolineTest;  // For the tests to check private methods.
@@ -106,6 +125,9 @@ class Module {
   // This class encapsulates the ability to asynchronously JIT compile a module.
   class AsyncCompileTask;
 
+  // The progress of a background compilation, shared with its task.
+  struct AsyncCompileState;
+
   // A trampoline is a stub function that serves as a landing point for all
   // functions executed in interpreted mode. The purpose of the trampoline is
   // to arrange and adjust call arguments from the C/C++ ABI to the TPL ABI.
@@ -146,10 +168,6 @@ class Module {
   // Compile this module into machine code. This is a blocking call.
   void CompileToMachineCode();
 
-  // Compile this module into machine code. This is a non-blocking call that
-  // triggers a compilation in the background.
-  void CompileToMachineCodeAsync();
-
  private:
   // The module containing all TBC (i.e., bytecode) for the TPL program.
   std::unique_ptr<BytecodeModule> bytecode_module_;
@@ -168,6 +186,14 @@ class Module {
 
   // Flag to indicate if the JIT compilation has occurred.
   std::once_flag compiled_flag_;
+
+  // Set once the compiled implementations of all functions are swapped in.
+  std::atomic<bool> compiled_{false};
+
+  // Set once a background compilation is requested. The background task refers to this module, so the module cancels
+  // the task if it has not started, or waits for it to finish, before it is destroyed.
+  std::atomic<bool> async_compile_requested_{false};
+  std::shared_ptr<AsyncCompileState> async_compile_state_;
 };
 
 // ---------------------------------------------------------
@@ -10,7 +10,8 @@ enum class ExecutionMode : uint8_t {
   Interpret,
   // Execute in interpreted mode, but trigger a compilation asynchronously. As
   // compiled code becomes available, seamlessly swap it in and execute mixed
-  // interpreter and compiled code.
+  // interpreter and compiled code. An ExecutableQuery only triggers the
+  // compilation once it ran often or long enough in interpreted mode.
   Adaptive,
   // Compile and generate all machine code before executing the function
   Compiled
@@ -21,6 +21,7 @@
 #include "self_driving/pilot/pilot_thread.h"
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
+#include "storage/checkpoint/checkpoint_manager.h"
 #include "storage/garbage_collector_thread.h"
 #include "traffic_cop/traffic_cop.h"
 #include "transaction/deferred_action_manager.h"
@@ -126,15 +127,16 @@ class DBMain {
      * @param block_store_reuse_limit argument to the BlockStore
      * @param use_gc enable GarbageCollector
      * @param log_manager needed for safe destruction of StorageLayer
+     * @param gc_num_workers argument to the GarbageCollector
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
                  const uint64_t block_store_reuse_limit, const bool use_gc,
-                 const common::ManagedPointer<storage::LogManager> log_manager)
+                 const common::ManagedPointer<storage::LogManager> log_manager, const uint32_t gc_num_workers = 1)
         : deferred_action_manager_(txn_layer->GetDeferredActionManager()), log_manager_(log_manager) {
       if (use_gc)
-        garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
-                                                                         txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
+        garbage_collector_ = std::make_unique<storage::GarbageCollector>(
+            txn_layer->GetTimestampManager(), txn_layer->GetDeferredActionManager(),
+            txn_layer->GetTransactionManager(), DISABLED, gc_num_workers);
 
       block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
     }
@@ -295,7 +297,11 @@ class DBMain {
    */
   class ExecutionLayer {
    public:
-    ExecutionLayer();
+    /**
+     * @param jit_object_cache_directory directory in which JIT-compiled code is cached across runs, empty for none
+     * @param jit_object_cache_size maximum size of the JIT-compiled code cache in bytes
+     */
+    ExecutionLayer(const std::string &jit_object_cache_directory, uint64_t jit_object_cache_size);
     ~ExecutionLayer();
   };
 
@@ -363,7 +369,8 @@ class DBMain {
         log_manager = std::make_unique<storage::LogManager>(
             wal_file_path_, wal_num_buffers_, std::chrono::microseconds{wal_serialization_interval_},
             std::chrono::microseconds{wal_persist_interval_}, wal_persist_threshold_,
-            common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(thread_registry));
+            common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(thread_registry),
+            std::chrono::microseconds{wal_group_commit_latency_target_}, wal_num_streams_);
         log_manager->Start();
       }
 
@@ -372,7 +379,7 @@ class DBMain {
 
       auto storage_layer =
           std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager));
+                                         use_gc_, common::ManagedPointer(log_manager), gc_num_workers_);
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
@@ -392,6 +399,16 @@ class DBMain {
                                                                       common::ManagedPointer(metrics_manager));
       }
 
+      std::unique_ptr<storage::CheckpointManager> checkpoint_manager = DISABLED;
+      if (use_checkpoints_) {
+        NOISEPAGE_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED,
+                         "CheckpointManager needs the CatalogLayer.");
+        checkpoint_manager = std::make_unique<storage::CheckpointManager>(
+            checkpoint_file_path_, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(),
+            txn_layer->GetTimestampManager(), common::ManagedPointer(log_manager));
+        checkpoint_manager->StartCheckpointThread(std::chrono::seconds{checkpoint_interval_});
+      }
+
       std::unique_ptr<optimizer::StatsStorage> stats_storage = DISABLED;
       if (use_stats_storage_) {
         stats_storage = std::make_unique<optimizer::StatsStorage>();
@@ -399,7 +416,7 @@ class DBMain {
 
       std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
       if (use_execution_) {
-        execution_layer = std::make_unique<ExecutionLayer>();
+        execution_layer = std::make_unique<ExecutionLayer>(jit_object_cache_directory_, jit_object_cache_size_);
       }
 
       std::unique_ptr<trafficcop::TrafficCop> traffic_cop = DISABLED;
@@ -411,7 +428,7 @@ class DBMain {
         traffic_cop = std::make_unique<trafficcop::TrafficCop>(
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(), DISABLED,
             common::ManagedPointer(settings_manager), common::ManagedPointer(stats_storage), optimizer_timeout_,
-            use_query_cache_, execution_mode_);
+            use_query_cache_, plan_cache_size_, execution_mode_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -457,6 +474,7 @@ class DBMain {
       db_main->storage_layer_ = std::move(storage_layer);
       db_main->catalog_layer_ = std::move(catalog_layer);
       db_main->gc_thread_ = std::move(gc_thread);
+      db_main->checkpoint_manager_ = std::move(checkpoint_manager);
       db_main->stats_storage_ = std::move(stats_storage);
       db_main->execution_layer_ = std::move(execution_layer);
       db_main->traffic_cop_ = std::move(traffic_cop);
@@ -568,6 +586,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalGroupCommitLatencyTarget(const int32_t value) {
+      wal_group_commit_latency_target_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalNumStreams(const uint32_t value) {
+      wal_num_streams_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -595,6 +631,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value GarbageCollector argument
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumWorkers(const uint32_t value) {
+      gc_num_workers_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -604,6 +649,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseCheckpoints(const bool value) {
+      use_checkpoints_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointFilePath(const std::string &value) {
+      checkpoint_file_path_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointInterval(const int32_t value) {
+      checkpoint_interval_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -721,6 +793,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value maximum number of plans shared across Simple Query protocol connections, 0 disables the cache
+     * @return self reference for chaining
+     */
+    Builder &SetPlanCacheSize(const uint64_t value) {
+      plan_cache_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -739,6 +820,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value directory in which JIT-compiled object code is cached across runs, empty to not cache it
+     * @return self reference for chaining
+     */
+    Builder &SetJitObjectCacheDirectory(const std::string &value) {
+      jit_object_cache_directory_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value maximum size of the JIT-compiled object code cache in bytes
+     * @return self reference for chaining
+     */
+    Builder &SetJitObjectCacheSize(const uint64_t value) {
+      jit_object_cache_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value with ModelServer enable
      * @return self reference for chaining
@@ -783,6 +882,8 @@ class DBMain {
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
     uint64_t wal_persist_threshold_ = static_cast<uint64_t>(1 << 20);
+    int32_t wal_group_commit_latency_target_ = 0;
+    uint32_t wal_num_streams_ = 1;
     bool use_logging_ = false;
     bool use_gc_ = false;
     bool use_pilot_thread_ = false;
@@ -795,13 +896,20 @@ class DBMain {
     uint64_t block_store_size_ = 1e5;
     uint64_t block_store_reuse_ = 1e3;
     int32_t gc_interval_ = 1000;
+    uint32_t gc_num_workers_ = 1;
     bool use_gc_thread_ = false;
+    bool use_checkpoints_ = false;
+    std::string checkpoint_file_path_ = "checkpoint.log";
+    int32_t checkpoint_interval_ = 300;
     bool use_stats_storage_ = false;
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
     uint64_t optimizer_timeout_ = 5000;
     bool use_query_cache_ = true;
+    uint64_t plan_cache_size_ = 1024;
     execution::vm::ExecutionMode execution_mode_ = execution::vm::ExecutionMode::Interpret;
+    std::string jit_object_cache_directory_;
+    uint64_t jit_object_cache_size_ = 1 << 28;
     uint16_t network_port_ = 15721;
     std::string uds_file_directory_ = "/tmp/";
     uint16_t connection_thread_count_ = 4;
@@ -841,6 +949,8 @@ class DBMain {
         wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
         wal_persist_threshold_ =
             static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_persist_threshold));
+        wal_group_commit_latency_target_ = settings_manager->GetInt(settings::Param::wal_group_commit_latency_target);
+        wal_num_streams_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::wal_num_streams));
       }
 
       use_metrics_ = settings_manager->GetBool(settings::Param::metrics);
@@ -849,6 +959,13 @@ class DBMain {
       pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_workers_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::gc_num_workers));
+
+      use_checkpoints_ = settings_manager->GetBool(settings::Param::checkpoint_enable);
+      if (use_checkpoints_) {
+        checkpoint_file_path_ = settings_manager->GetString(settings::Param::checkpoint_file_path);
+        checkpoint_interval_ = settings_manager->GetInt(settings::Param::checkpoint_interval);
+      }
       pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
       workload_forecast_interval_ = settings_manager->GetInt64(settings::Param::workload_forecast_interval);
       model_save_path_ = settings_manager->GetString(settings::Param::model_save_path);
@@ -862,10 +979,17 @@ class DBMain {
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      plan_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::plan_cache_size));
 
-      execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
-                            ? execution::vm::ExecutionMode::Compiled
-                            : execution::vm::ExecutionMode::Interpret;
+      execution_mode_ = execution::vm::ExecutionMode::Interpret;
+      if (settings_manager->GetBool(settings::Param::compiled_query_execution)) {
+        execution_mode_ = execution::vm::ExecutionMode::Compiled;
+      } else if (settings_manager->GetBool(settings::Param::adaptive_query_execution)) {
+        execution_mode_ = execution::vm::ExecutionMode::Adaptive;
+      }
+      jit_object_cache_directory_ = settings_manager->GetString(settings::Param::jit_object_cache_directory);
+      jit_object_cache_size_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::jit_object_cache_size));
 
       query_trace_metrics_ = settings_manager->GetBool(settings::Param::query_trace_metrics_enable);
       pipeline_metrics_ = settings_manager->GetBool(settings::Param::pipeline_metrics_enable);
@@ -966,6 +1090,13 @@ class DBMain {
     return common::ManagedPointer(gc_thread_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::CheckpointManager> GetCheckpointManager() const {
+    return common::ManagedPointer(checkpoint_manager_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -1021,6 +1152,7 @@ class DBMain {
   std::unique_ptr<CatalogLayer> catalog_layer_;
   std::unique_ptr<storage::GarbageCollectorThread>
       gc_thread_;  // thread needs to die before manual invocations of GC in CatalogLayer and others
+  std::unique_ptr<storage::CheckpointManager> checkpoint_manager_;  // thread needs to die before the CatalogLayer
   std::unique_ptr<optimizer::StatsStorage> stats_storage_;
   std::unique_ptr<ExecutionLayer> execution_layer_;
   std::unique_ptr<trafficcop::TrafficCop> traffic_cop_;
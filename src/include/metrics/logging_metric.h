@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <chrono>  //NOLINT
 #include <fstream>
 #include <list>
@@ -28,6 +29,8 @@ class LoggingMetricRawData : public AbstractRawData {
     if (!other_db_metric->consumer_data_.empty()) {
       consumer_data_.splice(consumer_data_.cend(), other_db_metric->consumer_data_);
     }
+    batch_size_histogram_.Aggregate(&other_db_metric->batch_size_histogram_);
+    fsync_latency_histogram_.Aggregate(&other_db_metric->fsync_latency_histogram_);
   }
 
   /**
@@ -47,6 +50,7 @@ class LoggingMetricRawData : public AbstractRawData {
 
     auto &serializer_outfile = (*outfiles)[0];
     auto &consumer_outfile = (*outfiles)[1];
+    auto &group_commit_outfile = (*outfiles)[2];
 
     for (const auto &data : serializer_data_) {
       serializer_outfile << data.num_bytes_ << ", " << data.num_records_ << ", " << data.num_txns_ << ", "
@@ -59,6 +63,8 @@ class LoggingMetricRawData : public AbstractRawData {
       data.resource_metrics_.ToCSV(consumer_outfile);
       consumer_outfile << std::endl;
     }
+    batch_size_histogram_.ToCSV(&group_commit_outfile, "batch_size");
+    fsync_latency_histogram_.ToCSV(&group_commit_outfile, "fsync_latency");
     serializer_data_.clear();
     consumer_data_.clear();
   }
@@ -66,14 +72,20 @@ class LoggingMetricRawData : public AbstractRawData {
   /**
    * Files to use for writing to CSV.
    */
-  static constexpr std::array<std::string_view, 2> FILES = {"./log_serializer_task.csv",
-                                                            "./disk_log_consumer_task.csv"};
+  static constexpr std::array<std::string_view, 3> FILES = {
+      "./log_serializer_task.csv", "./disk_log_consumer_task.csv", "./disk_log_group_commit.csv"};
   /**
    * Columns to use for writing to CSV.
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
-  static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {"num_bytes, num_records, num_txns, interval",
-                                                                      "num_bytes, num_buffers, interval"};
+  static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS = {
+      "num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, interval",
+      "histogram, bucket_upper_bound, count"};
+  /**
+   * Whether the rows of each file end in the resource counters. The group commit histograms are not measured with a
+   * resource tracker, so their file has only the feature columns.
+   */
+  static constexpr std::array<bool, 3> RESOURCE_COLUMNS = {true, true, false};
 
  private:
   friend class LoggingMetric;
@@ -89,6 +101,44 @@ class LoggingMetricRawData : public AbstractRawData {
     consumer_data_.emplace_back(num_bytes, num_buffers, interval, resource_metrics);
   }
 
+  void RecordGroupCommitData(const uint64_t batch_size, const uint64_t fsync_latency) {
+    batch_size_histogram_.Add(batch_size);
+    fsync_latency_histogram_.Add(fsync_latency);
+  }
+
+  /**
+   * Histogram with power of two buckets. Bucket i counts the values in [2^(i-1), 2^i), bucket 0 counts zeros and the
+   * last bucket also counts everything that is too large for the others.
+   */
+  class Log2Histogram {
+   public:
+    void Add(const uint64_t value) {
+      const auto bucket = value == 0 ? 0 : 64 - __builtin_clzll(value);
+      counts_[std::min<uint64_t>(bucket, NUM_BUCKETS - 1)]++;
+    }
+
+    void Aggregate(Log2Histogram *const other) {
+      for (uint32_t i = 0; i < NUM_BUCKETS; i++) counts_[i] += other->counts_[i];
+      other->counts_.fill(0);
+    }
+
+    uint64_t Count(const uint32_t bucket) const { return counts_[bucket]; }
+
+    void ToCSV(std::ofstream *const outfile, const std::string_view name) {
+      for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+        if (counts_[i] == 0) continue;
+        const uint64_t upper_bound = i == 0 ? 0 : (uint64_t(1) << i) - 1;
+        *outfile << name << ", " << upper_bound << ", " << counts_[i] << std::endl;
+      }
+      counts_.fill(0);
+    }
+
+    static constexpr uint32_t NUM_BUCKETS = 32;
+
+   private:
+    std::array<uint64_t, NUM_BUCKETS> counts_{};
+  };
+
   struct SerializerData {
     SerializerData(const uint64_t num_bytes, const uint64_t num_records, const uint64_t num_txns,
                    const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
@@ -116,6 +166,10 @@ class LoggingMetricRawData : public AbstractRawData {
 
   std::list<SerializerData> serializer_data_;
   std::list<ConsumerData> consumer_data_;
+  // Number of commits persisted by each fsync of the log file
+  Log2Histogram batch_size_histogram_;
+  // Latency of each fsync of the log file (us)
+  Log2Histogram fsync_latency_histogram_;
 };
 
 /**
@@ -134,5 +188,8 @@ class LoggingMetric : public AbstractMetric<LoggingMetricRawData> {
                           const common::ResourceTracker::Metrics &resource_metrics) {
     GetRawData()->RecordConsumerData(num_bytes, num_buffers, interval, resource_metrics);
   }
+  void RecordGroupCommitData(const uint64_t batch_size, const uint64_t fsync_latency) {
+    GetRawData()->RecordGroupCommitData(batch_size, fsync_latency);
+  }
 };
 }  // namespace noisepage::metrics
@@ -73,6 +73,20 @@ class MetricsStore {
     logging_metric_->RecordConsumerData(num_bytes, num_records, interval, resource_metrics);
   }
 
+  /**
+   * Record a group commit from the LogConsumerTask
+   * @param batch_size number of commits persisted by the fsync
+   * @param fsync_latency latency of the fsync (us)
+   */
+  void RecordGroupCommitData(const uint64_t batch_size, const uint64_t fsync_latency) {
+    if (!ComponentEnabled(MetricsComponent::LOGGING))
+      METRICS_LOG_WARN(
+          "RecordGroupCommitData() called without logging metrics enabled. Was it recently disabled and the component "
+          "is just lagging?");
+    NOISEPAGE_ASSERT(logging_metric_ != nullptr, "LoggingMetric not allocated. Check MetricsStore constructor.");
+    logging_metric_->RecordGroupCommitData(batch_size, fsync_latency);
+  }
+
   /**
    * Record metrics from GC
    * @param txns_deallocated first entry of metrics datapoint
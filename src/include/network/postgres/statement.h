@@ -118,6 +118,16 @@ class Statement {
     executable_query_ = std::move(executable_query);
   }
 
+  /**
+   * Mark this Statement as kept in a cache to run again, either the shared plan cache or a connection's statement cache
+   */
+  void SetRetained() { retained_ = true; }
+
+  /**
+   * @return true if this Statement is kept in a cache to run again, so that its executable query may be reused
+   */
+  bool IsRetained() const { return retained_; }
+
   /**
    * Stash desired parameter types to avoid having to do a full binding pass for prepared statements
    * @param desired_param_types output from the binder if Statement has parameters to fast-path convert for future
@@ -158,6 +168,7 @@ class Statement {
   std::unique_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
   std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
   std::vector<type::TypeId> desired_param_types_;                                     // generated in the Bind phase
+  bool retained_ = false;
 };
 
 }  // namespace noisepage::network
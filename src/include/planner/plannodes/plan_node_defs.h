@@ -74,6 +74,7 @@ enum class PlanNodeType {
   DISTINCT,
   HASH,
   SETOP,
+  WINDOW,
 
   // Utility
   EXPORT_EXTERNAL_FILE,
@@ -125,6 +126,18 @@ std::string JoinTypeToString(LogicalJoinType type);
 
 enum class SetOpType { INVALID = INVALID_TYPE_ID, INTERSECT = 1, INTERSECT_ALL = 2, EXCEPT = 3, EXCEPT_ALL = 4 };
 
+//===--------------------------------------------------------------------===//
+// Window Function Types
+//===--------------------------------------------------------------------===//
+
+enum class WindowFunctionType {
+  INVALID = INVALID_TYPE_ID,
+  ROW_NUMBER = 1,  // position of the row in its partition
+  RANK = 2,        // position of the first peer of the row in its partition
+  DENSE_RANK = 3,  // number of distinct peer groups up to the row in its partition
+  AGGREGATE = 4    // aggregate over the partition up to the last peer of the row
+};
+
 //===--------------------------------------------------------------------===//
 // External File defaults
 //===--------------------------------------------------------------------===//
@@ -32,6 +32,7 @@ class SeqScanPlanNode;
 class UpdatePlanNode;
 class SetOpPlanNode;
 class ResultPlanNode;
+class WindowPlanNode;
 
 /**
  * Utility class for visitor pattern for plan nodes
@@ -219,6 +220,12 @@ class PlanVisitor {
    * @param plan ResultPlanNode
    */
   virtual void Visit(UNUSED_ATTRIBUTE const ResultPlanNode *plan) {}
+
+  /**
+   * Visit a WindowPlanNode
+   * @param plan WindowPlanNode
+   */
+  virtual void Visit(UNUSED_ATTRIBUTE const WindowPlanNode *plan) {}
 };
 
 }  // namespace noisepage::planner
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/aggregate_plan_node.h"
+#include "planner/plannodes/order_by_plan_node.h"
+#include "planner/plannodes/plan_visitor.h"
+
+namespace noisepage::planner {
+
+/**
+ * A window function computed by a window plan node. Only aggregate window functions have an aggregate expression.
+ */
+struct WindowTerm {
+  /** The window function. */
+  WindowFunctionType type_;
+  /** The aggregate to compute, for aggregate window functions; null otherwise. */
+  AggregateTerm aggregate_;
+};
+
+/**
+ * Plan node for window functions. The input is partitioned by the partition keys and every partition is ordered by the
+ * sort keys; rows that are equal on all sort keys are peers. Every window term is evaluated with the default window
+ * frame: aggregates cover the partition from its first row up to the last peer of the current row, or the whole
+ * partition if there are no sort keys. All window terms of a node share the same partitioning and ordering; terms with
+ * different window definitions are computed by separate window nodes stacked on top of each other.
+ *
+ * The output schema refers to the columns of the child with DerivedValueExpressions of tuple index 0, and to the
+ * window terms with DerivedValueExpressions of tuple index 1 whose value index is the position of the term.
+ */
+class WindowPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Builder for window plan node
+   */
+  class Builder : public AbstractPlanNode::Builder<Builder> {
+   public:
+    Builder() = default;
+
+    /**
+     * Don't allow builder to be copied or moved
+     */
+    DISALLOW_COPY_AND_MOVE(Builder);
+
+    /**
+     * @param key expression to partition the input by
+     * @return builder object
+     */
+    Builder &AddPartitionKey(common::ManagedPointer<parser::AbstractExpression> key) {
+      partition_keys_.emplace_back(key);
+      return *this;
+    }
+
+    /**
+     * @param key expression to order every partition by
+     * @param ordering ordering (ASC or DESC) for key
+     * @return builder object
+     */
+    Builder &AddSortKey(common::ManagedPointer<parser::AbstractExpression> key,
+                        optimizer::OrderByOrderingType ordering) {
+      sort_keys_.emplace_back(key, ordering);
+      return *this;
+    }
+
+    /**
+     * @param type ranking window function to compute
+     * @return builder object
+     */
+    Builder &AddWindowTerm(WindowFunctionType type) {
+      NOISEPAGE_ASSERT(type != WindowFunctionType::AGGREGATE, "Aggregate window functions need an aggregate");
+      window_terms_.push_back({type, nullptr});
+      return *this;
+    }
+
+    /**
+     * @param aggregate aggregate to compute as a window function
+     * @return builder object
+     */
+    Builder &AddWindowTerm(AggregateTerm aggregate) {
+      window_terms_.push_back({WindowFunctionType::AGGREGATE, aggregate});
+      return *this;
+    }
+
+    /**
+     * Build the window plan node
+     * @return plan node
+     */
+    std::unique_ptr<WindowPlanNode> Build();
+
+   protected:
+    /**
+     * Expressions the input is partitioned by
+     */
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_keys_;
+    /**
+     * Expressions and ordering types every partition is ordered by
+     */
+    std::vector<SortKey> sort_keys_;
+    /**
+     * Window functions to compute
+     */
+    std::vector<WindowTerm> window_terms_;
+  };
+
+ private:
+  /**
+   * @param children child plan nodes
+   * @param output_schema Schema representing the structure of the output of this plan node
+   * @param partition_keys expressions the input is partitioned by
+   * @param sort_keys expressions and orderings every partition is ordered by
+   * @param window_terms window functions to compute
+   * @param plan_node_id Plan node id
+   */
+  WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children, std::unique_ptr<OutputSchema> output_schema,
+                 std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_keys,
+                 std::vector<SortKey> sort_keys, std::vector<WindowTerm> window_terms, plan_node_id_t plan_node_id);
+
+ public:
+  /**
+   * Default constructor used for deserialization
+   */
+  WindowPlanNode() = default;
+
+  DISALLOW_COPY_AND_MOVE(WindowPlanNode)
+
+  /**
+   * @return expressions the input is partitioned by
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetPartitionKeys() const {
+    return partition_keys_;
+  }
+
+  /**
+   * @return expressions and orderings every partition is ordered by
+   */
+  const std::vector<SortKey> &GetSortKeys() const { return sort_keys_; }
+
+  /**
+   * @return window functions to compute
+   */
+  const std::vector<WindowTerm> &GetWindowTerms() const { return window_terms_; }
+
+  /**
+   * @return the type of this plan node
+   */
+  PlanNodeType GetPlanNodeType() const override { return PlanNodeType::WINDOW; }
+
+  /**
+   * @return the hashed value of this plan node
+   */
+  common::hash_t Hash() const override;
+
+  bool operator==(const AbstractPlanNode &rhs) const override;
+
+  void Accept(common::ManagedPointer<PlanVisitor> v) const override { v->Visit(this); }
+
+  nlohmann::json ToJson() const override;
+  std::vector<std::unique_ptr<parser::AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+ private:
+  /* Expressions the input is partitioned by */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_keys_;
+
+  /* Expressions and ordering types ([ASC] or [DESC]) every partition is ordered by */
+  std::vector<SortKey> sort_keys_;
+
+  /* Window functions to compute */
+  std::vector<WindowTerm> window_terms_;
+};
+
+DEFINE_JSON_HEADER_DECLARATIONS(WindowPlanNode);
+
+}  // namespace noisepage::planner
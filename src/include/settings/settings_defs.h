@@ -89,6 +89,17 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of garbage collector workers
+SETTING_int(
+    gc_num_workers,
+    "The number of threads that unlink versions in every garbage collector run, including the GC thread (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Write ahead logging
 SETTING_bool(
     wal_enable,
@@ -140,6 +151,57 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of log streams
+SETTING_int(
+    wal_num_streams,
+    "The number of log streams the WAL is split into, each with its own serializer, consumer and log file (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Group commit latency target
+SETTING_int(
+    wal_group_commit_latency_target,
+    "p99 commit latency target (us) the log file persist is batched for, 0 disables group commit (default: 0)",
+    0,
+    0,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Whether checkpoints are taken
+SETTING_bool(
+    checkpoint_enable,
+    "Whether checkpoints are taken periodically, removing the log files they cover (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Path to checkpoint file
+SETTING_string(
+    checkpoint_file_path,
+    "The path to the checkpoint file (default: checkpoint.log)",
+    "checkpoint.log",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint interval
+SETTING_int(
+    checkpoint_interval,
+    "Time (s) between the end of a checkpoint and the start of the next one (default: 300)",
+    300,
+    1,
+    86400,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
@@ -155,6 +217,17 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Memory budget of a query
+SETTING_int64(
+    query_memory_budget,
+    "Memory (bytes) a query may use to buffer tuples in operators that can spill to disk, 0 for no limit (default: 0)",
+    0,
+    0,
+    INT64_MAX,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Log file persisting threshold
 SETTING_int64(
     wal_persist_threshold,
@@ -311,6 +384,16 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int(
+    plan_cache_size,
+    "Maximum number of plans that the Simple Query protocol shares across connections, 0 disables it (default: 1024)",
+    1024,
+    0,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     compiled_query_execution,
     "Compile queries to native machine code using LLVM, rather than relying on TPL interpretation (default: false).",
@@ -319,6 +402,52 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_bool(
+    adaptive_query_execution,
+    "Interpret queries until they ran often or long enough, then compile them in the background (default: false).",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    jit_object_cache_directory,
+    "Directory in which JIT-compiled query code is cached across restarts, empty to not cache it (default: empty)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    jit_object_cache_size,
+    "Maximum size (bytes) of the JIT-compiled query code cache before least recently used code is evicted (default: 256MB)",
+    (1 << 28) /* 256MB */,
+    (1 << 20) /* 1MB */,
+    INT64_MAX,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    adaptive_compile_runs,
+    "Number of interpreted runs after which adaptive query execution compiles a query (default: 3)",
+    3,
+    1,
+    INT64_MAX,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    adaptive_compile_interpret_time_us,
+    "Total interpreted run time (us) after which adaptive query execution compiles a query (default: 50000)",
+    50000,
+    0,
+    INT64_MAX,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_string(
     application_name,
     "The name of the application (default: NO_NAME)",
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "storage/storage_defs.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::catalog {
+class Catalog;
+class DatabaseCatalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TimestampManager;
+class TransactionContext;
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+class LogManager;
+class LogRecord;
+class SqlTable;
+
+/**
+ * A CheckpointManager writes fuzzy checkpoints: consistent snapshots of every table, including the catalog, taken by a
+ * single transaction while other transactions keep running. Recovery replays the latest checkpoint and only the part of
+ * the log that follows it, so log files covered by a checkpoint can be removed.
+ *
+ * A checkpoint is written in the log format, as if all tuples visible to the snapshot transaction had been inserted by
+ * transactions that committed at its start time. For every database, the catalog rows come first, followed by the
+ * updates to the pointer column of pg_class that make recovery recreate the tables and indexes, and then the rows of
+ * the user tables, split into transactions of at most CHECKPOINT_TXN_SIZE tuples. Every record carries the tuple slot
+ * of the tuple in the checkpointed table, so that the log following the checkpoint can be replayed on top of it. The
+ * checkpoint is written to a temporary file first and renamed once complete, so that a crash never leaves a partial
+ * checkpoint behind.
+ *
+ * If logging is enabled, every checkpoint rotates the log files (see LogManager::RotateLogFiles), and waits for all
+ * transactions that were running at the time to finish before taking its snapshot. Every transaction in the rotated
+ * log segments then committed before the snapshot, so the segments are removed once the checkpoint is written. On
+ * recovery, transactions in the rest of the log that committed before the snapshot are skipped, since their changes are
+ * part of the checkpoint already.
+ *
+ * @warning The snapshot transaction stays open while the checkpoint is written, which holds back garbage collection
+ */
+class CheckpointManager {
+ public:
+  /**
+   * @param checkpoint_file_path path to write checkpoints to, replacing the previous checkpoint
+   * @param catalog catalog of the tables to checkpoint
+   * @param txn_manager transaction manager to begin snapshot transactions with
+   * @param timestamp_manager timestamp manager of the transaction manager
+   * @param log_manager log manager whose log files are truncated by checkpoints, nullptr if logging is disabled
+   */
+  CheckpointManager(std::string checkpoint_file_path, common::ManagedPointer<catalog::Catalog> catalog,
+                    common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
+                    common::ManagedPointer<LogManager> log_manager)
+      : checkpoint_file_path_(std::move(checkpoint_file_path)),
+        catalog_(catalog),
+        txn_manager_(txn_manager),
+        timestamp_manager_(timestamp_manager),
+        log_manager_(log_manager) {}
+
+  ~CheckpointManager() {
+    if (run_checkpoint_thread_) StopCheckpointThread();
+  }
+
+  DISALLOW_COPY_AND_MOVE(CheckpointManager)
+
+  /**
+   * Writes a checkpoint, and removes the log segments it covers if logging is enabled. Blocks until all transactions
+   * that were running when it was called have finished, and the checkpoint is written.
+   * @return start time of the snapshot transaction, the timestamp the checkpoint is consistent at
+   */
+  transaction::timestamp_t TakeCheckpoint();
+
+  /**
+   * Spawns a thread that takes a checkpoint at a fixed interval
+   * @param checkpoint_interval time between the end of a checkpoint and the start of the next one
+   */
+  void StartCheckpointThread(std::chrono::seconds checkpoint_interval);
+
+  /**
+   * Stops the checkpoint thread, waiting for a checkpoint in progress to finish
+   */
+  void StopCheckpointThread();
+
+  /**
+   * @return path checkpoints are written to
+   */
+  const std::string &CheckpointFilePath() const { return checkpoint_file_path_; }
+
+  /**
+   * @param checkpoint_file_path path checkpoints are written to
+   * @return path checkpoints are written to until they are complete
+   */
+  static std::string TemporaryCheckpointFilePath(const std::string &checkpoint_file_path) {
+    return checkpoint_file_path + ".tmp";
+  }
+
+ private:
+  // Maximum number of tuples of user tables per transaction in a checkpoint, which bounds the memory recovery needs to
+  // buffer the records of a transaction
+  static constexpr uint32_t CHECKPOINT_TXN_SIZE = 10000;
+
+  // A table or index in pg_class, whose pointer column recovery needs to see an update to in order to recreate it
+  struct ClassEntry {
+    TupleSlot slot_;
+    uint32_t oid_;
+    char kind_;
+    uint64_t ptr_;
+  };
+
+  const std::string checkpoint_file_path_;
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
+  const common::ManagedPointer<LogManager> log_manager_;
+
+  // Only one checkpoint is taken at a time
+  std::mutex checkpoint_latch_;
+
+  // Background checkpointing, the thread waits on the condition variable between checkpoints so it can be stopped
+  bool run_checkpoint_thread_ = false;
+  std::chrono::seconds checkpoint_interval_{0};
+  std::mutex thread_latch_;
+  std::condition_variable thread_cv_;
+  std::thread checkpoint_thread_;
+
+  // State of the checkpoint being written
+  transaction::TransactionContext *txn_ = nullptr;
+  BufferedLogWriter *out_ = nullptr;
+  // Number of records written since the last commit record
+  uint64_t uncommitted_records_ = 0;
+
+  void CheckpointThreadLoop();
+
+  /**
+   * Writes all databases to the checkpoint file
+   */
+  void WriteCheckpoint();
+
+  /**
+   * Writes the catalog and the user tables of a database
+   * @param db_oid database to write
+   * @param pg_database_slot tuple slot of the row of the database in pg_database
+   */
+  void WriteDatabase(catalog::db_oid_t db_oid, TupleSlot pg_database_slot);
+
+  /**
+   * Writes an insert record for every tuple of a table that is visible to the snapshot transaction
+   * @tparam RowFn callable taking a RedoRecord *, invoked on every record before it is written. Returns false if the
+   * record should not be written
+   * @param db_oid database of the table
+   * @param table_oid oid of the table
+   * @param table the table
+   * @param split_txns whether to end a transaction every CHECKPOINT_TXN_SIZE tuples
+   * @param on_row function to inspect or modify the records with
+   */
+  template <class RowFn>
+  void WriteTable(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid, common::ManagedPointer<SqlTable> table,
+                  bool split_txns, const RowFn &on_row);
+
+  /**
+   * @param table a table
+   * @return oids of all columns of the table
+   */
+  static std::vector<catalog::col_oid_t> ColumnOids(common::ManagedPointer<SqlTable> table);
+
+  /**
+   * Writes a commit record for the records written since the last one
+   */
+  void WriteCommit();
+
+  /**
+   * Serializes a record to the checkpoint file
+   * @param record record to write
+   */
+  void WriteRecord(const LogRecord &record);
+};
+
+}  // namespace noisepage::storage
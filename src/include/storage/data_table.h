@@ -133,6 +133,18 @@ class DataTable {
       }
     }
 
+    // Advance the iterator past the given number of slots in the current block, moving on to the next block if the
+    // current one is exhausted. Used by DataTable to step over slots that were read in place.
+    void SkipInBlock(const uint32_t num_slots) {
+      slot_num_ += num_slots;
+      if (slot_num_ < max_slot_num_) {
+        current_slot_ = {current_slot_.GetBlock(), slot_num_};
+      } else {
+        block_index_++;
+        UpdateFromNextBlock();
+      }
+    }
+
     static auto InvalidTupleSlot() -> TupleSlot { return {nullptr, 0}; }
     const DataTable *table_ = nullptr;
     uint64_t block_index_ = 0, end_index_ = 0;
@@ -193,6 +205,11 @@ class DataTable {
    * to fill the buffer, unless there are no more tuples. The given iterator is mutated to point to one slot passed the
    * last slot scanned in the invocation.
    *
+   * FROZEN blocks are not materialized. If the scan starts on a frozen block and the buffer owns its data, the column
+   * vectors of the buffer are pointed directly at the block's Arrow columns and the block's in-place read latch is held
+   * until the buffer is next reset or destroyed. A materializing scan stops early at the start of a frozen block so
+   * that the next invocation can read it in place.
+   *
    * @param txn The calling transaction.
    * @param start_pos Iterator to the starting location for the sequential scan.
    * @param out_buffer Output buffer. This buffer is always cleared of old values.
@@ -261,6 +278,18 @@ class DataTable {
    */
   TupleSlot Insert(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo);
 
+  /**
+   * Inserts a batch of tuples, as given in the redos. Rather than finding a free slot in the insertion head once per
+   * tuple, runs of consecutive slots are claimed for as many tuples as each block has room for.
+   *
+   * @param txn the calling transaction
+   * @param redos after-images of the inserted tuples. Should not reference col_id 0
+   * @param num_tuples the number of tuples to insert
+   * @param[out] slots array of num_tuples tuple slots the slots allocated for the tuples are written to, in order
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow *const *redos,
+                   uint32_t num_tuples, TupleSlot *slots);
+
   /**
    * Deletes the given TupleSlot, this will call StageDelete on the provided txn to generate the RedoRecord for delete.
    * The rest of the behavior follows Update's behavior.
@@ -325,6 +354,10 @@ class DataTable {
   // data to minimize copies and increase efficiency.
   friend class ArrowSerializer;
 
+  // Maximum number of undo records a writer looks at past its own when pruning a version chain. Bounds the work done
+  // for nothing while a long running transaction keeps the versions alive.
+  static constexpr uint32_t MAX_PRUNE_TRAVERSAL = 16;
+
   /**
    * accessor_ tuple access strategy for DataTable
    */
@@ -345,6 +378,21 @@ class DataTable {
   bool SelectIntoBuffer(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
                         RowType *out_buffer) const;
 
+  // Reads the next run of tuples of a FROZEN block in place, pointing the columns of the output buffer straight at the
+  // block's data instead of copying it out. Returns false without touching the buffer if the block at the iterator's
+  // position cannot be read in place, in which case the caller should fall back to a transactional scan.
+  bool ScanInPlace(SlotIterator *start_pos, execution::sql::VectorProjection *out_buffer) const;
+
+  // Copies the tuples from the iterator's position up to the end of its version synopsis range into the output buffer
+  // with one memcpy per column and run of visible tuples, advancing the iterator and the fill count. Returns false
+  // without advancing anything if the range has version chains, in which case the caller should materialize tuples
+  // one at a time.
+  bool CopyUnversionedSlots(SlotIterator *start_pos, execution::sql::VectorProjection *out_buffer,
+                            uint32_t *filled) const;
+
+  // Whether the column vectors of the projection have the same element width as the attributes they are read from.
+  bool HasStorageCompatibleColumns(const execution::sql::VectorProjection &projection) const;
+
   void InsertInto(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
                   TupleSlot dest);
   // Atomically read out the version pointer value.
@@ -369,11 +417,21 @@ class DataTable {
 
   // Compares and swaps the version pointer to be the undo record, only if its value is equal to the expected one.
   bool CompareAndSwapVersionPtr(TupleSlot slot, const TupleAccessStrategy &accessor, UndoRecord *expected,
-                                UndoRecord *desired);
+                                UndoRecord *desired) const;
+
+  // Cuts the version chain after the given undo record off at the first record older than the horizon, if there is one
+  // among the next MAX_PRUNE_TRAVERSAL records. Such records are invisible to every running transaction, so no reader
+  // follows the chain past them. Pruning only ever sets next pointers to nullptr, so any number of transactions and the
+  // GC can prune the same version chain at the same time.
+  void PruneVersionChain(UndoRecord *record, transaction::timestamp_t horizon) const;
 
   // Allocates a new block to be used as insertion head.
   RawBlock *NewBlock();
 
+  // Allocates up to num_slots consecutive slots in the first block with free slots that no other thread is inserting
+  // into, writing them to slots. Returns the number of slots allocated, at least 1.
+  uint32_t AllocateSlots(uint32_t num_slots, TupleSlot *slots);
+
   /**
    * Determine if a Tuple is visible (present and not deleted) to the given transaction. It's effectively Select's logic
    * (follow a version chain if present) without the materialization. If the logic of Select changes, this should change
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
+#include "common/worker_pool.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -31,6 +34,11 @@ class Index;
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * With more than one worker, the undo records of the transactions that are safe to unlink are partitioned by the block
+ * of their tuple slot, and every partition is unlinked by one worker. A version chain is then only ever truncated by a
+ * single worker, which is what makes it safe to truncate it past the head without a CAS. Only as many workers as there
+ * are enough undo records for are used, and indexes are garbage collected by the workers in the meantime.
  */
 class GarbageCollector {
  public:
@@ -44,12 +52,15 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_workers number of threads that unlink undo records in every GC run, including the thread that invokes
+   *                    the GC
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer);
+                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   uint32_t num_workers = 1);
 
   ~GarbageCollector() {
     NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
@@ -86,7 +97,23 @@ class GarbageCollector {
    */
   void SetGCInterval(uint64_t gc_interval) { gc_interval_ = gc_interval; }
 
+  /**
+   * @return number of threads that unlink undo records in every GC run
+   */
+  uint32_t NumWorkers() const { return num_workers_; }
+
  private:
+  // Minimum number of undo records worth handing to another worker in a GC run
+  static constexpr uint32_t MIN_RECORDS_PER_WORKER = 1024;
+
+  // Undo records to unlink in one partition, along with the varlen buffers they leave for their transactions to free.
+  // The buffers are added to the transactions once all partitions are done, since a transaction's records can be in
+  // several partitions.
+  struct UnlinkPartition {
+    std::vector<std::pair<transaction::TransactionContext *, UndoRecord *>> records_;
+    std::vector<std::pair<transaction::TransactionContext *, const byte *>> loose_ptrs_;
+  };
+
   /**
    * Process the deallocate queue
    * @return number of txns (not UndoRecords) processed for debugging/testing
@@ -109,7 +136,15 @@ class GarbageCollector {
 
   void ReclaimSlotIfDeleted(UndoRecord *undo_record) const;
 
-  void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record) const;
+  void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record,
+                             std::vector<std::pair<transaction::TransactionContext *, const byte *>> *loose_ptrs) const;
+
+  /**
+   * Truncates the version chains of the undo records of a partition, and reclaims what they leave behind
+   * @param partition partition to process
+   * @param oldest_txn start time of the oldest running transaction
+   */
+  void ProcessUnlinkPartition(UnlinkPartition *partition, transaction::timestamp_t oldest_txn) const;
 
   void TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
 
@@ -130,6 +165,12 @@ class GarbageCollector {
   common::SharedLatch indexes_latch_;
 
   uint64_t gc_interval_{0};
+
+  const uint32_t num_workers_;
+  // Threads that process all but the first partition, nullptr if there is only one worker
+  std::unique_ptr<common::WorkerPool> worker_pool_;
+  // Reused across GC runs to keep their capacity
+  std::vector<UnlinkPartition> partitions_;
 };
 
 }  // namespace noisepage::storage
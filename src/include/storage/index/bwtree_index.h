@@ -100,6 +100,17 @@ class BwTreeIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Finds all the values associated with each of a batch of keys in our index. The keys are traversed in sorted order
+   * under a single epoch, and duplicate keys are only traversed once.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_list the values associated with the keys, grouped by key
+   * @param[out] key_offsets keys.size() + 1 offsets into value_list delimiting the values of every key
+   */
+  void ScanKeys(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_offsets) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -41,6 +41,8 @@ class HashIndex final : public Index {
   // TODO(Matt): unclear at the moment if we would want this to be tunable via the SettingsManager. Alternatively, it
   // might be something that is a per-index hint based on the table size (cardinality?), rather than a global setting
   static constexpr uint16_t INITIAL_CUCKOOHASH_MAP_SIZE = 256;
+  // Number of keys ahead of the one being looked up whose buckets are prefetched in a batch lookup
+  static constexpr uint32_t PREFETCH_DISTANCE = 8;
   struct TupleSlotHash;
 
   using ValueMap = std::unordered_set<TupleSlot, TupleSlotHash>;
@@ -48,6 +50,15 @@ class HashIndex final : public Index {
 
   explicit HashIndex(IndexMetadata metadata);
 
+  /**
+   * Appends the TupleSlots stored under a key that are visible to a txn to a value list
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param value the value stored under the key
+   * @param[out] value_list the vector to append the visible TupleSlots to
+   */
+  static void CollectVisible(const transaction::TransactionContext &txn, const ValueType &value,
+                             std::vector<TupleSlot> *value_list);
+
   const std::unique_ptr<
       cuckoohash_map<KeyType, ValueType, std::hash<KeyType>,
                      std::equal_to<KeyType>,  // NOLINT transparent functors can't figure out template
@@ -107,6 +118,17 @@ class HashIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Finds all the values associated with each of a batch of keys in our index. The buckets of upcoming keys are
+   * prefetched while a key is looked up, so that the cache misses of several lookups overlap.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_list the values associated with the keys, grouped by key
+   * @param[out] key_offsets keys.size() + 1 offsets into value_list delimiting the values of every key
+   */
+  void ScanKeys(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_offsets) final;
+
   /** @return The number of keys in the index. */
   uint64_t GetSize() const final;
 };
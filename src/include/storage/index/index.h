@@ -115,6 +115,29 @@ class Index {
   virtual void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                        std::vector<TupleSlot> *value_list) = 0;
 
+  /**
+   * Finds all the values associated with each of a batch of keys in our index. The values of keys[i] end up in
+   * value_list at [key_offsets[i], key_offsets[i + 1]). Index types that can probe several keys more cheaply than one
+   * after the other (sorted traversal, prefetching) override this, the default looks up every key with ScanKey.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_list the values associated with the keys, grouped by key
+   * @param[out] key_offsets keys.size() + 1 offsets into value_list delimiting the values of every key
+   */
+  virtual void ScanKeys(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                        std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_offsets) {
+    NOISEPAGE_ASSERT(value_list->empty() && key_offsets->empty(), "Result vectors should be empty.");
+    std::vector<TupleSlot> key_values;
+    key_offsets->reserve(keys.size() + 1);
+    key_offsets->emplace_back(0);
+    for (const auto *const key : keys) {
+      key_values.clear();
+      ScanKey(txn, *key, &key_values);
+      value_list->insert(value_list->end(), key_values.cbegin(), key_values.cend());
+      key_offsets->emplace_back(static_cast<uint32_t>(value_list->size()));
+    }
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
@@ -19,6 +21,13 @@ class DiskLogProvider : public AbstractLogProvider {
    */
   explicit DiskLogProvider(const std::string &log_file_path) : in_(BufferedLogReader(log_file_path.c_str())) {}
 
+  /**
+   * @param log_file_paths paths to log files to read logs from, in order, as if they were one log file. Used to read
+   * the log segments of a log stream along with its current log file (see LogManager::LogFilePaths)
+   */
+  explicit DiskLogProvider(std::vector<std::string> log_file_paths)
+      : in_(BufferedLogReader(std::move(log_file_paths))) {}
+
  private:
   // Buffered log file reader
   storage::BufferedLogReader in_;
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/recovery/abstract_log_provider.h"
+
+namespace noisepage::storage {
+
+/**
+ * @brief Log provider that merges the log streams of a log manager
+ * A log manager with more than one log stream writes every transaction to one of several log files. This provider
+ * merges them back into a single sequence the recovery manager can replay as if it had been written by one stream.
+ *
+ * Each stream is consumed in runs that end with a commit record, and the next run always comes from the stream whose
+ * run ends with the smallest commit timestamp. Records of a transaction all come from the same stream, so they still
+ * precede its commit record. A transaction that was serialized before another committed also committed before it, so
+ * every transaction older than the oldest active transaction of a commit record has its commit record provided before
+ * that commit record, just like in a single log file.
+ */
+class MergedLogProvider : public AbstractLogProvider {
+ public:
+  /**
+   * @param providers providers of the individual log streams
+   */
+  explicit MergedLogProvider(std::vector<std::unique_ptr<AbstractLogProvider>> providers);
+
+  /**
+   * Merges the log files of all the log streams of a log manager, each read along with its log segments
+   * @param log_file_path log file path the log manager was constructed with
+   * @param num_streams number of log streams of the log manager
+   */
+  MergedLogProvider(const std::string &log_file_path, uint32_t num_streams);
+
+  /**
+   * Provide next available log record, from whichever log stream is next in commit timestamp order
+   * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
+   * provided.
+   */
+  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() override;
+
+ private:
+  // A log stream along with the records read ahead from it
+  struct Stream {
+    std::unique_ptr<AbstractLogProvider> provider_;
+    // Records up to and including the next commit record, or up to the end of the log
+    std::deque<std::pair<LogRecord *, std::vector<byte *>>> run_;
+    bool exhausted_ = false;
+  };
+
+  std::vector<Stream> streams_;
+  // Stream whose run is currently provided
+  Stream *current_ = nullptr;
+
+  /**
+   * Reads ahead the next run of a stream
+   * @param stream stream to read from
+   */
+  void ReadRun(Stream *stream);
+
+  /**
+   * @return true if any stream has records left to provide
+   */
+  bool HasMoreRecords() override;
+
+  /**
+   * Records are read from the individual streams, so the merged provider never reads bytes itself
+   */
+  bool Read(void *dest, uint32_t size) override {
+    NOISEPAGE_ASSERT(false, "MergedLogProvider reads records from its streams");
+    return false;
+  }
+};
+
+}  // namespace noisepage::storage
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -18,6 +20,8 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/sql_table.h"
 
@@ -61,6 +65,77 @@ class RecoveryManager : public common::DedicatedThreadOwner {
     RecoveryManager *recovery_manager_;
   };
 
+  /**
+   * Maps tuple slots in the logs to the tuple slots they were recovered to. The map is split into latched shards, so
+   * that transactions replayed in parallel can use it concurrently.
+   */
+  class TupleSlotMap {
+   public:
+    /**
+     * @param slot tuple slot in the logs
+     * @return true if the slot has been recovered and not deleted since
+     */
+    bool Contains(const TupleSlot slot) {
+      auto &shard = ShardFor(slot);
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      return shard.map_.find(slot) != shard.map_.end();
+    }
+
+    /**
+     * @param slot tuple slot in the logs
+     * @return tuple slot the slot was recovered to
+     */
+    TupleSlot Get(const TupleSlot slot) {
+      auto &shard = ShardFor(slot);
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      NOISEPAGE_ASSERT(shard.map_.find(slot) != shard.map_.end(), "No tuple slot mapping exists");
+      return shard.map_[slot];
+    }
+
+    /**
+     * Maps a tuple slot in the logs to the tuple slot it was recovered to, overwriting any previous mapping
+     * @param old_slot tuple slot in the logs
+     * @param new_slot tuple slot after recovery
+     */
+    void Insert(const TupleSlot old_slot, const TupleSlot new_slot) {
+      auto &shard = ShardFor(old_slot);
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      shard.map_[old_slot] = new_slot;
+    }
+
+    /**
+     * Removes the mapping of a deleted tuple slot, the slot may be reused by a later insert
+     * @param slot tuple slot in the logs
+     */
+    void Erase(const TupleSlot slot) {
+      auto &shard = ShardFor(slot);
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      shard.map_.erase(slot);
+    }
+
+    /**
+     * @warning not safe to call while transactions are being replayed
+     * @return all mappings in a single map
+     */
+    std::unordered_map<TupleSlot, TupleSlot> ToUnorderedMap() const {
+      std::unordered_map<TupleSlot, TupleSlot> result;
+      for (const auto &shard : shards_) result.insert(shard.map_.begin(), shard.map_.end());
+      return result;
+    }
+
+   private:
+    static constexpr uint32_t NUM_SHARDS = 64;
+
+    struct Shard {
+      common::SpinLatch latch_;
+      std::unordered_map<TupleSlot, TupleSlot> map_;
+    };
+
+    Shard &ShardFor(const TupleSlot slot) { return shards_[std::hash<TupleSlot>()(slot) % NUM_SHARDS]; }
+
+    std::array<Shard, NUM_SHARDS> shards_;
+  };
+
  public:
   /**
    * @param log_provider arbitrary provider to receive logs from
@@ -69,20 +144,32 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param deferred_action_manager manager to use for deferred deletes
    * @param thread_registry thread registry to register tasks
    * @param store block store used for SQLTable creation during recovery
+   * @param num_replay_threads number of threads to replay transactions that only modify a single user table with. With
+   * more than one thread, such transactions are replayed in batches, with the transactions on every table replayed by
+   * one thread
+   * @param checkpoint_provider provider of the checkpoint to recover before the logs, nullptr if there is none. The log
+   * provider then only needs to provide the logs that follow the checkpoint
    */
   explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider> log_provider,
                            const common::ManagedPointer<catalog::Catalog> catalog,
                            const common::ManagedPointer<transaction::TransactionManager> txn_manager,
                            const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                            const common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry,
-                           const common::ManagedPointer<BlockStore> store)
+                           const common::ManagedPointer<BlockStore> store, const uint32_t num_replay_threads = 1,
+                           const common::ManagedPointer<AbstractLogProvider> checkpoint_provider = nullptr)
       : DedicatedThreadOwner(thread_registry),
         log_provider_(log_provider),
+        checkpoint_provider_(checkpoint_provider),
         catalog_(catalog),
         txn_manager_(txn_manager),
         deferred_action_manager_(deferred_action_manager),
         block_store_(store),
+        num_replay_threads_(num_replay_threads),
         recovered_txns_(0) {
+    NOISEPAGE_ASSERT(num_replay_threads > 0, "Recovery needs at least one thread to replay transactions");
+    if (num_replay_threads_ > 1) {
+      replay_pool_ = std::make_unique<common::WorkerPool>(num_replay_threads_, common::TaskQueue());
+    }
     // Initialize catalog_table_schemas_ map
     catalog_table_schemas_[catalog::postgres::PgClass::CLASS_TABLE_OID] =
         catalog::postgres::Builder::GetClassTableSchema();
@@ -116,6 +203,13 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // Log provider for reading in logs
   const common::ManagedPointer<AbstractLogProvider> log_provider_;
 
+  // Log provider for reading in the checkpoint, if any
+  const common::ManagedPointer<AbstractLogProvider> checkpoint_provider_;
+
+  // Time the recovered checkpoint is consistent at. Transactions in the logs that committed before it are part of the
+  // checkpoint already and are skipped.
+  transaction::timestamp_t checkpoint_time_ = transaction::INVALID_TXN_TIMESTAMP;
+
   // Catalog to fetch table pointers
   const common::ManagedPointer<catalog::Catalog> catalog_;
 
@@ -133,7 +227,19 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // Used during recovery from log. Maps old tuple slot to new tuple slot
   // TODO(Gus): This map may get huge, benchmark whether this becomes a problem and if we need a more sophisticated data
   // structure
-  std::unordered_map<TupleSlot, TupleSlot> tuple_slot_map_;
+  TupleSlotMap tuple_slot_map_;
+
+  // Number of threads that replay transactions on user tables, and the pool they run on if there is more than one
+  const uint32_t num_replay_threads_;
+  std::unique_ptr<common::WorkerPool> replay_pool_;
+
+  // Used during recovery from log with more than one replay thread. Committed transactions, in serial order, that are
+  // safe to replay but wait to be replayed in parallel with the next ones. A transaction that modifies the catalog or
+  // more than one table is never part of a batch, the batch is replayed before it instead.
+  std::vector<transaction::timestamp_t> replay_batch_;
+
+  // Number of transactions after which a batch is replayed even if no transaction that modifies the catalog follows
+  static constexpr uint32_t REPLAY_BATCH_SIZE = 1024;
 
   // Used during recovery from log. Stores deferred transactions in sorted sorted order to be able to execute them in
   // serial order. Transactions are defered when there is an older active transaction at the time it committed. Even
@@ -157,17 +263,28 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   uint32_t recovered_txns_;
 
   /**
-   * Recovers the databases using the provided log provider
-   * @return number of committed transactions replayed
+   * Recovers the databases using the provided checkpoint and log providers
    */
-  void Recover() { RecoverFromLogs(); }
+  void Recover();
 
   /**
-   * Recovers the databases from the logs.
-   * @note this is a separate method so in the future, we can also have a RecoverFromCheckpoint method
+   * Recovers the databases from the checkpoint, and remembers the time it is consistent at
+   */
+  void RecoverFromCheckpoint();
+
+  /**
+   * Recovers the databases from the logs, skipping transactions that are part of the recovered checkpoint
    */
   void RecoverFromLogs();
 
+  /**
+   * Buffers the records of a log provider until it stops providing them, replaying every committed transaction once it
+   * is safe to
+   * @param provider log provider to read records from
+   * @param from_checkpoint true if the records make up a checkpoint
+   */
+  void ReplayRecords(common::ManagedPointer<AbstractLogProvider> provider, bool from_checkpoint);
+
   /**
    * @brief Replay a committed transaction corresponding to txn_id.
    * @param txn_id start timestamp for committed transaction
@@ -183,7 +300,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
 
   /**
    * Replay any transaction who's txn start time is less than upper_bound. If upper_bound == transaction::NO_ACTIVE_TXN,
-   * it will replay all deferred transactions
+   * it will replay all deferred transactions. With more than one replay thread, transactions that only modify a single
+   * user table may only be added to replay_batch_, unless all deferred transactions are replayed
    * @param upper_bound upper bound for replaying
    * @return number of transactions replayed
    */
@@ -194,26 +312,71 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param slot old tuple slot
    * @return new tuple slot
    */
-  TupleSlot GetTupleSlotMapping(TupleSlot slot) {
-    NOISEPAGE_ASSERT(tuple_slot_map_.find(slot) != tuple_slot_map_.end(), "No tuple slot mapping exists");
-    return tuple_slot_map_[slot];
-  }
+  TupleSlot GetTupleSlotMapping(TupleSlot slot) { return tuple_slot_map_.Get(slot); }
 
   /**
    * Wrapper over GetDatabaseCatalog method that asserts the database exists
    * @param txn txn for catalog lookup
    * @param database oid for database we want
+   * @param lock true if the txn modifies the catalog and should hold the DDL lock of the database. Transactions that
+   * are replayed in parallel never modify the catalog, and must not take the lock.
    * @return pointer to database catalog
    */
   common::ManagedPointer<catalog::DatabaseCatalog> GetDatabaseCatalog(transaction::TransactionContext *txn,
-                                                                      catalog::db_oid_t db_oid) {
+                                                                      catalog::db_oid_t db_oid, bool lock = true) {
     auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
     NOISEPAGE_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
-    auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
-    NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+    if (lock) {
+      auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
+      NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+    }
     return db_catalog_ptr;
   }
 
+  /**
+   * @param table_oid oid of a table
+   * @return true if the table is a catalog table
+   */
+  static bool IsCatalogTable(const catalog::table_oid_t table_oid) {
+    return table_oid.UnderlyingValue() < catalog::START_OID;
+  }
+
+  /**
+   * @param record redo or delete record
+   * @return oid of the table the record modifies
+   */
+  static catalog::table_oid_t GetTableOid(const LogRecord *record) {
+    if (record->RecordType() == LogRecordType::REDO) {
+      return record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid();
+    }
+    return record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+  }
+
+  /**
+   * @param record redo or delete record
+   * @return oid of the database of the table the record modifies
+   */
+  static catalog::db_oid_t GetDatabaseOid(const LogRecord *record) {
+    if (record->RecordType() == LogRecordType::REDO) {
+      return record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid();
+    }
+    return record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid();
+  }
+
+  /**
+   * @param txn_id start timestamp for committed transaction
+   * @return true if the transaction modified any catalog table, or more than one table, and thus must be replayed on its
+   * own. Replaying its changes to every table in a txn of their own would break its atomicity.
+   */
+  bool MustReplaySerially(transaction::timestamp_t txn_id) const;
+
+  /**
+   * Replays the transactions in replay_batch_ on the replay threads. Every transaction modified a single table, and
+   * the transactions on every table are replayed by one thread, in serial order, with one txn each.
+   * @return number of transactions replayed
+   */
+  uint32_t ReplayBatch();
+
   /**
    * @param txn transaction to use for catalog lookup
    * @param db_oid database oid for requested table
@@ -284,9 +447,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param record record we want to determine redo type of
    * @return true if record is an insert redo, false if it is an update redo
    */
-  bool IsInsertRecord(const RedoRecord *record) const {
-    return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
-  }
+  bool IsInsertRecord(const RedoRecord *record) { return !tuple_slot_map_.Contains(record->GetTupleSlot()); }
 
   /**
    * Processes records that modify the catalog tables. Because catalog modifications usually result in multiple log
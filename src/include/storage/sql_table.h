@@ -118,6 +118,21 @@ class SqlTable {
     return slot;
   }
 
+  /**
+   * Inserts a batch of tuples, claiming their slots in runs of consecutive slots. Unlike Insert, the tuples are not
+   * read from staged writes, so the caller must StageWrite a copy of every tuple, with the slot it was inserted at, for
+   * the inserts to be logged.
+   *
+   * @param txn the calling transaction
+   * @param tuples the inserted tuples.
+   * @param num_tuples the number of tuples to insert
+   * @param[out] slots array of num_tuples tuple slots the slots of the inserted tuples are written to, in order
+   */
+  void InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                   const ProjectedRow *const *const tuples, const uint32_t num_tuples, TupleSlot *const slots) const {
+    table_.data_table_->InsertBatch(txn, tuples, num_tuples, slots);
+  }
+
   /**
    * Deletes the given TupleSlot. StageDelete must have been called as well in order for the operation to be logged.
    * @param txn the calling transaction
@@ -8,6 +8,7 @@
 #include "storage/arrow_block_metadata.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
+#include "storage/version_synopsis.h"
 
 namespace noisepage::storage {
 
@@ -47,7 +48,7 @@ class TupleAccessStrategy {
    * -----------------------------------------------------------------------------------------------------------------
    * | data_table *(64) | padding (16) | layout_version (16) | insert_head (32) |        control_block (64)          |
    * -----------------------------------------------------------------------------------------------------------------
-   * | ArrowBlockMetadata | attr_offsets[num_col] (32) | bitmap for slots (64-bit aligned) | data (64-bit aligned)   |
+   * | ArrowBlockMetadata | VersionSynopsis | attr_offsets[num_col] (32) | bitmap for slots (64-bit aligned) | data  |
    * -----------------------------------------------------------------------------------------------------------------
    *
    * Note that we will never need to span a tuple across multiple pages if we enforce
@@ -60,9 +61,14 @@ class TupleAccessStrategy {
     // well.
     ArrowBlockMetadata &GetArrowBlockMetadata() { return *reinterpret_cast<ArrowBlockMetadata *>(block_.content_); }
 
+    VersionSynopsis &GetVersionSynopsis(const BlockLayout &layout) {
+      return *reinterpret_cast<VersionSynopsis *>(block_.content_ + ArrowBlockMetadata::Size(layout.NumColumns()));
+    }
+
     // return reference to attr_offsets. Use as an array.
     uint32_t *AttrOffsets(const BlockLayout &layout) {
-      return reinterpret_cast<uint32_t *>(block_.content_ + ArrowBlockMetadata::Size(layout.NumColumns()));
+      return reinterpret_cast<uint32_t *>(block_.content_ + ArrowBlockMetadata::Size(layout.NumColumns()) +
+                                          VersionSynopsis::Size());
     }
 
     // return reference to the bitmap for slots. Use as a member
@@ -107,6 +113,14 @@ class TupleAccessStrategy {
     return reinterpret_cast<Block *>(block)->GetArrowBlockMetadata();
   }
 
+  /**
+   * @param block block to access
+   * @return the VersionSynopsis object of the requested block
+   */
+  VersionSynopsis &GetVersionSynopsis(RawBlock *block) const {
+    return reinterpret_cast<Block *>(block)->GetVersionSynopsis(layout_);
+  }
+
   /**
    * @param slot tuple slot value to check
    * @return whether the given slot is occupied by a tuple
@@ -221,6 +235,15 @@ class TupleAccessStrategy {
    */
   bool Allocate(RawBlock *block, TupleSlot *slot) const;
 
+  /**
+   * Allocates consecutive slots for new tuples, as many as the block has room for up to the number asked for.
+   * @param block block to allocate the slots in.
+   * @param num_slots the number of slots to allocate.
+   * @param[out] slots array of at least num_slots tuple slots to write the allocated slots to.
+   * @return the number of slots allocated, 0 if the block is full.
+   */
+  uint32_t Allocate(RawBlock *block, uint32_t num_slots, TupleSlot *slots) const;
+
   /**
    * @param block the block to access
    * @return pointer to the allocation bitmap of the block
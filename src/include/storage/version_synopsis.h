@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+
+#include "common/macros.h"
+#include "storage/block_layout.h"
+
+namespace noisepage::storage {
+
+/**
+ * A version synopsis summarizes which parts of a block have live version chains. The slots of a block are split into a
+ * fixed number of contiguous ranges, and for each range the synopsis tracks how many slots currently have a non-null
+ * version pointer. Readers can copy a range whose count is zero straight out of the block without looking at version
+ * chains, because every transaction alive sees the same image of those tuples.
+ *
+ * The count is packed together with a modification counter that only ever increases whenever a version chain is
+ * installed in the range. A reader takes a snapshot before copying a range and validates it afterwards. If the
+ * snapshot changed, a writer may have modified the tuples in place while they were being copied, and the reader has
+ * to fall back to the transactional path. The modification counter rules out the ABA problem where a version chain is
+ * installed and removed again while the copy is in progress.
+ *
+ * Writers must register a version chain before making it visible (i.e. before the version pointer is published), and
+ * may only deregister it after the version pointer is cleared.
+ */
+class VersionSynopsis {
+ public:
+  MEM_REINTERPRETATION_ONLY(VersionSynopsis)
+
+  /** Number of slot ranges tracked per block. */
+  static constexpr uint32_t NUM_RANGES = 64;
+
+  /** @return size of the synopsis in a block header */
+  static constexpr uint32_t Size() { return NUM_RANGES * static_cast<uint32_t>(sizeof(uint64_t)); }
+
+  /**
+   * @param layout layout of the block
+   * @return number of slots covered by each range of the synopsis
+   */
+  static uint32_t SlotsPerRange(const BlockLayout &layout) { return (layout.NumSlots() + NUM_RANGES - 1) / NUM_RANGES; }
+
+  /**
+   * Zeroes out the synopsis. A new block has no version chains.
+   */
+  void Initialize() { std::memset(static_cast<void *>(ranges_), 0, Size()); }
+
+  /**
+   * Records that the given slot is about to have a version chain installed.
+   * @param layout layout of the block
+   * @param offset offset of the slot within the block
+   */
+  void AddVersionChain(const BlockLayout &layout, const uint32_t offset) {
+    ranges_[offset / SlotsPerRange(layout)].fetch_add(MODIFICATION_INCREMENT + 1);
+  }
+
+  /**
+   * Records that the version chain of the given slot has been removed, or that an installation registered with
+   * AddVersionChain failed.
+   * @param layout layout of the block
+   * @param offset offset of the slot within the block
+   */
+  void RemoveVersionChain(const BlockLayout &layout, const uint32_t offset) {
+    NOISEPAGE_ASSERT((ranges_[offset / SlotsPerRange(layout)].load() & COUNT_MASK) > 0,
+                     "Removing a version chain that was never registered");
+    ranges_[offset / SlotsPerRange(layout)].fetch_sub(1);
+  }
+
+  /**
+   * @param range index of the range
+   * @return snapshot of the range, to be passed to IsUnversioned and compared against later snapshots
+   */
+  uint64_t Snapshot(const uint32_t range) const { return ranges_[range].load(); }
+
+  /**
+   * @param snapshot snapshot of a range
+   * @return whether no slot in the range had a version chain when the snapshot was taken
+   */
+  static bool IsUnversioned(const uint64_t snapshot) { return (snapshot & COUNT_MASK) == 0; }
+
+ private:
+  // | modification counter (32-bits) | number of slots with a version chain (32-bits) |
+  static constexpr uint64_t COUNT_MASK = 0xFFFFFFFF;
+  static constexpr uint64_t MODIFICATION_INCREMENT = uint64_t(1) << 32;
+
+  std::atomic<uint64_t> ranges_[NUM_RANGES];
+};
+
+}  // namespace noisepage::storage
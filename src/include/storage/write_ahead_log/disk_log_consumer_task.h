@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <chrono>              // NOLINT
 #include <condition_variable>  // NOLINT
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -9,6 +12,7 @@
 #include "common/dedicated_thread_task.h"
 #include "storage/storage_defs.h"
 #include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_stream_coordinator.h"
 
 namespace noisepage::storage {
 
@@ -25,18 +29,27 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param commit_latency_target p99 latency target for a commit waiting on the group commit window, zero disables
+   *                              group commit and persists on persist_interval instead
+   * @param coordinator coordinator of the log streams if there is more than one, nullptr otherwise
+   * @param stream log stream this task persists
    */
   explicit DiskLogConsumerTask(const std::chrono::microseconds persist_interval, uint64_t persist_threshold,
                                std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               const std::chrono::microseconds commit_latency_target = std::chrono::microseconds(0),
+                               LogStreamCoordinator *coordinator = nullptr, uint32_t stream = 0)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
         current_data_written_(0),
+        commit_latency_target_(commit_latency_target),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        coordinator_(coordinator),
+        stream_(stream) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -50,6 +63,15 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
 
  private:
   friend class LogManager;
+  FRIEND_TEST(WriteAheadLoggingTests, GroupCommitArrivalRateTest);
+  FRIEND_TEST(WriteAheadLoggingTests, GroupCommitFsyncLatencyTest);
+  FRIEND_TEST(WriteAheadLoggingTests, GroupCommitPersistDecisionTest);
+  using Clock = std::chrono::high_resolution_clock;
+  // Number of recent fsync latencies kept around to estimate the p99 fsync latency
+  static constexpr uint32_t NUM_FSYNC_LATENCY_SAMPLES = 100;
+  // Weight of a new sample in the moving average of the time between commit arrivals
+  static constexpr double ARRIVAL_SMOOTHING = 0.125;
+
   // Flag to signal task to run or stop
   bool run_task_;
   // Stores callbacks for commit records written to disk but not yet persisted
@@ -62,6 +84,21 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   // Amount of data written since last persist
   uint64_t current_data_written_;
 
+  // p99 latency target for commits in group commit mode, zero if group commit is disabled
+  const std::chrono::microseconds commit_latency_target_;
+  // Time at which the oldest commit callback that is not persisted yet was handed to this task
+  Clock::time_point oldest_pending_commit_;
+  // Time at which the most recent commit callbacks were handed to this task
+  Clock::time_point last_commit_arrival_;
+  // Moving average of the time between two commit arrivals (us). Negative until we have seen two arrivals
+  double commit_interarrival_us_ = -1.0;
+  // Latencies of the most recent fsyncs (us), treated as a ring buffer
+  std::array<uint64_t, NUM_FSYNC_LATENCY_SAMPLES> fsync_latencies_us_{};
+  // Next slot to overwrite in fsync_latencies_us_
+  uint32_t next_fsync_latency_ = 0;
+  // Latency of the last fsync (us), used for metrics
+  uint64_t last_fsync_latency_us_ = 0;
+
   // This stores a reference to all the buffers the log manager has created. Used for persisting
   std::vector<BufferedLogWriter> *buffers_;
   // The queue containing empty buffers. Task will enqueue a buffer into this queue when it has flushed its logs
@@ -69,8 +106,20 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
 
+  // Coordinator of the log streams, nullptr if the log manager only has one
+  LogStreamCoordinator *const coordinator_;
+  // Log stream this task persists
+  const uint32_t stream_;
+  // Number of filled buffers dequeued from filled_buffer_queue_ so far
+  uint64_t num_buffers_written_ = 0;
+  // Streams our persisted commits are waiting on, to be woken up once persist_lock_ is released
+  std::vector<uint32_t> streams_to_wake_;
+
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
   volatile bool force_flush_;
+  // Set by the log manager along with force_flush_ to have the log file moved to this path once it is persisted, and
+  // continue in a new log file. Empty if no rotation is pending
+  std::string rotate_log_file_path_;
 
   // Synchronisation primitives to synchronise persisting buffers to disk
   std::mutex persist_lock_;
@@ -92,9 +141,61 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
 
   /*
    * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-   * were persisted
+   * were persisted. With more than one log stream, the callbacks are handed to the coordinator instead, which invokes
+   * them once the other streams caught up.
    * @return number of buffers persisted, used for metrics
    */
   uint64_t PersistLogFile();
+
+  /**
+   * Moves the persisted log file to rotate_log_file_path_ and reopens all buffers on a new, empty log file. Must be
+   * called with persist_lock_ held, right after PersistLogFile
+   */
+  void RotateLogFile();
+
+  /**
+   * @return whether commits of another log stream are waiting for this stream to persist
+   */
+  bool PersistRequested() const { return coordinator_ != nullptr && coordinator_->PersistRequested(stream_); }
+
+  /**
+   * @return whether the task persists in groups sized by the commit latency target
+   */
+  bool GroupCommitEnabled() const { return commit_latency_target_.count() > 0; }
+
+  /**
+   * Updates the commit arrival rate with newly handed over commit callbacks, and opens the group commit window if they
+   * are the first pending ones
+   * @param num_commits number of commit callbacks that just arrived, already appended to commit_callbacks_
+   * @param now time of arrival
+   */
+  void RecordCommitArrivals(uint64_t num_commits, Clock::time_point now);
+
+  /**
+   * Adds an fsync latency to the recent samples, overwriting the oldest one
+   * @param latency_us latency of the fsync (us)
+   */
+  void RecordFsyncLatency(uint64_t latency_us);
+
+  /**
+   * @return the p99 fsync latency over the recent samples, zero until we have seen an fsync
+   */
+  std::chrono::microseconds P99FsyncLatency() const;
+
+  /**
+   * @return how long the oldest pending commit can still wait for other commits to join its group without missing the
+   * latency target, given the p99 fsync latency we observed recently
+   * @param now current time
+   */
+  std::chrono::microseconds GroupCommitWindowRemaining(Clock::time_point now) const;
+
+  /**
+   * Decides whether the pending group of commits should be persisted now. This is the case once the group commit window
+   * closes, or as soon as the next commit is not expected to arrive before it closes. The latter is what lets a lone
+   * committer go ahead without waiting out the window.
+   * @param now current time
+   * @return true if the log file should be persisted
+   */
+  bool ShouldPersistGroup(Clock::time_point now) const;
 };
 }  // namespace noisepage::storage
@@ -74,6 +74,13 @@ struct PosixIoWrappers {
    * @throws runtime_error if the underlying posix call failed
    */
   static void WriteFully(int fd, const void *buf, size_t nbyte);
+
+  /**
+   * Calls fsync on the directory a file is in, so that the file being created, renamed or removed there is persisted
+   * @param file_path path of the file
+   * @throws runtime_error if the underlying posix call failed
+   */
+  static void SyncParentDirectory(const std::string &file_path);
 };
 // TODO(Tianyu):  we need control over when and what to flush as the log manager. Thus, we need to write our
 // own wrapper around lower level I/O functions. I could be wrong, and in that case we should
@@ -91,13 +98,28 @@ class BufferedLogWriter {
    * file already exists; otherwise, a file is created.
    */
   explicit BufferedLogWriter(const char *log_file_path)
-      : out_(PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR)) {}
+      : log_file_path_(log_file_path),
+        out_(PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR)) {}
 
   /**
    * Must call before object is destructed
    */
   void Close() { PosixIoWrappers::Close(out_); }
 
+  /**
+   * Closes the log file and opens the file at the log file path again, creating it if it was moved away in the
+   * meantime. Buffered writes are kept and end up in the reopened file.
+   */
+  void Reopen() {
+    PosixIoWrappers::Close(out_);
+    out_ = PosixIoWrappers::Open(log_file_path_.c_str(), O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+  }
+
+  /**
+   * @return path of the log file written to
+   */
+  const std::string &LogFilePath() const { return log_file_path_; }
+
   /**
    * Write to the log file the given amount of bytes from the given location in memory, but buffer the write so the
    * update is only written out when the BufferedLogWriter is persisted. Note that this function writes to the buffer
@@ -150,6 +172,7 @@ class BufferedLogWriter {
   bool IsBufferFull() { return buffer_size_ == common::Constants::LOG_BUFFER_SIZE; }
 
  private:
+  std::string log_file_path_;
   int out_;  // fd of the output files
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
 
@@ -170,7 +193,17 @@ class BufferedLogReader {
    * Instantiates a new BufferedLogReader to read from the specified log file.
    * @param log_file_path path to the the log file to read from.
    */
-  explicit BufferedLogReader(const char *log_file_path) : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)) {}
+  explicit BufferedLogReader(const char *log_file_path)
+      : BufferedLogReader(std::vector<std::string>{std::string(log_file_path)}) {}
+
+  /**
+   * Instantiates a new BufferedLogReader to read from several log files, in the given order, as if they were one. A
+   * log record may start in one file and end in the next.
+   * @param log_file_paths paths to the log files to read from, at least one
+   */
+  explicit BufferedLogReader(std::vector<std::string> log_file_paths)
+      : log_file_paths_(std::move(log_file_paths)),
+        in_(PosixIoWrappers::Open(log_file_paths_.front().c_str(), O_RDONLY)) {}
 
   /**
    * Closes log file if it has not been closed already. While Read will close the file if it reaches the end, this will
@@ -211,6 +244,9 @@ class BufferedLogReader {
   }
 
  private:
+  std::vector<std::string> log_file_paths_;
+  // Index of the next file to open once in_ is read to the end
+  uint32_t next_file_ = 1;
   int in_;  // or -1 if closed
   uint32_t read_head_ = 0, filled_size_ = 0;
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
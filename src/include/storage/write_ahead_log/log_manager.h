@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <queue>
 #include <string>
 #include <unordered_map>
@@ -16,6 +17,7 @@
 #include "storage/record_buffer.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/log_stream_coordinator.h"
 
 namespace noisepage::storage {
 
@@ -36,8 +38,21 @@ class DiskLogConsumerTask;
  *          a) Someone calls ForceFlush on the LogManager, or
  *          b) Periodically
  *          c) A sufficient amount of data has been written since the last persist
+ *          d) In group commit mode, the pending group of commits would otherwise miss the commit latency target, or no
+ *             other commit is expected to join the group in time
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
  * were just persisted.
+ *
+ * The log can be split into several log streams, each with its own LogSerializerTask, DiskLogConsumerTask and log file,
+ * so that serialization and persisting scale past a single thread. All records of a transaction go to the same stream,
+ * picked by its start timestamp. Because a transaction may depend on transactions logged to another stream, commit
+ * callbacks are then only invoked once the LogStreamCoordinator found all streams to have caught up. The log files of
+ * all streams are replayed together by merging them on the commit timestamps of their commit records (see
+ * MergedLogProvider).
+ *
+ * The log files can be rotated (see RotateLogFiles), which moves everything logged so far into numbered log segments
+ * that can be removed once a checkpoint covers them. Recovery reads the segments of a log stream in order, followed by
+ * its current log file (see LogFilePaths).
  */
 class LogManager : public common::DedicatedThreadOwner {
  public:
@@ -53,11 +68,15 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param buffer_pool the object pool to draw log buffers from. This must be the same pool transactions draw their
    *                    buffers from
    * @param thread_registry DedicatedThreadRegistry dependency injection
+   * @param commit_latency_target p99 commit latency target of group commit, zero to persist on persist_interval instead
+   * @param num_streams number of log streams to split the log into. Stream 0 writes to log_file_path, every other
+   *                    stream to the path given by StreamLogFilePath
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::microseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
-             common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry)
+             common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry,
+             std::chrono::microseconds commit_latency_target = std::chrono::microseconds(0), uint32_t num_streams = 1)
       : DedicatedThreadOwner(thread_registry),
         run_log_manager_(false),
         log_file_path_(std::move(log_file_path)),
@@ -65,9 +84,45 @@ class LogManager : public common::DedicatedThreadOwner {
         buffer_pool_(buffer_pool.Get()),
         serialization_interval_(serialization_interval),
         persist_interval_(persist_interval),
-        persist_threshold_(persist_threshold) {}
+        persist_threshold_(persist_threshold),
+        commit_latency_target_(commit_latency_target),
+        num_streams_(num_streams) {
+    NOISEPAGE_ASSERT(num_streams_ > 0, "The log manager needs at least one log stream");
+  }
+
   /**
-   * Starts log manager. Does the following in order:
+   * @param log_file_path log file path the log manager was constructed with
+   * @param stream log stream
+   * @return path of the log file of the given log stream
+   */
+  static std::string StreamLogFilePath(const std::string &log_file_path, const uint32_t stream) {
+    return stream == 0 ? log_file_path : log_file_path + "." + std::to_string(stream);
+  }
+
+  /**
+   * @param stream_log_file_path path of the log file of a log stream
+   * @param segment number of the log segment
+   * @return path the log file of the stream is moved to when it is rotated into the given log segment
+   */
+  static std::string LogSegmentFilePath(const std::string &stream_log_file_path, const uint64_t segment) {
+    return stream_log_file_path + ".segment." + std::to_string(segment);
+  }
+
+  /**
+   * @param log_file_path log file path the log manager was constructed with
+   * @param stream log stream
+   * @return paths of all the files the log of the given stream is stored in, in the order they were written: its log
+   * segments, followed by its current log file
+   */
+  static std::vector<std::string> LogFilePaths(const std::string &log_file_path, uint32_t stream);
+
+  /**
+   * @return number of log streams the log is split into
+   */
+  uint32_t NumStreams() const { return num_streams_; }
+
+  /**
+   * Starts log manager. Does the following in order for every log stream:
    *    1. Initialize buffers to pass serialized logs to log consumers
    *    2. Starts up DiskLogConsumerTask
    *    3. Starts up LogSerializerTask
@@ -82,10 +137,25 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   void ForceFlush();
 
+  /**
+   * Persists the logs and moves the log file of every log stream into a new log segment, so that all following logs go
+   * to new log files. Every record in the log segment was serialized before this method returns.
+   * @return number of the new log segment
+   * @warning This method should only be called by the checkpoint manager or during testing
+   */
+  uint64_t RotateLogFiles();
+
+  /**
+   * Deletes the log segments of all log streams up to and including the given one. Only call this for segments whose
+   * contents are covered by a checkpoint.
+   * @param last_segment number of the last log segment to delete
+   */
+  void RemoveLogSegments(uint64_t last_segment);
+
   /**
    * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order:
-   *    1. Stops LogSerializerTask
-   *    2. Stops DiskLogConsumerTask
+   *    1. Stops the LogSerializerTasks
+   *    2. Stops the DiskLogConsumerTasks
    *    3. Closes all open buffers
    * @note Start() can be called to run the log manager again, a new log manager does not need to be initialized.
    */
@@ -102,7 +172,7 @@ class LogManager : public common::DedicatedThreadOwner {
 
   /**
    * For testing only
-   * @return number of buffers used for logging
+   * @return number of buffers used for logging by each log stream
    */
   uint64_t TestGetNumBuffers() { return num_buffers_; }
 
@@ -110,15 +180,18 @@ class LogManager : public common::DedicatedThreadOwner {
    * Set the number of buffers used for buffering logs. The operation fails if the LogManager has already allocated more
    * buffers than the new size
    *
-   * @param new_num_buffers the new number of buffers the log manager can use
+   * @param new_num_buffers the new number of buffers each log stream can use
    * @return true if new_num_buffers is successfully set and false the operation fails
    */
   bool SetNumBuffers(uint64_t new_num_buffers) {
     if (new_num_buffers >= num_buffers_) {
       // Add in new buffers
-      for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-        buffers_.emplace_back(BufferedLogWriter(log_file_path_.c_str()));
-        empty_buffer_queue_.Enqueue(&buffers_[num_buffers_ + i]);
+      for (uint32_t stream = 0; stream < streams_.size(); stream++) {
+        auto *const log_stream = streams_[stream].get();
+        for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
+          log_stream->buffers_.emplace_back(BufferedLogWriter(StreamLogFilePath(log_file_path_, stream).c_str()));
+          log_stream->empty_buffer_queue_.Enqueue(&log_stream->buffers_[num_buffers_ + i]);
+        }
       }
       num_buffers_ = new_num_buffers;
       return true;
@@ -140,26 +213,54 @@ class LogManager : public common::DedicatedThreadOwner {
   //  (e.g. logs can be streamed out to the network for remote replication)
   RecordBufferSegmentPool *buffer_pool_;
 
-  // This stores a reference to all the buffers the serializer or the log consumer threads use
-  std::vector<BufferedLogWriter> buffers_;
-  // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
-  // serializer thread should block when requesting a new buffer until it receives an empty buffer
-  common::ConcurrentBlockingQueue<BufferedLogWriter *> empty_buffer_queue_;
-  // The queue containing filled buffers pending flush to the disk
-  common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+  /**
+   * A log stream serializes and persists its share of the transactions to its own log file
+   */
+  struct LogStream {
+    // This stores a reference to all the buffers the serializer or the log consumer threads use
+    std::vector<BufferedLogWriter> buffers_;
+    // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
+    // serializer thread should block when requesting a new buffer until it receives an empty buffer
+    common::ConcurrentBlockingQueue<BufferedLogWriter *> empty_buffer_queue_;
+    // The queue containing filled buffers pending flush to the disk
+    common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+
+    // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
+    common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
+    // The log consumer task which flushes filled buffers to the disk
+    common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
+        common::ManagedPointer<DiskLogConsumerTask>(nullptr);
+  };
 
-  // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
-  common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
   // Interval used by log serialization task
   const std::chrono::microseconds serialization_interval_;
-
-  // The log consumer task which flushes filled buffers to the disk
-  common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
-      common::ManagedPointer<DiskLogConsumerTask>(nullptr);
   // Interval used by disk consumer task
   const std::chrono::microseconds persist_interval_;
   // Threshold used by disk consumer task
   uint64_t persist_threshold_;
+  // Group commit latency target used by disk consumer task
+  const std::chrono::microseconds commit_latency_target_;
+
+  // Number of log streams the log is split into
+  const uint32_t num_streams_;
+  // The log streams, only populated while the log manager is running
+  std::vector<std::unique_ptr<LogStream>> streams_;
+  // Decides when commits are durable across log streams, nullptr if there is only one
+  std::unique_ptr<LogStreamCoordinator> coordinator_;
+  // Serializes rotations of the log files
+  std::mutex rotation_latch_;
+
+  /**
+   * @param stream_log_file_path path of the log file of a log stream
+   * @return numbers and paths of the log segments of the stream, in ascending order
+   */
+  static std::vector<std::pair<uint64_t, std::string>> ListLogSegments(const std::string &stream_log_file_path);
+
+  /**
+   * @param buffer_segment buffer of log records of a single transaction
+   * @return log stream that serializes the transaction
+   */
+  LogStream *StreamForBuffer(RecordBufferSegment *buffer_segment);
 
   /**
    * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
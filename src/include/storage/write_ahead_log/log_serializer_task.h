@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>  // NOLINT
+#include <cstring>
 #include <queue>
 #include <thread>  // NOLINT
 #include <tuple>
@@ -11,9 +12,12 @@
 #include "common/container/concurrent_blocking_queue.h"
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
+#include "storage/data_table.h"
 #include "storage/record_buffer.h"
+#include "storage/storage_util.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/log_stream_coordinator.h"
 
 namespace noisepage::storage {
 
@@ -29,19 +33,24 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    * @param empty_buffer_queue pointer to queue to pop empty buffers from
    * @param filled_buffer_queue pointer to queue to push filled buffers to
    * @param disk_log_writer_thread_cv pointer to condition variable to notify consumer when a new buffer has handed over
+   * @param coordinator coordinator of the log streams if there is more than one, nullptr otherwise
+   * @param stream log stream this task serializes
    */
   explicit LogSerializerTask(const std::chrono::microseconds serialization_interval,
                              RecordBufferSegmentPool *buffer_pool,
                              common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
                              common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
-                             std::condition_variable *disk_log_writer_thread_cv)
+                             std::condition_variable *disk_log_writer_thread_cv,
+                             LogStreamCoordinator *coordinator = nullptr, uint32_t stream = 0)
       : run_task_(false),
         serialization_interval_(serialization_interval),
         buffer_pool_(buffer_pool),
         filled_buffer_(nullptr),
         empty_buffer_queue_(empty_buffer_queue),
         filled_buffer_queue_(filled_buffer_queue),
-        disk_log_writer_thread_cv_(disk_log_writer_thread_cv) {}
+        disk_log_writer_thread_cv_(disk_log_writer_thread_cv),
+        coordinator_(coordinator),
+        stream_(stream) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -122,6 +131,11 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   // Condition variable to signal disk log consumer task thread that a new full buffer has been pushed to the queue
   std::condition_variable *disk_log_writer_thread_cv_;
 
+  // Coordinator of the log streams, nullptr if the log manager only has one
+  LogStreamCoordinator *const coordinator_;
+  // Log stream this task serializes
+  const uint32_t stream_;
+
   /**
    * Main serialization loop. Calls Process every interval. Processes all the accumulated log records and
    * serializes them to log consumer tasks.
@@ -150,6 +164,20 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    */
   uint64_t SerializeRecord(const LogRecord &record);
 
+ public:
+  /**
+   * Serialize out the record in the log format, independently of the serialization buffers. This lets log records that
+   * never go through the log manager (e.g. those of a checkpoint) be written in a format recovery can read back.
+   * @tparam WriteFn callable taking a (const void *, uint32_t) pair of value and size, returning bytes written
+   * @param record the record to serialize
+   * @param write function to write the serialized bytes out with
+   * @return bytes serialized
+   */
+  template <class WriteFn>
+  static uint64_t SerializeRecord(const LogRecord &record, const WriteFn &write);
+
+ private:
+
   /**
    * Serialize the data pointed to by val to current serialization buffer
    * @tparam T Type of the value
@@ -180,4 +208,99 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    */
   void HandFilledBufferToWriter();
 };
+
+template <class WriteFn>
+uint64_t LogSerializerTask::SerializeRecord(const LogRecord &record, const WriteFn &write) {
+  const auto write_value = [&write](const auto &val) { return write(&val, static_cast<uint32_t>(sizeof(val))); };
+  uint64_t num_bytes = 0;
+  // First, serialize out fields common across all LogRecordType's.
+
+  // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the size
+  // of any potential varlen entries. It is logically different from the size of the serialized record, which the log
+  // manager generates in this function. In particular, the later value is very likely to be strictly smaller when the
+  // LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log record of
+  // this size.
+  num_bytes += write_value(record.Size());
+
+  num_bytes += write_value(record.RecordType());
+  num_bytes += write_value(record.TxnBegin());
+
+  switch (record.RecordType()) {
+    case LogRecordType::REDO: {
+      auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
+      num_bytes += write_value(record_body->GetDatabaseOid());
+      num_bytes += write_value(record_body->GetTableOid());
+      num_bytes += write_value(record_body->GetTupleSlot());
+
+      auto *delta = record_body->Delta();
+      // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
+      // ProjectedRowInitializer from these ids and their corresponding block layout.
+      num_bytes += write_value(delta->NumColumns());
+      num_bytes += write(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
+
+      // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
+      // layout
+      const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
+      uint16_t boundaries[NUM_ATTR_BOUNDARIES];
+      memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+      StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
+      write(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+
+      // Write out the null bitmap.
+      num_bytes += write(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
+
+      // Write out attribute values
+      for (uint16_t i = 0; i < delta->NumColumns(); i++) {
+        const auto *column_value_address = delta->AccessWithNullCheck(i);
+        if (column_value_address == nullptr) {
+          // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap contains all
+          // the relevant information.
+          continue;
+        }
+        // Get the column id of the current column in the ProjectedRow.
+        col_id_t col_id = delta->ColumnIds()[i];
+
+        if (block_layout.IsVarlen(col_id)) {
+          // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
+          const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
+          // Serialize out length of the varlen entry.
+          num_bytes += write_value(varlen_entry->Size());
+          if (varlen_entry->IsInlined()) {
+            // Serialize out the prefix of the varlen entry.
+            num_bytes += write(varlen_entry->Prefix(), varlen_entry->Size());
+          } else {
+            // Serialize out the content field of the varlen entry.
+            num_bytes += write(varlen_entry->Content(), varlen_entry->Size());
+          }
+        } else {
+          // Inline column value is the actual data we want to serialize out.
+          // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive offsets
+          // of the delta record, we avoid serializing out any potential padding.
+          num_bytes += write(column_value_address, block_layout.AttrSize(col_id));
+        }
+      }
+      break;
+    }
+    case LogRecordType::DELETE: {
+      auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
+      num_bytes += write_value(record_body->GetDatabaseOid());
+      num_bytes += write_value(record_body->GetTableOid());
+      num_bytes += write_value(record_body->GetTupleSlot());
+      break;
+    }
+    case LogRecordType::COMMIT: {
+      auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
+      num_bytes += write_value(record_body->CommitTime());
+      num_bytes += write_value(record_body->OldestActiveTxn());
+      break;
+    }
+    case LogRecordType::ABORT: {
+      // AbortRecord does not hold any additional metadata
+      break;
+    }
+  }
+
+  return num_bytes;
+}
+
 }  // namespace noisepage::storage
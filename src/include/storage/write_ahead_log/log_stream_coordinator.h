@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/write_ahead_log/log_io.h"
+
+namespace noisepage::storage {
+
+/**
+ * A LogStreamCoordinator decides when commits are durable if the log manager writes to more than one log stream.
+ *
+ * Every transaction is logged entirely to one stream, but it may depend on transactions that were logged to other
+ * streams. Recovery replays a transaction once the transactions older than the oldest active transaction at its commit
+ * have been replayed, so it needs the logs of all of them. Those transactions were serialized before the commit, so we
+ * only invoke the commit callbacks of a persisted batch once every stream has persisted all buffers that its serializer
+ * had handed over by the time the batch was persisted.
+ *
+ * Serializers count the buffers they hand over, and consumers report how many of them they have persisted together
+ * with the callbacks of the commits they just persisted. Whichever consumer persists the last buffer a batch depends on
+ * invokes the callbacks of the batch. A stream that a batch is waiting on is asked to persist, which lets an idle
+ * stream catch up without waiting for its own persist interval. Consumers persist with their own latch held, so the
+ * streams asked to persist are only woken up by WakeConsumers once the consumer released it.
+ */
+class LogStreamCoordinator {
+ public:
+  /**
+   * @param num_streams number of log streams to coordinate
+   */
+  explicit LogStreamCoordinator(uint32_t num_streams)
+      : handed_over_(num_streams),
+        persist_requested_(num_streams),
+        persisted_(num_streams, 0),
+        wakeups_(num_streams, {nullptr, nullptr}) {
+    for (uint32_t stream = 0; stream < num_streams; stream++) {
+      handed_over_[stream].store(0);
+      persist_requested_[stream].store(false);
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(LogStreamCoordinator)
+
+  /**
+   * @return number of log streams coordinated
+   */
+  uint32_t NumStreams() const { return static_cast<uint32_t>(handed_over_.size()); }
+
+  /**
+   * Called by the serializer of a stream after it handed over a buffer to its consumer
+   * @param stream stream of the serializer
+   */
+  void BufferHandedOver(const uint32_t stream) { handed_over_[stream].fetch_add(1); }
+
+  /**
+   * @return number of buffers handed over by each stream so far. Must be taken before the buffers of a batch are
+   * persisted, and passed along with the batch to CommitsPersisted
+   */
+  std::vector<uint64_t> HandedOverSnapshot() const;
+
+  /**
+   * Called by the consumer of a stream after it persisted a batch
+   * @param stream stream of the consumer
+   * @param num_persisted number of buffers the consumer has persisted so far
+   * @param handed_over HandedOverSnapshot taken before the batch was persisted
+   * @param callbacks commit callbacks of the batch, invoked as soon as every stream caught up with handed_over
+   * @param[out] to_wake streams that were asked to persist and need to be woken up by WakeConsumers
+   */
+  void CommitsPersisted(uint32_t stream, uint64_t num_persisted, std::vector<uint64_t> &&handed_over,
+                        std::vector<CommitCallback> &&callbacks, std::vector<uint32_t> *to_wake);
+
+  /**
+   * Registers the latch and condition variable the consumer of a stream waits with, so the stream can be woken up when
+   * a batch of another stream waits on it
+   * @param stream stream of the consumer
+   * @param latch latch the consumer holds while checking whether to wait, or nullptr once the consumer stops
+   * @param wakeup condition variable to notify, or nullptr once the consumer stops
+   */
+  void RegisterConsumer(uint32_t stream, std::mutex *latch, std::condition_variable *wakeup);
+
+  /**
+   * Wakes up the consumers of the given streams. Must not be called with the latch of any consumer held
+   * @param to_wake streams to wake up, cleared afterwards
+   */
+  void WakeConsumers(std::vector<uint32_t> *to_wake);
+
+  /**
+   * Clears and returns whether batches of other streams are waiting on this stream to persist
+   * @param stream stream of the consumer
+   * @return true if the consumer should persist
+   */
+  bool TakePersistRequest(const uint32_t stream) { return persist_requested_[stream].exchange(false); }
+
+  /**
+   * @param stream stream of the consumer
+   * @return true if batches of other streams are waiting on this stream to persist
+   */
+  bool PersistRequested(const uint32_t stream) const { return persist_requested_[stream].load(); }
+
+ private:
+  // Commit callbacks of a persisted batch, waiting for the other streams to catch up
+  struct PendingBatch {
+    std::vector<uint64_t> handed_over_;
+    std::vector<CommitCallback> callbacks_;
+  };
+
+  // Number of buffers handed over to the consumer of each stream
+  std::vector<std::atomic<uint64_t>> handed_over_;
+  // Whether batches of other streams are waiting on each stream to persist
+  std::vector<std::atomic<bool>> persist_requested_;
+
+  // Protects everything below
+  std::mutex latch_;
+  // Number of buffers persisted by the consumer of each stream
+  std::vector<uint64_t> persisted_;
+  // Batches that have been persisted by their own stream, but are still waiting on others
+  std::list<PendingBatch> pending_;
+
+  // Protects wakeups_. Taken before the latch of a consumer, and never while holding latch_
+  std::mutex wakeups_latch_;
+  // Latches and condition variables the consumers of each stream wait with, nullptr if a consumer is not running
+  std::vector<std::pair<std::mutex *, std::condition_variable *>> wakeups_;
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::network {
+class Statement;
+}  // namespace noisepage::network
+
+namespace noisepage::parser {
+class ConstantValueExpression;
+class ParseResult;
+}  // namespace noisepage::parser
+
+namespace noisepage::trafficcop {
+
+/**
+ * PlanCache holds bound, optimized and compiled statements that are shared by all connections of the server. Unlike
+ * the per-connection StatementCache of the Extended Query protocol, it is keyed on the database and on the query text
+ * with its literals replaced by parameters (see ParameterizeQuery), so queries that only differ in their literals reuse
+ * one plan. Every entry records the catalog version of the database it was planned against and is only handed out to
+ * transactions that see the same version. The cache holds a bounded number of entries and evicts the least recently
+ * used one when it is full.
+ */
+class PlanCache {
+ public:
+  /**
+   * @param capacity maximum number of statements in the cache
+   */
+  explicit PlanCache(uint64_t capacity) : capacity_(capacity) {}
+
+  DISALLOW_COPY_AND_MOVE(PlanCache)
+
+  /**
+   * Replace the literals of a SELECT, INSERT, UPDATE or DELETE statement with parameters in place. Only literals that
+   * are compared against a non-literal, or that are values of an INSERT or an UPDATE, are replaced; any other literal
+   * is part of the returned key instead. The statement is left untouched if any literal of the query text cannot be
+   * accounted for.
+   * @param query_text text the statement was parsed from
+   * @param parse_result parsed statement to parameterize
+   * @param[out] params values of the replaced literals, in the order of their parameter indexes
+   * @param[out] key key of the parameterized statement in the cache
+   * @return true if the statement was parameterized, false if it cannot be cached
+   */
+  static bool ParameterizeQuery(const std::string &query_text, common::ManagedPointer<parser::ParseResult> parse_result,
+                                std::vector<parser::ConstantValueExpression> *params, std::string *key);
+
+  /**
+   * Look up a statement. An entry planned against an older catalog version than the given one is dropped.
+   * @param db_oid database the query runs in
+   * @param key key of the parameterized statement
+   * @param catalog_version catalog version of the database seen by the transaction
+   * @return the cached statement, or nullptr if there is none for the catalog version
+   */
+  std::shared_ptr<network::Statement> Lookup(catalog::db_oid_t db_oid, const std::string &key,
+                                             transaction::timestamp_t catalog_version);
+
+  /**
+   * Add a statement that was planned and compiled against the given catalog version, evicting the least recently used
+   * statements if the cache is full.
+   * @param db_oid database the query runs in
+   * @param key key of the parameterized statement
+   * @param catalog_version catalog version of the database the statement was planned against
+   * @param statement statement to share
+   */
+  void Insert(catalog::db_oid_t db_oid, const std::string &key, transaction::timestamp_t catalog_version,
+              std::shared_ptr<network::Statement> statement);
+
+  /**
+   * @return maximum number of statements in the cache
+   */
+  uint64_t GetCapacity() const { return capacity_; }
+
+  /**
+   * @return number of statements in the cache
+   */
+  uint64_t Size() const {
+    std::lock_guard<std::mutex> guard(latch_);
+    return lru_.size();
+  }
+
+  /** @return number of lookups that found a statement */
+  uint64_t GetHits() const { return hits_.load(std::memory_order_relaxed); }
+
+  /** @return number of lookups that did not find a statement */
+  uint64_t GetMisses() const { return misses_.load(std::memory_order_relaxed); }
+
+  /** @return number of statements evicted because the cache was full */
+  uint64_t GetEvictions() const { return evictions_.load(std::memory_order_relaxed); }
+
+  /** @return number of statements dropped because the catalog changed */
+  uint64_t GetInvalidations() const { return invalidations_.load(std::memory_order_relaxed); }
+
+ private:
+  struct CacheKey {
+    catalog::db_oid_t db_oid_;
+    std::string query_key_;
+
+    bool operator==(const CacheKey &other) const { return db_oid_ == other.db_oid_ && query_key_ == other.query_key_; }
+  };
+
+  struct CacheKeyHasher {
+    std::size_t operator()(const CacheKey &key) const;
+  };
+
+  struct Entry {
+    CacheKey key_;
+    transaction::timestamp_t catalog_version_;
+    std::shared_ptr<network::Statement> statement_;
+  };
+
+  const uint64_t capacity_;
+
+  // Entries from the most to the least recently used, and the index over them.
+  mutable std::mutex latch_;
+  std::list<Entry> lru_;
+  std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHasher> entries_;
+
+  std::atomic<uint64_t> hits_ = 0;
+  std::atomic<uint64_t> misses_ = 0;
+  std::atomic<uint64_t> evictions_ = 0;
+  std::atomic<uint64_t> invalidations_ = 0;
+};
+
+}  // namespace noisepage::trafficcop
@@ -9,6 +9,7 @@
 #include "common/managed_pointer.h"
 #include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
+#include "traffic_cop/plan_cache.h"
 #include "traffic_cop/traffic_cop_defs.h"
 
 namespace noisepage::catalog {
@@ -73,6 +74,7 @@ class TrafficCop {
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
+   * @param plan_cache_size maximum number of plans shared across connections for Simple Query protocol, 0 disables it
    * @param execution_mode how to run executable queries after code generation
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
@@ -80,7 +82,7 @@ class TrafficCop {
              common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider,
              common::ManagedPointer<settings::SettingsManager> settings_manager,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache, const execution::vm::ExecutionMode execution_mode)
+             bool use_query_cache, uint64_t plan_cache_size, const execution::vm::ExecutionMode execution_mode)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_log_provider_(replication_log_provider),
@@ -88,6 +90,7 @@ class TrafficCop {
         stats_storage_(stats_storage),
         optimizer_timeout_(optimizer_timeout),
         use_query_cache_(use_query_cache),
+        plan_cache_(plan_cache_size),
         execution_mode_(execution_mode) {}
 
   virtual ~TrafficCop() = default;
@@ -245,6 +248,16 @@ class TrafficCop {
    */
   bool UseQueryCache() const { return use_query_cache_; }
 
+  /**
+   * @return true if plans are shared across connections for Simple Query protocol, false otherwise
+   */
+  bool UsePlanCache() const { return use_query_cache_ && plan_cache_.GetCapacity() > 0; }
+
+  /**
+   * @return the plan cache shared across connections
+   */
+  common::ManagedPointer<PlanCache> GetPlanCache() { return common::ManagedPointer(&plan_cache_); }
+
  private:
   common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   common::ManagedPointer<catalog::Catalog> catalog_;
@@ -254,6 +267,7 @@ class TrafficCop {
   common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
   uint64_t optimizer_timeout_;
   const bool use_query_cache_;
+  PlanCache plan_cache_;
   const execution::vm::ExecutionMode execution_mode_;
 };
 
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <unordered_set>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -17,11 +19,18 @@ namespace noisepage::transaction {
 class TransactionManager;
 /**
  * Generates timestamps, and keeps track of the lifetime of transactions (whether they have entered or left the system)
+ *
+ * Running transactions are tracked in latched shards, picked by start time, so that transactions beginning and
+ * finishing on different threads rarely contend on the same latch. A transaction that is beginning announces a lower
+ * bound of its start time in a begin slot before it checks out its start time, and only clears it once it is in its
+ * shard. OldestTransactionStartTime reads the begin slots before the shards, so it sees every transaction that started
+ * before it was called in at least one of them.
  */
 class TimestampManager {
  public:
   ~TimestampManager() {
-    NOISEPAGE_ASSERT(curr_running_txns_.empty(),
+    NOISEPAGE_ASSERT(std::all_of(shards_.cbegin(), shards_.cend(),
+                                 [](const Shard &shard) { return shard.running_txns_.empty(); }),
                      "Destroying the TimestampManager while txns are still running. That seems wrong.");
   }
 
@@ -40,8 +49,8 @@ class TimestampManager {
    * Because of concurrent operations, it is not guaranteed that upon return the txn is still alive. However,
    * it is guaranteed that the return timestamp is older than any transactions live.
    * @warning If logging is enabled, txns are not removed from the txn set until they are serialized. Thus, the active
-   * txn set can grow greatly in size, making this call expensive. Consider using CachedOldestTransactionStartTime for
-   * better peformance at the cost of a more stale timestamp.
+   * txn set can grow greatly in size, making this call expensive, as it visits every shard. Consider using
+   * CachedOldestTransactionStartTime for better peformance at the cost of a more stale timestamp.
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t OldestTransactionStartTime();
@@ -49,39 +58,54 @@ class TimestampManager {
   /**
    * Get the cached timestamp of the oldest active txn. The cached timestamp is only refreshed upon every invocation of
    * OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking a latch or
-   * iterating through the running txns set, making it much cheaper than OldestTransactionStartTime. This has the same
+   * iterating through the running txns, making it much cheaper than OldestTransactionStartTime. This has the same
    * correctness guarantee as OldestTransactionStartTime, but may cause performance degradations for processes that rely
    * on very fresh oldest txn timestamps
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t CachedOldestTransactionStartTime();
 
+  /**
+   * Recomputes the cached timestamp of the oldest active txn, if at least CACHE_REFRESH_INTERVAL timestamps have been
+   * checked out since it was last recomputed here. Only one of the threads calling this at the same time recomputes it,
+   * so this is cheap enough to be called on every commit.
+   */
+  void RefreshCachedOldestTransactionStartTime();
+
  private:
-  // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-  // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-  // along with removing a transaction from the table of active transactions. We need this for correctness
-  // in the deferred action framework when dropping tables.
+  // Each shard's latch guards its running txns, so that a transaction is visible to OldestTransactionStartTime from the
+  // moment it leaves its begin slot until it is removed from its shard. TransactionManager hands transactions to the GC
+  // through a concurrent queue, without holding any of these latches. That is still correct for the deferred action
+  // framework when dropping tables, since an action only runs once OldestTransactionStartTime has moved past every
+  // transaction that could still see the dropped table.
   friend class TransactionManager;
   friend class storage::LogSerializerTask;
-  timestamp_t BeginTransaction() {
-    timestamp_t start_time;
-    {
-      common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
-      // There is a three-way race that needs to be prevented.  Specifically, we
-      // cannot allow both a transaction to commit and the GC to poll for the
-      // oldest running transaction in between this transaction acquiring its
-      // begin timestamp and getting inserted into the current running
-      // transactions list.  Using the current running transactions latch
-      // prevents the GC from polling and stops the race.  This allows us to
-      // replace acquiring a shared instance of the commit latch with a
-      // read-only spin-latch and move the allocation out of a critical section.
-      start_time = time_++;
-
-      const auto ret UNUSED_ATTRIBUTE = curr_running_txns_.emplace(start_time);
-      NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
-    }  // Release latch on current running transactions
-    return start_time;
-  }
+
+  // Number of shards the running transactions are split into
+  static constexpr uint32_t NUM_SHARDS = 64;
+  // Number of transactions that can be in the middle of beginning at the same time without waiting for a begin slot
+  static constexpr uint32_t NUM_BEGIN_SLOTS = 256;
+  // Number of timestamps checked out between recomputations of the cached oldest start time in
+  // RefreshCachedOldestTransactionStartTime
+  static constexpr uint64_t CACHE_REFRESH_INTERVAL = 256;
+
+  // Running transactions whose start time maps to this shard. Padded to its own cache line, so that latching one shard
+  // does not invalidate the others
+  struct alignas(common::Constants::CACHELINE_SIZE) Shard {
+    common::SpinLatch latch_;
+    std::unordered_set<timestamp_t> running_txns_;
+  };
+
+  // Lower bound of the start time of a transaction that is beginning, INVALID_TXN_TIMESTAMP if the slot is free
+  struct alignas(common::Constants::CACHELINE_SIZE) BeginSlot {
+    std::atomic<timestamp_t> lower_bound_{INVALID_TXN_TIMESTAMP};
+  };
+
+  /**
+   * Checks out a start timestamp, and adds it to the running transactions
+   * @return start timestamp of the transaction
+   */
+  timestamp_t BeginTransaction();
 
   /**
    * Remove a timestamp from active txn set
@@ -90,22 +114,37 @@ class TimestampManager {
   void RemoveTransaction(timestamp_t timestamp);
 
   /**
-   * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
-   * timestamps.
+   * Bulk remove a set of timestamps from the active txn set. Only grabs the latch of each shard once for all the
+   * timestamps in it.
    * @param timestamps vector of timestamps to remove
    */
   void RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
+  /**
+   * Claims a free begin slot, and announces the current time in it
+   * @return the claimed slot, to be freed once the transaction is in its shard
+   */
+  BeginSlot &ClaimBeginSlot();
+
+  /**
+   * @param start_time start time of a transaction
+   * @return index of the shard the transaction is tracked in
+   */
+  static uint32_t ShardIndex(const timestamp_t start_time) {
+    return static_cast<uint32_t>(start_time.UnderlyingValue() % NUM_SHARDS);
+  }
+
   // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
   // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
   std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-  // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
-  // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change, it
+  // Time at which RefreshCachedOldestTransactionStartTime last recomputed the cached timestamp
+  std::atomic<timestamp_t> last_cache_refresh_time_{INITIAL_TXN_TIMESTAMP};
+  // TODO(Gus): The running txns initially only held items in the order of # of workers. With the logging change, they
   // can hold many more, since txns are only removed when serialized. We should consider if there is a possible better
   // data structure
-  std::unordered_set<timestamp_t> curr_running_txns_;
-  mutable common::SpinLatch curr_running_txns_latch_;
+  std::array<Shard, NUM_SHARDS> shards_;
+  std::array<BeginSlot, NUM_BEGIN_SLOTS> begin_slots_;
 };
 }  // namespace noisepage::transaction
@@ -11,6 +11,7 @@
 #include "storage/tuple_access_strategy.h"
 #include "storage/undo_record.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_defs.h"
 #include "transaction/transaction_util.h"
 
 namespace noisepage::storage {
@@ -74,6 +75,14 @@ class TransactionContext {
    */
   timestamp_t StartTime() const { return start_time_; }
 
+  /**
+   * @return timestamp that is older than the start time of every transaction alive while this transaction runs.
+   * Versions older than this are invisible to all of them, so they may be pruned from the version chains this
+   * transaction comes across. TransactionContexts generated outside of the TransactionManager (i.e. in tests) never
+   * prune anything.
+   */
+  timestamp_t PruneHorizon() const { return prune_horizon_; }
+
   /**
    * @return finish time of this transaction if it has been aborted or logged as a commit. Otherwise, current
    * MVCC semantics define it as StartTime + INT64_MIN. TransactionContexts generated outside of the TransactionManager
@@ -214,6 +223,8 @@ class TransactionContext {
   friend class storage::RecoveryTests;           // Needs access to redo buffer
   const timestamp_t start_time_;
   std::atomic<timestamp_t> finish_time_;
+  // Cached oldest start time of any running transaction at the time this one began, set by the TransactionManager
+  timestamp_t prune_horizon_ = INITIAL_TXN_TIMESTAMP;
   storage::UndoBuffer undo_buffer_;
   storage::RedoBuffer redo_buffer_;
   // TODO(Tianyu): Maybe not so much of a good idea to do this. Make explicit queue in GC?
@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <utility>
 
+#include "common/container/concurrent_queue.h"
 #include "common/gate.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
@@ -87,7 +88,8 @@ class TransactionManager {
   common::Gate txn_gate_;
 
   bool gc_enabled_ = false;
-  TransactionQueue completed_txns_;
+  // Finished transactions waiting to be handed to the GC, enqueued by every transaction without taking a shared latch
+  common::ConcurrentQueue<TransactionContext *> completed_txns_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
   timestamp_t UpdatingCommitCriticalSection(TransactionContext *txn);
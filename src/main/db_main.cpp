@@ -30,7 +30,10 @@ void DBMain::ForceShutdown() {
 
 DBMain::~DBMain() { ForceShutdown(); }
 
-DBMain::ExecutionLayer::ExecutionLayer() { execution::ExecutionUtil::InitTPL(); }
+DBMain::ExecutionLayer::ExecutionLayer(const std::string &jit_object_cache_directory,
+                                       const uint64_t jit_object_cache_size) {
+  execution::ExecutionUtil::InitTPL(jit_object_cache_directory, jit_object_cache_size);
+}
 
 DBMain::ExecutionLayer::~ExecutionLayer() { execution::ExecutionUtil::ShutdownTPL(); }
 
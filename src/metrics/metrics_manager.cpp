@@ -5,6 +5,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -15,6 +16,17 @@ bool FileExists(const std::string &path) {
   return (stat(path.c_str(), &buffer) == 0);
 }
 
+// Rows end in the resource counters, unless the raw data says otherwise for their file in RESOURCE_COLUMNS
+template <typename abstract_raw_data, typename = void>
+struct ResourceColumns {
+  static bool InFile(size_t file UNUSED_ATTRIBUTE) { return true; }
+};
+
+template <typename abstract_raw_data>
+struct ResourceColumns<abstract_raw_data, std::void_t<decltype(abstract_raw_data::RESOURCE_COLUMNS)>> {
+  static bool InFile(size_t file) { return abstract_raw_data::RESOURCE_COLUMNS[file]; }
+};
+
 template <typename abstract_raw_data>
 void OpenFiles(std::vector<std::ofstream> *outfiles) {
   const auto num_files = abstract_raw_data::FILES.size();
@@ -25,6 +37,10 @@ void OpenFiles(std::vector<std::ofstream> *outfiles) {
     outfiles->emplace_back(file_name, std::ios_base::out | std::ios_base::app);
     if (!file_existed) {
       // write the column titles on the first line since we're creating a new csv file
+      if (!ResourceColumns<abstract_raw_data>::InFile(file)) {
+        outfiles->back() << abstract_raw_data::FEATURE_COLUMNS[file] << std::endl;
+        continue;
+      }
       if (!abstract_raw_data::FEATURE_COLUMNS[file].empty())
         outfiles->back() << abstract_raw_data::FEATURE_COLUMNS[file] << ", ";
       outfiles->back() << common::ResourceTracker::Metrics::COLUMNS << std::endl;
@@ -3,13 +3,16 @@
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
+#include "catalog/catalog_accessor.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
 #include "network/network_util.h"
 #include "network/postgres/postgres_packet_util.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
 #include "network/postgres/statement.h"
+#include "traffic_cop/plan_cache.h"
 #include "traffic_cop/traffic_cop.h"
 
 namespace noisepage::network {
@@ -98,8 +101,18 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     return FinishSimpleQueryCommand(out, connection);
   }
 
-  const auto statement = std::make_unique<network::Statement>(
-      std::move(query_text), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
+  // Literals of DML are replaced with parameters so that connections share the plan of queries that only differ in them
+  auto &parsed = std::get<std::unique_ptr<parser::ParseResult>>(parse_result);
+  std::vector<parser::ConstantValueExpression> params;
+  std::vector<type::TypeId> param_types;
+  std::string plan_key;
+  const bool cacheable =
+      t_cop->UsePlanCache() &&
+      trafficcop::PlanCache::ParameterizeQuery(query_text, common::ManagedPointer(parsed), &params, &plan_key);
+  for (const auto &param : params) param_types.emplace_back(param.GetReturnValueType());
+
+  auto statement =
+      std::make_unique<network::Statement>(std::move(query_text), std::move(parsed), std::move(param_types));
 
   // TODO(Matt): Clients may send multiple statements in a single SimpleQuery packet/string. Handling that would
   // probably exist here, looping over all of the elements in the ParseResult. It's not clear to me how the binder would
@@ -174,15 +187,28 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
                      common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
     out->WriteCommandComplete(query_type, 0);
   } else {
-    // Try to bind the parsed statement
-    const auto bind_result = t_cop->BindQuery(connection, common::ManagedPointer(statement), nullptr);
+    // A plan is shared for as long as the catalog version it was planned against is the one this txn sees
+    const auto catalog_version =
+        cacheable ? connection->Accessor()->GetCatalogVersion() : transaction::INVALID_TXN_TIMESTAMP;
+    std::shared_ptr<network::Statement> cached_statement = nullptr;
+    auto bound_statement = common::ManagedPointer(statement);
+    if (catalog_version != transaction::INVALID_TXN_TIMESTAMP) {
+      cached_statement = t_cop->GetPlanCache()->Lookup(connection->GetDatabaseOid(), plan_key, catalog_version);
+      if (cached_statement != nullptr) bound_statement = common::ManagedPointer(cached_statement.get());
+    }
+
+    // Try to bind the parsed statement, which only converts the parameters if the statement is cached
+    const auto bind_result = t_cop->BindQuery(connection, bound_statement, common::ManagedPointer(&params));
     if (bind_result.type_ == trafficcop::ResultType::COMPLETE) {
-      // Binding succeeded, optimize to generate a physical plan and then execute
-      auto optimize_result = t_cop->OptimizeBoundQuery(connection, statement->ParseResult());
+      if (cached_statement == nullptr) {
+        // Binding succeeded, optimize to generate a physical plan and then execute
+        auto optimize_result = t_cop->OptimizeBoundQuery(connection, statement->ParseResult());
 
-      statement->SetOptimizeResult(std::move(optimize_result));
+        statement->SetOptimizeResult(std::move(optimize_result));
+      }
 
-      const auto portal = std::make_unique<Portal>(common::ManagedPointer(statement));
+      const auto portal = std::make_unique<Portal>(bound_statement, std::move(params),
+                                                   std::vector<FieldFormat>{FieldFormat::text});
 
       if (query_type == network::QueryType::QUERY_SELECT) {
         out->WriteRowDescription(portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns(),
@@ -191,6 +217,13 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
 
       ExecutePortal(connection, common::ManagedPointer(portal), out, t_cop,
                     postgres_interpreter->ExplicitTransactionBlock());
+
+      // Only share plans that compiled and ran without failing the txn
+      if (cached_statement == nullptr && catalog_version != transaction::INVALID_TXN_TIMESTAMP &&
+          statement->GetExecutableQuery() != nullptr && !connection->Transaction()->MustAbort()) {
+        statement->SetRetained();
+        t_cop->GetPlanCache()->Insert(connection->GetDatabaseOid(), plan_key, catalog_version, std::move(statement));
+      }
     } else if (bind_result.type_ == trafficcop::ResultType::NOTICE) {
       NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(bind_result.extra_),
                        "We're expecting a message here.");
@@ -281,6 +314,7 @@ Transition ParseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
   if (cached_statement == nullptr) {
     // Not in the cache, add to cache
     cached_statement = common::ManagedPointer(statement);
+    statement->SetRetained();
     postgres_interpreter->AddStatementToCache(std::move(statement));
   }
 
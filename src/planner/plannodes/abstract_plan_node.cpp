@@ -37,6 +37,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 
 namespace noisepage::planner {
 
@@ -269,6 +270,11 @@ JSONDeserializeNodeIntermediate DeserializePlanNode(const nlohmann::json &json)
       break;
     }
 
+    case PlanNodeType::WINDOW: {
+      plan_node = std::make_unique<WindowPlanNode>();
+      break;
+    }
+
     default:
       throw std::runtime_error("Unknown plan node type during deserialization");
   }
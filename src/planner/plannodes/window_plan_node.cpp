@@ -0,0 +1,155 @@
+#include "planner/plannodes/window_plan_node.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/hash_util.h"
+#include "common/json.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace noisepage::planner {
+
+std::unique_ptr<WindowPlanNode> WindowPlanNode::Builder::Build() {
+  return std::unique_ptr<WindowPlanNode>(new WindowPlanNode(std::move(children_), std::move(output_schema_),
+                                                            std::move(partition_keys_), std::move(sort_keys_),
+                                                            std::move(window_terms_), plan_node_id_));
+}
+
+WindowPlanNode::WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
+                               std::unique_ptr<OutputSchema> output_schema,
+                               std::vector<common::ManagedPointer<parser::AbstractExpression>> partition_keys,
+                               std::vector<SortKey> sort_keys, std::vector<WindowTerm> window_terms,
+                               plan_node_id_t plan_node_id)
+    : AbstractPlanNode(std::move(children), std::move(output_schema), plan_node_id),
+      partition_keys_(std::move(partition_keys)),
+      sort_keys_(std::move(sort_keys)),
+      window_terms_(std::move(window_terms)) {}
+
+common::hash_t WindowPlanNode::Hash() const {
+  common::hash_t hash = AbstractPlanNode::Hash();
+
+  // Partition Keys
+  for (const auto &partition_key : partition_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, partition_key->Hash());
+  }
+
+  // Sort Keys
+  for (const auto &sort_key : sort_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, sort_key.first->Hash());
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(sort_key.second));
+  }
+
+  // Window Terms
+  for (const auto &window_term : window_terms_) {
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(window_term.type_));
+    if (window_term.aggregate_ != nullptr) {
+      hash = common::HashUtil::CombineHashes(hash, window_term.aggregate_->Hash());
+    }
+  }
+
+  return hash;
+}
+
+bool WindowPlanNode::operator==(const AbstractPlanNode &rhs) const {
+  if (!AbstractPlanNode::operator==(rhs)) return false;
+
+  auto &other = static_cast<const WindowPlanNode &>(rhs);
+
+  // Partition Keys
+  if (partition_keys_.size() != other.partition_keys_.size()) return false;
+  for (auto i = 0U; i < partition_keys_.size(); i++) {
+    if (*partition_keys_[i] != *other.partition_keys_[i]) return false;
+  }
+
+  // Sort Keys
+  if (sort_keys_.size() != other.sort_keys_.size()) return false;
+  for (auto i = 0U; i < sort_keys_.size(); i++) {
+    if (sort_keys_[i].second != other.sort_keys_[i].second) return false;
+    if (*sort_keys_[i].first != *other.sort_keys_[i].first) return false;
+  }
+
+  // Window Terms
+  if (window_terms_.size() != other.window_terms_.size()) return false;
+  for (auto i = 0U; i < window_terms_.size(); i++) {
+    auto &term = window_terms_[i];
+    auto &other_term = other.window_terms_[i];
+    if (term.type_ != other_term.type_) return false;
+    if ((term.aggregate_ == nullptr) != (other_term.aggregate_ == nullptr)) return false;
+    if (term.aggregate_ != nullptr && *term.aggregate_ != *other_term.aggregate_) return false;
+  }
+
+  return true;
+}
+
+nlohmann::json WindowPlanNode::ToJson() const {
+  nlohmann::json j = AbstractPlanNode::ToJson();
+
+  std::vector<nlohmann::json> partition_keys;
+  partition_keys.reserve(partition_keys_.size());
+  for (const auto &key : partition_keys_) {
+    partition_keys.emplace_back(key->ToJson());
+  }
+  j["partition_keys"] = partition_keys;
+
+  std::vector<std::pair<nlohmann::json, optimizer::OrderByOrderingType>> sort_keys;
+  sort_keys.reserve(sort_keys_.size());
+  for (const auto &key : sort_keys_) {
+    sort_keys.emplace_back(key.first->ToJson(), key.second);
+  }
+  j["sort_keys"] = sort_keys;
+
+  std::vector<std::pair<WindowFunctionType, nlohmann::json>> window_terms;
+  window_terms.reserve(window_terms_.size());
+  for (const auto &term : window_terms_) {
+    window_terms.emplace_back(term.type_, term.aggregate_ == nullptr ? nlohmann::json() : term.aggregate_->ToJson());
+  }
+  j["window_terms"] = window_terms;
+  return j;
+}
+
+std::vector<std::unique_ptr<parser::AbstractExpression>> WindowPlanNode::FromJson(const nlohmann::json &j) {
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs;
+  auto e1 = AbstractPlanNode::FromJson(j);
+  exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
+
+  // Deserialize partition keys
+  auto partition_keys = j.at("partition_keys").get<std::vector<nlohmann::json>>();
+  for (const auto &key_json : partition_keys) {
+    auto deserialized = parser::DeserializeExpression(key_json);
+    partition_keys_.emplace_back(common::ManagedPointer(deserialized.result_));
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+  }
+
+  // Deserialize sort keys
+  auto sort_keys = j.at("sort_keys").get<std::vector<std::pair<nlohmann::json, optimizer::OrderByOrderingType>>>();
+  for (const auto &key_json : sort_keys) {
+    auto deserialized = parser::DeserializeExpression(key_json.first);
+    sort_keys_.emplace_back(common::ManagedPointer(deserialized.result_), key_json.second);
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+  }
+
+  // Deserialize window terms
+  auto window_terms = j.at("window_terms").get<std::vector<std::pair<WindowFunctionType, nlohmann::json>>>();
+  for (const auto &term_json : window_terms) {
+    if (term_json.second.is_null()) {
+      window_terms_.push_back({term_json.first, nullptr});
+      continue;
+    }
+    auto deserialized = parser::DeserializeExpression(term_json.second);
+    auto agg_ptr = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<parser::AggregateExpression>();
+    window_terms_.push_back({term_json.first, agg_ptr});
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+  }
+  return exprs;
+}
+
+DEFINE_JSON_BODY_DECLARATIONS(WindowPlanNode);
+
+}  // namespace noisepage::planner
@@ -11,6 +11,7 @@
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregation_translator.h"
+#include "execution/compiler/operator/window_translator.h"
 #include "execution/sql/aggregators.h"
 #include "execution/sql/hash_table_entry.h"
 #include "parser/expression/constant_value_expression.h"
@@ -46,6 +47,7 @@
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "self_driving/modeling/operating_unit.h"
 #include "self_driving/modeling/operating_unit_util.h"
 #include "storage/block_layout.h"
@@ -654,6 +656,45 @@ void OperatingUnitRecorder::Visit(const planner::OrderByPlanNode *plan) {
   }
 }
 
+void OperatingUnitRecorder::Visit(const planner::WindowPlanNode *plan) {
+  auto translator = current_translator_.CastManagedPointerTo<execution::compiler::WindowTranslator>();
+
+  if (translator->IsBuildPipeline(*current_pipeline_)) {
+    // SORT_BUILD will operate on the partition keys followed by the sort keys
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> keys;
+    for (auto key : plan->GetPartitionKeys()) {
+      keys.emplace_back(key);
+    }
+    for (auto key : plan->GetSortKeys()) {
+      keys.emplace_back(key.first);
+    }
+    for (auto key : keys) {
+      auto features = OperatingUnitUtil::ExtractFeaturesFromExpression(key);
+      arithmetic_feature_types_.insert(arithmetic_feature_types_.end(), std::make_move_iterator(features.begin()),
+                                       std::make_move_iterator(features.end()));
+    }
+
+    // Get Struct and compute memory scaling factor
+    auto num_key = keys.size();
+    auto key_size = ComputeKeySize(keys, &num_key);
+    auto scale = ComputeMemoryScaleFactor(translator->GetStructDecl(), 0, key_size, 0);
+
+    // Sort build sizes/operations are based on the input (from child)
+    const auto *c_plan = plan->GetChild(0);
+    RecordArithmeticFeatures(c_plan, 1);
+    AggregateFeatures(ExecutionOperatingUnitType::SORT_BUILD, key_size, num_key, c_plan, 1, scale);
+  } else if (translator->IsScanPipeline(*current_pipeline_)) {
+    // SORT_ITERATE will compute the window terms and do any output computations
+    VisitAbstractPlanNode(plan);
+    RecordArithmeticFeatures(plan, 1);
+
+    // Copy outwards
+    auto num_keys = plan->GetOutputSchema()->GetColumns().size();
+    auto key_size = ComputeKeySizeOutputSchema(plan, &num_keys);
+    AggregateFeatures(ExecutionOperatingUnitType::SORT_ITERATE, key_size, num_keys, plan, 1, 1);
+  }
+}
+
 void OperatingUnitRecorder::Visit(const planner::ProjectionPlanNode *plan) {
   VisitAbstractPlanNode(plan);
   RecordArithmeticFeatures(plan, 1);
@@ -6,6 +6,7 @@
 
 #include "storage/arrow_block_metadata.h"
 #include "storage/storage_util.h"
+#include "storage/version_synopsis.h"
 
 namespace noisepage::storage {
 BlockLayout::BlockLayout(std::vector<uint16_t> attr_sizes)
@@ -38,6 +39,7 @@ uint32_t BlockLayout::ComputeStaticHeaderSize() const {
       sizeof(uintptr_t) + sizeof(uint16_t) + sizeof(layout_version_t) +  // datatable pointer, padding, layout_version
       sizeof(uint32_t)                                                   // insert_head
       + sizeof(BlockAccessController) + ArrowBlockMetadata::Size(NumColumns())  // access controller and metadata
+      + VersionSynopsis::Size()                                                 // version synopsis
       + NumColumns() * sizeof(uint32_t));                                       // attr_offsets
   return StorageUtil::PadUpToSize(sizeof(uint64_t), unpadded_size);
 }
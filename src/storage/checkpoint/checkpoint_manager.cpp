@@ -0,0 +1,245 @@
+#include "storage/checkpoint/checkpoint_manager.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "catalog/postgres/pg_attribute.h"
+#include "catalog/postgres/pg_class.h"
+#include "catalog/postgres/pg_constraint.h"
+#include "catalog/postgres/pg_database.h"
+#include "catalog/postgres/pg_index.h"
+#include "catalog/postgres/pg_language.h"
+#include "catalog/postgres/pg_namespace.h"
+#include "catalog/postgres/pg_proc.h"
+#include "catalog/postgres/pg_type.h"
+#include "common/allocator.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/log_serializer_task.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::storage {
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint() {
+  std::unique_lock<std::mutex> guard(checkpoint_latch_);
+
+  uint64_t segment = 0;
+  if (log_manager_ != nullptr) {
+    // Everything logged so far goes to a log segment, which only holds records of transactions that started before now
+    segment = log_manager_->RotateLogFiles();
+    // Wait for those transactions to finish, so that all of the transactions in the segment are part of the snapshot
+    const auto rotation_time = timestamp_manager_->CurrentTime();
+    while (timestamp_manager_->OldestTransactionStartTime() < rotation_time) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  txn_ = txn_manager_->BeginTransaction();
+  const auto checkpoint_time = txn_->StartTime();
+
+  // Write to a temporary file, so the previous checkpoint stays intact until this one is complete
+  const auto temporary_file_path = TemporaryCheckpointFilePath(checkpoint_file_path_);
+  std::remove(temporary_file_path.c_str());
+  auto out = std::make_unique<BufferedLogWriter>(temporary_file_path.c_str());
+  out_ = out.get();
+  WriteCheckpoint();
+  out_->FlushBuffer();
+  out_->Persist();
+  out_->Close();
+  out_ = nullptr;
+  if (std::rename(temporary_file_path.c_str(), checkpoint_file_path_.c_str()) == -1) {
+    throw std::runtime_error("Failed to rename checkpoint file with errno " + std::to_string(errno));
+  }
+  // Persist the rename before the log segments the new checkpoint replaces are removed
+  PosixIoWrappers::SyncParentDirectory(checkpoint_file_path_);
+
+  txn_manager_->Commit(txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_ = nullptr;
+
+  // The checkpoint covers everything in the rotated log segments, and those before them
+  if (log_manager_ != nullptr) log_manager_->RemoveLogSegments(segment);
+  return checkpoint_time;
+}
+
+void CheckpointManager::StartCheckpointThread(const std::chrono::seconds checkpoint_interval) {
+  NOISEPAGE_ASSERT(!run_checkpoint_thread_, "Checkpoint thread should not already be running.");
+  checkpoint_interval_ = checkpoint_interval;
+  run_checkpoint_thread_ = true;
+  checkpoint_thread_ = std::thread([this] { CheckpointThreadLoop(); });
+}
+
+void CheckpointManager::StopCheckpointThread() {
+  NOISEPAGE_ASSERT(run_checkpoint_thread_, "Checkpoint thread should already be running.");
+  {
+    std::unique_lock<std::mutex> lock(thread_latch_);
+    run_checkpoint_thread_ = false;
+  }
+  thread_cv_.notify_one();
+  checkpoint_thread_.join();
+}
+
+void CheckpointManager::CheckpointThreadLoop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(thread_latch_);
+      thread_cv_.wait_for(lock, checkpoint_interval_, [&] { return !run_checkpoint_thread_; });
+      if (!run_checkpoint_thread_) return;
+    }
+    TakeCheckpoint();
+  }
+}
+
+void CheckpointManager::WriteCheckpoint() {
+  // Find the databases first, so each of them can be written along with its row in pg_database
+  std::vector<std::pair<catalog::db_oid_t, TupleSlot>> databases;
+  const auto pg_database = common::ManagedPointer(catalog_->databases_);
+  const auto initializer = pg_database->InitializerForProjectedRow({catalog::postgres::PgDatabase::DATOID.oid_});
+  auto *const buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  for (auto it = pg_database->begin(); it != pg_database->end(); it++) {
+    auto *const pr = initializer.InitializeRow(buffer);
+    if (!pg_database->Select(common::ManagedPointer(txn_), *it, pr)) continue;
+    databases.emplace_back(*reinterpret_cast<catalog::db_oid_t *>(pr->AccessForceNotNull(0)), *it);
+  }
+  delete[] buffer;
+
+  for (const auto &database : databases) WriteDatabase(database.first, database.second);
+
+  // The checkpoint always ends with a commit record, which also tells recovery when the snapshot was taken
+  WriteCommit();
+}
+
+void CheckpointManager::WriteDatabase(const catalog::db_oid_t db_oid, const TupleSlot pg_database_slot) {
+  const auto all_rows = [](RedoRecord *) { return true; };
+
+  // The insert into pg_database makes recovery create the database catalog. Like when the database is created, it is
+  // logged without a database oid.
+  WriteTable(catalog::INVALID_DATABASE_OID, catalog::postgres::PgDatabase::DATABASE_TABLE_OID,
+             common::ManagedPointer(catalog_->databases_), false,
+             [=](RedoRecord *record) { return record->GetTupleSlot() == pg_database_slot; });
+
+  const auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn_), db_oid);
+  WriteTable(db_oid, catalog::postgres::PgNamespace::NAMESPACE_TABLE_OID, db_catalog->pg_core_.namespaces_, false,
+             all_rows);
+
+  // Recovery recreates a table or index once its pointer is set, which must come after its columns and index metadata.
+  // So its pointers are left null at first, like when it is created, and set further down.
+  std::vector<ClassEntry> classes;
+  const auto pg_class = db_catalog->pg_core_.classes_;
+  auto pg_class_map = pg_class->ProjectionMapForOids(ColumnOids(pg_class));
+  WriteTable(db_oid, catalog::postgres::PgClass::CLASS_TABLE_OID, pg_class, false, [&](RedoRecord *record) {
+    auto *const delta = record->Delta();
+    const auto ptr_offset = pg_class_map[catalog::postgres::PgClass::REL_PTR.oid_];
+    const auto *const ptr = delta->AccessWithNullCheck(ptr_offset);
+    if (ptr != nullptr) {
+      const auto oid_offset = pg_class_map[catalog::postgres::PgClass::RELOID.oid_];
+      const auto kind_offset = pg_class_map[catalog::postgres::PgClass::RELKIND.oid_];
+      classes.push_back({record->GetTupleSlot(), *reinterpret_cast<uint32_t *>(delta->AccessForceNotNull(oid_offset)),
+                         *reinterpret_cast<char *>(delta->AccessForceNotNull(kind_offset)),
+                         *reinterpret_cast<const uint64_t *>(ptr)});
+    }
+    delta->SetNull(ptr_offset);
+    delta->SetNull(pg_class_map[catalog::postgres::PgClass::REL_SCHEMA.oid_]);
+    return true;
+  });
+
+  WriteTable(db_oid, catalog::postgres::PgIndex::INDEX_TABLE_OID, db_catalog->pg_core_.indexes_, false, all_rows);
+  WriteTable(db_oid, catalog::postgres::PgAttribute::COLUMN_TABLE_OID, db_catalog->pg_core_.columns_, false,
+             all_rows);
+  WriteTable(db_oid, catalog::postgres::PgType::TYPE_TABLE_OID, db_catalog->pg_type_.types_, false, all_rows);
+  WriteTable(db_oid, catalog::postgres::PgConstraint::CONSTRAINT_TABLE_OID, db_catalog->pg_constraint_.constraints_,
+             false, all_rows);
+  WriteTable(db_oid, catalog::postgres::PgLanguage::LANGUAGE_TABLE_OID, db_catalog->pg_language_.languages_, false,
+             all_rows);
+  WriteTable(db_oid, catalog::postgres::PgProc::PRO_TABLE_OID, db_catalog->pg_proc_.procs_, false, all_rows);
+
+  // Set the pointers of the tables, then those of the indexes on them. Recovery only looks at which column is updated,
+  // and brings its own objects.
+  const auto initializer = pg_class->InitializerForProjectedRow({catalog::postgres::PgClass::REL_PTR.oid_});
+  auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+  for (const auto kind :
+       {catalog::postgres::PgClass::RelKind::REGULAR_TABLE, catalog::postgres::PgClass::RelKind::INDEX}) {
+    for (const auto &entry : classes) {
+      if (entry.kind_ != static_cast<char>(kind)) continue;
+      auto *const record = RedoRecord::Initialize(buffer, txn_->StartTime(), db_oid,
+                                                  catalog::postgres::PgClass::CLASS_TABLE_OID, initializer);
+      auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+      redo->SetTupleSlot(entry.slot_);
+      *reinterpret_cast<uint64_t *>(redo->Delta()->AccessForceNotNull(0)) = entry.ptr_;
+      WriteRecord(*record);
+    }
+  }
+  delete[] buffer;
+  WriteCommit();
+
+  // The user tables go last, in transactions of bounded size
+  for (const auto &entry : classes) {
+    if (entry.kind_ != static_cast<char>(catalog::postgres::PgClass::RelKind::REGULAR_TABLE) ||
+        entry.oid_ < catalog::START_OID) {
+      continue;
+    }
+    WriteTable(db_oid, catalog::table_oid_t(entry.oid_),
+               common::ManagedPointer(reinterpret_cast<SqlTable *>(entry.ptr_)), true, all_rows);
+  }
+  if (uncommitted_records_ > 0) WriteCommit();
+}
+
+template <class RowFn>
+void CheckpointManager::WriteTable(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                                   const common::ManagedPointer<SqlTable> table, const bool split_txns,
+                                   const RowFn &on_row) {
+  const auto initializer = table->InitializerForProjectedRow(ColumnOids(table));
+  auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+  for (auto it = table->begin(); it != table->end(); it++) {
+    auto *const record = RedoRecord::Initialize(buffer, txn_->StartTime(), db_oid, table_oid, initializer);
+    auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+    if (!table->Select(common::ManagedPointer(txn_), *it, redo->Delta())) continue;
+    redo->SetTupleSlot(*it);
+    if (!on_row(redo)) continue;
+    WriteRecord(*record);
+    if (split_txns && uncommitted_records_ >= CHECKPOINT_TXN_SIZE) WriteCommit();
+  }
+  delete[] buffer;
+}
+
+std::vector<catalog::col_oid_t> CheckpointManager::ColumnOids(const common::ManagedPointer<SqlTable> table) {
+  std::vector<catalog::col_oid_t> col_oids;
+  col_oids.reserve(table->GetColumnMap().size());
+  for (const auto &column : table->GetColumnMap()) col_oids.push_back(column.first);
+  return col_oids;
+}
+
+void CheckpointManager::WriteCommit() {
+  // Recovery replays a commit record with no oldest active transaction right away, so the records of a transaction of
+  // the checkpoint are never buffered along with those of the next
+  auto *const buffer = common::AllocationUtil::AllocateAligned(CommitRecord::Size());
+  auto *const record = CommitRecord::Initialize(buffer, txn_->StartTime(), txn_->StartTime(), nullptr, nullptr,
+                                                transaction::INVALID_TXN_TIMESTAMP, false, nullptr, nullptr);
+  WriteRecord(*record);
+  delete[] buffer;
+  uncommitted_records_ = 0;
+}
+
+void CheckpointManager::WriteRecord(const LogRecord &record) {
+  LogSerializerTask::SerializeRecord(record, [this](const void *val, const uint32_t size) {
+    uint32_t size_written = 0;
+    while (size_written < size) {
+      size_written += out_->BufferWrite(reinterpret_cast<const byte *>(val) + size_written, size - size_written);
+      if (out_->IsBufferFull()) out_->FlushBuffer();
+    }
+    return size;
+  });
+  uncommitted_records_++;
+}
+
+}  // namespace noisepage::storage
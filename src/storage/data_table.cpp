@@ -1,11 +1,14 @@
 #include "storage/data_table.h"
 
+#include <atomic>
 #include <list>
 
 #include "common/allocator.h"
 #include "execution/sql/vector_projection.h"
+#include "storage/arrow_block_metadata.h"
 #include "storage/block_access_controller.h"
 #include "storage/storage_util.h"
+#include "storage/version_synopsis.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_util.h"
 
@@ -60,9 +63,17 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
 
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
                      execution::sql::VectorProjection *const out_buffer) const {
+  // Frozen blocks have no versions and cannot be modified while we hold the in-place read latch, so they can be handed
+  // out without materialization.
+  if (ScanInPlace(start_pos, out_buffer)) return;
+
+  const bool can_bulk_copy = HasStorageCompatibleColumns(*out_buffer);
   uint32_t filled = 0;
   while (filled < out_buffer->GetTupleCapacity() && *start_pos != end() &&
          **start_pos != SlotIterator::InvalidTupleSlot()) {
+    // Runs of tuples without version chains can be copied out in bulk, as there is nothing to reconstruct for them
+    if (can_bulk_copy && CopyUnversionedSlots(start_pos, out_buffer, &filled)) continue;
+
     execution::sql::VectorProjection::RowView row = out_buffer->InterpretAsRow(filled);
     const TupleSlot slot = **start_pos;
     // Only fill the buffer with valid, visible tuples
@@ -71,10 +82,123 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
       filled++;
     }
     ++(*start_pos);
+
+    // Leave the next block to the next invocation if it can be read in place
+    if (filled > 0 && start_pos->slot_num_ == 0 && **start_pos != SlotIterator::InvalidTupleSlot() &&
+        (*start_pos)->GetBlock()->controller_.GetBlockState()->load() == BlockState::FROZEN) {
+      break;
+    }
   }
   out_buffer->Reset(filled);
 }
 
+bool DataTable::ScanInPlace(SlotIterator *const start_pos, execution::sql::VectorProjection *const out_buffer) const {
+  // A referencing projection keeps pointing at whatever its vectors were last set to, so a later materializing scan
+  // would write into the block. Only owning projections are re-pointed at their own buffer on Reset().
+  if (out_buffer->owned_buffer_ == nullptr || !HasStorageCompatibleColumns(*out_buffer)) return false;
+
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+
+  while (*start_pos != end() && **start_pos != SlotIterator::InvalidTupleSlot()) {
+    RawBlock *const block = (*start_pos)->GetBlock();
+    if (!block->controller_.TryAcquireInPlaceRead()) return false;
+
+    // A frozen block is compacted, so all of its live tuples are stored contiguously at the front of the block.
+    const ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(block);
+    const uint32_t start = start_pos->slot_num_;
+    if (start >= metadata.NumRecords()) {
+      block->controller_.ReleaseInPlaceRead();
+      start_pos->SkipInBlock(start_pos->max_slot_num_ - start);
+      continue;
+    }
+    const auto num_tuples =
+        static_cast<uint32_t>(std::min<uint64_t>(out_buffer->GetTupleCapacity(), metadata.NumRecords() - start));
+
+    // Drops the latch held for the previous invocation, if any, so take over the new one afterwards
+    out_buffer->Reset(num_tuples);
+    out_buffer->in_place_block_.reset(block);
+
+    for (uint32_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+      const col_id_t col_id = out_buffer->ColumnIds()[i];
+      execution::sql::Vector *const col = out_buffer->GetColumn(i);
+      col->Reference(accessor_.ColumnStart(block, col_id) + layout.AttrSize(col_id) * start, nullptr, num_tuples);
+      // The block's bitmap marks present values while the vector's marks NULLs, so it cannot be referenced directly
+      if (metadata.NullCount(col_id) == 0) continue;
+      common::RawConcurrentBitmap *const bitmap = accessor_.ColumnNullBitmap(block, col_id);
+      for (uint32_t offset = 0; offset < num_tuples; offset++) {
+        if (!bitmap->Test(start + offset)) col->SetNull(offset, true);
+      }
+    }
+    for (uint32_t offset = 0; offset < num_tuples; offset++) out_buffer->SetTupleSlot({block, start + offset}, offset);
+
+    // Skip the rest of the block once its records are exhausted, the slots past them are empty after compaction
+    const bool block_done = start + num_tuples == metadata.NumRecords();
+    start_pos->SkipInBlock(block_done ? start_pos->max_slot_num_ - start : num_tuples);
+    return true;
+  }
+  return false;
+}
+
+bool DataTable::CopyUnversionedSlots(SlotIterator *const start_pos, execution::sql::VectorProjection *const out_buffer,
+                                     uint32_t *const filled) const {
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  RawBlock *const block = (*start_pos)->GetBlock();
+  const uint32_t start = start_pos->slot_num_;
+  const uint32_t slots_per_range = VersionSynopsis::SlotsPerRange(layout);
+  const uint32_t range = start / slots_per_range;
+  const VersionSynopsis &synopsis = accessor_.GetVersionSynopsis(block);
+  const uint64_t snapshot = synopsis.Snapshot(range);
+  if (!VersionSynopsis::IsUnversioned(snapshot)) return false;
+
+  const auto capacity = static_cast<uint32_t>(out_buffer->GetTupleCapacity());
+  const uint32_t end = std::min({(range + 1) * slots_per_range, start_pos->max_slot_num_, start + capacity - *filled});
+  uint32_t copied = *filled;
+  uint32_t offset = start;
+  while (offset < end) {
+    // Without a version chain a tuple is visible to everyone if it is present and not deleted, and invisible otherwise
+    if (!Visible({block, offset}, accessor_)) {
+      offset++;
+      continue;
+    }
+    const uint32_t run_start = offset;
+    while (offset < end && Visible({block, offset}, accessor_)) offset++;
+    const uint32_t run_length = offset - run_start;
+
+    for (uint16_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+      const col_id_t col_id = out_buffer->ColumnIds()[i];
+      const uint16_t attr_size = layout.AttrSize(col_id);
+      execution::sql::Vector *const col = out_buffer->GetColumn(i);
+      std::memcpy(col->GetValuePointer(copied), accessor_.ColumnStart(block, col_id) + attr_size * run_start,
+                  attr_size * run_length);
+      common::RawConcurrentBitmap *const bitmap = accessor_.ColumnNullBitmap(block, col_id);
+      for (uint32_t j = 0; j < run_length; j++) col->SetNull(copied + j, !bitmap->Test(run_start + j));
+    }
+    for (uint32_t j = 0; j < run_length; j++) out_buffer->SetTupleSlot({block, run_start + j}, copied + j);
+    copied += run_length;
+  }
+
+  // A writer may have installed a version and modified tuples in place while we were copying. Leave the range to the
+  // transactional path in that case, it overwrites whatever we copied. The fence keeps the plain reads of the copy from
+  // being reordered after the validating re-read of the synopsis.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (synopsis.Snapshot(range) != snapshot) return false;
+
+  *filled = copied;
+  start_pos->SkipInBlock(end - start);
+  return true;
+}
+
+bool DataTable::HasStorageCompatibleColumns(const execution::sql::VectorProjection &projection) const {
+  // Column vectors can only hold a run of attributes copied straight from a block if their elements are laid out with
+  // the same width.
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  for (uint32_t i = 0; i < projection.GetColumnCount(); i++) {
+    if (execution::sql::GetTypeIdSize(projection.GetColumnType(i)) != layout.AttrSize(projection.ColumnIds()[i]))
+      return false;
+  }
+  return true;
+}
+
 bool DataTable::Update(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot,
                        const ProjectedRow &redo) {
   NOISEPAGE_ASSERT(redo.NumColumns() <= accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
@@ -113,6 +237,8 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
   }
 
+  // Hot tuples pile up versions in between garbage collections. Drop the ones nobody can see anymore while we are here.
+  PruneVersionChain(undo, txn->PruneHorizon());
   return true;
 }
 
@@ -122,6 +248,28 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
                    "The input buffer never changes the version pointer column, so it should have  exactly 1 fewer "
                    "attribute than the DataTable's layout.");
 
+  TupleSlot result;
+  AllocateSlots(1, &result);
+  InsertInto(txn, redo, result);
+
+  return result;
+}
+
+void DataTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            const ProjectedRow *const *const redos, const uint32_t num_tuples, TupleSlot *const slots) {
+  // Claim slots for as many of the tuples as fit in the insertion head at once, instead of one tuple at a time
+  for (uint32_t num_allocated = 0; num_allocated < num_tuples;) {
+    num_allocated += AllocateSlots(num_tuples - num_allocated, slots + num_allocated);
+  }
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    NOISEPAGE_ASSERT(redos[i]->NumColumns() == accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
+                     "The input buffer never changes the version pointer column, so it should have  exactly 1 fewer "
+                     "attribute than the DataTable's layout.");
+    InsertInto(txn, *redos[i], slots[i]);
+  }
+}
+
+uint32_t DataTable::AllocateSlots(const uint32_t num_slots, TupleSlot *const slots) {
   // Insertion index points to the first block that has free tuple slots
   // Once a txn arrives, it will start from the insertion index to find the first
   // idle (no other txn is trying to get tuple slots in that block) and non-full block.
@@ -129,9 +277,9 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
   // Before the txn writes to the block, it will set block status to busy.
   // The first bit of block insert_head_ is used to indicate if the block is busy
   // If the first bit is 1, it indicates one txn is writing to the block.
-  TupleSlot result;
   uint64_t current_insert_idx = insert_index_.load();
   RawBlock *block;
+  uint32_t num_allocated;
   while (true) {
     // No free block left
     uint64_t size = blocks_size_;
@@ -147,7 +295,8 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
     }
     if (accessor_.SetBlockBusyStatus(block)) {
       // No one is inserting into this block
-      if (accessor_.Allocate(block, &result)) {
+      num_allocated = accessor_.Allocate(block, num_slots, slots);
+      if (num_allocated > 0) {
         // The block is not full, succeed
         break;
       }
@@ -170,11 +319,9 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
   }
 
   // Do not need to wait unit finish inserting,
-  // can flip back the status bit once the thread gets the allocated tuple slot
+  // can flip back the status bit once the thread gets the allocated tuple slots
   accessor_.ClearBlockBusyStatus(block);
-  InsertInto(txn, redo, result);
-
-  return result;
+  return num_allocated;
 }
 
 void DataTable::InsertInto(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
@@ -187,6 +334,7 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
   UndoRecord *undo = txn->UndoRecordForInsert(this, dest);
   NOISEPAGE_ASSERT(dest.GetBlock()->controller_.GetBlockState()->load() == BlockState::HOT,
                    "Should only be able to insert into hot blocks");
+  accessor_.GetVersionSynopsis(dest.GetBlock()).AddVersionChain(accessor_.GetBlockLayout(), dest.GetOffset());
   AtomicallyWriteVersionPtr(dest, accessor_, undo);
   // Set the logically deleted bit to present as the undo record is ready
   accessor_.AccessForceNotNull(dest, VERSION_POINTER_COLUMN_ID);
@@ -219,6 +367,7 @@ bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
 
   // We have the write lock. Go ahead and flip the logically deleted bit to true
   accessor_.SetNull(slot, VERSION_POINTER_COLUMN_ID);
+  PruneVersionChain(undo, txn->PruneHorizon());
   return true;
 }
 
@@ -251,7 +400,17 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
     return visible;
   }
 
+  // If the whole version chain is invisible to every running transaction, drop it without waiting for the GC, so that
+  // readers can skip the tuple's range again. Going through the CAS keeps the version synopsis accurate, and losing the
+  // race to a writer simply leaves the chain to the GC.
+  const transaction::timestamp_t horizon = txn->PruneHorizon();
+  if (transaction::TransactionUtil::NewerThan(horizon, version_ptr->Timestamp().load())) {
+    CompareAndSwapVersionPtr(slot, accessor_, version_ptr, nullptr);
+    return visible;
+  }
+
   // Apply deltas until we reconstruct a version safe for us to read
+  UndoRecord *applied = nullptr;
   while (version_ptr != nullptr &&
          transaction::TransactionUtil::NewerThan(version_ptr->Timestamp().load(), txn->StartTime())) {
     switch (version_ptr->Type()) {
@@ -268,9 +427,16 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
       default:
         throw std::runtime_error("unexpected delta record type");
     }
+    applied = version_ptr;
     version_ptr = version_ptr->Next();
   }
 
+  // The version we stopped at is older than every running transaction, so is the rest of the chain. Cut it off.
+  if (applied != nullptr && version_ptr != nullptr &&
+      transaction::TransactionUtil::NewerThan(horizon, version_ptr->Timestamp().load())) {
+    applied->Next().store(nullptr);
+  }
+
   return visible;
 }
 
@@ -313,10 +479,33 @@ bool DataTable::HasConflict(const transaction::TransactionContext &txn, UndoReco
 }
 
 bool DataTable::CompareAndSwapVersionPtr(const TupleSlot slot, const TupleAccessStrategy &accessor,
-                                         UndoRecord *expected, UndoRecord *const desired) {
+                                         UndoRecord *expected, UndoRecord *const desired) const {
   // Okay to ignore presence bit, because we use that for logical delete, not for validity of the version pointer value
   byte *ptr_location = accessor.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID);
-  return reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, desired);
+  VersionSynopsis &synopsis = accessor.GetVersionSynopsis(slot.GetBlock());
+  const BlockLayout &layout = accessor.GetBlockLayout();
+  // Readers that skip version chains based on the synopsis must learn about a new chain before it is published
+  const bool installs_chain = expected == nullptr && desired != nullptr;
+  const bool removes_chain = expected != nullptr && desired == nullptr;
+  if (installs_chain) synopsis.AddVersionChain(layout, slot.GetOffset());
+  const bool result =
+      reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, desired);
+  if ((installs_chain && !result) || (removes_chain && result)) synopsis.RemoveVersionChain(layout, slot.GetOffset());
+  return result;
+}
+
+void DataTable::PruneVersionChain(UndoRecord *const record, const transaction::timestamp_t horizon) const {
+  UndoRecord *curr = record;
+  for (uint32_t i = 0; i < MAX_PRUNE_TRAVERSAL; i++) {
+    UndoRecord *const next = curr->Next().load();
+    if (next == nullptr) return;
+    // Version chains are sorted newest-to-oldest, so everything from here on is invisible to running transactions
+    if (transaction::TransactionUtil::NewerThan(horizon, next->Timestamp().load())) {
+      curr->Next().store(nullptr);
+      return;
+    }
+    curr = next;
+  }
 }
 
 RawBlock *DataTable::NewBlock() {
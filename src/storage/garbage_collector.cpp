@@ -1,7 +1,9 @@
 #include "storage/garbage_collector.h"
 
+#include <algorithm>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/thread_context.h"
@@ -21,14 +23,23 @@ namespace noisepage::storage {
 GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+    const uint32_t num_workers)
     : timestamp_manager_(timestamp_manager),
       deferred_action_manager_(deferred_action_manager),
       txn_manager_(txn_manager),
       observer_(observer),
-      last_unlinked_{0} {
+      last_unlinked_{0},
+      num_workers_(num_workers),
+      partitions_(num_workers) {
   NOISEPAGE_ASSERT(txn_manager_->GCEnabled(),
                    "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+  NOISEPAGE_ASSERT(num_workers_ > 0, "The GC needs at least one worker");
+  if (num_workers_ > 1) {
+    // The thread that invokes the GC is a worker as well
+    worker_pool_ = std::make_unique<common::WorkerPool>(num_workers_ - 1, common::TaskQueue());
+    worker_pool_->Startup();
+  }
 }
 
 std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
@@ -42,7 +53,16 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
   uint32_t txns_deallocated = ProcessDeallocateQueue(oldest_txn);
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): txns_deallocated: {}", txns_deallocated);
   uint32_t txns_unlinked, buffer_unlinked, readonly_unlinked;
-  std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked) = ProcessUnlinkQueue(oldest_txn);
+  if (worker_pool_ != nullptr) {
+    // The workers garbage collect the indexes while the version chains are unlinked. The latch is held until they are
+    // done, so that no index is unregistered and freed in the meantime.
+    common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
+    for (const auto &index : indexes_) worker_pool_->SubmitTask([index] { index->PerformGarbageCollection(); });
+    std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked) = ProcessUnlinkQueue(oldest_txn);
+    worker_pool_->WaitUntilAllFinished();
+  } else {
+    std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked) = ProcessUnlinkQueue(oldest_txn);
+  }
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): txns_unlinked: {}", txns_unlinked);
   if (txns_unlinked > 0) {
     // Only update this field if we actually unlinked anything, otherwise we're being too conservative about when it's
@@ -52,7 +72,7 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): last_unlinked_: {}",
                     last_unlinked_.UnderlyingValue());
   ProcessDeferredActions(oldest_txn);
-  ProcessIndexes();
+  if (worker_pool_ == nullptr) ProcessIndexes();
 
   if ((txns_deallocated > 0 || txns_unlinked > 0) && gc_metrics_enabled) {
     if (common::thread_context.resource_tracker_.IsRunning()) {
@@ -98,10 +118,9 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
-  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-  // wasteful traversals of the version chain.
-  std::unordered_set<TupleSlot> visited_slots;
+  // Transactions that are safe to gc, whose undo records are unlinked below
+  transaction::TransactionQueue unlinked;
+  std::vector<std::pair<transaction::TransactionContext *, UndoRecord *>> &records = partitions_[0].records_;
 
   // Process every transaction in the unlink queue
   while (!txns_to_unlink_.empty()) {
@@ -116,22 +135,13 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
     } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
       // Safe to garbage collect.
       for (auto &undo_record : txn->undo_buffer_) {
-        // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimBufferIfVarlen(txn, &undo_record);
-          ReclaimSlotIfDeleted(&undo_record);
-        }
+        // It is possible for the table field to be null, for aborted transaction's last conflicting record, in which
+        // case there is nothing to unlink
+        if (undo_record.Table() != nullptr) records.emplace_back(txn, &undo_record);
         if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
         buffer_processed++;
       }
-      txns_to_deallocate_.push_front(txn);
+      unlinked.push_front(txn);
       txns_processed++;
     } else {
       // This is a committed txn that is still visible, requeue for next GC run
@@ -139,12 +149,59 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
     }
   }
 
+  // Use as many workers as there are enough records for. Records are partitioned by block, so that all records of a
+  // version chain end up in the same partition, in the order they were found in.
+  const auto num_partitions = std::clamp<uint32_t>(static_cast<uint32_t>(records.size() / MIN_RECORDS_PER_WORKER), 1,
+                                                   num_workers_);
+  if (num_partitions > 1) {
+    std::vector<std::pair<transaction::TransactionContext *, UndoRecord *>> all_records;
+    all_records.swap(records);
+    for (const auto &record : all_records) {
+      const auto block = reinterpret_cast<uintptr_t>(record.second->Slot().GetBlock());
+      partitions_[(block / common::Constants::BLOCK_SIZE) % num_partitions].records_.push_back(record);
+    }
+    for (uint32_t i = 1; i < num_partitions; i++) {
+      worker_pool_->SubmitTask([this, i, oldest_txn] { ProcessUnlinkPartition(&partitions_[i], oldest_txn); });
+    }
+  }
+  ProcessUnlinkPartition(&partitions_[0], oldest_txn);
+  if (num_partitions > 1) worker_pool_->WaitUntilAllFinished();
+
+  for (uint32_t i = 0; i < num_partitions; i++) {
+    for (const auto &loose_ptr : partitions_[i].loose_ptrs_) loose_ptr.first->loose_ptrs_.push_back(loose_ptr.second);
+    partitions_[i].records_.clear();
+    partitions_[i].loose_ptrs_.clear();
+  }
+  txns_to_deallocate_.splice_after(txns_to_deallocate_.cbefore_begin(), std::move(unlinked));
+
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
   return std::make_tuple(txns_processed, buffer_processed, readonly_processed);
 }
 
+void GarbageCollector::ProcessUnlinkPartition(UnlinkPartition *const partition,
+                                              const transaction::timestamp_t oldest_txn) const {
+  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
+  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
+  // wasteful traversals of the version chain.
+  std::unordered_set<TupleSlot> visited_slots;
+  for (const auto &record : partition->records_) {
+    transaction::TransactionContext *const txn = record.first;
+    UndoRecord *const undo_record = record.second;
+    // Each version chain needs to be traversed and truncated at most once every GC period. Check
+    // if we have already visited this tuple slot; if not, proceed to prune the version chain.
+    if (visited_slots.insert(undo_record->Slot()).second)
+      TruncateVersionChain(undo_record->Table(), undo_record->Slot(), oldest_txn);
+    // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
+    // unless the transaction is aborted, and the record holds a version that is still visible.
+    if (!txn->Aborted()) {
+      ReclaimBufferIfVarlen(txn, undo_record, &partition->loose_ptrs_);
+      ReclaimSlotIfDeleted(undo_record);
+    }
+  }
+}
+
 void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_txn) {
   if (deferred_action_manager_ != DISABLED) {
     // TODO(Tianyu): Eventually we will remove the GC and implement version chain pruning with deferred actions
@@ -171,8 +228,8 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
     return;
   }
 
-  // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-  // to traverse and update pointers without CAS
+  // a version chain is guaranteed to not change when not at the head, other than being truncated by transactions that
+  // come across it (see DataTable::PruneVersionChain), so we are safe to traverse and update pointers without CAS
   UndoRecord *curr = version_ptr;
   UndoRecord *next;
   // Traverse until we find the earliest UndoRecord that can be unlinked.
@@ -198,8 +255,9 @@ void GarbageCollector::ReclaimSlotIfDeleted(UndoRecord *const undo_record) const
   if (undo_record->Type() == DeltaRecordType::DELETE) undo_record->Table()->accessor_.Deallocate(undo_record->Slot());
 }
 
-void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *const txn,
-                                             UndoRecord *const undo_record) const {
+void GarbageCollector::ReclaimBufferIfVarlen(
+    transaction::TransactionContext *const txn, UndoRecord *const undo_record,
+    std::vector<std::pair<transaction::TransactionContext *, const byte *>> *const loose_ptrs) const {
   const TupleAccessStrategy &accessor = undo_record->Table()->accessor_;
   const BlockLayout &layout = accessor.GetBlockLayout();
   switch (undo_record->Type()) {
@@ -212,7 +270,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
         // Okay to include version vector, as it is never varlen
         if (layout.IsVarlen(col_id)) {
           auto *varlen = reinterpret_cast<VarlenEntry *>(accessor.AccessWithNullCheck(undo_record->Slot(), col_id));
-          if (varlen != nullptr && varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
+          if (varlen != nullptr && varlen->NeedReclaim()) loose_ptrs->emplace_back(txn, varlen->Content());
         }
       }
       break;
@@ -222,7 +280,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
         col_id_t col_id = undo_record->Delta()->ColumnIds()[i];
         if (layout.IsVarlen(col_id)) {
           auto *varlen = reinterpret_cast<VarlenEntry *>(undo_record->Delta()->AccessWithNullCheck(i));
-          if (varlen != nullptr && varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
+          if (varlen != nullptr && varlen->NeedReclaim()) loose_ptrs->emplace_back(txn, varlen->Content());
         }
       }
       break;
@@ -1,5 +1,9 @@
 #include "storage/index/bwtree_index.h"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
 #include "bwtree/bwtree.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -153,6 +157,60 @@ void BwTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, c
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BwTreeIndex<KeyType>::ScanKeys(const transaction::TransactionContext &txn,
+                                    const std::vector<const ProjectedRow *> &keys, std::vector<TupleSlot> *value_list,
+                                    std::vector<uint32_t> *key_offsets) {
+  NOISEPAGE_ASSERT(value_list->empty() && key_offsets->empty(), "Result vectors should begin empty.");
+  const auto num_keys = static_cast<uint32_t>(keys.size());
+
+  // Build search keys
+  std::vector<KeyType> index_keys(num_keys);
+  for (uint32_t i = 0; i < num_keys; i++) {
+    index_keys[i].SetFromProjectedRow(*keys[i], metadata_, metadata_.GetSchema().GetColumns().size());
+  }
+
+  // Sort the keys so that consecutive traversals share the nodes that are still in cache, and look up every distinct
+  // key once
+  std::vector<uint32_t> order(num_keys);
+  std::iota(order.begin(), order.end(), 0);
+  const std::less<KeyType> key_less{};
+  const std::equal_to<KeyType> key_equal{};
+  std::sort(order.begin(), order.end(),
+            [&](const uint32_t a, const uint32_t b) { return key_less(index_keys[a], index_keys[b]); });
+  std::vector<const KeyType *> distinct_keys;
+  std::vector<uint32_t> distinct_index(num_keys);
+  for (const uint32_t i : order) {
+    if (distinct_keys.empty() || !key_equal(*distinct_keys.back(), index_keys[i])) {
+      distinct_keys.emplace_back(&index_keys[i]);
+    }
+    distinct_index[i] = static_cast<uint32_t>(distinct_keys.size() - 1);
+  }
+
+  // Perform lookups in BwTree, and the visibility check on the results of every distinct key
+  std::vector<TupleSlot> distinct_values;
+  std::vector<uint32_t> distinct_offsets;
+  distinct_offsets.reserve(distinct_keys.size() + 1);
+  distinct_offsets.emplace_back(0);
+  bwtree_->GetValues(distinct_keys, [&](size_t /* distinct key */, const std::vector<TupleSlot> &results) {
+    for (const auto &result : results) {
+      if (IsVisible(txn, result)) distinct_values.emplace_back(result);
+    }
+    distinct_offsets.emplace_back(static_cast<uint32_t>(distinct_values.size()));
+  });
+
+  // Hand out the results in the order of the keys
+  value_list->reserve(distinct_values.size());
+  key_offsets->reserve(num_keys + 1);
+  key_offsets->emplace_back(0);
+  for (uint32_t i = 0; i < num_keys; i++) {
+    const uint32_t distinct = distinct_index[i];
+    value_list->insert(value_list->end(), distinct_values.cbegin() + distinct_offsets[distinct],
+                       distinct_values.cbegin() + distinct_offsets[distinct + 1]);
+    key_offsets->emplace_back(static_cast<uint32_t>(value_list->size()));
+  }
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                          uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
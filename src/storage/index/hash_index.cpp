@@ -1,5 +1,7 @@
 #include "storage/index/hash_index.h"
 
+#include <algorithm>
+
 #include "libcuckoo/cuckoohash_map.hh"
 #include "storage/index/generic_key.h"
 #include "storage/index/hash_key.h"
@@ -237,18 +239,7 @@ void HashIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, con
    * value the current value for this key value (found by underlying containiner on lookup, then passed to
    * key_found_fn)
    */
-  auto key_found_fn = [value_list, &txn](const ValueType &value) -> void {
-    if (std::holds_alternative<TupleSlot>(value)) {
-      const auto existing_location = std::get<TupleSlot>(value);
-      if (IsVisible(txn, existing_location)) value_list->emplace_back(existing_location);
-    } else {
-      const auto &value_map = std::get<ValueMap>(value);
-
-      for (const auto i : value_map) {
-        if (IsVisible(txn, i)) value_list->emplace_back(i);
-      }
-    }
-  };
+  auto key_found_fn = [value_list, &txn](const ValueType &value) -> void { CollectVisible(txn, value, value_list); };
 
   const bool UNUSED_ATTRIBUTE find_result = hash_map_->find_fn(index_key, key_found_fn);
 
@@ -256,6 +247,46 @@ void HashIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, con
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void HashIndex<KeyType>::ScanKeys(const transaction::TransactionContext &txn,
+                                  const std::vector<const ProjectedRow *> &keys, std::vector<TupleSlot> *value_list,
+                                  std::vector<uint32_t> *key_offsets) {
+  NOISEPAGE_ASSERT(value_list->empty() && key_offsets->empty(), "Result vectors should begin empty.");
+  const auto num_keys = static_cast<uint32_t>(keys.size());
+
+  // Build search keys
+  std::vector<KeyType> index_keys(num_keys);
+  for (uint32_t i = 0; i < num_keys; i++) {
+    index_keys[i].SetFromProjectedRow(*keys[i], metadata_, metadata_.GetSchema().GetColumns().size());
+  }
+
+  // Look up the keys in order, keeping the buckets of the next PREFETCH_DISTANCE keys in flight
+  for (uint32_t i = 0; i < std::min(num_keys, PREFETCH_DISTANCE); i++) hash_map_->prefetch(index_keys[i]);
+  auto key_found_fn = [value_list, &txn](const ValueType &value) -> void { CollectVisible(txn, value, value_list); };
+  key_offsets->reserve(num_keys + 1);
+  key_offsets->emplace_back(0);
+  for (uint32_t i = 0; i < num_keys; i++) {
+    if (i + PREFETCH_DISTANCE < num_keys) hash_map_->prefetch(index_keys[i + PREFETCH_DISTANCE]);
+    hash_map_->find_fn(index_keys[i], key_found_fn);
+    key_offsets->emplace_back(static_cast<uint32_t>(value_list->size()));
+  }
+}
+
+template <typename KeyType>
+void HashIndex<KeyType>::CollectVisible(const transaction::TransactionContext &txn, const ValueType &value,
+                                        std::vector<TupleSlot> *value_list) {
+  if (std::holds_alternative<TupleSlot>(value)) {
+    const auto existing_location = std::get<TupleSlot>(value);
+    if (IsVisible(txn, existing_location)) value_list->emplace_back(existing_location);
+  } else {
+    const auto &value_map = std::get<ValueMap>(value);
+
+    for (const auto i : value_map) {
+      if (IsVisible(txn, i)) value_list->emplace_back(i);
+    }
+  }
+}
+
 #undef ERASE_KEY_ACTION
 
 template class HashIndex<HashKey<8>>;
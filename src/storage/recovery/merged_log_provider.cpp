@@ -0,0 +1,74 @@
+#include "storage/recovery/merged_log_provider.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/recovery/disk_log_provider.h"
+#include "storage/write_ahead_log/log_manager.h"
+
+namespace noisepage::storage {
+
+MergedLogProvider::MergedLogProvider(std::vector<std::unique_ptr<AbstractLogProvider>> providers) {
+  streams_.resize(providers.size());
+  for (uint32_t i = 0; i < providers.size(); i++) streams_[i].provider_ = std::move(providers[i]);
+}
+
+MergedLogProvider::MergedLogProvider(const std::string &log_file_path, const uint32_t num_streams) {
+  streams_.resize(num_streams);
+  for (uint32_t stream = 0; stream < num_streams; stream++) {
+    streams_[stream].provider_ =
+        std::make_unique<DiskLogProvider>(LogManager::LogFilePaths(log_file_path, stream));
+  }
+}
+
+void MergedLogProvider::ReadRun(Stream *const stream) {
+  while (true) {
+    auto record = stream->provider_->GetNextRecord();
+    if (record.first == nullptr) {
+      stream->exhausted_ = true;
+      return;
+    }
+    const bool is_commit = record.first->RecordType() == LogRecordType::COMMIT;
+    stream->run_.emplace_back(std::move(record));
+    if (is_commit) return;
+  }
+}
+
+bool MergedLogProvider::HasMoreRecords() {
+  for (auto &stream : streams_) {
+    if (stream.run_.empty() && !stream.exhausted_) ReadRun(&stream);
+    if (!stream.run_.empty()) return true;
+  }
+  return false;
+}
+
+std::pair<LogRecord *, std::vector<byte *>> MergedLogProvider::GetNextRecord() {
+  if (current_ == nullptr || current_->run_.empty()) {
+    // Pick the run that ends with the oldest commit. Runs that end without a commit record belong to transactions that
+    // never committed, and their order does not matter, so they go last.
+    current_ = nullptr;
+    uint64_t oldest_commit = std::numeric_limits<uint64_t>::max();
+    for (auto &stream : streams_) {
+      if (stream.run_.empty() && !stream.exhausted_) ReadRun(&stream);
+      if (stream.run_.empty()) continue;
+      auto *const last = stream.run_.back().first;
+      const uint64_t commit_time =
+          last->RecordType() == LogRecordType::COMMIT
+              ? last->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime().UnderlyingValue()
+              : std::numeric_limits<uint64_t>::max();
+      if (current_ == nullptr || commit_time < oldest_commit) {
+        current_ = &stream;
+        oldest_commit = commit_time;
+      }
+    }
+    if (current_ == nullptr) return {nullptr, std::vector<byte *>()};
+  }
+  auto result = std::move(current_->run_.front());
+  current_->run_.pop_front();
+  return result;
+}
+
+}  // namespace noisepage::storage
@@ -39,10 +39,43 @@ void RecoveryManager::WaitForRecoveryToFinish() {
   }
 }
 
+void RecoveryManager::Recover() {
+  if (replay_pool_ != nullptr) replay_pool_->Startup();
+  if (checkpoint_provider_ != nullptr) RecoverFromCheckpoint();
+  RecoverFromLogs();
+  if (replay_pool_ != nullptr) replay_pool_->Shutdown();
+}
+
+void RecoveryManager::RecoverFromCheckpoint() {
+  ReplayRecords(checkpoint_provider_, true);
+  // Every transaction of a checkpoint commits with no older active transaction, so it has been replayed right away
+  NOISEPAGE_ASSERT(deferred_txns_.empty() && buffered_changes_map_.empty(),
+                   "A checkpoint should not leave any transactions unprocessed");
+}
+
 void RecoveryManager::RecoverFromLogs() {
+  ReplayRecords(log_provider_, false);
+
+  // Process all deferred txns
+  recovered_txns_ += ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+  NOISEPAGE_ASSERT(deferred_txns_.empty() && replay_batch_.empty(),
+                   "We should have no unprocessed deferred transactions at the end of recovery");
+
+  // If we have unprocessed buffered changes, then these transactions were in-process at the time of system shutdown.
+  // They are unrecoverable, so we need to clean up the memory of their records.
+  if (!buffered_changes_map_.empty()) {
+    for (const auto &txn : buffered_changes_map_) {
+      DeferRecordDeletes(txn.first, true);
+    }
+    buffered_changes_map_.clear();
+  }
+}
+
+void RecoveryManager::ReplayRecords(const common::ManagedPointer<AbstractLogProvider> provider,
+                                    const bool from_checkpoint) {
   // Replay logs until the log provider no longer gives us logs
   while (true) {
-    auto pair = log_provider_->GetNextRecord();
+    auto pair = provider->GetNextRecord();
     auto *log_record = pair.first;
 
     // If we have exhausted all the logs, break from the loop
@@ -61,6 +94,18 @@ void RecoveryManager::RecoverFromLogs() {
         NOISEPAGE_ASSERT(pair.second.empty(), "Commit records should not have any varlen pointers");
         auto *commit_record = log_record->GetUnderlyingRecordBodyAs<CommitRecord>();
 
+        if (from_checkpoint) {
+          checkpoint_time_ = commit_record->CommitTime();
+        } else if (checkpoint_time_ != transaction::INVALID_TXN_TIMESTAMP &&
+                   commit_record->CommitTime() < checkpoint_time_) {
+          // The changes of the transaction are part of the checkpoint already. Some of its records may have been in log
+          // files that were removed after the checkpoint was taken.
+          DeferRecordDeletes(log_record->TxnBegin(), true);
+          buffered_changes_map_.erase(log_record->TxnBegin());
+          deferred_action_manager_->RegisterDeferredAction([=] { delete[] reinterpret_cast<byte *>(log_record); });
+          break;
+        }
+
         // We defer all transactions initially
         deferred_txns_.insert(log_record->TxnBegin());
 
@@ -79,19 +124,6 @@ void RecoveryManager::RecoverFromLogs() {
         buffered_changes_map_[log_record->TxnBegin()].push_back(pair);
     }
   }
-  // Process all deferred txns
-  ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
-  NOISEPAGE_ASSERT(deferred_txns_.empty(),
-                   "We should have no unprocessed deferred transactions at the end of recovery");
-
-  // If we have unprocessed buffered changes, then these transactions were in-process at the time of system shutdown.
-  // They are unrecoverable, so we need to clean up the memory of their records.
-  if (!buffered_changes_map_.empty()) {
-    for (const auto &txn : buffered_changes_map_) {
-      DeferRecordDeletes(txn.first, true);
-    }
-    buffered_changes_map_.clear();
-  }
 }
 
 void RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timestamp_t txn_id) {
@@ -140,21 +172,96 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(noisepage::transaction::ti
   auto txns_processed = 0;
   // If the upper bound is INVALID_TXN_TIMESTAMP, then we should process all deferred txns. We can accomplish this by
   // setting the upper bound to INT_MAX
-  upper_bound_ts =
-      (upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP) ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
+  const bool process_all = upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP;
+  upper_bound_ts = process_all ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
   auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
+  auto released = 0;
 
   for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-    ProcessCommittedTransaction(*it);
-    txns_processed++;
+    released++;
+    if (replay_pool_ == nullptr) {
+      ProcessCommittedTransaction(*it);
+      txns_processed++;
+    } else if (MustReplaySerially(*it)) {
+      // Catalog changes, and changes to several tables that must stay atomic, are replayed serially, after everything
+      // before them and before everything after them
+      txns_processed += ReplayBatch();
+      ProcessCommittedTransaction(*it);
+      txns_processed++;
+    } else {
+      replay_batch_.push_back(*it);
+      if (replay_batch_.size() >= REPLAY_BATCH_SIZE) txns_processed += ReplayBatch();
+    }
   }
+  if (process_all && replay_pool_ != nullptr) txns_processed += ReplayBatch();
 
-  // If we actually processed some txns, remove them from the set
-  if (txns_processed > 0) deferred_txns_.erase(deferred_txns_.begin(), upper_bound_it);
+  // If we actually released some txns, remove them from the set
+  if (released > 0) deferred_txns_.erase(deferred_txns_.begin(), upper_bound_it);
 
   return txns_processed;
 }
 
+bool RecoveryManager::MustReplaySerially(const transaction::timestamp_t txn_id) const {
+  const auto it = buffered_changes_map_.find(txn_id);
+  if (it == buffered_changes_map_.end() || it->second.empty()) return false;
+  const auto *const first_record = it->second.front().first;
+  return std::any_of(it->second.begin(), it->second.end(), [&](const auto &buffered_pair) {
+    const auto table_oid = GetTableOid(buffered_pair.first);
+    return IsCatalogTable(table_oid) || table_oid != GetTableOid(first_record) ||
+           GetDatabaseOid(buffered_pair.first) != GetDatabaseOid(first_record);
+  });
+}
+
+uint32_t RecoveryManager::ReplayBatch() {
+  if (replay_batch_.empty()) return 0;
+
+  // Split the transactions of the batch by the table they modified. Every partition holds the transactions on some
+  // tables, in serial order.
+  std::vector<std::vector<std::pair<transaction::timestamp_t, std::vector<LogRecord *>>>> partitions(
+      num_replay_threads_);
+  for (const auto txn_id : replay_batch_) {
+    NOISEPAGE_ASSERT(!MustReplaySerially(txn_id), "Only transactions on a single user table are replayed in parallel");
+    for (const auto &buffered_pair : buffered_changes_map_[txn_id]) {
+      auto *const record = buffered_pair.first;
+      auto &partition = partitions[GetTableOid(record).UnderlyingValue() % num_replay_threads_];
+      if (partition.empty() || partition.back().first != txn_id) {
+        partition.emplace_back(txn_id, std::vector<LogRecord *>());
+      }
+      partition.back().second.push_back(record);
+    }
+  }
+
+  // Replay every partition on its own thread, with one txn per transaction, which keeps it atomic and logged as one. A
+  // table is only ever modified by one thread, and every replayed txn begins after the previous one on the table
+  // committed, so the replayed changes never conflict.
+  for (const auto &partition : partitions) {
+    if (partition.empty()) continue;
+    replay_pool_->SubmitTask([this, &partition] {
+      for (const auto &txn_records : partition) {
+        auto *txn = txn_manager_->BeginTransaction();
+        for (auto *const record : txn_records.second) {
+          if (record->RecordType() == LogRecordType::REDO) {
+            ReplayRedoRecord(txn, record);
+          } else {
+            ReplayDeleteRecord(txn, record);
+          }
+        }
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      }
+    });
+  }
+  replay_pool_->WaitUntilAllFinished();
+
+  // Defer deletes of the log records
+  for (const auto txn_id : replay_batch_) {
+    DeferRecordDeletes(txn_id, false);
+    buffered_changes_map_.erase(txn_id);
+  }
+  const auto txns_replayed = static_cast<uint32_t>(replay_batch_.size());
+  replay_batch_.clear();
+  return txns_replayed;
+}
+
 void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record) {
   auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
   auto sql_table_ptr = GetSqlTable(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
@@ -175,9 +282,9 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
     NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                      "Insert should update redo record with new tuple slot");
     // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
-    tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
+    tuple_slot_map_.Insert(old_tuple_slot, new_tuple_slot);
   } else {
-    auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+    auto new_tuple_slot = GetTupleSlotMapping(redo_record->GetTupleSlot());
     redo_record->SetTupleSlot(new_tuple_slot);
     // Stage the write. This way the recovery operation is logged if logging is enabled
     auto staged_record = txn->StageRecoveryWrite(record);
@@ -191,7 +298,8 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
   // Get tuple slot
   auto new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, delete_record->GetDatabaseOid());
+  auto db_catalog_ptr =
+      GetDatabaseCatalog(txn, delete_record->GetDatabaseOid(), IsCatalogTable(delete_record->GetTableOid()));
   auto sql_table_ptr = db_catalog_ptr->GetTable(common::ManagedPointer(txn), delete_record->GetTableOid());
   const auto &schema = GetTableSchema(txn, db_catalog_ptr, delete_record->GetTableOid());
 
@@ -216,7 +324,7 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   UpdateIndexesOnTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), sql_table_ptr,
                        new_tuple_slot, pr, false /* delete */);
   // We can delete the TupleSlot from the map
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  tuple_slot_map_.Erase(delete_record->GetTupleSlot());
   delete[] buffer;
 }
 
@@ -224,7 +332,7 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
                                            catalog::table_oid_t table_oid,
                                            common::ManagedPointer<storage::SqlTable> table_ptr,
                                            const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
   // Stores index objects and schemas
   std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects;
@@ -474,7 +582,7 @@ uint32_t RecoveryManager::ProcessSpecialCasePGDatabaseRecord(
     std::vector<TupleSlot> tuple_slot_result;
     pg_database_oid_index->ScanKey(*txn, *pr, &tuple_slot_result);
     NOISEPAGE_ASSERT(tuple_slot_result.size() == 1, "Index scan should only yield one result");
-    tuple_slot_map_[redo_record->GetTupleSlot()] = tuple_slot_result[0];
+    tuple_slot_map_.Insert(redo_record->GetTupleSlot(), tuple_slot_result[0]);
     delete[] buffer;
 
     return 0;  // No additional records processed
@@ -539,9 +647,9 @@ uint32_t RecoveryManager::ProcessSpecialCasePGDatabaseRecord(
           std::vector<TupleSlot> tuple_slot_result;
           pg_database_oid_index->ScanKey(*txn, *pr, &tuple_slot_result);
           NOISEPAGE_ASSERT(tuple_slot_result.size() == 1, "Index scan should only yield one result");
-          tuple_slot_map_[next_redo_record->GetTupleSlot()] = tuple_slot_result[0];
+          tuple_slot_map_.Insert(next_redo_record->GetTupleSlot(), tuple_slot_result[0]);
           delete[] buffer;
-          tuple_slot_map_.erase(delete_record->GetTupleSlot());
+          tuple_slot_map_.Erase(delete_record->GetTupleSlot());
           delete[] reinterpret_cast<byte *>(next_redo_record);
 
           return 1;  // We processed an additional record
@@ -555,7 +663,7 @@ uint32_t RecoveryManager::ProcessSpecialCasePGDatabaseRecord(
   NOISEPAGE_ASSERT(result, "Database deletion should succeed");
 
   // Step 4: Clean up any metadata
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  tuple_slot_map_.Erase(delete_record->GetTupleSlot());
   return 0;  // No additional logs processed
 }
 
@@ -793,9 +901,9 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
           std::vector<TupleSlot> tuple_slot_result;
           pg_class_oid_index->ScanKey(*txn, *pr, &tuple_slot_result);
           NOISEPAGE_ASSERT(tuple_slot_result.size() == 1, "Index scan should only yield one result");
-          tuple_slot_map_[next_redo_record->GetTupleSlot()] = tuple_slot_result[0];
+          tuple_slot_map_.Insert(next_redo_record->GetTupleSlot(), tuple_slot_result[0]);
           delete[] buffer;
-          tuple_slot_map_.erase(delete_record->GetTupleSlot());
+          tuple_slot_map_.Erase(delete_record->GetTupleSlot());
           delete[] reinterpret_cast<byte *>(next_redo_record);
 
           return 1;  // We processed an additional record
@@ -823,7 +931,7 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
   NOISEPAGE_ASSERT(result, "Table/index DROP should always succeed");
 
   // Step 5: Clean up metadata
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  tuple_slot_map_.Erase(delete_record->GetTupleSlot());
 
   return 0;  // No additional logs processed
 }
@@ -835,7 +943,7 @@ common::ManagedPointer<storage::SqlTable> RecoveryManager::GetSqlTable(transacti
     return common::ManagedPointer(catalog_->databases_);
   }
 
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
   common::ManagedPointer<storage::SqlTable> table_ptr = nullptr;
 
@@ -1,5 +1,6 @@
 #include "storage/tuple_access_strategy.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "common/container/concurrent_bitmap.h"
@@ -33,6 +34,7 @@ void TupleAccessStrategy::InitializeRawBlock(storage::DataTable *const data_tabl
   raw->controller_.Initialize();
   auto *result = reinterpret_cast<TupleAccessStrategy::Block *>(raw);
   result->GetArrowBlockMetadata().Initialize(GetBlockLayout().NumColumns());
+  result->GetVersionSynopsis(layout_).Initialize();
   for (uint16_t i = 0; i < layout_.NumColumns(); i++) result->AttrOffsets(layout_)[i] = column_offsets_[i];
 
   result->SlotAllocationBitmap(layout_)->UnsafeClear(layout_.NumSlots());
@@ -61,4 +63,19 @@ bool TupleAccessStrategy::Allocate(RawBlock *const block, TupleSlot *const slot)
   block->insert_head_++;
   return true;
 }
+
+uint32_t TupleAccessStrategy::Allocate(RawBlock *const block, const uint32_t num_slots, TupleSlot *const slots) const {
+  common::RawConcurrentBitmap *bitmap = reinterpret_cast<Block *>(block)->SlotAllocationBitmap(layout_);
+  const uint32_t start = block->GetInsertHead();
+  const uint32_t num_allocated = std::min(num_slots, layout_.NumSlots() - start);
+
+  // Same assumption as above, no other thread inserts into the block, so the slots past the head are all free
+  for (uint32_t i = 0; i < num_allocated; i++) {
+    bool UNUSED_ATTRIBUTE flip_res = bitmap->Flip(start + i, false);
+    NOISEPAGE_ASSERT(flip_res, "Flip should always succeed");
+    slots[i] = TupleSlot(block, start + i);
+  }
+  block->insert_head_ += num_allocated;
+  return num_allocated;
+}
 }  // namespace noisepage::storage
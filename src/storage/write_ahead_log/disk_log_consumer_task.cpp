@@ -1,6 +1,11 @@
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <string>
 #include <thread>  // NOLINT
+#include <utility>
+#include <vector>
 
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
@@ -25,9 +30,11 @@ void DiskLogConsumerTask::Terminate() {
 void DiskLogConsumerTask::WriteBuffersToLogFile() {
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
+  const auto num_pending_commits = commit_callbacks_.size();
   while (!filled_buffer_queue_->Empty()) {
     // Dequeue filled buffers and flush them to disk, as well as storing commit callbacks
     filled_buffer_queue_->Dequeue(&logs);
+    num_buffers_written_++;
     if (logs.first != nullptr) {
       // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be invoked
       current_data_written_ += logs.first->FlushBuffer();
@@ -39,22 +46,91 @@ void DiskLogConsumerTask::WriteBuffersToLogFile() {
       empty_buffer_queue_->Enqueue(logs.first);
     }
   }
+  if (commit_callbacks_.size() > num_pending_commits) {
+    RecordCommitArrivals(commit_callbacks_.size() - num_pending_commits, Clock::now());
+  }
+}
+
+void DiskLogConsumerTask::RecordCommitArrivals(const uint64_t num_commits, const Clock::time_point now) {
+  if (commit_callbacks_.size() == num_commits) oldest_pending_commit_ = now;
+  if (last_commit_arrival_ != Clock::time_point()) {
+    // All commits that arrived in one go are spread evenly over the time since the last arrival
+    const double interarrival_us =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(now - last_commit_arrival_).count()) /
+        static_cast<double>(num_commits);
+    commit_interarrival_us_ = commit_interarrival_us_ < 0
+                                  ? interarrival_us
+                                  : (1 - ARRIVAL_SMOOTHING) * commit_interarrival_us_ +
+                                        ARRIVAL_SMOOTHING * interarrival_us;
+  }
+  last_commit_arrival_ = now;
+}
+
+void DiskLogConsumerTask::RecordFsyncLatency(const uint64_t latency_us) {
+  fsync_latencies_us_[next_fsync_latency_] = latency_us;
+  next_fsync_latency_ = (next_fsync_latency_ + 1) % NUM_FSYNC_LATENCY_SAMPLES;
+}
+
+std::chrono::microseconds DiskLogConsumerTask::P99FsyncLatency() const {
+  // With NUM_FSYNC_LATENCY_SAMPLES samples, the largest one is our estimate of the p99 fsync latency
+  return std::chrono::microseconds(*std::max_element(fsync_latencies_us_.cbegin(), fsync_latencies_us_.cend()));
+}
+
+std::chrono::microseconds DiskLogConsumerTask::GroupCommitWindowRemaining(const Clock::time_point now) const {
+  const auto waited = std::chrono::duration_cast<std::chrono::microseconds>(now - oldest_pending_commit_);
+  return std::max(commit_latency_target_ - P99FsyncLatency() - waited, std::chrono::microseconds(0));
+}
+
+bool DiskLogConsumerTask::ShouldPersistGroup(const Clock::time_point now) const {
+  if (commit_callbacks_.empty()) return false;
+  const auto remaining = GroupCommitWindowRemaining(now);
+  if (remaining.count() == 0) return true;
+  // Until we know the arrival rate, we have no reason to believe anyone will join the group
+  if (commit_interarrival_us_ < 0) return true;
+  // Only wait if the next commit is expected to show up before the window closes
+  const auto time_since_arrival = std::chrono::duration_cast<std::chrono::microseconds>(now - last_commit_arrival_);
+  const auto expected_next_arrival =
+      std::chrono::microseconds(static_cast<int64_t>(commit_interarrival_us_)) - time_since_arrival;
+  return expected_next_arrival >= remaining;
 }
 
 uint64_t DiskLogConsumerTask::PersistLogFile() {
+  // What the other streams had handed over before we persist, our commits may depend on any of it
+  std::vector<uint64_t> handed_over;
+  if (coordinator_ != nullptr) handed_over = coordinator_->HandedOverSnapshot();
   // buffers_ may be empty but we have callbacks to invoke due to read-only txns
   if (!buffers_->empty()) {
     // Force the buffers to be written to disk. Because all buffers log to the same file, it suffices to call persist on
     // any buffer.
+    const auto fsync_start = Clock::now();
     buffers_->front().Persist();
+    last_fsync_latency_us_ = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - fsync_start).count());
+    RecordFsyncLatency(last_fsync_latency_us_);
   }
   const auto num_buffers = commit_callbacks_.size();
-  // Execute the callbacks for the transactions that have been persisted
-  for (auto &callback : commit_callbacks_) callback.first(callback.second);
+  if (coordinator_ != nullptr) {
+    coordinator_->CommitsPersisted(stream_, num_buffers_written_, std::move(handed_over), std::move(commit_callbacks_),
+                                   &streams_to_wake_);
+  } else {
+    // Execute the callbacks for the transactions that have been persisted
+    for (auto &callback : commit_callbacks_) callback.first(callback.second);
+  }
   commit_callbacks_.clear();
   return num_buffers;
 }
 
+void DiskLogConsumerTask::RotateLogFile() {
+  if (!buffers_->empty()) {
+    // Everything written so far is persisted, and buffers handed over later are flushed to the new log file
+    if (std::rename(buffers_->front().LogFilePath().c_str(), rotate_log_file_path_.c_str()) == -1) {
+      throw std::runtime_error("Failed to rotate log file with errno " + std::to_string(errno));
+    }
+    for (auto &buffer : *buffers_) buffer.Reopen();
+  }
+  rotate_log_file_path_.clear();
+}
+
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // input for this operating unit
   uint64_t num_bytes = 0, num_buffers = 0;
@@ -66,7 +142,8 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   auto next_sleep = curr_sleep;
   const std::chrono::microseconds max_sleep = std::chrono::microseconds(10000);
   // Time since last log file persist
-  auto last_persist = std::chrono::high_resolution_clock::now();
+  auto last_persist = Clock::now();
+  if (coordinator_ != nullptr) coordinator_->RegisterConsumer(stream_, &persist_lock_, &disk_log_writer_thread_cv_);
   // Disk log consumer task thread spins in this loop. When notified or periodically, we wake up and process serialized
   // buffers
   do {
@@ -88,9 +165,14 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       // 2) There is a filled buffer to write to the disk
       // 3) LogManager has shut down the task
       // 4) Our persist interval timed out
-
-      bool signaled = disk_log_writer_thread_cv_.wait_for(
-          lock, curr_sleep, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
+      // 5) The group commit window of the pending commits closed
+      // 6) Commits of another log stream are waiting for this stream to persist
+      const auto wait = GroupCommitEnabled() && !commit_callbacks_.empty()
+                            ? std::min(curr_sleep, GroupCommitWindowRemaining(Clock::now()))
+                            : curr_sleep;
+      bool signaled = disk_log_writer_thread_cv_.wait_for(lock, wait, [&] {
+        return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_ || PersistRequested();
+      });
       next_sleep = signaled ? persist_interval_ : curr_sleep * 2;
       next_sleep = std::min(next_sleep, max_sleep);
     }
@@ -99,25 +181,36 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     WriteBuffersToLogFile();
 
     // We persist the log file if the following conditions are met
-    // 1) The persist interval amount of time has passed since the last persist
+    // 1) The persist interval amount of time has passed since the last persist, or in group commit mode, the group of
+    //    pending commits is ready to be persisted
     // 2) We have written more data since the last persist than the threshold
-    // 3) We are signaled to persist
+    // 3) We are signaled to persist, either by the log manager or on behalf of another log stream
     // 4) We are shutting down this task
-    bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
-                                                                         last_persist) > curr_sleep;
+    const auto now = Clock::now();
+    bool timeout = GroupCommitEnabled()
+                       ? ShouldPersistGroup(now)
+                       : std::chrono::duration_cast<std::chrono::microseconds>(now - last_persist) > curr_sleep;
 
-    if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_) {
+    const bool persist_requested = coordinator_ != nullptr && coordinator_->TakePersistRequest(stream_);
+
+    if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || persist_requested || !run_task_) {
       std::unique_lock<std::mutex> lock(persist_lock_);
       num_buffers = PersistLogFile();
       num_bytes = current_data_written_;
+      if (logging_metrics_enabled && num_buffers > 0) {
+        common::thread_context.metrics_store_->RecordGroupCommitData(num_buffers, last_fsync_latency_us_);
+      }
       // Reset meta data
-      last_persist = std::chrono::high_resolution_clock::now();
+      last_persist = Clock::now();
       current_data_written_ = 0;
+      if (!rotate_log_file_path_.empty()) RotateLogFile();
       force_flush_ = false;
 
       // Signal anyone who forced a persist that the persist has finished
       persist_cv_.notify_all();
     }
+    // Wake up the streams our commits are waiting on, now that we no longer hold our latch
+    if (coordinator_ != nullptr) coordinator_->WakeConsumers(&streams_to_wake_);
 
     if (logging_metrics_enabled && num_buffers > 0) {
       // Stop the resource tracker for this operating unit
@@ -131,5 +224,9 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // Be extra sure we processed everything
   WriteBuffersToLogFile();
   PersistLogFile();
+  if (coordinator_ != nullptr) {
+    coordinator_->WakeConsumers(&streams_to_wake_);
+    coordinator_->RegisterConsumer(stream_, nullptr, nullptr);
+  }
 }
 }  // namespace noisepage::storage
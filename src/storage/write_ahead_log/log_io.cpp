@@ -39,6 +39,19 @@ void PosixIoWrappers::WriteFully(int fd, const void *buf, size_t nbyte) {
   }
 }
 
+void PosixIoWrappers::SyncParentDirectory(const std::string &file_path) {
+  const auto separator = file_path.find_last_of('/');
+  const std::string directory =
+      separator == std::string::npos ? "." : file_path.substr(0, std::max<size_t>(separator, 1));
+  const int fd = Open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fsync(fd) == -1) {
+    const auto error = errno;
+    Close(fd);
+    throw std::runtime_error("fsync of directory failed with errno " + std::to_string(error));
+  }
+  Close(fd);
+}
+
 bool BufferedLogReader::Read(void *dest, uint32_t size) {
   if (read_head_ + size <= filled_size_) {
     // bytes to read are already buffered.
@@ -61,11 +74,17 @@ void BufferedLogReader::RefillBuffer() {
   NOISEPAGE_ASSERT(read_head_ == filled_size_, "Refilling a buffer that is not fully read results in loss of data");
   if (in_ == -1) throw std::runtime_error("No more bytes left in the log file");
   read_head_ = 0;
-  filled_size_ = PosixIoWrappers::ReadFully(in_, buffer_, common::Constants::LOG_BUFFER_SIZE);
-  if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
-    // TODO(Tianyu): Is it better to make this an explicit close?
-    PosixIoWrappers::Close(in_);
-    in_ = -1;
+  filled_size_ = 0;
+  while (filled_size_ < common::Constants::LOG_BUFFER_SIZE && in_ != -1) {
+    filled_size_ +=
+        PosixIoWrappers::ReadFully(in_, buffer_ + filled_size_, common::Constants::LOG_BUFFER_SIZE - filled_size_);
+    if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
+      // TODO(Tianyu): Is it better to make this an explicit close?
+      PosixIoWrappers::Close(in_);
+      // The log continues in the next file, if there is one
+      in_ = next_file_ < log_file_paths_.size() ? PosixIoWrappers::Open(log_file_paths_[next_file_++].c_str(), O_RDONLY)
+                                                : -1;
+    }
   }
 }
 
@@ -1,6 +1,16 @@
 #include "storage/write_ahead_log/log_manager.h"
 
+#include <dirent.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "common/dedicated_thread_registry.h"
+#include "common/hash_util.h"
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_serializer_task.h"
 #include "transaction/transaction_context.h"
@@ -9,37 +19,131 @@ namespace noisepage::storage {
 
 void LogManager::Start() {
   NOISEPAGE_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
-  // Initialize buffers for logging
-  for (size_t i = 0; i < num_buffers_; i++) {
-    buffers_.emplace_back(BufferedLogWriter(log_file_path_.c_str()));
-  }
-  for (size_t i = 0; i < num_buffers_; i++) {
-    empty_buffer_queue_.Enqueue(&buffers_[i]);
+  if (num_streams_ > 1) coordinator_ = std::make_unique<LogStreamCoordinator>(num_streams_);
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    streams_.emplace_back(std::make_unique<LogStream>());
+    auto *const log_stream = streams_.back().get();
+    // Initialize buffers for logging
+    const auto stream_file_path = StreamLogFilePath(log_file_path_, stream);
+    for (size_t i = 0; i < num_buffers_; i++) {
+      log_stream->buffers_.emplace_back(BufferedLogWriter(stream_file_path.c_str()));
+    }
+    for (size_t i = 0; i < num_buffers_; i++) {
+      log_stream->empty_buffer_queue_.Enqueue(&log_stream->buffers_[i]);
+    }
   }
 
   run_log_manager_ = true;
 
-  // Register DiskLogConsumerTask
-  disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
-      this /* requester */, persist_interval_, persist_threshold_, &buffers_, &empty_buffer_queue_,
-      &filled_buffer_queue_);
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    auto *const log_stream = streams_[stream].get();
+    // Register DiskLogConsumerTask
+    log_stream->disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
+        this /* requester */, persist_interval_, persist_threshold_, &log_stream->buffers_,
+        &log_stream->empty_buffer_queue_, &log_stream->filled_buffer_queue_, commit_latency_target_,
+        coordinator_.get(), stream);
 
-  // Register LogSerializerTask
-  log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
-      this /* requester */, serialization_interval_, buffer_pool_, &empty_buffer_queue_, &filled_buffer_queue_,
-      &disk_log_writer_task_->disk_log_writer_thread_cv_);
+    // Register LogSerializerTask
+    log_stream->log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
+        this /* requester */, serialization_interval_, buffer_pool_, &log_stream->empty_buffer_queue_,
+        &log_stream->filled_buffer_queue_, &log_stream->disk_log_writer_task_->disk_log_writer_thread_cv_,
+        coordinator_.get(), stream);
+  }
 }
 
 void LogManager::ForceFlush() {
-  // Force the serializer task to serialize buffers
-  log_serializer_task_->Process();
-  // Signal the disk log consumer task thread to persist the buffers to disk
-  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
-  disk_log_writer_task_->force_flush_ = true;
-  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
-
-  // Wait for the disk log consumer task thread to persist the logs
-  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->force_flush_; });
+  for (const auto &log_stream : streams_) {
+    // Force the serializer task to serialize buffers
+    log_stream->log_serializer_task_->Process();
+  }
+  for (const auto &log_stream : streams_) {
+    // Signal the disk log consumer task thread to persist the buffers to disk
+    const auto disk_log_writer_task = log_stream->disk_log_writer_task_;
+    std::unique_lock<std::mutex> lock(disk_log_writer_task->persist_lock_);
+    disk_log_writer_task->force_flush_ = true;
+    disk_log_writer_task->disk_log_writer_thread_cv_.notify_one();
+
+    // Wait for the disk log consumer task thread to persist the logs
+    disk_log_writer_task->persist_cv_.wait(lock, [&] { return !disk_log_writer_task->force_flush_; });
+  }
+}
+
+uint64_t LogManager::RotateLogFiles() {
+  NOISEPAGE_ASSERT(run_log_manager_, "Can't rotate the log files of an un-started LogManager");
+  std::unique_lock<std::mutex> guard(rotation_latch_);
+  // The new segment comes after every segment of any stream, so the segments of all streams share their numbers
+  uint64_t segment = 0;
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    const auto segments = ListLogSegments(StreamLogFilePath(log_file_path_, stream));
+    if (!segments.empty()) segment = std::max(segment, segments.back().first);
+  }
+  segment++;
+
+  for (const auto &log_stream : streams_) {
+    // Force the serializer task to serialize buffers
+    log_stream->log_serializer_task_->Process();
+  }
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    // Signal the disk log consumer task thread to persist the buffers and move the log file away
+    const auto disk_log_writer_task = streams_[stream]->disk_log_writer_task_;
+    std::unique_lock<std::mutex> lock(disk_log_writer_task->persist_lock_);
+    disk_log_writer_task->rotate_log_file_path_ =
+        LogSegmentFilePath(StreamLogFilePath(log_file_path_, stream), segment);
+    disk_log_writer_task->force_flush_ = true;
+    disk_log_writer_task->disk_log_writer_thread_cv_.notify_one();
+
+    // Wait for the disk log consumer task thread to persist and rotate the log file
+    disk_log_writer_task->persist_cv_.wait(lock, [&] { return !disk_log_writer_task->force_flush_; });
+  }
+  // The log files of all streams are in the same directory. Persist their renames, so that a crash cannot lose a log
+  // segment that a checkpoint taken after this relies on
+  PosixIoWrappers::SyncParentDirectory(log_file_path_);
+  return segment;
+}
+
+void LogManager::RemoveLogSegments(const uint64_t last_segment) {
+  for (uint32_t stream = 0; stream < num_streams_; stream++) {
+    for (const auto &segment : ListLogSegments(StreamLogFilePath(log_file_path_, stream))) {
+      if (segment.first > last_segment) break;
+      if (std::remove(segment.second.c_str()) == -1) {
+        throw std::runtime_error("Failed to remove log segment with errno " + std::to_string(errno));
+      }
+    }
+  }
+}
+
+std::vector<std::string> LogManager::LogFilePaths(const std::string &log_file_path, const uint32_t stream) {
+  const auto stream_log_file_path = StreamLogFilePath(log_file_path, stream);
+  std::vector<std::string> result;
+  for (auto &segment : ListLogSegments(stream_log_file_path)) result.emplace_back(std::move(segment.second));
+  result.emplace_back(stream_log_file_path);
+  return result;
+}
+
+std::vector<std::pair<uint64_t, std::string>> LogManager::ListLogSegments(const std::string &stream_log_file_path) {
+  const auto separator = stream_log_file_path.find_last_of('/');
+  const std::string directory =
+      separator == std::string::npos ? "." : stream_log_file_path.substr(0, std::max<size_t>(separator, 1));
+  const std::string prefix =
+      LogSegmentFilePath(separator == std::string::npos ? stream_log_file_path
+                                                        : stream_log_file_path.substr(separator + 1),
+                         0);
+  const auto prefix_length = prefix.size() - 1;  // Without the segment number
+
+  std::vector<std::pair<uint64_t, std::string>> result;
+  DIR *const dir = opendir(directory.c_str());
+  if (dir == nullptr) return result;
+  for (const dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    const std::string name(entry->d_name);
+    if (name.size() <= prefix_length || name.compare(0, prefix_length, prefix, 0, prefix_length) != 0) continue;
+    const auto number = name.substr(prefix_length);
+    if (!std::all_of(number.begin(), number.end(), [](const char c) { return c >= '0' && c <= '9'; })) continue;
+    const auto path = separator == std::string::npos ? name : stream_log_file_path.substr(0, separator + 1) + name;
+    result.emplace_back(std::stoull(number), path);
+  }
+  closedir(dir);
+  std::sort(result.begin(), result.end());
+  return result;
 }
 
 void LogManager::PersistAndStop() {
@@ -48,28 +152,47 @@ void LogManager::PersistAndStop() {
 
   // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to the
   // log file, and persisted. The order in which we shut down the tasks is important, we must first serialize, then
-  // shutdown the disk consumer task (reverse order of Start())
-  auto result UNUSED_ATTRIBUTE =
-      thread_registry_->StopTask(this, log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
-
-  result = thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
-  NOISEPAGE_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
-
-  // Close the buffers corresponding to the log file
-  for (auto buf : buffers_) {
-    buf.Close();
+  // shutdown the disk consumer task (reverse order of Start()). With multiple log streams, all serializers must be
+  // stopped before the first consumer, so that the last persist of every consumer covers everything that the commits of
+  // other streams may depend on.
+  for (const auto &log_stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, log_stream->log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
   }
-  // Clear buffer queues
-  empty_buffer_queue_.Clear();
-  filled_buffer_queue_.Clear();
-  buffers_.clear();
+
+  for (const auto &log_stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, log_stream->disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
+    NOISEPAGE_ASSERT(log_stream->filled_buffer_queue_.Empty(),
+                     "disk log consumer task should have processed all filled buffers\n");
+
+    // Close the buffers corresponding to the log file
+    for (auto buf : log_stream->buffers_) {
+      buf.Close();
+    }
+  }
+  // Clear buffer queues along with the streams
+  streams_.clear();
+  coordinator_.reset();
 }
 
 void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment) {
   NOISEPAGE_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-  log_serializer_task_->AddBufferToFlushQueue(buffer_segment);
+  StreamForBuffer(buffer_segment)->log_serializer_task_->AddBufferToFlushQueue(buffer_segment);
+}
+
+LogManager::LogStream *LogManager::StreamForBuffer(RecordBufferSegment *const buffer_segment) {
+  if (num_streams_ == 1) return streams_.front().get();
+  // A redo buffer only ever holds records of the transaction that owns it, so all buffers of a transaction end up in
+  // the same stream and keep their order. An empty buffer carries nothing to serialize and can go anywhere.
+  IterableBufferSegment<LogRecord> records(buffer_segment);
+  if (records.begin() == records.end()) return streams_.front().get();
+  // Begin and commit timestamps come from the same counter, so begin timestamps tend to share their low bits. Mix them
+  // first, or some streams would sit idle.
+  const auto txn_begin = static_cast<uint64_t>(records.begin()->TxnBegin().UnderlyingValue());
+  return streams_[common::HashUtil::ScrambleHash(txn_begin) % num_streams_].get();
 }
 
 }  // namespace noisepage::storage
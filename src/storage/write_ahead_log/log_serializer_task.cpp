@@ -110,8 +110,8 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::Process() {
     // Mark the last buffer that was written to as full
     if (buffers_processed) HandFilledBufferToWriter();
 
-    // Bulk remove all the transactions we serialized. This prevents having to take the TimestampManager's latch once
-    // for each timestamp we remove.
+    // Bulk remove all the transactions we serialized. This prevents having to take the latch of a TimestampManager
+    // shard once for each timestamp we remove.
     for (const auto &txns : serialized_txns_) {
       txns.first->RemoveTransactions(txns.second);
     }
@@ -138,6 +138,7 @@ BufferedLogWriter *LogSerializerTask::GetCurrentWriteBuffer() {
 void LogSerializerTask::HandFilledBufferToWriter() {
   // Hand over the filled buffer
   filled_buffer_queue_->Enqueue(std::make_pair(filled_buffer_, commits_in_buffer_));
+  if (coordinator_ != nullptr) coordinator_->BufferHandedOver(stream_);
   // Signal disk log consumer task thread that a buffer has been handed over
   disk_log_writer_thread_cv_->notify_one();
   // Mark that the task doesn't have a buffer in its possession to which it can write to
@@ -186,95 +187,7 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
 }
 
 uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord &record) {
-  uint64_t num_bytes = 0;
-  // First, serialize out fields common across all LogRecordType's.
-
-  // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the size
-  // of any potential varlen entries. It is logically different from the size of the serialized record, which the log
-  // manager generates in this function. In particular, the later value is very likely to be strictly smaller when the
-  // LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log record of
-  // this size.
-  num_bytes += WriteValue(record.Size());
-
-  num_bytes += WriteValue(record.RecordType());
-  num_bytes += WriteValue(record.TxnBegin());
-
-  switch (record.RecordType()) {
-    case LogRecordType::REDO: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
-
-      auto *delta = record_body->Delta();
-      // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
-      // ProjectedRowInitializer from these ids and their corresponding block layout.
-      num_bytes += WriteValue(delta->NumColumns());
-      num_bytes += WriteValue(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
-
-      // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
-      // layout
-      const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
-      uint16_t boundaries[NUM_ATTR_BOUNDARIES];
-      memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-      StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
-      WriteValue(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-
-      // Write out the null bitmap.
-      num_bytes += WriteValue(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
-
-      // Write out attribute values
-      for (uint16_t i = 0; i < delta->NumColumns(); i++) {
-        const auto *column_value_address = delta->AccessWithNullCheck(i);
-        if (column_value_address == nullptr) {
-          // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap contains all
-          // the relevant information.
-          continue;
-        }
-        // Get the column id of the current column in the ProjectedRow.
-        col_id_t col_id = delta->ColumnIds()[i];
-
-        if (block_layout.IsVarlen(col_id)) {
-          // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
-          const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
-          // Serialize out length of the varlen entry.
-          num_bytes += WriteValue(varlen_entry->Size());
-          if (varlen_entry->IsInlined()) {
-            // Serialize out the prefix of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Prefix(), varlen_entry->Size());
-          } else {
-            // Serialize out the content field of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Content(), varlen_entry->Size());
-          }
-        } else {
-          // Inline column value is the actual data we want to serialize out.
-          // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive offsets
-          // of the delta record, we avoid serializing out any potential padding.
-          num_bytes += WriteValue(column_value_address, block_layout.AttrSize(col_id));
-        }
-      }
-      break;
-    }
-    case LogRecordType::DELETE: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
-      break;
-    }
-    case LogRecordType::COMMIT: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
-      num_bytes += WriteValue(record_body->CommitTime());
-      num_bytes += WriteValue(record_body->OldestActiveTxn());
-      break;
-    }
-    case LogRecordType::ABORT: {
-      // AbortRecord does not hold any additional metadata
-      break;
-    }
-  }
-
-  return num_bytes;
+  return SerializeRecord(record, [this](const void *val, const uint32_t size) { return WriteValue(val, size); });
 }
 
 uint32_t LogSerializerTask::WriteValue(const void *val, const uint32_t size) {
@@ -0,0 +1,69 @@
+#include "storage/write_ahead_log/log_stream_coordinator.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace noisepage::storage {
+
+std::vector<uint64_t> LogStreamCoordinator::HandedOverSnapshot() const {
+  std::vector<uint64_t> result;
+  result.reserve(handed_over_.size());
+  for (const auto &count : handed_over_) result.push_back(count.load());
+  return result;
+}
+
+void LogStreamCoordinator::RegisterConsumer(const uint32_t stream, std::mutex *const latch,
+                                            std::condition_variable *const wakeup) {
+  std::unique_lock<std::mutex> guard(wakeups_latch_);
+  wakeups_[stream] = {latch, wakeup};
+}
+
+void LogStreamCoordinator::WakeConsumers(std::vector<uint32_t> *const to_wake) {
+  if (to_wake->empty()) return;
+  std::unique_lock<std::mutex> guard(wakeups_latch_);
+  for (const auto stream : *to_wake) {
+    const auto &[latch, wakeup] = wakeups_[stream];
+    if (wakeup == nullptr) continue;
+    // Notify with the consumer's latch held, otherwise the request could slip in between its check and its wait
+    std::unique_lock<std::mutex> consumer_guard(*latch);
+    wakeup->notify_one();
+  }
+  to_wake->clear();
+}
+
+void LogStreamCoordinator::CommitsPersisted(const uint32_t stream, const uint64_t num_persisted,
+                                            std::vector<uint64_t> &&handed_over,
+                                            std::vector<CommitCallback> &&callbacks,
+                                            std::vector<uint32_t> *const to_wake) {
+  std::vector<CommitCallback> durable;
+  {
+    std::unique_lock<std::mutex> guard(latch_);
+    NOISEPAGE_ASSERT(num_persisted >= persisted_[stream], "Consumers never persist fewer buffers than before");
+    persisted_[stream] = num_persisted;
+    // Buffers of this stream that were handed over after the consumer took its batch are not needed by the batch
+    handed_over[stream] = std::min(handed_over[stream], num_persisted);
+    if (!callbacks.empty()) pending_.push_back({std::move(handed_over), std::move(callbacks)});
+
+    // This persist may be the last one some pending batches of any stream were waiting for
+    for (auto it = pending_.begin(); it != pending_.end();) {
+      bool caught_up = true;
+      for (uint32_t other = 0; other < persisted_.size(); other++) {
+        if (persisted_[other] >= it->handed_over_[other]) continue;
+        caught_up = false;
+        // Ask the stream to persist, it might be idle and not persist on its own for a while
+        if (!persist_requested_[other].exchange(true)) to_wake->push_back(other);
+      }
+      if (caught_up) {
+        durable.insert(durable.end(), it->callbacks_.begin(), it->callbacks_.end());
+        it = pending_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  // Execute the callbacks for the transactions that are now durable
+  for (auto &callback : durable) callback.first(callback.second);
+}
+
+}  // namespace noisepage::storage
@@ -0,0 +1,234 @@
+#include "traffic_cop/plan_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "libpg_query/pg_query.h"
+#include "network/postgres/statement.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/parameter_value_expression.h"
+#include "parser/insert_statement.h"
+#include "parser/parse_result.h"
+#include "parser/select_statement.h"
+#include "parser/update_statement.h"
+#include "spdlog/fmt/fmt.h"
+#include "transaction/transaction_util.h"
+#include "xxHash/xxh3.h"
+
+namespace noisepage::trafficcop {
+
+namespace {
+
+// A literal of the statement, along with the expression it is a child of (if any) to swap it for a parameter.
+struct Literal {
+  common::ManagedPointer<parser::ConstantValueExpression> value_;
+  common::ManagedPointer<parser::AbstractExpression> parent_;
+  uint32_t child_idx_;
+  bool parameterize_;
+};
+
+bool IsComparison(const parser::ExpressionType type) {
+  switch (type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void CollectLiterals(const common::ManagedPointer<parser::AbstractExpression> expr, std::vector<Literal> *literals) {
+  for (uint32_t i = 0; i < expr->GetChildrenSize(); i++) {
+    const auto child = expr->GetChild(i);
+    if (child->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT) {
+      // Literals compared against anything but another literal take their type from the other side in the binder.
+      const bool parameterize = IsComparison(expr->GetExpressionType()) && expr->GetChildrenSize() == 2 &&
+                                expr->GetChild(1 - i)->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT;
+      literals->push_back({child.CastManagedPointerTo<parser::ConstantValueExpression>(), expr, i, parameterize});
+    }
+    CollectLiterals(child, literals);
+  }
+}
+
+void AppendLiteral(const parser::ConstantValueExpression &value, const bool parameterize, std::string *key) {
+  key->append(fmt::format("|{}", static_cast<int>(value.GetReturnValueType())));
+  if (parameterize) return;
+  if (value.IsNull()) {
+    key->append("=null");
+    return;
+  }
+  const auto str = value.ToString();
+  key->append(fmt::format("={}:{}", str.size(), str));
+}
+
+}  // namespace
+
+bool PlanCache::ParameterizeQuery(const std::string &query_text,
+                                  const common::ManagedPointer<parser::ParseResult> parse_result,
+                                  std::vector<parser::ConstantValueExpression> *params, std::string *key) {
+  if (parse_result->GetStatements().size() != 1) return false;
+  const auto statement = parse_result->GetStatement(0);
+  const auto type = statement->GetType();
+  if (type != parser::StatementType::SELECT && type != parser::StatementType::INSERT &&
+      type != parser::StatementType::UPDATE && type != parser::StatementType::DELETE) {
+    return false;
+  }
+  // Every literal of the normalized text becomes a placeholder, so existing ones would be ambiguous.
+  if (query_text.find('$') != std::string::npos) return false;
+
+  // Normalizing replaces every literal of the query text, wherever it occurs, with a numbered placeholder.
+  const PgQueryNormalizeResult normalized = pg_query_normalize(query_text.c_str());
+  if (normalized.error != nullptr) {
+    pg_query_free_normalize_result(normalized);
+    return false;
+  }
+  std::string normalized_text(normalized.normalized_query);
+  pg_query_free_normalize_result(normalized);
+
+  // Values of INSERT and UPDATE are the top-level expressions that are parameterized.
+  std::unordered_set<const parser::AbstractExpression *> value_roots;
+  if (type == parser::StatementType::INSERT) {
+    const auto values = statement.CastManagedPointerTo<parser::InsertStatement>()->GetValues();
+    if (values != nullptr) {
+      for (const auto &tuple : *values) {
+        for (const auto &value : tuple) value_roots.insert(value.Get());
+      }
+    }
+  } else if (type == parser::StatementType::UPDATE) {
+    for (const auto &clause : statement.CastManagedPointerTo<parser::UpdateStatement>()->GetUpdateClauses()) {
+      value_roots.insert(clause->GetUpdateValue().Get());
+    }
+  }
+
+  // Every literal the parser turned into an expression is owned by a top-level expression of the parse result.
+  std::vector<Literal> literals;
+  for (const auto &expr : parse_result->GetExpressions()) {
+    if (expr->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT) {
+      literals.push_back({expr.CastManagedPointerTo<parser::ConstantValueExpression>(), nullptr, 0,
+                          value_roots.count(expr.Get()) > 0});
+    }
+    CollectLiterals(expr, &literals);
+  }
+
+  std::string limit_key;
+  uint64_t num_literals = literals.size();
+  if (type == parser::StatementType::SELECT) {
+    const auto limit = statement.CastManagedPointerTo<parser::SelectStatement>()->GetSelectLimit();
+    if (limit != nullptr) {
+      num_literals += (limit->GetLimit() != parser::LimitDescription::NO_LIMIT ? 1 : 0) +
+                      (limit->GetOffset() != parser::LimitDescription::NO_OFFSET ? 1 : 0);
+      limit_key = fmt::format("|limit={},{}", limit->GetLimit(), limit->GetOffset());
+    }
+  }
+
+  // The literals of the text that are not found in the statement are not covered by the key, so give up on them.
+  if (static_cast<uint64_t>(std::count(normalized_text.begin(), normalized_text.end(), '$')) != num_literals) {
+    return false;
+  }
+
+  *key = std::move(normalized_text);
+  params->clear();
+  for (auto &literal : literals) {
+    literal.parameterize_ = literal.parameterize_ && !literal.value_->IsNull();
+    AppendLiteral(*literal.value_, literal.parameterize_, key);
+  }
+  key->append(limit_key);
+
+  for (const auto &literal : literals) {
+    if (!literal.parameterize_) continue;
+    const auto param_idx = static_cast<uint32_t>(params->size());
+    params->emplace_back(*literal.value_);
+    if (literal.parent_ != nullptr) {
+      parser::ParameterValueExpression param(param_idx);
+      literal.parent_->SetChild(static_cast<int>(literal.child_idx_),
+                                common::ManagedPointer(&param).CastManagedPointerTo<parser::AbstractExpression>());
+      continue;
+    }
+
+    // Top-level values are referenced by the statement itself.
+    auto param = std::make_unique<parser::ParameterValueExpression>(param_idx);
+    const auto param_ptr = common::ManagedPointer(param).CastManagedPointerTo<parser::AbstractExpression>();
+    parse_result->AddExpression(std::move(param));
+    const auto old_value = literal.value_.CastManagedPointerTo<parser::AbstractExpression>();
+    if (type == parser::StatementType::INSERT) {
+      for (auto &tuple : *statement.CastManagedPointerTo<parser::InsertStatement>()->GetValues()) {
+        std::replace(tuple.begin(), tuple.end(), old_value, param_ptr);
+      }
+    } else {
+      for (const auto &clause : statement.CastManagedPointerTo<parser::UpdateStatement>()->GetUpdateClauses()) {
+        if (clause->GetUpdateValue() == old_value) clause->ResetValue(param_ptr);
+      }
+    }
+  }
+  return true;
+}
+
+std::size_t PlanCache::CacheKeyHasher::operator()(const CacheKey &key) const {
+  return XXH3_64bits_withSeed(key.query_key_.data(), key.query_key_.length(), key.db_oid_.UnderlyingValue());
+}
+
+std::shared_ptr<network::Statement> PlanCache::Lookup(const catalog::db_oid_t db_oid, const std::string &key,
+                                                      const transaction::timestamp_t catalog_version) {
+  std::shared_ptr<network::Statement> stale;  // released outside of the latch
+  std::lock_guard<std::mutex> guard(latch_);
+  const auto it = entries_.find({db_oid, key});
+  if (it == entries_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  const auto entry = it->second;
+  if (entry->catalog_version_ != catalog_version) {
+    // A statement planned against an older catalog is never valid again, one planned against a newer catalog is still
+    // valid for newer transactions.
+    if (transaction::TransactionUtil::NewerThan(catalog_version, entry->catalog_version_)) {
+      stale = std::move(entry->statement_);
+      entries_.erase(it);
+      lru_.erase(entry);
+      invalidations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  lru_.splice(lru_.begin(), lru_, entry);
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return entry->statement_;
+}
+
+void PlanCache::Insert(const catalog::db_oid_t db_oid, const std::string &key,
+                       const transaction::timestamp_t catalog_version, std::shared_ptr<network::Statement> statement) {
+  if (capacity_ == 0) return;
+  std::vector<std::shared_ptr<network::Statement>> evicted;  // released outside of the latch
+  std::lock_guard<std::mutex> guard(latch_);
+  CacheKey cache_key{db_oid, key};
+  const auto it = entries_.find(cache_key);
+  if (it != entries_.end()) {
+    // Another connection may have planned the same query against a newer catalog in the meantime.
+    if (!transaction::TransactionUtil::NewerThan(catalog_version, it->second->catalog_version_)) return;
+    evicted.emplace_back(std::move(it->second->statement_));
+    lru_.erase(it->second);
+    entries_.erase(it);
+  }
+
+  lru_.push_front({cache_key, catalog_version, std::move(statement)});
+  entries_.emplace(std::move(cache_key), lru_.begin());
+
+  while (lru_.size() > capacity_) {
+    auto &victim = lru_.back();
+    evicted.emplace_back(std::move(victim.statement_));
+    entries_.erase(victim.key_);
+    lru_.pop_back();
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace noisepage::trafficcop
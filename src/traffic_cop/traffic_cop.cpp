@@ -443,8 +443,15 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
 
   const auto exec_query = portal->GetStatement()->GetExecutableQuery();
 
+  // Executable queries of statements that are not retained in a cache never run again, so they are not worth compiling
+  // in the background.
+  const bool reused = use_query_cache_ && portal->GetStatement()->IsRetained();
+  const auto execution_mode = execution_mode_ == execution::vm::ExecutionMode::Adaptive && !reused
+                                  ? execution::vm::ExecutionMode::Interpret
+                                  : execution_mode_;
+
   try {
-    exec_query->Run(common::ManagedPointer(exec_ctx), execution_mode_);
+    exec_query->Run(common::ManagedPointer(exec_ctx), execution_mode);
   } catch (ExecutionException &e) {
     /*
      * An ExecutionException is thrown in the case of some failure caused by a software bug or caused by some data
@@ -1,31 +1,94 @@
 #include "transaction/timestamp_manager.h"
 
 #include <algorithm>
+#include <functional>
+#include <thread>  // NOLINT
 #include <vector>
 
 namespace noisepage::transaction {
 
+timestamp_t TimestampManager::BeginTransaction() {
+  // There is a three-way race that needs to be prevented.  Specifically, we cannot allow both a transaction to commit
+  // and the GC to poll for the oldest running transaction in between this transaction acquiring its begin timestamp
+  // and getting inserted into the current running transactions.  Announcing a lower bound of the begin timestamp in a
+  // begin slot until the transaction is in its shard covers that window, without a latch shared by all transactions.
+  BeginSlot &slot = ClaimBeginSlot();
+  const timestamp_t start_time = time_++;
+  {
+    Shard &shard = shards_[ShardIndex(start_time)];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    const auto ret UNUSED_ATTRIBUTE = shard.running_txns_.emplace(start_time);
+    NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
+  }
+  slot.lower_bound_.store(INVALID_TXN_TIMESTAMP);
+  return start_time;
+}
+
+TimestampManager::BeginSlot &TimestampManager::ClaimBeginSlot() {
+  // Start probing at a slot picked by the thread, so that threads beginning transactions at the same time rarely probe
+  // the same slots
+  auto index = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()) % NUM_BEGIN_SLOTS);
+  while (true) {
+    BeginSlot &slot = begin_slots_[index];
+    timestamp_t expected = INVALID_TXN_TIMESTAMP;
+    // The time is read before the slot is claimed, so it is no later than the start time checked out afterwards
+    if (slot.lower_bound_.load() == INVALID_TXN_TIMESTAMP &&
+        slot.lower_bound_.compare_exchange_strong(expected, time_.load())) {
+      return slot;
+    }
+    index = (index + 1) % NUM_BEGIN_SLOTS;
+  }
+}
+
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Any transaction that has not claimed a begin slot by the time the slots are read checks out a start time that is no
+  // older than this
+  timestamp_t result = time_.load();
+  // A transaction that frees its begin slot before it is read is already in its shard when the shards are read
+  for (const auto &slot : begin_slots_) {
+    const timestamp_t lower_bound = slot.lower_bound_.load();
+    if (lower_bound != INVALID_TXN_TIMESTAMP) result = std::min(result, lower_bound);
+  }
+  for (auto &shard : shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    const auto &oldest_txn = std::min_element(shard.running_txns_.cbegin(), shard.running_txns_.cend());
+    if (oldest_txn != shard.running_txns_.cend()) result = std::min(result, *oldest_txn);
+  }
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
 
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
+void TimestampManager::RefreshCachedOldestTransactionStartTime() {
+  timestamp_t last_refresh = last_cache_refresh_time_.load();
+  const timestamp_t now = time_.load();
+  if (now.UnderlyingValue() - last_refresh.UnderlyingValue() < CACHE_REFRESH_INTERVAL) return;
+  // Whoever moves the refresh time forward recomputes the timestamp, everyone else keeps going
+  if (!last_cache_refresh_time_.compare_exchange_strong(last_refresh, now)) return;
+  OldestTransactionStartTime();
+}
+
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
+  Shard &shard = shards_[ShardIndex(timestamp)];
+  common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+  const size_t ret UNUSED_ATTRIBUTE = shard.running_txns_.erase(timestamp);
   NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
 }
 
 void TimestampManager::RemoveTransactions(const std::vector<noisepage::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Group the timestamps by shard, so every shard is latched once
+  std::vector<timestamp_t> sorted(timestamps);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const timestamp_t a, const timestamp_t b) { return ShardIndex(a) < ShardIndex(b); });
+  for (auto run_begin = sorted.cbegin(); run_begin != sorted.cend();) {
+    const uint32_t shard_index = ShardIndex(*run_begin);
+    Shard &shard = shards_[shard_index];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    for (; run_begin != sorted.cend() && ShardIndex(*run_begin) == shard_index; run_begin++) {
+      const size_t ret UNUSED_ATTRIBUTE = shard.running_txns_.erase(*run_begin);
+      NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+    }
   }
 }
 
@@ -1,5 +1,7 @@
 #include "execution/compiler/compiler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -8,6 +10,7 @@
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/constants.h"
 #include "execution/ast/ast_dump.h"
 #include "execution/ast/context.h"
 #include "execution/compiler/compilation_context.h"
@@ -39,6 +42,9 @@
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
 #include "type/type_id.h"
 
 namespace noisepage::execution::compiler::test {
@@ -1064,6 +1070,80 @@ TEST_F(CompilerTest, CountStarTest) {
   multi_checker.CheckCorrectness();
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, AdaptiveCountStarTest) {
+  // SELECT COUNT(*) FROM test_1;
+  // Run adaptively until the query is compiled in the background, after which it runs compiled.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto schema = seq_scan_out.MakeSchema();
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(nullptr)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Make the aggregate
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    // Add aggregates
+    agg_out.AddAggTerm("count_star", expr_maker.AggCount(expr_maker.Star()));
+    // Make the output expressions
+    agg_out.AddOutput("count_star", agg_out.GetAggTermForOutput("count_star"));
+    auto schema = agg_out.MakeSchema();
+    // Build
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddAggregateTerm(agg_out.GetAggTerm("count_star"))
+              .AddChild(std::move(seq_scan))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+
+  auto compile_ctx = MakeExecCtx();
+  auto executable = execution::compiler::CompilationContext::Compile(*agg, compile_ctx->GetExecutionSettings(),
+                                                                     compile_ctx->GetAccessor());
+
+  // Run & Check, returning the execution mode the query ran with.
+  auto run = [&]() {
+    NumChecker num_checker{1};
+    SingleIntComparisonChecker count_checker{std::equal_to<>(), 0, sql::TEST1_SIZE};
+    MultiChecker multi_checker{std::vector<OutputChecker *>{&num_checker, &count_checker}};
+    OutputStore store{&multi_checker, agg->GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+    auto exec_ctx = MakeExecCtx(&callback_fn, agg->GetOutputSchema().Get());
+    executable->Run(common::ManagedPointer(exec_ctx), vm::ExecutionMode::Adaptive);
+    multi_checker.CheckCorrectness();
+    return static_cast<vm::ExecutionMode>(exec_ctx->GetExecutionMode());
+  };
+
+  // The compilation is triggered by the number of interpreted runs at the latest.
+  for (uint64_t i = 0; i < common::Constants::ADAPTIVE_COMPILE_RUNS && !executable->IsCompiledToMachineCode(); i++) {
+    EXPECT_EQ(run(), vm::ExecutionMode::Interpret);
+  }
+  EXPECT_LE(executable->GetNumInterpretedRuns(), common::Constants::ADAPTIVE_COMPILE_RUNS);
+
+  // Keep interpreting while the compilation is in progress.
+  while (!executable->IsCompiledToMachineCode()) {
+    EXPECT_EQ(run(), vm::ExecutionMode::Interpret);
+  }
+  const auto num_interpreted_runs = executable->GetNumInterpretedRuns();
+  EXPECT_EQ(run(), vm::ExecutionMode::Compiled);
+  EXPECT_EQ(executable->GetNumInterpretedRuns(), num_interpreted_runs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, StaticAggregateTest) {
   // SELECT COUNT(*), SUM(cola) FROM test_1;
@@ -1847,6 +1927,198 @@ TEST_F(CompilerTest, SimpleSortTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec1, exp_vec1));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, WindowTest) {
+  // SELECT col1, col2, ROW_NUMBER() OVER w, RANK() OVER w, DENSE_RANK() OVER w, SUM(col1) OVER w
+  // FROM test_1 WHERE col1 < 3000 WINDOW w AS (PARTITION BY col2 ORDER BY col1 / 10 DESC)
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    seq_scan_out.AddOutput("col2", col2);
+    auto schema = seq_scan_out.MakeSchema();
+    // Make predicate
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(3000));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Window
+  std::unique_ptr<planner::AbstractPlanNode> window;
+  OutputSchemaHelper window_out{0, &expr_maker};
+  {
+    auto col1 = seq_scan_out.GetOutput("col1");
+    auto col2 = seq_scan_out.GetOutput("col2");
+    auto sum = expr_maker.AggSum(col1);
+    // Output columns col1, col2, then the window terms
+    window_out.AddOutput("col1", col1);
+    window_out.AddOutput("col2", col2);
+    window_out.AddOutput("row_number", expr_maker.DVE(type::TypeId::BIGINT, 1, 0));
+    window_out.AddOutput("rank", expr_maker.DVE(type::TypeId::BIGINT, 1, 1));
+    window_out.AddOutput("dense_rank", expr_maker.DVE(type::TypeId::BIGINT, 1, 2));
+    window_out.AddOutput("sum", expr_maker.DVE(sum->GetReturnValueType(), 1, 3));
+    auto schema = window_out.MakeSchema();
+    // Build
+    planner::WindowPlanNode::Builder builder;
+    window = builder.SetOutputSchema(std::move(schema))
+                 .AddChild(std::move(seq_scan))
+                 .AddPartitionKey(col2)
+                 .AddSortKey(expr_maker.OpDiv(col1, expr_maker.Constant(10)), optimizer::OrderByOrderingType::DESC)
+                 .AddWindowTerm(planner::WindowFunctionType::ROW_NUMBER)
+                 .AddWindowTerm(planner::WindowFunctionType::RANK)
+                 .AddWindowTerm(planner::WindowFunctionType::DENSE_RANK)
+                 .AddWindowTerm(sum)
+                 .Build();
+  }
+  // Checkers:
+  // There should be 3000 output rows, where col1 < 3000, grouped by col2 and sorted by col1 / 10 DESC.
+  // Rows with the same col1 / 10 in a partition are peers: they share their rank and the running sum.
+  struct WindowRow {
+    int64_t col1_, col2_, row_number_, rank_, dense_rank_, sum_;
+  };
+  std::vector<WindowRow> rows;
+  RowChecker row_checker = [&rows](const std::vector<sql::Val *> &vals) {
+    std::vector<int64_t> row;
+    for (auto *val : vals) {
+      auto *integer = static_cast<sql::Integer *>(val);
+      ASSERT_FALSE(integer->is_null_);
+      row.push_back(integer->val_);
+    }
+    rows.push_back({row[0], row[1], row[2], row[3], row[4], row[5]});
+  };
+  CorrectnessFn correctness_fn = [&rows]() {
+    ASSERT_EQ(rows.size(), 3000);
+    for (uint64_t begin = 0, end = 0; begin < rows.size(); begin = end) {
+      // Find the partition.
+      while (end < rows.size() && rows[end].col2_ == rows[begin].col2_) end++;
+      if (end < rows.size()) ASSERT_LT(rows[begin].col2_, rows[end].col2_);
+      int64_t sum = 0, dense_rank = 0;
+      for (uint64_t peers_begin = begin, peers_end = begin; peers_begin < end; peers_begin = peers_end) {
+        // Find the peer group and its contribution to the running sum.
+        const int64_t key = rows[peers_begin].col1_ / 10;
+        while (peers_end < end && rows[peers_end].col1_ / 10 == key) sum += rows[peers_end++].col1_;
+        if (peers_end < end) ASSERT_GT(key, rows[peers_end].col1_ / 10);
+        dense_rank++;
+        for (uint64_t i = peers_begin; i < peers_end; i++) {
+          ASSERT_EQ(static_cast<int64_t>(i - begin + 1), rows[i].row_number_);
+          ASSERT_EQ(static_cast<int64_t>(peers_begin - begin + 1), rows[i].rank_);
+          ASSERT_EQ(dense_rank, rows[i].dense_rank_);
+          ASSERT_EQ(sum, rows[i].sum_);
+        }
+      }
+    }
+  };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  // Create exec ctx
+  OutputStore store{&checker, window->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(window->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, window->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*window, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, WindowPipelineMetricsTest) {
+  // SELECT col1, row_number() OVER w FROM test_1 WHERE col1 < 500 WINDOW w AS (ORDER BY col1)
+  // The window records sort features, which must have been registered for its pipelines.
+  EnableCounters();
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    auto schema = seq_scan_out.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Window
+  std::unique_ptr<planner::AbstractPlanNode> window;
+  OutputSchemaHelper window_out{0, &expr_maker};
+  {
+    auto col1 = seq_scan_out.GetOutput("col1");
+    window_out.AddOutput("col1", col1);
+    window_out.AddOutput("row_number", expr_maker.DVE(type::TypeId::BIGINT, 1, 0));
+    auto schema = window_out.MakeSchema();
+    planner::WindowPlanNode::Builder builder;
+    window = builder.SetOutputSchema(std::move(schema))
+                 .AddChild(std::move(seq_scan))
+                 .AddSortKey(col1, optimizer::OrderByOrderingType::ASC)
+                 .AddWindowTerm(planner::WindowFunctionType::ROW_NUMBER)
+                 .Build();
+  }
+  // Checkers: 500 rows numbered in col1 order
+  uint32_t num_output_rows{0};
+  RowChecker row_checker = [&num_output_rows](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto row_number = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_ || row_number->is_null_);
+    ASSERT_EQ(col1->val_ + 1, row_number->val_);
+    num_output_rows++;
+  };
+  CorrectnessFn correctness_fn = [&num_output_rows]() { ASSERT_EQ(num_output_rows, 500); };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  // Create exec ctx
+  OutputStore store{&checker, window->GetOutputSchema().Get()};
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, window->GetOutputSchema().Get());
+  ASSERT_TRUE(exec_ctx->GetExecutionSettings().GetIsCountersEnabled());
+  ASSERT_TRUE(exec_ctx->GetExecutionSettings().GetIsPipelineMetricsEnabled());
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*window, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+
+  // Pipeline Units
+  auto pipeline = executable->GetPipelineOperatingUnits();
+  EXPECT_EQ(pipeline->units_.size(), 2);
+
+  auto has_feature = [&pipeline](execution::pipeline_id_t pipeline_id, selfdriving::ExecutionOperatingUnitType type) {
+    const auto &features = pipeline->GetPipelineFeatures(pipeline_id);
+    return std::any_of(features.cbegin(), features.cend(),
+                       [type](const auto &feature) { return feature.GetExecutionOperatingUnitType() == type; });
+  };
+  EXPECT_TRUE(has_feature(execution::pipeline_id_t(1), selfdriving::ExecutionOperatingUnitType::SORT_ITERATE));
+  EXPECT_TRUE(has_feature(execution::pipeline_id_t(2), selfdriving::ExecutionOperatingUnitType::SORT_BUILD));
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SortWithLimitTest) {
   // SELECT col1, col2, col1 + col2 FROM test_1 WHERE col1 < 500 ORDER BY col2 ASC, col1 - col2 DESC LIMIT 10
@@ -2502,6 +2774,86 @@ TEST_F(CompilerTest, SimpleIndexNestedLoopJoinMultiColumnTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, ParallelIndexNestedLoopJoinTest) {
+  // SELECT t1.colA, t2.colA FROM test_1 AS t1 INNER JOIN test_1 AS t2 ON t1.colA=t2.colA
+  // The outer scan runs in parallel and the exact lookups are batched, so every thread is left with a partial batch
+  // that it flushes at the end of its work.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+
+  // Make the seq scan: Here test_1 is the outer table
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+    auto table_schema1 = accessor->GetSchema(table_oid1);
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    auto schema = seq_scan_out.MakeSchema();
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(nullptr)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid1)
+                   .Build();
+  }
+  // Make index join
+  std::unique_ptr<planner::AbstractPlanNode> index_join;
+  OutputSchemaHelper index_join_out{0, &expr_maker};
+  {
+    auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+    auto table_schema1 = accessor->GetSchema(table_oid1);
+    auto index_oid1 = accessor->GetIndexOid(NSOid(), "index_1");
+    auto t1_col1 = seq_scan_out.GetOutput("col1");
+    auto t2_col1 = expr_maker.CVE(table_schema1.GetColumn("colA").Oid(), type::TypeId::INTEGER);
+    // Output Schema
+    index_join_out.AddOutput("t1.col1", t1_col1);
+    index_join_out.AddOutput("t2.col1", t2_col1);
+    auto schema = index_join_out.MakeSchema();
+    // Build
+    planner::IndexJoinPlanNode::Builder builder;
+    index_join = builder.AddChild(std::move(seq_scan))
+                     .SetIndexOid(index_oid1)
+                     .SetTableOid(table_oid1)
+                     .AddLoIndexColumn(catalog::indexkeycol_oid_t(1), t1_col1)
+                     .AddHiIndexColumn(catalog::indexkeycol_oid_t(1), t1_col1)
+                     .SetScanType(planner::IndexScanType::Exact)
+                     .SetOutputSchema(std::move(schema))
+                     .SetJoinType(planner::LogicalJoinType::INNER)
+                     .SetJoinPredicate(nullptr)
+                     .Build();
+  }
+  // Compile and Run
+  // Every tuple of test_1 matches exactly itself
+  std::atomic<uint32_t> num_output_rows{0};
+  RowChecker row_checker = [&num_output_rows](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+    ASSERT_EQ(col1->val_, col2->val_);
+    num_output_rows++;
+  };
+  CorrectnessFn correctness_fn = [&num_output_rows]() { ASSERT_EQ(num_output_rows, sql::TEST1_SIZE); };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  // Make Exec Ctx
+  OutputStore store{&checker, index_join->GetOutputSchema().Get()};
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, index_join->GetOutputSchema().Get());
+  ASSERT_TRUE(exec_ctx->GetExecutionSettings().GetIsParallelQueryExecutionEnabled());
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*index_join, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleDeleteTest) {
   // DELETE FROM test_1 WHERE colA BETWEEN 495 AND 505
@@ -3006,6 +3358,64 @@ TEST_F(CompilerTest, SimpleInsertTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, InsertUniqueViolationInBatchTest) {
+  // CREATE TABLE unique_table (id INTEGER); CREATE UNIQUE INDEX unique_index ON unique_table (id);
+  // INSERT INTO unique_table (id) VALUES (1), (2), (1), (3), (4)
+  // The duplicate falls in the same batch of the batched inserter as the key it duplicates, and must still abort the
+  // transaction at the row that causes it.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+
+  std::vector<catalog::Schema::Column> cols;
+  cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto table_oid = accessor->CreateTable(NSOid(), "unique_table", catalog::Schema(cols));
+  const auto &table_schema = accessor->GetSchema(table_oid);
+  EXPECT_TRUE(accessor->SetTablePointer(table_oid, new storage::SqlTable(BlockStore(), table_schema)));
+
+  auto id_oid = table_schema.GetColumn("id").Oid();
+  std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+      "id", type::TypeId::INTEGER, false, parser::ColumnValueExpression(test_db_oid_, table_oid, id_oid)}};
+  auto index_oid =
+      accessor->CreateIndex(NSOid(), table_oid, "unique_index",
+                            catalog::IndexSchema(key_cols, storage::index::IndexType::BWTREE, true, true, false, true));
+  storage::index::IndexBuilder index_builder;
+  index_builder.SetKeySchema(accessor->GetIndexSchema(index_oid));
+  EXPECT_TRUE(accessor->SetIndexPointer(index_oid, index_builder.Build()));
+
+  // make InsertPlanNode
+  std::unique_ptr<planner::AbstractPlanNode> insert;
+  {
+    planner::InsertPlanNode::Builder builder;
+    builder.AddParameterInfo(id_oid);
+    for (int32_t id : {1, 2, 1, 3, 4}) {
+      std::vector<ExpressionMaker::ManagedExpression> values;
+      values.push_back(expr_maker.Constant(id));
+      builder.AddValues(std::move(values));
+    }
+    insert = builder.SetIndexOids({index_oid})
+                 .SetTableOid(table_oid)
+                 .SetOutputSchema(std::make_unique<planner::OutputSchema>())
+                 .Build();
+  }
+
+  // Execute insert
+  {
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{}};
+    exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+    auto exec_ctx = MakeExecCtx(&callback_fn, insert->GetOutputSchema().Get());
+    auto executable = execution::compiler::CompilationContext::Compile(*insert, exec_ctx->GetExecutionSettings(),
+                                                                       exec_ctx->GetAccessor());
+    executable->Run(common::ManagedPointer(exec_ctx), MODE);
+
+    // The duplicate is the third row, and the rows after it are never inserted.
+    EXPECT_TRUE(test_txn_->MustAbort());
+    EXPECT_EQ(exec_ctx->RowsAffected(), 3);
+  }
+
+  AbortTestTxn();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, DISABLED_InsertIntoSelectWithParamTest) {
   // TODO(WAN): insert into select doesn't work yet in TPL2
@@ -5,6 +5,7 @@
 
 #include "catalog/catalog_defs.h"
 #include "execution/sql/table_vector_iterator.h"
+#include "execution/sql/thread_state_container.h"
 #include "execution/sql_test.h"
 #include "execution/util/timer.h"
 
@@ -108,6 +109,51 @@ TEST_F(IndexIteratorTest, SimpleAscendingScanTest) {
   ASSERT_EQ(num_matches, 11);
 }
 
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorTest, ParallelAscendingScanTest) {
+  //
+  // Scan the whole index, splitting the matches between threads
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  std::array<uint32_t, 1> col_oids{1};
+  IndexIterator index_iter{exec_ctx_.get(),
+                           1,
+                           table_oid.UnderlyingValue(),
+                           index_oid.UnderlyingValue(),
+                           col_oids.data(),
+                           static_cast<uint32_t>(col_oids.size())};
+  index_iter.Init();
+  auto *const lo_pr(index_iter.LoPR());
+  auto *const hi_pr(index_iter.HiPR());
+  lo_pr->Set<int32_t, false>(0, 0, false);
+  hi_pr->Set<int32_t, false>(0, static_cast<int32_t>(TEST1_SIZE - 1), false);
+  index_iter.ScanAscending(storage::index::ScanType::Closed, 0);
+
+  // Every thread counts the tuples it scanned
+  ThreadStateContainer container(exec_ctx_->GetMemoryPool());
+  container.Reset(
+      sizeof(uint32_t), [](UNUSED_ATTRIBUTE void *ctx, void *s) { *reinterpret_cast<uint32_t *>(s) = 0; }, nullptr,
+      nullptr);
+
+  // Every range is a contiguous run of keys
+  const auto scan_fn = [](UNUSED_ATTRIBUTE void *query_state, void *thread_state, IndexIterator *iter) {
+    int32_t prev_match = -1;
+    while (iter->Advance()) {
+      auto *val = iter->TablePR()->Get<int32_t, false>(0, nullptr);
+      if (prev_match != -1) EXPECT_EQ(prev_match + 1, *val);
+      prev_match = *val;
+      (*reinterpret_cast<uint32_t *>(thread_state))++;
+    }
+  };
+  index_iter.ParallelScan(nullptr, &container, scan_fn);
+
+  uint32_t num_matches = 0;
+  container.ForEach<uint32_t>([&](const uint32_t *count) { num_matches += *count; });
+  ASSERT_EQ(num_matches, TEST1_SIZE);
+}
+
 // NOLINTNEXTLINE
 TEST_F(IndexIteratorTest, SimpleLimitAscendingScanTest) {
   //
@@ -438,4 +438,78 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SpilledParallelAggregationTest) {
+  // Each thread-local table alone exceeds the budget, as do the spilled partitions when loaded
+  SetQueryMemoryBudget(1024 * 1024);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  struct QueryState {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint32_t> bad_aggs_;
+  };
+
+  QueryState query_state{0, 0};
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+  container.Reset(
+      sizeof(AggregationHashTable),
+      [](void *ctx, void *aht) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+      },
+      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+
+  // Every thread aggregates every key once
+  constexpr uint32_t num_aggs = 100000;
+  constexpr uint32_t num_threads = 4;
+  LaunchParallel(num_threads, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+    for (uint32_t idx = 0; idx < num_aggs; idx++) {
+      InputTuple input(idx, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->AllocInputTuplePartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+  });
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  main_table.TransferMemoryAndPartitions(
+      &container, 0, [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+        for (; iter->HasNext(); iter->Next()) {
+          auto *partial_agg = iter->GetRowAs<AggTuple>();
+          auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+          if (existing != nullptr) {
+            existing->Merge(*partial_agg);
+          } else {
+            table->Insert(iter->GetEntryForRow());
+          }
+        }
+      });
+  EXPECT_TRUE(main_table.IsSpilled());
+
+  // The spilled thread-local tables hold on to no memory
+  container.Clear();
+
+  main_table.ExecuteParallelPartitionedScan(
+      &query_state, &container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+        auto *qs = reinterpret_cast<QueryState *>(query_state);
+        qs->row_count_ += agg_table->GetTupleCount();
+        for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+          auto *agg = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+          if (agg->count1_ != num_threads) qs->bad_aggs_++;
+        }
+      });
+
+  EXPECT_EQ(num_aggs, query_state.row_count_.load());
+  EXPECT_EQ(0u, query_state.bad_aggs_.load());
+  EXPECT_LE(exec_ctx->GetReservedMemory(), 1024u * 1024u);
+}
+
 }  // namespace noisepage::execution::sql
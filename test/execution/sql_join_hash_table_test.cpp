@@ -1,12 +1,18 @@
 #include <tbb/tbb.h>
 
+#include <algorithm>
+#include <limits>
 #include <random>
 #include <vector>
 
 #include "common/hash_util.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/sql/join_hash_table.h"
+#include "execution/sql/operators/hash_operators.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql/vector_projection.h"
 #include "execution/sql_test.h"
 
 // TODO(WAN): can't FRIEND_TEST unless in the same namespace
@@ -135,6 +141,42 @@ void BuildAndProbeTest(exec::ExecutionContext *exec_ctx, uint32_t num_tuples, ui
   }
 }
 
+template <bool UseCHT>
+void LookupBatchTest(exec::ExecutionContext *exec_ctx, uint32_t num_tuples, uint32_t dup_scale_factor) {
+  JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple), UseCHT);
+  PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+  join_hash_table.Build();
+
+  // Probe half hits and half misses, skipping every third probe through the filter
+  const uint32_t num_probes = 2 * num_tuples;
+  Vector hashes(TypeId::Hash, true, false);
+  hashes.Resize(num_probes);
+  auto *raw_hashes = reinterpret_cast<hash_t *>(hashes.GetData());
+  TupleIdList tids(num_probes);
+  for (uint32_t i = 0; i < num_probes; i++) {
+    raw_hashes[i] = Tuple{i, 0, 0, 0}.Hash();
+    if (i % 3 != 0) tids.Add(i);
+  }
+  hashes.SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+
+  Vector results(TypeId::Pointer, true, false);
+  join_hash_table.LookupBatch(hashes, &results);
+
+  // The entries found in the batch lead to the same matches as a lookup one at a time
+  auto *raw_results = reinterpret_cast<const HashTableEntry **>(results.GetData());
+  EXPECT_EQ(tids.GetTupleCount(), results.GetCount());
+  tids.ForEach([&](const uint64_t i) {
+    uint32_t count = 0;
+    for (HashTableEntryIterator iter(raw_results[i], raw_hashes[i]); iter.HasNext();) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+      if (matched->a_ == i) {
+        count++;
+      }
+    }
+    EXPECT_EQ(i < num_tuples ? dup_scale_factor : 0u, count) << "Key [" << i << "] found " << count << " matches";
+  });
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, UniqueKeyLookupTest) {
   auto exec_ctx = MakeExecCtx();
@@ -159,6 +201,73 @@ TEST_F(JoinHashTableTest, DuplicateKeyLookupConciseTableTest) {
   BuildAndProbeTest<true>(exec_ctx.get(), 400, 5);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, LookupBatchTest) {
+  auto exec_ctx = MakeExecCtx();
+  LookupBatchTest<false>(exec_ctx.get(), 1000, 3);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, LookupBatchConciseTableTest) {
+  auto exec_ctx = MakeExecCtx();
+  LookupBatchTest<true>(exec_ctx.get(), 1000, 3);
+}
+
+// Look up keys [0, num_probes) in a batch, skipping every third key through the filter. Returns the entry
+// found for every probe, and null for the skipped ones.
+std::vector<const HashTableEntry *> LookupBatchResults(const JoinHashTable &join_hash_table, uint32_t num_probes) {
+  Vector hashes(TypeId::Hash, true, false);
+  hashes.Resize(num_probes);
+  auto *raw_hashes = reinterpret_cast<hash_t *>(hashes.GetData());
+  TupleIdList tids(num_probes);
+  for (uint32_t i = 0; i < num_probes; i++) {
+    raw_hashes[i] = Tuple{i, 0, 0, 0}.Hash();
+    if (i % 3 != 0) tids.Add(i);
+  }
+  hashes.SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+
+  Vector results(TypeId::Pointer, true, false);
+  join_hash_table.LookupBatch(hashes, &results);
+  auto *raw_results = reinterpret_cast<const HashTableEntry **>(results.GetData());
+  std::vector<const HashTableEntry *> entries(num_probes, nullptr);
+  tids.ForEach([&](const uint64_t i) { entries[i] = raw_results[i]; });
+  return entries;
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PrefetchingLookupBatchTest) {
+  auto exec_ctx = MakeExecCtx();
+  JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false);
+  PopulateJoinHashTable(&join_hash_table, 1000, 3);
+  join_hash_table.Build();
+
+  // Without prefetching, prefetching the build tuples only, and prefetching from both the
+  // index and the build tuples, the batch finds the same entries.
+  join_hash_table.prefetch_threshold_ = std::numeric_limits<uint64_t>::max();
+  const auto expected = LookupBatchResults(join_hash_table, 2000);
+  EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [](const auto *entry) { return entry != nullptr; }));
+  join_hash_table.prefetch_threshold_ = join_hash_table.GetJoinIndexMemoryUsage();
+  EXPECT_EQ(expected, LookupBatchResults(join_hash_table, 2000));
+  join_hash_table.prefetch_threshold_ = 0;
+  EXPECT_EQ(expected, LookupBatchResults(join_hash_table, 2000));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PrefetchingLookupBatchConciseTableTest) {
+  auto exec_ctx = MakeExecCtx();
+  JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), true);
+  PopulateJoinHashTable(&join_hash_table, 1000, 3);
+  join_hash_table.Build();
+
+  join_hash_table.prefetch_threshold_ = std::numeric_limits<uint64_t>::max();
+  const auto expected = LookupBatchResults(join_hash_table, 2000);
+  EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [](const auto *entry) { return entry != nullptr; }));
+  join_hash_table.prefetch_threshold_ = join_hash_table.GetJoinIndexMemoryUsage();
+  EXPECT_EQ(expected, LookupBatchResults(join_hash_table, 2000));
+  join_hash_table.prefetch_threshold_ = 0;
+  EXPECT_EQ(expected, LookupBatchResults(join_hash_table, 2000));
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, ParallelBuildTest) {
   auto exec_ctx = MakeExecCtx();
@@ -217,6 +326,278 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PartitionedParallelBuildTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec::ExecutionSettings exec_settings{};
+  tbb::task_scheduler_init sched;
+
+  const uint32_t num_tuples = 10000;
+  const uint32_t num_thread_local_tables = 4;
+  const uint32_t radix_bits = 4;
+
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+
+  struct Context {
+    exec::ExecutionContext *exec_ctx_;
+    exec::ExecutionSettings *settings_;
+  };
+
+  Context ctx{exec_ctx.get(), &exec_settings};
+
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) {
+        auto context = reinterpret_cast<Context *>(ctx);
+        new (s) JoinHashTable(*context->settings_, context->exec_ctx_, sizeof(Tuple), false);
+      },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, &ctx);
+
+  LaunchParallel(num_thread_local_tables, [&](auto tid) {
+    auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+    PopulateJoinHashTable(jht, num_tuples, 1);
+  });
+
+  // Small inputs never pick the partitioned merge on their own, so force it
+  std::vector<JoinHashTable *> tl_join_tables;
+  container.CollectThreadLocalStateElementsAs(&tl_join_tables, 0);
+
+  JoinHashTable main_jht(exec_settings, exec_ctx.get(), sizeof(Tuple), false);
+  main_jht.MergePartitioned(&container, tl_join_tables, radix_bits);
+
+  EXPECT_TRUE(main_jht.IsPartitioned());
+  EXPECT_EQ(1u << radix_bits, main_jht.GetNumPartitions());
+  EXPECT_EQ(num_tuples * num_thread_local_tables, main_jht.GetTupleCount());
+
+  // Every key finds all its duplicates in the partition its hash routes to
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto probe = Tuple{i, 1, 2, 3};
+    uint32_t count = 0;
+    for (auto iter = main_jht.Lookup<false>(probe.Hash()); iter.HasNext();) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+      if (matched->a_ == probe.a_) {
+        count++;
+      }
+    }
+    EXPECT_EQ(num_thread_local_tables, count);
+  }
+
+  for (uint32_t i = num_tuples; i < num_tuples + 1000; i++) {
+    auto probe = Tuple{i, 1, 2, 3};
+    for (auto iter = main_jht.Lookup<false>(probe.Hash()); iter.HasNext();) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+      EXPECT_NE(probe.a_, matched->a_);
+    }
+  }
+}
+
+// Join the spilled partitions of the given table, counting the build matches of every probe key
+void JoinSpilledPartitions(exec::ExecutionContext *exec_ctx, JoinHashTable *jht, uint64_t budget,
+                           std::vector<uint32_t> *match_counts, uint32_t *num_partitions) {
+  while (jht->LoadNextSpilledPartition()) {
+    (*num_partitions)++;
+    EXPECT_LE(exec_ctx->GetReservedMemory(), budget);
+    for (auto *probe = reinterpret_cast<const Tuple *>(jht->NextSpilledProbeTuple()); probe != nullptr;
+         probe = reinterpret_cast<const Tuple *>(jht->NextSpilledProbeTuple())) {
+      for (auto iter = jht->Lookup<false>(probe->Hash()); iter.HasNext();) {
+        auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+        if (matched->a_ == probe->a_) {
+          (*match_counts)[probe->a_]++;
+        }
+      }
+    }
+  }
+  // All memory is given back once the last partition is joined
+  EXPECT_EQ(0u, exec_ctx->GetReservedMemory());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpilledBuildTest) {
+  // Less than a single reservation, so the table spills right away. The partitions
+  // are then too large as well, and are partitioned once more.
+  const uint64_t budget = 256 * 1024;
+  SetQueryMemoryBudget(budget);
+  auto exec_ctx = MakeExecCtx();
+
+  const uint32_t num_tuples = 100000;
+  const uint32_t num_misses = 1000;
+  const uint32_t dup_scale_factor = 2;
+
+  JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false);
+  jht.EnableSpilling();
+  PopulateJoinHashTable(&jht, num_tuples, dup_scale_factor);
+  EXPECT_TRUE(jht.IsSpilled());
+
+  jht.Build();
+  EXPECT_TRUE(jht.IsBuilt());
+
+  for (uint32_t i = 0; i < num_tuples + num_misses; i++) {
+    auto probe = Tuple{i, 1, 2, 3};
+    *reinterpret_cast<Tuple *>(jht.AllocSpilledProbeTuple(probe.Hash(), sizeof(Tuple))) = probe;
+  }
+
+  std::vector<uint32_t> match_counts(num_tuples + num_misses, 0);
+  uint32_t num_partitions = 0;
+  JoinSpilledPartitions(exec_ctx.get(), &jht, budget, &match_counts, &num_partitions);
+
+  EXPECT_GT(num_partitions, 1u << JoinHashTable::SPILL_RADIX_BITS);
+  for (uint32_t i = 0; i < num_tuples + num_misses; i++) {
+    EXPECT_EQ(i < num_tuples ? dup_scale_factor : 0u, match_counts[i]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpilledParallelBuildTest) {
+  const uint64_t budget = 2 * JoinHashTable::MEMORY_RESERVATION_SIZE;
+  SetQueryMemoryBudget(budget);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  const uint32_t num_tuples = 50000;
+  const uint32_t num_thread_local_tables = 4;
+
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) {
+        auto *context = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        auto *jht = new (s) JoinHashTable(context->GetExecutionSettings(), context, sizeof(Tuple), false);
+        jht->EnableSpilling();
+      },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, exec_ctx.get());
+
+  LaunchParallel(num_thread_local_tables, [&](auto tid) {
+    auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+    PopulateJoinHashTable(jht, num_tuples, 1);
+  });
+
+  JoinHashTable main_jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false);
+  main_jht.EnableSpilling();
+  main_jht.MergeParallel(&container, 0);
+  EXPECT_TRUE(main_jht.IsSpilled());
+
+  // Probe from several threads, each with its own spilled probe files
+  LaunchParallel(num_thread_local_tables, [&](auto tid) {
+    for (uint32_t i = tid; i < num_tuples; i += num_thread_local_tables) {
+      auto probe = Tuple{i, 1, 2, 3};
+      *reinterpret_cast<Tuple *>(main_jht.AllocSpilledProbeTuple(probe.Hash(), sizeof(Tuple))) = probe;
+    }
+  });
+
+  std::vector<uint32_t> match_counts(num_tuples, 0);
+  uint32_t num_partitions = 0;
+  JoinSpilledPartitions(exec_ctx.get(), &main_jht, budget, &match_counts, &num_partitions);
+
+  EXPECT_EQ(1u << JoinHashTable::SPILL_RADIX_BITS, num_partitions);
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    EXPECT_EQ(num_thread_local_tables, match_counts[i]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, BloomFilterTest) {
+  auto exec_ctx = MakeExecCtx();
+  const uint32_t num_tuples = 1000;
+
+  // Build a table over the even keys, hashed the way a vectorized probe hashes them
+  JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false);
+  jht.EnableBloomFilter();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto tuple = Tuple{2 * i, 1, 2, 3};
+    auto hash = Hash<int32_t>{}(static_cast<int32_t>(tuple.a_), false);
+    *reinterpret_cast<Tuple *>(jht.AllocInputTuple(hash)) = tuple;
+  }
+  jht.Build();
+  EXPECT_TRUE(jht.HasBloomFilter());
+
+  // Filter the keys [0, 2 * num_tuples)
+  VectorProjection vp;
+  vp.Initialize({TypeId::Integer});
+  vp.Reset(2 * num_tuples);
+  VectorOps::Generate(vp.GetColumn(0), 0, 1);
+
+  TupleIdList tids(2 * num_tuples);
+  tids.AddAll();
+  const uint32_t key_cols[] = {0};
+  jht.FilterBatch(&vp, key_cols, 1, &tids);
+
+  // All even keys pass, and most of the odd keys are filtered out
+  uint32_t num_odd = 0;
+  for (uint32_t i = 0; i < 2 * num_tuples; i++) {
+    if (i % 2 == 0) {
+      EXPECT_TRUE(tids.Contains(i));
+    } else if (tids.Contains(i)) {
+      num_odd++;
+    }
+  }
+  EXPECT_EQ(num_tuples + num_odd, tids.GetTupleCount());
+  EXPECT_LT(num_odd, num_tuples / 10);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, FilterBatchLookupGateTest) {
+  auto exec_ctx = MakeExecCtx();
+  const uint32_t num_tuples = 1000;
+  const uint32_t key_cols[] = {0};
+
+  // Build a table over every key_step-th key, without a bloom filter, and have it looked up as if
+  // it were out of cache
+  const auto build = [&](JoinHashTable *jht, const uint32_t key_step) {
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto tuple = Tuple{key_step * i, 1, 2, 3};
+      auto hash = Hash<int32_t>{}(static_cast<int32_t>(tuple.a_), false);
+      *reinterpret_cast<Tuple *>(jht->AllocInputTuple(hash)) = tuple;
+    }
+    jht->Build();
+    jht->prefetch_threshold_ = 0;
+  };
+
+  // Filter the keys [0, num_keys), returning the surviving tuples
+  const auto filter = [&](const JoinHashTable &jht, const uint32_t num_keys) {
+    VectorProjection vp;
+    vp.Initialize({TypeId::Integer});
+    vp.Reset(num_keys);
+    VectorOps::Generate(vp.GetColumn(0), 0, 1);
+    TupleIdList tids(num_keys);
+    tids.AddAll();
+    jht.FilterBatch(&vp, key_cols, 1, &tids);
+    std::vector<uint32_t> survivors;
+    tids.ForEach([&](const uint64_t i) { survivors.push_back(static_cast<uint32_t>(i)); });
+    return survivors;
+  };
+
+  // Every key is found, so the lookups remove nothing and stop once the sample is taken
+  {
+    JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false);
+    build(&jht, 1);
+    while (jht.num_filter_lookups_ < JoinHashTable::FILTER_LOOKUP_SAMPLE_SIZE) {
+      EXPECT_EQ(num_tuples, filter(jht, num_tuples).size());
+    }
+    const uint64_t num_lookups = jht.num_filter_lookups_.load();
+    EXPECT_EQ(0u, jht.num_filter_lookups_removed_.load());
+    EXPECT_EQ(num_tuples, filter(jht, num_tuples).size());
+    EXPECT_EQ(num_lookups, jht.num_filter_lookups_.load());
+  }
+
+  // Only the even keys are found, so the lookups remove about half of the tuples and go on
+  {
+    JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false);
+    build(&jht, 2);
+    while (jht.num_filter_lookups_ < JoinHashTable::FILTER_LOOKUP_SAMPLE_SIZE) {
+      filter(jht, 2 * num_tuples);
+    }
+    const uint64_t num_lookups = jht.num_filter_lookups_.load();
+    const auto survivors = filter(jht, 2 * num_tuples);
+    EXPECT_EQ(num_lookups + 2 * num_tuples, jht.num_filter_lookups_.load());
+    uint32_t num_even = 0;
+    for (const auto tid : survivors) {
+      if (tid % 2 == 0) num_even++;
+    }
+    EXPECT_EQ(num_tuples, num_even);
+    EXPECT_LT(survivors.size() - num_even, num_tuples / 10);
+  }
+}
+
 #if 0
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, PerfTest) {
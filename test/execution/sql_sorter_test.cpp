@@ -262,4 +262,179 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpilledSortTest) {
+  // A budget of two reservations forces the sorter to write out several runs
+  SetQueryMemoryBudget(2 * Sorter::MEMORY_RESERVATION_SIZE);
+  auto exec_ctx = MakeExecCtx();
+
+  const uint32_t num_tuples = 500000;
+  const auto cmp_fn = [](const void *left, const void *right) {
+    return reinterpret_cast<const TestTuple<2> *>(left)->Compare(*reinterpret_cast<const TestTuple<2> *>(right));
+  };
+
+  uint64_t expected_sum = 0;
+  {
+    Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(TestTuple<2>));
+    std::uniform_int_distribution<uint32_t> rng(0, 3333);
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto *elem = reinterpret_cast<TestTuple<2> *>(sorter.AllocInputTuple());
+      elem->key_ = rng(generator_);
+      elem->data_[0] = i;
+      expected_sum += i;
+    }
+    EXPECT_TRUE(sorter.IsSpilled());
+    EXPECT_LE(exec_ctx->GetReservedMemory(), 2 * Sorter::MEMORY_RESERVATION_SIZE);
+
+    sorter.Sort();
+    EXPECT_TRUE(sorter.IsSorted());
+    EXPECT_EQ(num_tuples, sorter.GetTupleCount());
+
+    // The merged runs are sorted, and contain every tuple exactly once. Iterate twice.
+    for (uint32_t pass = 0; pass < 2; pass++) {
+      SorterIterator iter(sorter);
+      EXPECT_EQ(num_tuples, iter.NumRemaining());
+      uint32_t prev_key = 0;
+      uint64_t sum = 0;
+      for (; iter.HasNext(); iter.Next()) {
+        const auto *curr = iter.GetRowAs<TestTuple<2>>();
+        EXPECT_LE(prev_key, curr->key_);
+        prev_key = curr->key_;
+        sum += curr->data_[0];
+      }
+      EXPECT_EQ(expected_sum, sum);
+    }
+
+    // Skipping rows of the merge
+    SorterIterator iter(sorter);
+    iter.AdvanceBy(num_tuples - 10);
+    EXPECT_EQ(10u, iter.NumRemaining());
+    iter.AdvanceBy(20);
+    EXPECT_FALSE(iter.HasNext());
+  }
+
+  // All reservations are released
+  EXPECT_EQ(0u, exec_ctx->GetReservedMemory());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpilledParallelSortTest) {
+  // Every thread-local sorter alone exceeds the budget
+  SetQueryMemoryBudget(2 * Sorter::MEMORY_RESERVATION_SIZE);
+  auto exec_ctx = MakeExecCtx();
+  TestParallelSort<2>(exec_ctx.get(), {200000, 200000, 200000, 200000});
+  TestParallelSort<2>(exec_ctx.get(), {200000, 0, 10, 1000});
+  EXPECT_EQ(0u, exec_ctx->GetReservedMemory());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ParallelScanTest) {
+  tbb::task_scheduler_init sched;
+
+  // Collect the keys passed to the output callback, which must arrive in sorted order
+  std::vector<uint32_t> output;
+  exec::OutputCallback callback = [&](byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      output.push_back(*reinterpret_cast<uint32_t *>(tuples + i * tuple_size));
+    }
+  };
+  auto exec_ctx = MakeExecCtx(&callback);
+
+  const auto cmp_fn = [](const void *left, const void *right) {
+    return reinterpret_cast<const TestTuple<2> *>(left)->Compare(*reinterpret_cast<const TestTuple<2> *>(right));
+  };
+
+  // Every thread counts the tuples it scanned
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+  const auto init_count = [](UNUSED_ATTRIBUTE void *ctx, void *s) { *reinterpret_cast<uint64_t *>(s) = 0; };
+
+  // Output the key of every tuple in the range
+  const auto scan_fn = [](void *query_state, void *thread_state, SorterIterator *iter) {
+    auto *ctx = reinterpret_cast<exec::ExecutionContext *>(query_state);
+    exec::OutputBuffer buffer(ctx->GetMemoryPool(), 1, sizeof(uint32_t), ctx->GetOutputCallback());
+    for (; iter->HasNext(); iter->Next()) {
+      *reinterpret_cast<uint32_t *>(buffer.AllocOutputSlot()) = iter->GetRowAs<TestTuple<2>>()->key_;
+      (*reinterpret_cast<uint64_t *>(thread_state))++;
+    }
+    buffer.Finalize();
+  };
+
+  std::mt19937 mt(generator_());
+  for (const uint64_t num_tuples : {uint64_t{0}, uint64_t{10}, 10 * Sorter::PARALLEL_SCAN_RANGE_SIZE + 17}) {
+    output.clear();
+    Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(TestTuple<2>));
+    for (uint64_t i = 0; i < num_tuples; i++) {
+      reinterpret_cast<TestTuple<2> *>(sorter.AllocInputTuple())->key_ = mt() % 3333;
+    }
+    sorter.Sort();
+    container.Reset(sizeof(uint64_t), init_count, nullptr, nullptr);
+    sorter.ParallelScan(exec_ctx.get(), &container, scan_fn);
+
+    // All tuples were scanned and output in order
+    uint64_t num_scanned = 0;
+    container.ForEach<uint64_t>([&](const uint64_t *count) { num_scanned += *count; });
+    EXPECT_EQ(num_tuples, num_scanned);
+    EXPECT_EQ(num_tuples, output.size());
+    EXPECT_TRUE(std::is_sorted(output.begin(), output.end()));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ParallelScanOverBudgetTest) {
+  tbb::task_scheduler_init sched;
+
+  std::vector<uint32_t> output;
+  exec::OutputCallback callback = [&](byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      output.push_back(*reinterpret_cast<uint32_t *>(tuples + i * tuple_size));
+    }
+  };
+
+  const auto cmp_fn = [](const void *left, const void *right) {
+    return reinterpret_cast<const TestTuple<2> *>(left)->Compare(*reinterpret_cast<const TestTuple<2> *>(right));
+  };
+  const auto scan_fn = [](void *query_state, UNUSED_ATTRIBUTE void *thread_state, SorterIterator *iter) {
+    auto *ctx = reinterpret_cast<exec::ExecutionContext *>(query_state);
+    exec::OutputBuffer buffer(ctx->GetMemoryPool(), 1, sizeof(uint32_t), ctx->GetOutputCallback());
+    for (; iter->HasNext(); iter->Next()) {
+      *reinterpret_cast<uint32_t *>(buffer.AllocOutputSlot()) = iter->GetRowAs<TestTuple<2>>()->key_;
+    }
+    buffer.Finalize();
+  };
+
+  const uint64_t num_tuples = 10 * Sorter::PARALLEL_SCAN_RANGE_SIZE + 17;
+  std::vector<uint32_t> keys(num_tuples);
+  std::mt19937 mt(generator_());
+  for (auto &key : keys) key = mt() % 3333;
+  const auto fill = [&](Sorter *sorter) {
+    for (const auto key : keys) reinterpret_cast<TestTuple<2> *>(sorter->AllocInputTuple())->key_ = key;
+    sorter->Sort();
+  };
+
+  // Find out how much memory the sorter reserves for the tuples
+  uint64_t sorter_memory;
+  {
+    auto exec_ctx = MakeExecCtx();
+    Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(TestTuple<2>));
+    fill(&sorter);
+    sorter_memory = exec_ctx->GetReservedMemory();
+  }
+
+  // Only a few batches of output can be staged on top of the sorted tuples, so most ranges are deferred
+  SetQueryMemoryBudget(sorter_memory + 4 * exec::OutputBuffer::BATCH_SIZE * sizeof(uint32_t));
+  auto exec_ctx = MakeExecCtx(&callback);
+  Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(TestTuple<2>));
+  fill(&sorter);
+  ASSERT_FALSE(sorter.IsSpilled());
+
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+  container.Reset(sizeof(uint64_t), nullptr, nullptr, nullptr);
+  sorter.ParallelScan(exec_ctx.get(), &container, scan_fn);
+
+  // All tuples were output in order, and the memory reserved for staged output was released
+  EXPECT_EQ(num_tuples, output.size());
+  EXPECT_TRUE(std::is_sorted(output.begin(), output.end()));
+  EXPECT_EQ(sorter_memory, exec_ctx->GetReservedMemory());
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -160,4 +161,38 @@ TEST_F(SorterVectorIteratorTest, Iterate) {
   EXPECT_EQ(num_elems, num_found);
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterVectorIteratorTest, IterateSpilled) {
+  // Enough tuples to exceed the budget several times over
+  SetQueryMemoryBudget(Sorter::MEMORY_RESERVATION_SIZE);
+  auto exec_ctx = MakeExecCtx();
+  const uint32_t num_elems = 200000;
+
+  const auto compare = [](const void *lhs, const void *rhs) {
+    return CompareTuple(*reinterpret_cast<const Tuple *>(lhs), *reinterpret_cast<const Tuple *>(rhs));
+  };
+  Sorter sorter(exec_ctx.get(), compare, sizeof(Tuple));
+  PopulateSorter(&sorter, num_elems);
+  EXPECT_TRUE(sorter.IsSpilled());
+  sorter.Sort();
+
+  uint32_t num_found = 0;
+  int64_t prev_key = std::numeric_limits<int64_t>::min();
+  for (SorterVectorIterator iter(sorter, RowMeta(), Transpose); iter.HasNext(); iter.Next(Transpose)) {
+    auto *vpi = iter.GetVectorProjectionIterator();
+
+    // Verify sorted, also across vectors
+    const auto *key_vector = vpi->GetVectorProjection()->GetColumn(0);
+    const auto *key_data = reinterpret_cast<const decltype(Tuple::key_) *>(key_vector->GetData());
+    EXPECT_TRUE(std::is_sorted(key_data, key_data + key_vector->GetCount()));
+    EXPECT_LE(prev_key, key_data[0]);
+    prev_key = key_data[key_vector->GetCount() - 1];
+
+    // Count
+    num_found += vpi->GetSelectedTupleCount();
+  }
+
+  EXPECT_EQ(num_elems, num_found);
+}
+
 }  // namespace noisepage::execution::sql::test
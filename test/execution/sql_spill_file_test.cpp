@@ -0,0 +1,91 @@
+#include <cstring>
+#include <vector>
+
+#include "execution/sql/spill_file.h"
+#include "execution/tpl_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class SpillFileTest : public TplTest {};
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, EmptyFile) {
+  SpillFile file(sizeof(uint64_t));
+  file.Rewind();
+  EXPECT_EQ(0u, file.GetRecordCount());
+  EXPECT_EQ(nullptr, file.Next());
+  EXPECT_FALSE(file.IsOnDisk());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, BufferedRecords) {
+  // Few enough records to stay in the buffer
+  const uint64_t num_records = SpillFile::BUFFER_SIZE / sizeof(uint64_t);
+  SpillFile file(sizeof(uint64_t));
+  for (uint64_t i = 0; i < num_records; i++) {
+    *reinterpret_cast<uint64_t *>(file.Append()) = i;
+  }
+  file.Rewind();
+  EXPECT_FALSE(file.IsOnDisk());
+
+  uint64_t count = 0;
+  for (byte *r = file.Next(); r != nullptr; r = file.Next()) {
+    EXPECT_EQ(count++, *reinterpret_cast<uint64_t *>(r));
+  }
+  EXPECT_EQ(num_records, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, SpilledRecords) {
+  // Records of an odd size that span many buffers, read twice
+  struct Record {
+    uint32_t vals_[5];
+  };
+  const uint32_t num_records = 100000;
+  SpillFile file(sizeof(Record));
+  for (uint32_t i = 0; i < num_records; i++) {
+    auto *record = reinterpret_cast<Record *>(file.Append());
+    for (uint32_t j = 0; j < 5; j++) record->vals_[j] = i + j;
+  }
+  EXPECT_EQ(num_records, file.GetRecordCount());
+  EXPECT_TRUE(file.IsOnDisk());
+
+  for (uint32_t pass = 0; pass < 2; pass++) {
+    file.Rewind();
+    uint32_t count = 0;
+    for (byte *r = file.Next(); r != nullptr; r = file.Next(), count++) {
+      auto *record = reinterpret_cast<Record *>(r);
+      for (uint32_t j = 0; j < 5; j++) ASSERT_EQ(count + j, record->vals_[j]);
+    }
+    EXPECT_EQ(num_records, count);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, ConcurrentReaders) {
+  // Readers that interleave over the same file, on disk and in the buffer
+  for (const uint64_t num_records : {uint64_t{100}, uint64_t{100000}}) {
+    SpillFile file(sizeof(uint64_t));
+    for (uint64_t i = 0; i < num_records; i++) {
+      *reinterpret_cast<uint64_t *>(file.Append()) = i;
+    }
+    file.Finish();
+    EXPECT_EQ(num_records > SpillFile::BUFFER_SIZE / sizeof(uint64_t), file.IsOnDisk());
+
+    // The lead reader runs ahead of the other by a few records
+    SpillFile::Reader reader(file), lead(file);
+    for (uint64_t i = 0; i < 7; i++) {
+      ASSERT_EQ(i, *reinterpret_cast<const uint64_t *>(lead.Next()));
+    }
+    for (uint64_t i = 0; i < num_records; i++) {
+      ASSERT_EQ(i, *reinterpret_cast<const uint64_t *>(reader.Next()));
+      if (const byte *r = lead.Next(); r != nullptr) {
+        ASSERT_EQ(i + 7, *reinterpret_cast<const uint64_t *>(r));
+      }
+    }
+    EXPECT_EQ(nullptr, reader.Next());
+    EXPECT_EQ(nullptr, lead.Next());
+  }
+}
+
+}  // namespace noisepage::execution::sql::test
@@ -92,6 +92,78 @@ TEST_F(StorageInterfaceTest, SimpleInsertTest) {
   EXPECT_EQ(num_tuples, (hi_match - lo_match) + 1);
 }
 
+// NOLINTNEXTLINE
+TEST_F(StorageInterfaceTest, BatchedInsertTest) {
+  // INSERT INTO empty_table SELECT colA FROM test_1 WHERE colA BETWEEN 0 and 599, spanning several batches.
+  auto table_oid0 = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "empty_table");
+  auto index_oid0 = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_empty");
+  auto table_oid1 = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto index_oid1 = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  // Select colA only
+  std::array<uint32_t, 1> col_oids{1};
+
+  IndexIterator index_iter1{exec_ctx_.get(),
+                            1,
+                            table_oid1.UnderlyingValue(),
+                            index_oid1.UnderlyingValue(),
+                            col_oids.data(),
+                            static_cast<uint32_t>(col_oids.size())};
+  index_iter1.Init();
+
+  // Batched inserter.
+  StorageInterface inserter(exec_ctx_.get(), table_oid0, col_oids.data(), col_oids.size(), true, true);
+
+  int32_t lo_match = 0;
+  int32_t hi_match = 599;
+  index_iter1.LoPR()->Set<int32_t, false>(0, lo_match, false);
+  index_iter1.HiPR()->Set<int32_t, false>(0, hi_match, false);
+  index_iter1.ScanAscending(storage::index::ScanType::Closed, 0);
+  std::vector<int32_t> inserted_vals;
+  while (index_iter1.Advance()) {
+    auto *val_a = index_iter1.TablePR()->Get<int32_t, false>(0, nullptr);
+    inserted_vals.emplace_back(*val_a);
+    inserter.GetTablePR()->Set<int32_t, false>(0, *val_a, false);
+    inserter.TableInsertBatched();
+    inserter.GetIndexPR(index_oid0)->Set<int32_t, false>(0, *val_a, false);
+    ASSERT_TRUE(inserter.IndexInsert());
+  }
+  ASSERT_GT(inserted_vals.size(), StorageInterface::BATCH_SIZE);
+  inserter.Flush();
+
+  // Every row is in the table, in insertion order.
+  TableVectorIterator table_iter(exec_ctx_.get(), table_oid0.UnderlyingValue(), col_oids.data(),
+                                 static_cast<uint32_t>(col_oids.size()));
+  table_iter.Init();
+  VectorProjectionIterator *vpi = table_iter.GetVectorProjectionIterator();
+  uint32_t num_tuples = 0;
+  while (table_iter.Advance()) {
+    for (; vpi->HasNext(); vpi->Advance()) {
+      ASSERT_EQ(*vpi->GetValue<int32_t, false>(0, nullptr), inserted_vals[num_tuples]);
+      num_tuples++;
+    }
+    vpi->Reset();
+  }
+  EXPECT_EQ(num_tuples, inserted_vals.size());
+
+  // Every key is in the index, pointing to its row.
+  IndexIterator index_iter0{exec_ctx_.get(),
+                            1,
+                            table_oid0.UnderlyingValue(),
+                            index_oid0.UnderlyingValue(),
+                            col_oids.data(),
+                            static_cast<uint32_t>(col_oids.size())};
+  index_iter0.Init();
+  index_iter0.LoPR()->Set<int32_t, false>(0, lo_match, false);
+  index_iter0.HiPR()->Set<int32_t, false>(0, hi_match, false);
+  index_iter0.ScanAscending(storage::index::ScanType::Closed, 0);
+  uint32_t num_keys = 0;
+  while (index_iter0.Advance()) {
+    ASSERT_EQ(*index_iter0.TablePR()->Get<int32_t, false>(0, nullptr), inserted_vals[num_keys]);
+    num_keys++;
+  }
+  EXPECT_EQ(num_keys, inserted_vals.size());
+}
+
 // NOLINTNEXTLINE
 TEST_F(StorageInterfaceTest, SimpleDeleteTest) {
   // DELETE FROM test_1 where colA BETWEEN 495 and 505.
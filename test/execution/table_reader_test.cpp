@@ -0,0 +1,161 @@
+#include "execution/table_generator/table_reader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/sql_test.h"
+#include "storage/sql_table.h"
+
+namespace noisepage::execution::sql::test {
+
+class TableReaderTest : public SqlBasedTest {
+ public:
+  void SetUp() override {
+    SqlBasedTest::SetUp();
+    exec_ctx_ = MakeExecCtx();
+  }
+
+  void TearDown() override {
+    for (const auto &file : files_) std::remove(file.c_str());
+    SqlBasedTest::TearDown();
+  }
+
+  // Load the data into a new table with an integer and a varchar column, using the given chunk size. Returns the name
+  // of the table.
+  std::string Load(const std::string &data, const std::size_t chunk_size, const std::string &col_a_type = "int") {
+    const std::string table_name = "table_" + std::to_string(files_.size());
+    const auto schema_file = WriteFile(table_name + ".schema",
+                                       table_name + " 2\ncol_a " + col_a_type + " 0\ncol_b varchar 1 100\n0\n");
+    const auto data_file = WriteFile(table_name + ".data", data);
+    TableReader reader(exec_ctx_.get(), BlockStore().Get(), NSOid(), chunk_size);
+    num_read_ = reader.ReadTable(schema_file, data_file);
+    return table_name;
+  }
+
+  // Read the rows of a table loaded by Load, in order of the first column.
+  std::vector<std::pair<int64_t, std::string>> Scan(const std::string &table_name) {
+    const auto table_oid = accessor_->GetTableOid(NSOid(), table_name);
+    const auto table = accessor_->GetTable(table_oid);
+    const auto &schema = accessor_->GetSchema(table_oid);
+    std::vector<catalog::col_oid_t> col_oids{schema.GetColumn("col_a").Oid(), schema.GetColumn("col_b").Oid()};
+    const auto pri = table->InitializerForProjectedRow(col_oids);
+    auto offsets = table->ProjectionMapForOids(col_oids);
+    const auto type = schema.GetColumn("col_a").Type();
+
+    byte *buffer = common::AllocationUtil::AllocateAligned(pri.ProjectedRowSize());
+    auto *row = pri.InitializeRow(buffer);
+    std::vector<std::pair<int64_t, std::string>> rows;
+    for (auto iter = table->begin(); iter != table->end(); iter++) {
+      if (!table->Select(common::ManagedPointer(test_txn_), *iter, row)) continue;
+      const byte *col_a = row->AccessForceNotNull(offsets[col_oids[0]]);
+      int64_t a;
+      if (type == type::TypeId::TINYINT) {
+        a = *reinterpret_cast<const int8_t *>(col_a);
+      } else if (type == type::TypeId::BIGINT) {
+        a = *reinterpret_cast<const int64_t *>(col_a);
+      } else {
+        a = *reinterpret_cast<const int32_t *>(col_a);
+      }
+      const auto *col_b =
+          reinterpret_cast<const storage::VarlenEntry *>(row->AccessWithNullCheck(offsets[col_oids[1]]));
+      rows.emplace_back(a, col_b == nullptr ? "NULL" : std::string(col_b->StringView()));
+    }
+    delete[] buffer;
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+ protected:
+  uint32_t num_read_ = 0;
+
+ private:
+  std::string WriteFile(const std::string &name, const std::string &contents) {
+    const std::string path = "/tmp/table_reader_test_" + name;
+    std::ofstream(path, std::ios::binary) << contents;
+    files_.emplace_back(path);
+    return path;
+  }
+
+  std::unique_ptr<exec::ExecutionContext> exec_ctx_;
+  std::vector<std::string> files_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(TableReaderTest, SkipHeader) {
+  const auto table = Load("col_a,col_b\n1,a\n2,b\n", TableReader::DEFAULT_CHUNK_SIZE);
+  EXPECT_EQ(2u, num_read_);
+  const std::vector<std::pair<int64_t, std::string>> expected{{1, "a"}, {2, "b"}};
+  EXPECT_EQ(expected, Scan(table));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableReaderTest, RecordsStraddleChunks) {
+  // Every chunk size splits some records, and also puts chunk boundaries right after newlines and inside the header.
+  std::string data = "col_a,col_b\n";
+  std::vector<std::pair<int64_t, std::string>> expected;
+  for (int64_t i = 0; i < 50; i++) {
+    expected.emplace_back(i, std::string(i % 20, 'x'));
+    data += std::to_string(i) + "," + expected.back().second + (i % 3 == 0 ? "\r\n" : "\n");
+  }
+  for (std::size_t chunk_size = 1; chunk_size <= 64; chunk_size++) {
+    const auto table = Load(data, chunk_size);
+    EXPECT_EQ(expected.size(), num_read_) << "chunk size " << chunk_size;
+    EXPECT_EQ(expected, Scan(table)) << "chunk size " << chunk_size;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableReaderTest, QuotedFields) {
+  const std::string data =
+      "col_a,\"col,b\"\n"
+      "1,\"a,b\"\n"
+      "2,\"line 1\nline 2,\n\"\n"
+      "3,\"say \"\"hi\"\"\"\n"
+      "4,\"\"\n"
+      "5,\\N\n";
+  const std::vector<std::pair<int64_t, std::string>> expected{
+      {1, "a,b"}, {2, "line 1\nline 2,\n"}, {3, "say \"hi\""}, {4, ""}, {5, "NULL"}};
+  // Chunks that start inside a quoted field must skip to the end of its record, not to the newline inside it.
+  for (std::size_t chunk_size = 1; chunk_size <= data.size(); chunk_size++) {
+    const auto table = Load(data, chunk_size);
+    EXPECT_EQ(expected.size(), num_read_) << "chunk size " << chunk_size;
+    EXPECT_EQ(expected, Scan(table)) << "chunk size " << chunk_size;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableReaderTest, GuessDelimiter) {
+  const std::vector<std::pair<int64_t, std::string>> expected{{1, "a,b"}, {2, "c;d"}};
+  // The delimiter splits the header into as many fields as there are columns, allowing for a trailing delimiter.
+  EXPECT_EQ(expected, Scan(Load("col_a|col_b\n1|a,b\n2|c;d\n", TableReader::DEFAULT_CHUNK_SIZE)));
+  EXPECT_EQ(expected, Scan(Load("col_a|col_b|\n1|a,b|\n2|c;d|\n", TableReader::DEFAULT_CHUNK_SIZE)));
+  EXPECT_EQ(expected, Scan(Load("col_a\tcol_b\n1\ta,b\n2\tc;d\n", TableReader::DEFAULT_CHUNK_SIZE)));
+  EXPECT_EQ(expected, Scan(Load("col_a;col_b\n1;\"a,b\"\n2;\"c;d\"\n", TableReader::DEFAULT_CHUNK_SIZE)));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableReaderTest, IntegerLimits) {
+  const std::vector<std::pair<int64_t, std::string>> expected{{-128, "a"}, {127, "b"}};
+  EXPECT_EQ(expected, Scan(Load("col_a,col_b\n-128,a\n+127,b\n", TableReader::DEFAULT_CHUNK_SIZE, "tinyint")));
+  const std::vector<std::pair<int64_t, std::string>> expected_bigint{
+      {std::numeric_limits<int64_t>::min(), "a"}, {std::numeric_limits<int64_t>::max(), "b"}};
+  EXPECT_EQ(expected_bigint, Scan(Load("col_a,col_b\n-9223372036854775808,a\n9223372036854775807,b\n",
+                                       TableReader::DEFAULT_CHUNK_SIZE, "bigint")));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableReaderTest, MalformedIntegers) {
+  for (const std::string field : {"", "-", "+", "abc", "12abc", "1.5", " 1", "--1", "2147483648", "-2147483649"}) {
+    EXPECT_ANY_THROW(Load("col_a,col_b\n1,a\n" + field + ",b\n", TableReader::DEFAULT_CHUNK_SIZE)) << field;
+  }
+  EXPECT_ANY_THROW(Load("col_a,col_b\n128,a\n", TableReader::DEFAULT_CHUNK_SIZE, "tinyint"));
+  EXPECT_ANY_THROW(Load("col_a,col_b\n-129,a\n", TableReader::DEFAULT_CHUNK_SIZE, "tinyint"));
+  EXPECT_ANY_THROW(Load("col_a,col_b\n9223372036854775808,a\n", TableReader::DEFAULT_CHUNK_SIZE, "bigint"));
+}
+
+}  // namespace noisepage::execution::sql::test
@@ -2,6 +2,7 @@
 #include <limits>
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -145,6 +146,32 @@ TEST_F(BytecodeTrampolineTest, VoidReturnTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeTrampolineTest, AsyncCompileTest) {
+  auto src = "fun add2(a: int32, b: int32) -> int32 { return a + b }";
+
+  // Modules destroyed right after requesting a background compilation cancel it or wait for it.
+  for (uint32_t i = 0; i < 16; i++) {
+    auto compiler = ModuleCompiler();
+    auto module = compiler.CompileToModule(src);
+    EXPECT_FALSE(compiler.HasErrors());
+    module->CompileToMachineCodeAsync();
+  }
+
+  // The compiled function is swapped in once the background compilation is done.
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  EXPECT_FALSE(compiler.HasErrors());
+  module->CompileToMachineCodeAsync();
+  while (!module->IsCompiledToMachineCode()) {
+    std::this_thread::yield();
+  }
+  const auto func_id = module->GetFuncInfoByName("add2")->GetId();
+  EXPECT_NE(GetTrampoline(*module, "add2"), module->GetRawFunctionImpl(func_id));
+  auto fn = reinterpret_cast<int32_t (*)(int32_t, int32_t)>(module->GetRawFunctionImpl(func_id));
+  EXPECT_EQ(20, fn(10, 10));
+}
+
 // NOLINTNEXTLINE
 TEST_F(BytecodeTrampolineTest, CodeGenComparisonFunctionSorterTest) {
   //
@@ -0,0 +1,188 @@
+#include "execution/vm/llvm_engine.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/ast/context.h"
+#include "execution/compiler/compiler.h"
+#include "execution/sema/error_reporter.h"
+#include "execution/tpl_test.h"
+#include "execution/util/region.h"
+#include "execution/vm/module.h"
+
+namespace noisepage::execution::vm::test {
+
+class LLVMEngineTest : public TplTest {
+ public:
+  LLVMEngineTest() : region_("llvm_engine_test"), error_reporter_(&region_), context_(&region_, &error_reporter_) {
+    LLVMEngine::Initialize();
+    EXPECT_FALSE(llvm::sys::fs::createUniqueDirectory("tpl-object-cache", cache_directory_));
+  }
+
+  ~LLVMEngineTest() override { llvm::sys::fs::remove_directories(cache_directory_); }
+
+  // Compile the TPL source into a bytecode module.
+  std::unique_ptr<Module> MakeModule(const std::string &name, const std::string &src) {
+    auto input = compiler::Compiler::Input(name, &context_, &src);
+    return compiler::Compiler::RunCompilationSimple(input);
+  }
+
+  // The paths of the entries in the object cache.
+  std::vector<std::string> CacheEntries() const {
+    std::vector<std::string> entries;
+    std::error_code error;
+    for (llvm::sys::fs::directory_iterator iter(cache_directory_, error), end; !error && iter != end;
+         iter.increment(error)) {
+      entries.emplace_back(iter->path());
+    }
+    EXPECT_FALSE(error);
+    return entries;
+  }
+
+  // The size of the given file.
+  static uint64_t FileSize(const std::string &path) {
+    uint64_t size = 0;
+    EXPECT_FALSE(llvm::sys::fs::file_size(path, size));
+    return size;
+  }
+
+  // The file system ID of the given file, which changes when the file is replaced.
+  static llvm::sys::fs::UniqueID FileId(const std::string &path) {
+    llvm::sys::fs::UniqueID id;
+    EXPECT_FALSE(llvm::sys::fs::getUniqueID(path, id));
+    return id;
+  }
+
+  util::Region region_;
+  sema::ErrorReporter error_reporter_;
+  ast::Context context_;
+  llvm::SmallString<128> cache_directory_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineTest, ObjectCacheTest) {
+  using IntFunction = int32_t (*)(int32_t);
+  LLVMEngine::CompilerOptions options;
+  options.SetObjectCacheDirectory(cache_directory_.str().str());
+
+  // Compiling a module adds its object code to the cache.
+  auto module = MakeModule("first", "fun addOne(x: int32) -> int32 { return x + 1 }");
+  ASSERT_NE(module, nullptr);
+  auto compiled = LLVMEngine::Compile(*module->GetBytecodeModule(), options);
+  auto *add_one = reinterpret_cast<IntFunction>(compiled->GetFunctionPointer("addOne"));
+  ASSERT_NE(add_one, nullptr);
+  EXPECT_EQ(add_one(1), 2);
+  auto entries = CacheEntries();
+  ASSERT_EQ(entries.size(), 1);
+  const auto entry = entries[0];
+  const auto entry_id = FileId(entry);
+
+  // A module that only differs in its names is loaded from the cache rather than compiled and stored again.
+  auto renamed = MakeModule("second", "fun increment(x: int32) -> int32 { return x + 1 }");
+  ASSERT_NE(renamed, nullptr);
+  auto cached = LLVMEngine::Compile(*renamed->GetBytecodeModule(), options);
+  auto *increment = reinterpret_cast<IntFunction>(cached->GetFunctionPointer("increment"));
+  ASSERT_NE(increment, nullptr);
+  EXPECT_EQ(increment(41), 42);
+  EXPECT_EQ(CacheEntries().size(), 1);
+  EXPECT_EQ(FileId(entry), entry_id);
+
+  // Other code gets its own entry.
+  auto other = MakeModule("third", "fun addTwo(x: int32) -> int32 { return x + 2 }");
+  ASSERT_NE(other, nullptr);
+  auto compiled_other = LLVMEngine::Compile(*other->GetBytecodeModule(), options);
+  auto *add_two = reinterpret_cast<IntFunction>(compiled_other->GetFunctionPointer("addTwo"));
+  ASSERT_NE(add_two, nullptr);
+  EXPECT_EQ(add_two(1), 3);
+  EXPECT_EQ(CacheEntries().size(), 2);
+
+  // A corrupt entry is compiled again and replaced.
+  {
+    std::error_code error;
+    llvm::raw_fd_ostream out(entry, error);
+    ASSERT_FALSE(error);
+    out << "not an object cache entry";
+  }
+  auto recompiled = LLVMEngine::Compile(*renamed->GetBytecodeModule(), options);
+  increment = reinterpret_cast<IntFunction>(recompiled->GetFunctionPointer("increment"));
+  ASSERT_NE(increment, nullptr);
+  EXPECT_EQ(increment(1), 2);
+  EXPECT_EQ(CacheEntries().size(), 2);
+  EXPECT_NE(FileId(entry), entry_id);
+}
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineTest, ObjectCacheEvictionTest) {
+  LLVMEngine::CompilerOptions options;
+  options.SetObjectCacheDirectory(cache_directory_.str().str());
+  auto first = MakeModule("first", "fun addOne(x: int32) -> int32 { return x + 1 }");
+  auto second = MakeModule("second", "fun addTwo(x: int32) -> int32 { return x + 2 }");
+  auto third = MakeModule("third", "fun addSix(x: int32) -> int32 { return x + 6 }");
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_NE(third, nullptr);
+
+  // Modification times are only as precise as the kernel's clock tick, so space out the uses of entries.
+  const auto next_use = [] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+
+  LLVMEngine::Compile(*first->GetBytecodeModule(), options);
+  auto entries = CacheEntries();
+  ASSERT_EQ(entries.size(), 1);
+  const auto first_entry = entries[0];
+  next_use();
+  LLVMEngine::Compile(*second->GetBytecodeModule(), options);
+  entries = CacheEntries();
+  ASSERT_EQ(entries.size(), 2);
+  const auto second_entry = entries[0] == first_entry ? entries[1] : entries[0];
+
+  // Loading the first entry makes the second one the least recently used.
+  next_use();
+  LLVMEngine::Compile(*first->GetBytecodeModule(), options);
+  next_use();
+
+  // Adding a third entry to a cache that only fits two evicts the second one.
+  const uint64_t first_size = FileSize(first_entry), second_size = FileSize(second_entry);
+  options.SetObjectCacheMaxSize(first_size + second_size + std::min(first_size, second_size) / 2);
+  auto compiled = LLVMEngine::Compile(*third->GetBytecodeModule(), options);
+  auto *add_six = reinterpret_cast<int32_t (*)(int32_t)>(compiled->GetFunctionPointer("addSix"));
+  ASSERT_NE(add_six, nullptr);
+  EXPECT_EQ(add_six(1), 7);
+  entries = CacheEntries();
+  EXPECT_EQ(entries.size(), 2);
+  EXPECT_NE(std::find(entries.begin(), entries.end(), first_entry), entries.end());
+  EXPECT_EQ(std::find(entries.begin(), entries.end(), second_entry), entries.end());
+}
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineTest, ObjectCacheDirectoryTest) {
+  // A missing cache directory is created private to the user running the process.
+  llvm::SmallString<128> directory(cache_directory_);
+  llvm::sys::path::append(directory, "cache");
+  LLVMEngine::Initialize(directory.str().str());
+  EXPECT_EQ(LLVMEngine::GetObjectCacheDirectory(), directory.str().str());
+  struct stat status;
+  ASSERT_EQ(::stat(directory.c_str(), &status), 0);
+  EXPECT_EQ(status.st_mode & 0777, S_IRWXU);
+
+  // A cache directory that other users can write to is refused.
+  ASSERT_EQ(::chmod(directory.c_str(), 0777), 0);
+  LLVMEngine::Initialize(directory.str().str());
+  EXPECT_TRUE(LLVMEngine::GetObjectCacheDirectory().empty());
+  ASSERT_EQ(::chmod(directory.c_str(), 0720), 0);
+  LLVMEngine::Initialize(directory.str().str());
+  EXPECT_TRUE(LLVMEngine::GetObjectCacheDirectory().empty());
+
+  LLVMEngine::Initialize();
+}
+
+}  // namespace noisepage::execution::vm::test
@@ -75,6 +75,22 @@ class SqlBasedTest : public TplTest {
     return catalog_->GetAccessor(common::ManagedPointer(test_txn_), test_db_oid_, DISABLED);
   }
 
+  /** Set the query memory budget of execution contexts made from now on. */
+  void SetQueryMemoryBudget(uint64_t budget) { exec_settings_->query_memory_budget_ = budget; }
+
+  /** Enable the counters behind pipeline metrics in execution contexts made from now on. */
+  void EnableCounters() { exec_settings_->is_counters_enabled_ = true; }
+
+  /**
+   * Abort the test transaction, which undoes everything the test did in it, and begin an empty one for the teardown to
+   * commit. For tests whose queries leave the test transaction unable to commit.
+   */
+  void AbortTestTxn() {
+    accessor_.reset();
+    txn_manager_->Abort(test_txn_);
+    test_txn_ = txn_manager_->BeginTransaction();
+  }
+
  protected:
   std::unique_ptr<catalog::CatalogAccessor> accessor_;
   transaction::TransactionContext *test_txn_;
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <fstream>
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
 #include <random>
@@ -108,9 +110,28 @@ TEST_F(MetricsTests, LoggingCSVTest) {
   if (!(aggregated_data->consumer_data_.empty())) {
     EXPECT_GE(aggregated_data->consumer_data_.begin()->num_buffers_, 0);  // 1 buffer flushed
   }
+  // Every persist that made commits durable adds one data point to both group commit histograms
+  uint64_t num_batches = 0, num_fsyncs = 0;
+  for (uint32_t i = 0; i < LoggingMetricRawData::Log2Histogram::NUM_BUCKETS; i++) {
+    num_batches += aggregated_data->batch_size_histogram_.Count(i);
+    num_fsyncs += aggregated_data->fsync_latency_histogram_.Count(i);
+  }
+  EXPECT_EQ(num_batches, num_fsyncs);
+  EXPECT_EQ(aggregated_data->batch_size_histogram_.Count(0), 0);  // empty batches are not recorded
   metrics_manager_->ToCSV();
   EXPECT_EQ(aggregated_data->serializer_data_.size(), 0);
   EXPECT_EQ(aggregated_data->consumer_data_.size(), 0);
+  for (uint32_t i = 0; i < LoggingMetricRawData::Log2Histogram::NUM_BUCKETS; i++) {
+    EXPECT_EQ(aggregated_data->batch_size_histogram_.Count(i), 0);
+    EXPECT_EQ(aggregated_data->fsync_latency_histogram_.Count(i), 0);
+  }
+  // The group commit histograms have as many columns as their header
+  std::ifstream group_commit_file{std::string(LoggingMetricRawData::FILES[2])};
+  std::string header, row;
+  ASSERT_TRUE(std::getline(group_commit_file, header));
+  while (std::getline(group_commit_file, row)) {
+    EXPECT_EQ(std::count(row.cbegin(), row.cend(), ','), std::count(header.cbegin(), header.cend(), ','));
+  }
 
   Insert();
   Insert();
@@ -41,6 +41,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
 #include "type/type_id.h"
@@ -900,4 +901,36 @@ TEST(PlanNodeJsonTest, UpdatePlanNodeJsonTest) {
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
 
+// NOLINTNEXTLINE
+TEST(PlanNodeJsonTest, WindowPlanNodeJsonTest) {
+  // Construct WindowPlanNode
+  std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+  children.push_back(std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 2));
+  auto agg_term = std::make_unique<parser::AggregateExpression>(parser::ExpressionType::AGGREGATE_SUM,
+                                                                std::move(children), false);
+  auto partition_key = std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 0);
+  auto sort_key = std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 1);
+
+  WindowPlanNode::Builder builder;
+  auto plan_node = builder.SetOutputSchema(PlanNodeJsonTest::BuildDummyOutputSchema())
+                       .AddPartitionKey(common::ManagedPointer<parser::AbstractExpression>(partition_key.get()))
+                       .AddSortKey(common::ManagedPointer<parser::AbstractExpression>(sort_key.get()),
+                                   optimizer::OrderByOrderingType::DESC)
+                       .AddWindowTerm(WindowFunctionType::RANK)
+                       .AddWindowTerm(common::ManagedPointer(agg_term))
+                       .Build();
+
+  // Serialize to Json
+  auto json = plan_node->ToJson();
+  EXPECT_FALSE(json.is_null());
+
+  // Deserialize plan node
+  auto deserialized = DeserializePlanNode(json);
+  auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<WindowPlanNode>();
+  EXPECT_TRUE(deserialized_plan != nullptr);
+  EXPECT_EQ(PlanNodeType::WINDOW, deserialized_plan->GetPlanNodeType());
+  EXPECT_EQ(*plan_node, *deserialized_plan);
+  EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
+}
+
 }  // namespace noisepage::planner
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "common/hash_util.h"
+#include "execution/sql/vector_projection.h"
 #include "storage/block_access_controller.h"
 #include "storage/garbage_collector.h"
 #include "storage/storage_defs.h"
@@ -385,4 +386,93 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
   }
 }
 
+// This test freezes a single block of a table and scans it into a vector projection. It verifies that the scan
+// references the block's columns in place instead of materializing them, and that the in-place read latch taken by the
+// scan is dropped once the projection goes away so that writers can proceed.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, InPlaceScanTest) {
+  storage::BlockLayout layout({8, 8, 8});
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  storage::RawBlock *block = table.GetBlocks()[0];
+
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), true, DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  // Fill up exactly one block, with every other value of the second column being NULL
+  const std::vector<storage::col_id_t> col_ids = {storage::col_id_t(1), storage::col_id_t(2)};
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, col_ids);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  const uint16_t nullable_idx = row->ColumnIds()[0] == storage::col_id_t(2) ? 0 : 1;
+  auto *txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < layout.NumSlots(); i++) {
+    *reinterpret_cast<int64_t *>(row->AccessForceNotNull(0)) = i;
+    *reinterpret_cast<int64_t *>(row->AccessForceNotNull(1)) = i;
+    if (i % 2 == 0) row->SetNull(nullable_idx);
+    table.Insert(common::ManagedPointer(txn), *row);
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  ASSERT_EQ(table.GetNumBlocks(), 1u);
+
+  storage::BlockCompactor compactor;
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+  ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  txn = txn_manager.BeginTransaction();
+  {
+    execution::sql::VectorProjection projection;
+    projection.SetStorageColIds(col_ids);
+    projection.Initialize({execution::sql::TypeId::BigInt, execution::sql::TypeId::BigInt});
+
+    uint32_t scanned = 0;
+    auto it = table.begin();
+    while (it != table.end()) {
+      table.Scan(common::ManagedPointer(txn), &it, &projection);
+      for (uint32_t i = 0; i < projection.GetColumnCount(); i++) {
+        const byte *in_block = accessor.ColumnStart(block, col_ids[i]) + sizeof(int64_t) * scanned;
+        EXPECT_EQ(in_block, projection.GetColumn(i)->GetData());
+      }
+      for (uint32_t offset = 0; offset < projection.GetTotalTupleCount(); offset++) {
+        // Compaction does not reorder a full block with no gaps
+        const uint32_t expected = scanned + offset;
+        EXPECT_EQ(expected, reinterpret_cast<int64_t *>(projection.GetColumn(0)->GetData())[offset]);
+        EXPECT_EQ(expected % 2 == 0, projection.GetColumn(1)->IsNull(offset));
+        EXPECT_EQ(storage::TupleSlot(block, expected), projection.GetTupleSlot(offset));
+      }
+      scanned += projection.GetTotalTupleCount();
+      // The block must stay frozen while the projection references it
+      EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+    }
+    EXPECT_EQ(scanned, layout.NumSlots());
+  }
+
+  // The projection is gone, so an update must not wait on an in-place reader
+  storage::ProjectedRowInitializer update_initializer =
+      storage::ProjectedRowInitializer::Create(layout, {storage::col_id_t(1)});
+  byte *update_buffer = common::AllocationUtil::AllocateAligned(update_initializer.ProjectedRowSize());
+  auto *update = update_initializer.InitializeRow(update_buffer);
+  *reinterpret_cast<int64_t *>(update->AccessForceNotNull(0)) = -1;
+  EXPECT_TRUE(table.Update(common::ManagedPointer(txn), storage::TupleSlot(block, 0), *update));
+  EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::HOT);
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  delete[] buffer;
+  delete[] update_buffer;
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
 }  // namespace noisepage
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <limits>
@@ -539,6 +540,64 @@ TEST_F(BwTreeIndexTests, ScanLimitDescending) {
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Looks up a shuffled batch of keys, every one of them repeated and half of them missing from the index, and checks
+ * that every key gets the same values from ScanKeys as from ScanKey.
+ */
+// NOLINTNEXTLINE
+TEST_F(BwTreeIndexTests, ScanKeys) {
+  const int32_t num_keys = 1000;
+  // insert every key in [0, num_keys) twice
+  auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  for (int32_t i = 0; i < 2 * num_keys; i++) {
+    auto *const insert_txn = txn_manager_->BeginTransaction();
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = i % num_keys;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i % num_keys;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+    txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+
+  // look up every key in [0, 2 * num_keys) twice, in random order
+  std::vector<int32_t> key_values;
+  for (int32_t i = 0; i < 2 * num_keys; i++) {
+    key_values.emplace_back(i);
+    key_values.emplace_back(i);
+  }
+  std::shuffle(key_values.begin(), key_values.end(), generator_);
+  std::vector<byte *> key_buffers;
+  std::vector<const ProjectedRow *> keys;
+  for (const auto key_value : key_values) {
+    key_buffers.emplace_back(
+        common::AllocationUtil::AllocateAligned(default_index_->GetProjectedRowInitializer().ProjectedRowSize()));
+    auto *const key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffers.back());
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = key_value;
+    keys.emplace_back(key);
+  }
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  std::vector<uint32_t> key_offsets;
+  default_index_->ScanKeys(*scan_txn, keys, &results, &key_offsets);
+  ASSERT_EQ(key_offsets.size(), keys.size() + 1);
+  EXPECT_EQ(results.size(), static_cast<size_t>(4 * num_keys));
+
+  std::vector<storage::TupleSlot> expected;
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    expected.clear();
+    default_index_->ScanKey(*scan_txn, *keys[i], &expected);
+    EXPECT_EQ(expected.size(), key_values[i] < num_keys ? 2u : 0u);
+    EXPECT_TRUE(std::is_permutation(results.cbegin() + key_offsets[i], results.cbegin() + key_offsets[i + 1],
+                                    expected.cbegin(), expected.cend()));
+  }
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  for (auto *const key_buffer : key_buffers) delete[] key_buffer;
+}
+
 // Verifies that primary key insert fails on write-write conflict
 // NOLINTNEXTLINE
 TEST_F(BwTreeIndexTests, UniqueKey1) {
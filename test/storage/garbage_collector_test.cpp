@@ -1,14 +1,20 @@
 #include "storage/garbage_collector.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/object_pool.h"
+#include "execution/sql/vector_projection.h"
 #include "main/db_main.h"
 #include "storage/data_table.h"
 #include "storage/storage_util.h"
+#include "storage/tuple_access_strategy.h"
+#include "storage/version_synopsis.h"
 #include "test_util/data_table_test_util.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
@@ -699,4 +705,191 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Run a txn that inserts and then updates a tuple. Confirm that the block's version synopsis reports a version chain for
+// the tuple's slot range until the GC truncates the chain.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, VersionSynopsis) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+    storage::TupleAccessStrategy accessor(tested.Layout());
+    const uint32_t range = 0;
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple);
+    const storage::VersionSynopsis &synopsis = accessor.GetVersionSynopsis(slot.GetBlock());
+    const uint64_t after_insert = synopsis.Snapshot(range);
+    EXPECT_FALSE(storage::VersionSynopsis::IsUnversioned(after_insert));
+
+    // Updating a tuple that already has a version chain does not install a new one
+    auto *update = tested.GenerateRandomUpdate(&generator_);
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn0), slot, *update));
+    EXPECT_EQ(after_insert, synopsis.Snapshot(range));
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Unlinking truncates the version chain
+    EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+    const uint64_t after_unlink = synopsis.Snapshot(range);
+    EXPECT_TRUE(storage::VersionSynopsis::IsUnversioned(after_unlink));
+    EXPECT_NE(after_insert, after_unlink);
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+
+    // A new version chain must change the snapshot even though the count goes back to where it was before
+    auto *txn1 = txn_manager->BeginTransaction();
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), slot, *update));
+    EXPECT_NE(after_insert, synopsis.Snapshot(range));
+    EXPECT_FALSE(storage::VersionSynopsis::IsUnversioned(synopsis.Snapshot(range)));
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
+
+// Scan a table whose version synopsis ranges are unversioned after GC into a vector projection, while another thread
+// keeps installing versions that set every tuple to the number of its txn. Confirm that every scan sees the same value
+// for all tuples, from a txn that committed before the scanning txn began.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ScanUnversionedRangesDuringUpdates) {
+  const int64_t num_updates = 200;
+  auto db_main = DBMain::Builder().SetUseGC(true).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  storage::BlockLayout layout({8, 8});
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(db_main->GetStorageLayer()->GetBlockStore(), layout, storage::layout_version_t(0));
+  const std::vector<storage::col_id_t> col_ids = {storage::col_id_t(1)};
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, col_ids);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+
+  // Fill a few ranges with tuples holding 0, and let the GC truncate their version chains
+  const uint32_t num_tuples = 4 * storage::VersionSynopsis::SlotsPerRange(layout);
+  std::vector<storage::TupleSlot> slots;
+  *reinterpret_cast<int64_t *>(row->AccessForceNotNull(0)) = 0;
+  auto *txn = txn_manager->BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i++) slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  const storage::VersionSynopsis &synopsis = accessor.GetVersionSynopsis(slots[0].GetBlock());
+  for (uint32_t range = 0; range < 4; range++) {
+    ASSERT_TRUE(storage::VersionSynopsis::IsUnversioned(synopsis.Snapshot(range)));
+  }
+
+  // Every value is announced before its txn commits and again once it has committed. The GC runs every few txns, so
+  // that the ranges keep becoming unversioned while they are scanned.
+  std::atomic<int64_t> committing{0}, committed{0};
+  std::thread updater([&] {
+    byte *update_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *update = initializer.InitializeRow(update_buffer);
+    for (int64_t value = 1; value <= num_updates; value++) {
+      *reinterpret_cast<int64_t *>(update->AccessForceNotNull(0)) = value;
+      auto *update_txn = txn_manager->BeginTransaction();
+      for (const auto &slot : slots) EXPECT_TRUE(table.Update(common::ManagedPointer(update_txn), slot, *update));
+      committing = value;
+      txn_manager->Commit(update_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      committed = value;
+      if (value % 4 == 0) {
+        gc->PerformGarbageCollection();
+        gc->PerformGarbageCollection();
+      }
+    }
+    delete[] update_buffer;
+  });
+
+  execution::sql::VectorProjection projection;
+  projection.SetStorageColIds(col_ids);
+  projection.Initialize({execution::sql::TypeId::BigInt});
+  std::vector<int64_t> values;
+  while (committed.load() < num_updates) {
+    // Values committed before the scanning txn began are visible to it, and only values announced before then can be
+    const int64_t oldest = committed.load();
+    auto *scan_txn = txn_manager->BeginTransaction();
+    const int64_t newest = committing.load();
+
+    values.clear();
+    for (auto it = table.begin(); it != table.end();) {
+      table.Scan(common::ManagedPointer(scan_txn), &it, &projection);
+      const auto *data = reinterpret_cast<const int64_t *>(projection.GetColumn(0)->GetData());
+      values.insert(values.end(), data, data + projection.GetTotalTupleCount());
+    }
+    txn_manager->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    EXPECT_EQ(num_tuples, values.size());
+    if (values.empty()) continue;
+    // A torn scan would mix the values of different txns
+    EXPECT_TRUE(std::all_of(values.begin(), values.end(), [&](const int64_t value) { return value == values[0]; }));
+    EXPECT_LE(oldest, values[0]);
+    EXPECT_GE(newest, values[0]);
+  }
+  updater.join();
+
+  delete[] buffer;
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+}
+
+// Run a txn that updates a tuple while an older txn is still running. Confirm that readers leave the version chain to
+// the GC while the older txn may still need it, and drop it themselves once it is invisible to every running txn.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, CooperativePruning) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+    storage::TupleAccessStrategy accessor(tested.Layout());
+    const uint32_t range = 0;
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple);
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+    const storage::VersionSynopsis &synopsis = accessor.GetVersionSynopsis(slot.GetBlock());
+
+    auto *txn1 = txn_manager->BeginTransaction();
+
+    auto *txn2 = txn_manager->BeginTransaction();
+    auto *update = tested.GenerateRandomUpdate(&generator_);
+    auto *update_tuple = tested.GenerateVersionFromUpdate(*update, *insert_tuple);
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn2), slot, *update));
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // txn1 still needs the version chain, so a reader that began after the commit must not prune it
+    timestamp_manager->OldestTransactionStartTime();
+    auto *txn3 = txn_manager->BeginTransaction();
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn3, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, update_tuple));
+    EXPECT_FALSE(storage::VersionSynopsis::IsUnversioned(synopsis.Snapshot(range)));
+    txn_manager->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    select_tuple = tested.SelectIntoBuffer(txn1, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Once nothing running can see the old versions, the next reader drops the version chain before the GC gets to it
+    timestamp_manager->OldestTransactionStartTime();
+    auto *txn4 = txn_manager->BeginTransaction();
+    select_tuple = tested.SelectIntoBuffer(txn4, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, update_tuple));
+    EXPECT_TRUE(storage::VersionSynopsis::IsUnversioned(synopsis.Snapshot(range)));
+    txn_manager->Commit(txn4, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The GC processes the pruned transactions like any other
+    EXPECT_EQ(std::make_pair(0U, 5U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
+  }
+}
+
 }  // namespace noisepage
@@ -9,11 +9,12 @@
 namespace noisepage {
 class LargeGCTests : public TerrierTest {
  public:
-  void RunTest(const LargeDataTableTestConfiguration &config) {
+  void RunTest(const LargeDataTableTestConfiguration &config, const uint32_t num_gc_workers = 1) {
     for (uint32_t iteration = 0; iteration < config.NumIterations(); iteration++) {
       std::default_random_engine generator;
 
-      auto db_main = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).Build();
+      auto db_main =
+          DBMain::Builder().SetUseGC(true).SetUseGCThread(true).SetGCNumWorkers(num_gc_workers).Build();
       auto *const tested = new LargeDataTableTestObject(config, db_main->GetStorageLayer()->GetBlockStore().Get(),
                                                         db_main->GetTransactionLayer()->GetTransactionManager().Get(),
                                                         &generator, DISABLED);
@@ -170,4 +171,22 @@ TEST_F(LargeGCTests, TPCCishHighThreadWithGC) {
                     .Build();
   RunTest(config);
 }
+
+// This test runs the workload of TPCCishHighThreadWithGC with long transactions, and unlinks the versions they leave
+// behind on several GC workers.
+// NOLINTNEXTLINE
+TEST_F(LargeGCTests, TPCCishParallelGC) {
+  auto config = LargeDataTableTestConfiguration::Builder()
+                    .SetNumIterations(10)
+                    .SetNumTxns(1000)
+                    .SetBatchSize(100)
+                    .SetNumConcurrentTxns(2 * MultiThreadTestUtil::HardwareConcurrency())
+                    .SetUpdateSelectRatio({0.4, 0.6})
+                    .SetTxnLength(40)
+                    .SetInitialTableSize(10000)
+                    .SetMaxColumns(20)
+                    .SetVarlenAllowed(true)
+                    .Build();
+  RunTest(config, 4);
+}
 }  // namespace noisepage
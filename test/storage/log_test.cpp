@@ -11,6 +11,7 @@
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_manager.h"
 #include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
@@ -18,6 +19,7 @@
 #include "test_util/test_harness.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
 
 #define LOG_TEST_LOG_FILE_NAME "./test_log_test.log"
 
@@ -448,4 +450,135 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
   // DeferredAction
   db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
 }
+
+// Verify that in group commit mode every commit of a burst is persisted once its group commit window closes, without
+// anyone forcing a persist.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitTest) {
+  // Stop the fixture's log manager so that the group commit log manager has the log file to itself
+  log_manager_->PersistAndStop();
+  unlink(LOG_TEST_LOG_FILE_NAME);
+  auto group_commit_db_main = noisepage::DBMain::Builder()
+                                  .SetWalFilePath(LOG_TEST_LOG_FILE_NAME)
+                                  .SetUseLogging(true)
+                                  .SetUseGC(true)
+                                  .SetWalGroupCommitLatencyTarget(10000)
+                                  .Build();
+  auto txn_manager = group_commit_db_main->GetTransactionLayer()->GetTransactionManager();
+
+  const uint32_t num_txns = 100;
+  std::vector<std::promise<bool>> promises(num_txns);
+  for (auto &promise : promises) txn_manager->Commit(txn_manager->BeginTransaction(), TestCommitCallback, &promise);
+  for (auto &promise : promises) EXPECT_TRUE(promise.get_future().get());
+}
+
+// Verify the moving average of the time between commit arrivals
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitArrivalRateTest) {
+  // The task is never run, its estimators are driven with injected times
+  const std::chrono::microseconds target(10000);
+  DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+  const auto start = DiskLogConsumerTask::Clock::time_point() + std::chrono::seconds(1);
+  const auto arrive = [&](const uint64_t num_commits, const int64_t time_us) {
+    for (uint64_t i = 0; i < num_commits; i++) {
+      task.commit_callbacks_.emplace_back(transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+    task.RecordCommitArrivals(num_commits, start + std::chrono::microseconds(time_us));
+  };
+
+  // Unknown until the second arrival
+  arrive(1, 0);
+  EXPECT_LT(task.commit_interarrival_us_, 0);
+  arrive(1, 100);
+  EXPECT_DOUBLE_EQ(task.commit_interarrival_us_, 100);
+
+  // Commits that arrive together are spread over the time since the last arrival
+  arrive(2, 300);
+  EXPECT_DOUBLE_EQ(task.commit_interarrival_us_, 100);
+
+  // A new sample only moves the average by ARRIVAL_SMOOTHING of the difference
+  arrive(1, 1200);
+  EXPECT_DOUBLE_EQ(task.commit_interarrival_us_, 100 + DiskLogConsumerTask::ARRIVAL_SMOOTHING * (900 - 100));
+}
+
+// Verify that the p99 fsync latency only covers the recent samples
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitFsyncLatencyTest) {
+  // The task is never run, its estimators are driven with injected samples
+  const std::chrono::microseconds target(10000);
+  DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+
+  EXPECT_EQ(task.P99FsyncLatency().count(), 0);
+  task.RecordFsyncLatency(500);
+  for (uint32_t i = 1; i < DiskLogConsumerTask::NUM_FSYNC_LATENCY_SAMPLES; i++) task.RecordFsyncLatency(10);
+  EXPECT_EQ(task.P99FsyncLatency().count(), 500);
+  // The slow fsync is the oldest sample, and is forgotten with the next one
+  task.RecordFsyncLatency(20);
+  EXPECT_EQ(task.P99FsyncLatency().count(), 20);
+}
+
+// Verify when a group of commits is persisted: a lone committer goes ahead, a group waits for commits expected to join
+// it, and no commit waits past the latency target minus the p99 fsync latency.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitPersistDecisionTest) {
+  const auto start = DiskLogConsumerTask::Clock::time_point() + std::chrono::seconds(1);
+  const auto at = [&](const int64_t time_us) { return start + std::chrono::microseconds(time_us); };
+  // The tasks are never run, their estimators are driven with injected times and samples
+  const auto arrive = [&](DiskLogConsumerTask *const task, const int64_t time_us) {
+    task->commit_callbacks_.emplace_back(transaction::TransactionUtil::EmptyCallback, nullptr);
+    task->RecordCommitArrivals(1, at(time_us));
+  };
+  const auto persist = [](DiskLogConsumerTask *const task, const uint64_t fsync_latency_us) {
+    task->RecordFsyncLatency(fsync_latency_us);
+    task->commit_callbacks_.clear();
+  };
+  const std::chrono::microseconds target(10000);
+
+  // Nothing to persist
+  {
+    DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+    EXPECT_FALSE(task.ShouldPersistGroup(at(0)));
+  }
+
+  // Until the arrival rate is known, nobody is expected to join the group
+  {
+    DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+    arrive(&task, 0);
+    EXPECT_TRUE(task.ShouldPersistGroup(at(0)));
+  }
+
+  // Commits arrive every 100us, so the group waits for more until its window closes. The window is the latency target
+  // minus the p99 fsync latency, counted from the oldest pending commit.
+  {
+    DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+    persist(&task, 2000);
+    arrive(&task, 0);
+    arrive(&task, 100);
+    EXPECT_EQ(task.GroupCommitWindowRemaining(at(150)).count(), 8000 - 150);
+    EXPECT_FALSE(task.ShouldPersistGroup(at(150)));
+    EXPECT_FALSE(task.ShouldPersistGroup(at(7999)));
+    EXPECT_EQ(task.GroupCommitWindowRemaining(at(8000)).count(), 0);
+    EXPECT_TRUE(task.ShouldPersistGroup(at(8000)));
+  }
+
+  // Commits arrive every 10ms, longer than the window, so a lone committer does not wait for the next one
+  {
+    DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+    arrive(&task, 0);
+    persist(&task, 2000);
+    arrive(&task, 10000);
+    EXPECT_DOUBLE_EQ(task.commit_interarrival_us_, 10000);
+    EXPECT_EQ(task.GroupCommitWindowRemaining(at(10010)).count(), 8000 - 10);
+    EXPECT_TRUE(task.ShouldPersistGroup(at(10010)));
+  }
+
+  // An fsync slower than the latency target leaves no window at all
+  {
+    DiskLogConsumerTask task(std::chrono::microseconds(10), 0, nullptr, nullptr, nullptr, target);
+    persist(&task, 20000);
+    arrive(&task, 0);
+    arrive(&task, 100);
+    EXPECT_TRUE(task.ShouldPersistGroup(at(100)));
+  }
+}
 }  // namespace noisepage::storage
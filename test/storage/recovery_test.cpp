@@ -1,3 +1,5 @@
+#include <sys/stat.h>
+
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -7,9 +9,11 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "storage/checkpoint/checkpoint_manager.h"
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/index_builder.h"
 #include "storage/recovery/disk_log_provider.h"
+#include "storage/recovery/merged_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
 #include "storage/write_ahead_log/log_manager.h"
@@ -24,6 +28,7 @@
 // executions will read old test's data, and the cause of the errors will be hard to identify. Trust me it will drive
 // you nuts...
 #define RECOVERY_TEST_LOG_FILE_NAME "./test_recovery_test.log"
+#define RECOVERY_TEST_CHECKPOINT_FILE_NAME "./test_recovery_test.checkpoint"
 
 namespace noisepage::storage {
 class RecoveryTests : public TerrierTest {
@@ -48,6 +53,7 @@ class RecoveryTests : public TerrierTest {
   void SetUp() override {
     // Unlink log file incase one exists from previous test iteration
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    unlink(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
 
     db_main_ = noisepage::DBMain::Builder()
                    .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
@@ -76,8 +82,28 @@ class RecoveryTests : public TerrierTest {
   }
 
   void TearDown() override {
-    // Delete log file
+    // Delete log file, along with the ones of any additional log streams
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    for (uint32_t stream = 1; stream < log_manager_->NumStreams(); stream++) {
+      unlink(LogManager::StreamLogFilePath(RECOVERY_TEST_LOG_FILE_NAME, stream).c_str());
+    }
+    unlink(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
+  }
+
+  // Replaces the original components with ones that split the log into several log streams
+  void UseLogStreams(const uint32_t num_log_streams) {
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalNumStreams(num_log_streams)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
   }
 
   catalog::IndexSchema DummyIndexSchema() {
@@ -183,22 +209,43 @@ class RecoveryTests : public TerrierTest {
     recovery_manager.WaitForRecoveryToFinish();
   }
 
-  void RunTest(const LargeSqlTableTestConfiguration &config) {
+  void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t num_replay_threads = 1,
+               const bool take_checkpoint = false) {
     // Run workload
     auto *tested =
         new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
     tested->SimulateOltp(100, 4);
 
+    // Checkpoint the tables halfway through the workload, which removes the log written so far
+    std::unique_ptr<AbstractLogProvider> checkpoint_provider;
+    if (take_checkpoint) {
+      CheckpointManager checkpoint_manager(RECOVERY_TEST_CHECKPOINT_FILE_NAME, catalog_, txn_manager_,
+                                           db_main_->GetTransactionLayer()->GetTimestampManager(), log_manager_);
+      checkpoint_manager.TakeCheckpoint();
+      for (uint32_t stream = 0; stream < log_manager_->NumStreams(); stream++) {
+        EXPECT_EQ(LogManager::LogFilePaths(RECOVERY_TEST_LOG_FILE_NAME, stream).size(), 1U);
+      }
+      tested->SimulateOltp(100, 4);
+      checkpoint_provider = std::make_unique<DiskLogProvider>(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
+    }
+
     ShutdownAndRestartSystem();
 
     // Instantiate recovery manager, and recover the tables.
-    DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
-    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+    std::unique_ptr<AbstractLogProvider> log_provider;
+    if (log_manager_->NumStreams() == 1) {
+      log_provider = std::make_unique<DiskLogProvider>(RECOVERY_TEST_LOG_FILE_NAME);
+    } else {
+      log_provider = std::make_unique<MergedLogProvider>(RECOVERY_TEST_LOG_FILE_NAME, log_manager_->NumStreams());
+    }
+    RecoveryManager recovery_manager{common::ManagedPointer(log_provider),
                                      recovery_catalog_,
                                      recovery_txn_manager_,
                                      recovery_deferred_action_manager_,
                                      recovery_thread_registry_,
-                                     recovery_block_store_};
+                                     recovery_block_store_,
+                                     num_replay_threads,
+                                     common::ManagedPointer(checkpoint_provider)};
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
 
@@ -220,7 +267,7 @@ class RecoveryTests : public TerrierTest {
 
         EXPECT_TRUE(StorageTestUtil::SqlTableEqualDeep(
             original_sql_table->table_.layout_, original_sql_table, recovered_sql_table,
-            tested->GetTupleSlotsForTable(database_oid, table_oid), recovery_manager.tuple_slot_map_,
+            tested->GetTupleSlotsForTable(database_oid, table_oid), recovery_manager.tuple_slot_map_.ToUnorderedMap(),
             txn_manager_.Get(), recovery_txn_manager_.Get()));
         txn_manager_->Commit(original_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
         recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
@@ -248,6 +295,32 @@ TEST_F(RecoveryTests, SingleTableTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test runs the workload of SingleTableTest with the log split into several log streams. It then recovers the
+// table by merging the log files of all streams.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(1)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  UseLogStreams(4);
+  RecoveryTests::RunTest(config);
+
+  // Transactions are spread over the streams, rather than all landing in a few of them
+  uint32_t num_written_streams = 0;
+  for (uint32_t stream = 0; stream < log_manager_->NumStreams(); stream++) {
+    struct stat log_file_stat {};
+    const auto log_file_path = LogManager::StreamLogFilePath(RECOVERY_TEST_LOG_FILE_NAME, stream);
+    if (stat(log_file_path.c_str(), &log_file_stat) == 0 && log_file_stat.st_size > 0) num_written_streams++;
+  }
+  EXPECT_GT(num_written_streams, 1U);
+}
+
 // This test checks that we recover correctly in a high abort rate workload. We achieve the high abort rate by having
 // large transaction lengths (number of updates). Further, to ensure that more aborted transactions flush logs before
 // aborting, we have transactions make large updates (by having high number columns). This will cause RedoBuffers to
@@ -282,6 +355,73 @@ TEST_F(RecoveryTests, MultiDatabaseTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test runs the tables of MultiDatabaseTest with transactions that modify a single table each, and replays the
+// transactions on the tables in parallel. The tables are created by transactions that modify the catalog, which are
+// replayed serially in between.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(3)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(1)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.6, 0.0, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 4);
+}
+
+// This test replays a workload in parallel where most transactions modify several tables, some of them in different
+// databases. Those transactions are replayed serially, each in one txn, in between batches of the transactions that
+// modify a single table.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayMultiTableTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(2)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.6, 0.0, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 4);
+}
+
+// This test runs the workload of MultiDatabaseTest in two halves with a checkpoint in between. It then recovers the
+// tables from the checkpoint and the log written after it, and verifies that they are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(3)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.6, 0.0, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 1, true);
+}
+
+// This test takes a checkpoint in the middle of the workload of MultiStreamTest, with every log stream rotated and
+// truncated by the checkpoint.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamCheckpointTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(1)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  UseLogStreams(4);
+  RecoveryTests::RunTest(config, 1, true);
+}
+
 // Tests that we correctly process records corresponding to a drop database command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropDatabaseTest) {
@@ -685,8 +825,8 @@ TEST_F(RecoveryTests, DoubleRecoveryTest) {
 
       EXPECT_TRUE(StorageTestUtil::SqlTableEqualDeep(
           GetBlockLayout(original_sql_table), original_sql_table, recovered_sql_table,
-          tested->GetTupleSlotsForTable(database_oid, table_oid), recovery_manager.tuple_slot_map_, txn_manager_.Get(),
-          recovery_txn_manager_.Get()));
+          tested->GetTupleSlotsForTable(database_oid, table_oid), recovery_manager.tuple_slot_map_.ToUnorderedMap(),
+          txn_manager_.Get(), recovery_txn_manager_.Get()));
       txn_manager_->Commit(original_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
       recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
     }
@@ -729,8 +869,9 @@ TEST_F(RecoveryTests, DoubleRecoveryTest) {
 
   // Maps from tuple slots in original tables to tuple slots in tables after second recovery
   std::unordered_map<TupleSlot, TupleSlot> new_tuple_slot_map;
-  for (const auto &slot_pair : recovery_manager.tuple_slot_map_) {
-    new_tuple_slot_map[slot_pair.first] = secondary_recovery_manager.tuple_slot_map_[slot_pair.second];
+  auto secondary_tuple_slot_map = secondary_recovery_manager.tuple_slot_map_.ToUnorderedMap();
+  for (const auto &slot_pair : recovery_manager.tuple_slot_map_.ToUnorderedMap()) {
+    new_tuple_slot_map[slot_pair.first] = secondary_tuple_slot_map[slot_pair.second];
   }
 
   // Check we recovered all the original tables
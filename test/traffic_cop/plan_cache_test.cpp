@@ -0,0 +1,139 @@
+#include "traffic_cop/plan_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "network/postgres/statement.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/parameter_value_expression.h"
+#include "parser/parse_result.h"
+#include "parser/postgresparser.h"
+#include "parser/statements.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::trafficcop {
+
+class PlanCacheTests : public TerrierTest {
+ protected:
+  // Parse and parameterize the query, returning its key or the empty string if it cannot be cached.
+  static std::string Parameterize(const std::string &query_text, std::vector<parser::ConstantValueExpression> *params,
+                                  std::unique_ptr<parser::ParseResult> *parse_result = nullptr) {
+    auto result = parser::PostgresParser::BuildParseTree(query_text);
+    std::string key;
+    if (!PlanCache::ParameterizeQuery(query_text, common::ManagedPointer(result), params, &key)) key.clear();
+    if (parse_result != nullptr) *parse_result = std::move(result);
+    return key;
+  }
+
+  static std::shared_ptr<network::Statement> MakeStatement(std::string query_text) {
+    return std::make_shared<network::Statement>(std::move(query_text), std::make_unique<parser::ParseResult>());
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, ParameterizeComparisonsTest) {
+  std::vector<parser::ConstantValueExpression> params;
+  std::unique_ptr<parser::ParseResult> parse_result;
+  const auto key = Parameterize("SELECT a FROM foo WHERE a = 1 AND b > 'x';", &params, &parse_result);
+  ASSERT_FALSE(key.empty());
+  ASSERT_EQ(params.size(), 2);
+  EXPECT_EQ(params[0].Peek<int64_t>(), 1);
+  EXPECT_EQ(params[1].Peek<std::string_view>(), "x");
+
+  // The literals of the statement are now parameters.
+  auto select = parse_result->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
+  auto where = select->GetSelectCondition();
+  EXPECT_EQ(where->GetChild(0)->GetChild(1)->GetExpressionType(), parser::ExpressionType::VALUE_PARAMETER);
+  EXPECT_EQ(where->GetChild(1)->GetChild(1)->GetExpressionType(), parser::ExpressionType::VALUE_PARAMETER);
+
+  // Other literals of the same types share the key, literals of other types do not.
+  std::vector<parser::ConstantValueExpression> other_params;
+  EXPECT_EQ(Parameterize("SELECT a FROM foo WHERE a = 42 AND b > 'yz';", &other_params), key);
+  EXPECT_EQ(other_params[0].Peek<int64_t>(), 42);
+  EXPECT_NE(Parameterize("SELECT a FROM foo WHERE a = 1.5 AND b > 'x';", &other_params), key);
+  EXPECT_NE(Parameterize("SELECT a FROM foo WHERE a = 1 AND b < 'x';", &other_params), key);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, ParameterizeKeepsOtherLiteralsTest) {
+  std::vector<parser::ConstantValueExpression> params;
+
+  // Literals that are not compared against a column are part of the key.
+  const auto key = Parameterize("SELECT a + 1 FROM foo WHERE a = 1 LIMIT 10;", &params);
+  ASSERT_FALSE(key.empty());
+  EXPECT_EQ(params.size(), 1);
+  EXPECT_EQ(Parameterize("SELECT a + 1 FROM foo WHERE a = 2 LIMIT 10;", &params), key);
+  EXPECT_NE(Parameterize("SELECT a + 2 FROM foo WHERE a = 1 LIMIT 10;", &params), key);
+  EXPECT_NE(Parameterize("SELECT a + 1 FROM foo WHERE a = 1 LIMIT 20;", &params), key);
+  EXPECT_NE(Parameterize("SELECT a + 1 FROM foo WHERE a IS NULL LIMIT 10;", &params), key);
+
+  // Only DML is cached, and queries that already have parameters are not.
+  EXPECT_TRUE(Parameterize("CREATE TABLE foo (a INT);", &params).empty());
+  EXPECT_TRUE(Parameterize("SELECT a FROM foo WHERE a = $1;", &params).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, ParameterizeValuesTest) {
+  std::vector<parser::ConstantValueExpression> params;
+  std::unique_ptr<parser::ParseResult> parse_result;
+  const auto key = Parameterize("INSERT INTO foo VALUES (1, 'a'), (2, NULL);", &params, &parse_result);
+  ASSERT_FALSE(key.empty());
+  // NULL stays a literal since it has no type to bind a parameter with.
+  EXPECT_EQ(params.size(), 3);
+  auto values = parse_result->GetStatement(0).CastManagedPointerTo<parser::InsertStatement>()->GetValues();
+  EXPECT_EQ((*values)[0][0]->GetExpressionType(), parser::ExpressionType::VALUE_PARAMETER);
+  EXPECT_EQ((*values)[1][1]->GetExpressionType(), parser::ExpressionType::VALUE_CONSTANT);
+  EXPECT_EQ(Parameterize("INSERT INTO foo VALUES (3, 'b'), (4, NULL);", &params), key);
+  EXPECT_NE(Parameterize("INSERT INTO foo VALUES (3, 'b');", &params), key);
+
+  EXPECT_FALSE(Parameterize("UPDATE foo SET b = 'c' WHERE a = 1;", &params).empty());
+  EXPECT_EQ(params.size(), 2);
+  EXPECT_FALSE(Parameterize("DELETE FROM foo WHERE a < 5;", &params).empty());
+  EXPECT_EQ(params.size(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, LRUTest) {
+  PlanCache cache(2);
+  const catalog::db_oid_t db_oid{1};
+  const transaction::timestamp_t version{5};
+
+  cache.Insert(db_oid, "a", version, MakeStatement("a"));
+  cache.Insert(db_oid, "b", version, MakeStatement("b"));
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_EQ(cache.Lookup(db_oid, "a", version)->GetQueryText(), "a");
+  EXPECT_EQ(cache.Lookup(catalog::db_oid_t{2}, "a", version), nullptr);
+
+  // "b" is the least recently used entry.
+  cache.Insert(db_oid, "c", version, MakeStatement("c"));
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_EQ(cache.GetEvictions(), 1);
+  EXPECT_EQ(cache.Lookup(db_oid, "b", version), nullptr);
+  EXPECT_NE(cache.Lookup(db_oid, "a", version), nullptr);
+  EXPECT_NE(cache.Lookup(db_oid, "c", version), nullptr);
+
+  EXPECT_EQ(cache.GetHits(), 3);
+  EXPECT_EQ(cache.GetMisses(), 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, CatalogVersionTest) {
+  PlanCache cache(4);
+  const catalog::db_oid_t db_oid{1};
+
+  cache.Insert(db_oid, "a", transaction::timestamp_t{5}, MakeStatement("a"));
+
+  // Transactions that see an older catalog cannot use the statement, but do not drop it either.
+  EXPECT_EQ(cache.Lookup(db_oid, "a", transaction::timestamp_t{3}), nullptr);
+  cache.Insert(db_oid, "a", transaction::timestamp_t{3}, MakeStatement("old"));
+  EXPECT_EQ(cache.Lookup(db_oid, "a", transaction::timestamp_t{5})->GetQueryText(), "a");
+
+  // Once the catalog changed, the statement is dropped.
+  EXPECT_EQ(cache.Lookup(db_oid, "a", transaction::timestamp_t{7}), nullptr);
+  EXPECT_EQ(cache.GetInvalidations(), 1);
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+}  // namespace noisepage::trafficcop
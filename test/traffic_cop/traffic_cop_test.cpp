@@ -189,4 +189,44 @@ TEST_F(TrafficCopTests, ArithmeticErrorTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, PlanCacheTest) {
+  const auto plan_cache = db_main_->GetTrafficCop()->GetPlanCache();
+  try {
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+
+    // Every statement runs in its own txn, so the catalog version of the committed CREATE TABLE is visible.
+    pqxx::nontransaction txn1(connection1);
+    pqxx::nontransaction txn2(connection2);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+
+    // Queries that only differ in their literals share one plan, also across connections.
+    for (int i = 0; i < 10; i++) {
+      txn1.exec(fmt::format("INSERT INTO TableA VALUES ({0}, 'row{0}');", i));
+    }
+    for (int i = 0; i < 10; i++) {
+      pqxx::result r = (i % 2 == 0 ? txn1 : txn2).exec(fmt::format("SELECT data FROM TableA WHERE id = {};", i));
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<std::string>(), fmt::format("row{}", i));
+    }
+    EXPECT_EQ(plan_cache->Size(), 2);
+    EXPECT_GE(plan_cache->GetHits(), 18);
+
+    // A DDL change invalidates the plans, which are planned again against the new catalog.
+    txn2.exec("CREATE INDEX idx_data ON TableA (data);");
+    pqxx::result r = txn1.exec("SELECT id FROM TableA WHERE data = 'row3';");
+    ASSERT_EQ(r.size(), 1);
+    EXPECT_EQ(r[0][0].as<int>(), 3);
+    r = txn2.exec("SELECT data FROM TableA WHERE id = 7;");
+    ASSERT_EQ(r.size(), 1);
+    EXPECT_EQ(r[0][0].as<std::string>(), "row7");
+    EXPECT_EQ(plan_cache->GetInvalidations(), 1);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
 }  // namespace noisepage::trafficcop
@@ -0,0 +1,60 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "main/db_main.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage {
+
+class TimestampManagerTests : public TerrierTest {
+ protected:
+  void SetUp() override {
+    db_main_ = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    timestamp_manager_ = db_main_->GetTransactionLayer()->GetTimestampManager();
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
+};
+
+// Checks that the oldest transaction start time is never newer than a running transaction, while transactions begin
+// and finish concurrently on many threads and a long running transaction holds back the oldest start time.
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, OldestTransactionStartTime) {
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency();
+  const uint32_t num_txns = 1000;
+  common::WorkerPool thread_pool(num_threads, {});
+  thread_pool.Startup();
+
+  auto *const long_txn = txn_manager_->BeginTransaction();
+  std::atomic<uint32_t> violations = 0;
+  auto workload = [&](uint32_t id) {
+    for (uint32_t i = 0; i < num_txns; i++) {
+      auto *const txn = txn_manager_->BeginTransaction();
+      if (timestamp_manager_->OldestTransactionStartTime() > txn->StartTime()) violations++;
+      if (timestamp_manager_->OldestTransactionStartTime() > long_txn->StartTime()) violations++;
+      if (id % 2 == 0) {
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      } else {
+        txn_manager_->Abort(txn);
+      }
+    }
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+  EXPECT_EQ(violations.load(), 0);
+  EXPECT_EQ(timestamp_manager_->OldestTransactionStartTime(), long_txn->StartTime());
+  EXPECT_EQ(timestamp_manager_->CachedOldestTransactionStartTime(), long_txn->StartTime());
+
+  // Once nothing is running, the oldest start time catches up with the current time
+  txn_manager_->Commit(long_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  EXPECT_EQ(timestamp_manager_->OldestTransactionStartTime(), timestamp_manager_->CurrentTime());
+}
+
+}  // namespace noisepage
@@ -6833,6 +6833,31 @@ class BwTree : public BwTreeBase {
     epoch_manager.LeaveEpoch(epoch_node_p);
   }
 
+  /*
+   * GetValues() - Look up a batch of keys under a single epoch
+   *
+   * Keys are traversed in the given order, so passing them sorted lets
+   * consecutive traversals share the inner nodes and leaf pages that are
+   * still in cache. The callback is invoked as fn(i, value_list) for every
+   * key, and value_list is only valid for the duration of the call
+   */
+  template <typename Fn>
+  NO_ASAN void GetValues(const std::vector<const KeyType *> &search_keys, Fn fn) {
+    INDEX_LOG_TRACE("GetValues()");
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    std::vector<ValueType> value_list{};
+    for (size_t i = 0; i < search_keys.size(); i++) {
+      Context context{*search_keys[i]};
+      value_list.clear();
+      TraverseReadOptimized(&context, &value_list);
+      fn(i, value_list);
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+  }
+
   /*
    * GetValue() - Return value in a ValueSet object
    *
@@ -478,6 +478,24 @@ class cuckoohash_map {
     }
   }
 
+  /**
+   * Prefetches the two buckets @p key may be stored in, without taking any
+   * locks. This is only a hint, meant to overlap the cache misses of lookups
+   * that are about to be issued for several keys.
+   *
+   * @tparam K type of the key. This can be any type comparable with @c key_type
+   * @param key the key that is about to be searched for
+   */
+  template <typename K>
+  void prefetch(const K &key) const {
+    const hash_value hv = hashed_key(key);
+    const size_type hp = hashpower();
+    const size_type i1 = index_hash(hp, hv.hash);
+    const size_type i2 = alt_index(hp, hv.partial, i1);
+    __builtin_prefetch(&buckets_[i1]);
+    __builtin_prefetch(&buckets_[i2]);
+  }
+
   /**
    * Searches the table for @p key, and invokes @p fn on the value. @p fn is
    * allow to modify the contents of the value if found.
@@ -1,19 +1,127 @@
 #include "execution/table_generator/table_reader.h"
 
 #include <storage/index/index_builder.h>
+#include <tbb/parallel_for.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 #include <vector>
 
-#include "csv/csv.hpp"  // NOLINT
+#include "common/constants.h"
+#include "common/math_util.h"
+#include "common/spin_latch.h"
 #include "execution/sql/value.h"
+#include "execution/util/file.h"
+#include "fast_float/fast_float.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
 
 namespace noisepage::execution::sql {
 
+namespace {
+
+// How much further to read at a time when the last record of a chunk runs past its end.
+constexpr std::size_t TAIL_READ_SIZE = 64 * common::Constants::KB;
+// The number of rows a thread parses before inserting them.
+constexpr uint32_t BATCH_SIZE = 1024;
+
+void ReadRange(const util::File &file, std::size_t offset, char *data, std::size_t len) {
+  if (file.ReadFullFromPosition(offset, reinterpret_cast<std::byte *>(data), len) != static_cast<int32_t>(len)) {
+    throw std::runtime_error("Unable to read from data file.");
+  }
+}
+
+// Find the first newline outside of quotes in the given range, starting inside quotes if in_quotes is set. Returns the
+// length of the range if there is none, with in_quotes set if the range ends inside quotes. Doubled quotes toggle the
+// state twice, so escaped quotes need no special handling.
+std::size_t FindRecordEnd(const char *data, const std::size_t len, bool *in_quotes) {
+  std::size_t pos = 0, newline = std::string_view::npos;
+  while (pos < len) {
+    if (*in_quotes) {
+      const auto *quote = static_cast<const char *>(std::memchr(data + pos, '"', len - pos));
+      if (quote == nullptr) return len;
+      pos = quote - data + 1;
+      *in_quotes = false;
+      continue;
+    }
+    if (newline == std::string_view::npos || newline < pos) {
+      const auto *found = static_cast<const char *>(std::memchr(data + pos, '\n', len - pos));
+      newline = found == nullptr ? len : found - data;
+    }
+    const auto *quote = static_cast<const char *>(std::memchr(data + pos, '"', newline - pos));
+    if (quote == nullptr) return newline;
+    pos = quote - data + 1;
+    *in_quotes = true;
+  }
+  return len;
+}
+
+// Pick the delimiter that splits the first record into as many fields as the table has columns, allowing for a
+// trailing delimiter. Falls back to the most frequent candidate.
+char GuessDelimiter(const util::File &file, std::size_t file_size, std::size_t num_cols) {
+  std::string line(std::min(file_size, TAIL_READ_SIZE), '\0');
+  ReadRange(file, 0, line.data(), line.size());
+  line.resize(std::min(line.find('\n'), line.size()));
+
+  char best = ',';
+  std::size_t best_count = 0;
+  for (const char candidate : {',', '|', '\t', ';'}) {
+    const auto count = static_cast<std::size_t>(std::count(line.begin(), line.end(), candidate));
+    const bool fits = count + 1 == num_cols || (count == num_cols && !line.empty() && line.back() == candidate);
+    if (fits) return candidate;
+    if (count > best_count) {
+      best = candidate;
+      best_count = count;
+    }
+  }
+  return best;
+}
+
+template <typename T>
+T ParseInteger(std::string_view field) {
+  constexpr int64_t min = std::numeric_limits<T>::min(), max = std::numeric_limits<T>::max();
+  std::size_t i = 0;
+  const bool negative = !field.empty() && field[0] == '-';
+  if (negative || (!field.empty() && field[0] == '+')) i++;
+  if (i == field.size()) {
+    throw std::runtime_error("Not an integer: '" + std::string(field) + "'");
+  }
+  // Accumulate the value negated, so that the minimum of the type can be parsed without overflowing.
+  int64_t val = 0;
+  for (; i < field.size(); i++) {
+    if (field[i] < '0' || field[i] > '9') {
+      throw std::runtime_error("Not an integer: '" + std::string(field) + "'");
+    }
+    const int64_t digit = field[i] - '0';
+    if (val < (min + digit) / 10) {
+      throw std::runtime_error("Integer out of range: '" + std::string(field) + "'");
+    }
+    val = val * 10 - digit;
+  }
+  if (!negative) {
+    if (val < -max) {
+      throw std::runtime_error("Integer out of range: '" + std::string(field) + "'");
+    }
+    val = -val;
+  }
+  return static_cast<T>(val);
+}
+
+// The number of words an index key takes up in a key buffer.
+uint32_t KeyWords(const storage::index::Index &index) {
+  return static_cast<uint32_t>(
+      common::MathUtil::DivRoundUp(index.GetProjectedRowInitializer().ProjectedRowSize(), sizeof(uint64_t)));
+}
+
+}  // namespace
+
 uint32_t TableReader::ReadTable(const std::string &schema_file, const std::string &data_file) {
-  uint32_t val_written = 0;
   // Read schema and create table and indexes
   SchemaReader schema_reader{};
   auto table_info = schema_reader.ReadTableInfo(schema_file);
@@ -39,39 +147,159 @@ uint32_t TableReader::ReadTable(const std::string &schema_file, const std::strin
   // Create Indexes
   CreateIndexes(table_info.get(), table_oid);
 
-  // Iterate through CSV file
-  std::vector<std::string> col_names;
-  for (const auto &col : table_info->cols_) {
-    col_names.emplace_back(col.Name());
+  // Parse the chunks of the CSV file in parallel
+  util::File file(data_file, util::File::FLAG_OPEN | util::File::FLAG_READ);
+  if (!file.IsOpen()) {
+    throw std::runtime_error("Unable to open data file " + data_file);
   }
-  csv::CSVReader reader(data_file);
-  for (csv::CSVRow &row : reader) {
-    // Write table data
-    auto *const redo = exec_ctx_->GetTxn()->StageWrite(exec_ctx_->DBOid(), table_oid, pri);
-    uint16_t col_idx = 0;
-    for (csv::CSVField &field : row) {
-      auto col_offset = table_offsets[col_idx];
-      auto col_type = table_info->cols_[col_idx].Type();
-      WriteTableCol(redo->Delta(), col_offset, col_type, &field);
-      col_idx++;
+  const auto file_size = static_cast<std::size_t>(file.Length());
+  const std::size_t num_chunks = common::MathUtil::DivRoundUp(file_size, chunk_size_);
+
+  // Quoted fields may contain newlines, so a chunk may start inside quotes. Count the quotes in every chunk up front,
+  // so that each chunk knows from the quotes before it whether it does.
+  std::vector<std::size_t> quotes_before(num_chunks + 1, 0);
+  tbb::parallel_for(std::size_t{0}, num_chunks, [&](const std::size_t chunk) {
+    std::vector<char> buffer(std::min(chunk_size_, file_size - chunk * chunk_size_));
+    ReadRange(file, chunk * chunk_size_, buffer.data(), buffer.size());
+    quotes_before[chunk + 1] = static_cast<std::size_t>(std::count(buffer.begin(), buffer.end(), '"'));
+  });
+  std::partial_sum(quotes_before.begin(), quotes_before.end(), quotes_before.begin());
+
+  const TableLoad load{table_info.get(), table_oid, table, pri, std::move(table_offsets),
+                       GuessDelimiter(file, file_size, table_info->cols_.size())};
+  std::atomic<uint32_t> val_written{0};
+  std::vector<ChunkKeys> chunk_keys(num_chunks);
+  tbb::parallel_for(std::size_t{0}, num_chunks, [&](const std::size_t chunk) {
+    chunk_keys[chunk].keys_.resize(table_info->indexes_.size());
+    val_written += ReadChunk(load, file, file_size, chunk, quotes_before[chunk], &chunk_keys[chunk]);
+  });
+
+  // Insert the index keys one index at a time. An index registers the abort actions of its inserts in the transaction
+  // under its own latch, so the chunks may only insert into the same index concurrently.
+  auto txn = exec_ctx_->GetTxn();
+  for (std::size_t idx = 0; idx < table_info->indexes_.size(); idx++) {
+    const auto index = table_info->indexes_[idx]->index_ptr_;
+    const uint32_t key_words = KeyWords(*index);
+    tbb::parallel_for(std::size_t{0}, num_chunks, [&](const std::size_t chunk) {
+      const auto &keys = chunk_keys[chunk];
+      for (std::size_t i = 0; i < keys.slots_.size(); i++) {
+        const auto *key = reinterpret_cast<const storage::ProjectedRow *>(&keys.keys_[idx][i * key_words]);
+        index->Insert(txn, *key, keys.slots_[i]);
+      }
+    });
+  }
+
+  // Return
+  return val_written;
+}
+
+uint32_t TableReader::ReadChunk(const TableLoad &load, const util::File &file, const std::size_t file_size,
+                                const std::size_t chunk, const std::size_t quotes_before, ChunkKeys *keys) {
+  // Read the chunk along with the byte before it, to tell whether a record starts right at the chunk.
+  const std::size_t begin = chunk * chunk_size_;
+  const std::size_t read_begin = begin == 0 ? 0 : begin - 1;
+  const std::size_t chunk_end = std::min(begin + chunk_size_, file_size) - read_begin;
+  std::vector<char> buffer(chunk_end);
+  ReadRange(file, read_begin, buffer.data(), buffer.size());
+
+  // The first record of the file is the header, and the first record found by any other chunk started in the chunk
+  // before it, so skip to the end of the first record.
+  bool in_quotes = (quotes_before - (begin != 0 && buffer[0] == '"' ? 1 : 0)) % 2 == 1;
+  std::size_t pos = FindRecordEnd(buffer.data(), buffer.size(), &in_quotes) + 1;
+  if (pos > buffer.size()) return 0;
+
+  // Rows are parsed into a thread-local buffer, and inserted a batch at a time.
+  const auto row_size =
+      static_cast<uint32_t>(common::MathUtil::AlignTo(load.pri_.ProjectedRowSize(), alignof(uint64_t)));
+  std::vector<uint64_t> row_buffer(BATCH_SIZE * row_size / sizeof(uint64_t));
+  std::vector<storage::ProjectedRow *> rows(BATCH_SIZE);
+  for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+    rows[i] = load.pri_.InitializeRow(reinterpret_cast<byte *>(row_buffer.data()) + i * row_size);
+  }
+  std::vector<storage::TupleSlot> slots(BATCH_SIZE);
+  std::string scratch;
+
+  uint32_t num_rows = 0, num_read = 0;
+  while (pos < chunk_end) {
+    // Find the end of the record, reading past the chunk if the record runs over it.
+    in_quotes = false;
+    std::size_t record_end = pos + FindRecordEnd(&buffer[pos], buffer.size() - pos, &in_quotes);
+    while (record_end == buffer.size() && read_begin + buffer.size() < file_size) {
+      const std::size_t old_size = buffer.size();
+      const std::size_t len = std::min(TAIL_READ_SIZE, file_size - read_begin - old_size);
+      buffer.resize(old_size + len);
+      ReadRange(file, read_begin + old_size, &buffer[old_size], len);
+      record_end = old_size + FindRecordEnd(&buffer[old_size], len, &in_quotes);
     }
-    // Insert into sql table
-    auto slot = table->Insert(exec_ctx_->GetTxn(), redo);
-    val_written++;
+    std::string_view record(&buffer[pos], record_end - pos);
+    pos = record_end + 1;
+    if (!record.empty() && record.back() == '\r') record.remove_suffix(1);
+    if (record.empty()) continue;
 
-    // Write index data
-    for (auto &index_info : table_info->indexes_) {
-      WriteIndexEntry(index_info.get(), redo->Delta(), table_offsets, slot);
+    ParseRecord(load, record, rows[num_rows], &scratch);
+    if (++num_rows == BATCH_SIZE) {
+      InsertRows(load, rows.data(), num_rows, slots.data(), keys);
+      num_read += num_rows;
+      num_rows = 0;
     }
   }
+  InsertRows(load, rows.data(), num_rows, slots.data(), keys);
+  return num_read + num_rows;
+}
 
-  // Deallocate
-  for (auto &index_info : table_info->indexes_) {
-    delete[] reinterpret_cast<byte *>(index_info->index_pr_);
+void TableReader::ParseRecord(const TableLoad &load, std::string_view record, storage::ProjectedRow *row,
+                              std::string *scratch) {
+  std::size_t pos = 0;
+  for (uint16_t col_idx = 0; col_idx < load.info_->cols_.size(); col_idx++) {
+    std::string_view field = NULL_STRING;
+    if (pos < record.size() && record[pos] == '"') {
+      // Quoted fields may contain the delimiter, and quotes escaped by doubling them.
+      scratch->clear();
+      for (pos++; pos < record.size(); pos++) {
+        if (record[pos] == '"' && (pos + 1 == record.size() || record[++pos] != '"')) break;
+        scratch->push_back(record[pos]);
+      }
+      field = *scratch;
+      pos = std::min(record.find(load.delimiter_, pos), record.size()) + 1;
+    } else if (pos <= record.size()) {
+      const std::size_t end = std::min(record.find(load.delimiter_, pos), record.size());
+      field = record.substr(pos, end - pos);
+      pos = end + 1;
+    }
+    WriteTableCol(row, load.table_offsets_[col_idx], load.info_->cols_[col_idx].Type(), field);
   }
+}
 
-  // Return
-  return val_written;
+void TableReader::InsertRows(const TableLoad &load, storage::ProjectedRow *const *rows, const uint32_t num_rows,
+                             storage::TupleSlot *slots, ChunkKeys *keys) {
+  if (num_rows == 0) return;
+  auto txn = exec_ctx_->GetTxn();
+  {
+    // Inserting the rows appends their undo records to the transaction, and logging them their redo records.
+    common::SpinLatch::ScopedSpinLatch guard(exec_ctx_->GetTxnLatch());
+    load.table_->InsertBatch(txn, rows, num_rows, slots);
+    for (uint32_t i = 0; i < num_rows; i++) {
+      auto *const redo = txn->StageWrite(exec_ctx_->DBOid(), load.table_oid_, load.pri_);
+      std::memcpy(redo->Delta(), rows[i], load.pri_.ProjectedRowSize());
+      redo->SetTupleSlot(slots[i]);
+    }
+  }
+
+  // Write the index keys into the chunk's own buffers, to be inserted once the table is loaded.
+  if (load.info_->indexes_.empty()) return;
+  keys->slots_.insert(keys->slots_.end(), slots, slots + num_rows);
+  for (std::size_t idx = 0; idx < load.info_->indexes_.size(); idx++) {
+    auto *const index_info = load.info_->indexes_[idx].get();
+    const auto &index_pri = index_info->index_ptr_->GetProjectedRowInitializer();
+    const uint32_t key_words = KeyWords(*index_info->index_ptr_);
+    auto &buffer = keys->keys_[idx];
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + num_rows * key_words);
+    for (uint32_t i = 0; i < num_rows; i++) {
+      auto *const key = index_pri.InitializeRow(&buffer[offset + i * key_words]);
+      WriteIndexEntry(index_info, rows[i], load.table_offsets_, key);
+    }
+  }
 }
 
 catalog::table_oid_t TableReader::CreateTable(TableInfo *info) {
@@ -103,16 +331,11 @@ void TableReader::CreateIndexes(TableInfo *info, catalog::table_oid_t table_oid)
       auto &index_col = schema.GetColumn(index_col_name);
       index_info->offsets_.emplace_back(index->GetKeyOidToOffsetMap().at(index_col.Oid()));
     }
-
-    // Create Projected Row
-    auto &index_pri = index->GetProjectedRowInitializer();
-    byte *index_buffer = common::AllocationUtil::AllocateAligned(index_pri.ProjectedRowSize());
-    index_info->index_pr_ = index_pri.InitializeRow(index_buffer);
   }
 }
 
 void TableReader::WriteIndexEntry(IndexInfo *index_info, storage::ProjectedRow *table_pr,
-                                  const std::vector<uint16_t> &table_offsets, const storage::TupleSlot &slot) {
+                                  const std::vector<uint16_t> &table_offsets, storage::ProjectedRow *index_pr) {
   for (uint32_t index_col_idx = 0; index_col_idx < index_info->offsets_.size(); index_col_idx++) {
     // Get the offset of this column in the table
     uint16_t table_col_idx = index_info->index_map_[index_col_idx];
@@ -121,57 +344,59 @@ void TableReader::WriteIndexEntry(IndexInfo *index_info, storage::ProjectedRow *
     uint16_t index_offset = index_info->offsets_[index_col_idx];
     // Check null and write bytes.
     if (index_info->cols_[index_col_idx].Nullable() && table_pr->IsNull(table_offset)) {
-      index_info->index_pr_->SetNull(index_offset);
+      index_pr->SetNull(index_offset);
     } else {
-      byte *index_data = index_info->index_pr_->AccessForceNotNull(index_offset);
+      byte *index_data = index_pr->AccessForceNotNull(index_offset);
       uint8_t type_size = type::TypeUtil::GetTypeTrueSize(index_info->cols_[index_col_idx].Type());
       std::memcpy(index_data, table_pr->AccessForceNotNull(table_offset), type_size);
     }
   }
-  // Insert into index
-  index_info->index_ptr_->Insert(exec_ctx_->GetTxn(), *index_info->index_pr_, slot);
 }
 
 void TableReader::WriteTableCol(storage::ProjectedRow *insert_pr, uint16_t col_offset, type::TypeId type,
-                                csv::CSVField *field) {
-  if (*field == NULL_STRING) {
+                                std::string_view field) {
+  if (field == NULL_STRING) {
     insert_pr->SetNull(col_offset);
     return;
   }
   byte *insert_offset = insert_pr->AccessForceNotNull(col_offset);
   switch (type) {
     case type::TypeId::TINYINT: {
-      auto val = field->get<int8_t>();
+      auto val = ParseInteger<int8_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int8_t));
       break;
     }
     case type::TypeId::SMALLINT: {
-      auto val = field->get<int16_t>();
+      auto val = ParseInteger<int16_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int16_t));
       break;
     }
     case type::TypeId::INTEGER: {
-      auto val = field->get<int32_t>();
+      auto val = ParseInteger<int32_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int32_t));
       break;
     }
     case type::TypeId::BIGINT: {
-      auto val = field->get<int64_t>();
+      auto val = ParseInteger<int64_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int64_t));
       break;
     }
     case type::TypeId::REAL: {
-      auto val = field->get<double>();
+      double val = 0;
+      const auto result = fast_float::from_chars(field.data(), field.data() + field.size(), val);
+      if (result.ec != std::errc() || result.ptr != field.data() + field.size()) {
+        throw std::runtime_error("Not a number: '" + std::string(field) + "'");
+      }
       std::memcpy(insert_offset, &val, sizeof(double));
       break;
     }
     case type::TypeId::DATE: {
-      auto val = sql::Date::FromString(field->get<std::string>());
+      auto val = sql::Date::FromString(field);
       std::memcpy(insert_offset, &val, sizeof(uint32_t));
       break;
     }
     case type::TypeId::VARCHAR: {
-      auto val = field->get<std::string_view>();
+      auto val = field;
       auto content_size = static_cast<uint32_t>(val.size());
       if (content_size <= storage::VarlenEntry::InlineThreshold()) {
         *reinterpret_cast<storage::VarlenEntry *>(insert_offset) =
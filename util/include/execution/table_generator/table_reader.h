@@ -3,42 +3,93 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "common/constants.h"
 #include "execution/exec/execution_context.h"
 #include "execution/table_generator/schema_reader.h"
+#include "storage/projected_row.h"
 #include "transaction/transaction_context.h"
 #include "type/type_id.h"
 
-// Forward declaration
-namespace csv {
-class CSVField;
-}
+namespace noisepage::storage {
+class SqlTable;
+}  // namespace noisepage::storage
+
+namespace noisepage::execution::util {
+class File;
+}  // namespace noisepage::execution::util
 
 namespace noisepage::execution::sql {
 /**
- * This class reads table from files
+ * This class reads table from files.
+ *
+ * The first record of a data file is a header, and is skipped. Data files are split into chunks that are parsed in
+ * parallel. A chunk owns every record that starts within it, so chunk boundaries fall on record boundaries once every
+ * chunk skips the tail of the record it starts in. Fields may be quoted, in which case they may contain delimiters and
+ * newlines. A double quote anywhere else is not supported. Every thread parses rows into its own buffer and inserts
+ * them into the table in batches, taking the transaction latch of the execution context only to stage them in the
+ * transaction. The index keys are written into per-chunk buffers, and inserted one index at a time once the table is
+ * loaded. Rows are therefore loaded in no particular order.
+ *
+ * Fields that do not parse as the type of their column throw a std::runtime_error.
  */
 class TableReader {
  public:
+  /** The default size of the chunks data files are split into to be parsed in parallel. */
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = 4 * common::Constants::MB;
+
   /**
    * Constructor
    * @param exec_ctx execution context to use
    * @param store block store to use when creating tables
    * @param ns_oid oid of the namespace
+   * @param chunk_size size of the chunks data files are split into
    */
-  explicit TableReader(exec::ExecutionContext *exec_ctx, storage::BlockStore *store, catalog::namespace_oid_t ns_oid)
-      : exec_ctx_{exec_ctx}, store_{store}, ns_oid_{ns_oid} {}
+  explicit TableReader(exec::ExecutionContext *exec_ctx, storage::BlockStore *store, catalog::namespace_oid_t ns_oid,
+                       std::size_t chunk_size = DEFAULT_CHUNK_SIZE)
+      : exec_ctx_{exec_ctx}, store_{store}, ns_oid_{ns_oid}, chunk_size_{chunk_size} {}
 
   /**
    * Read a table given a schema file and a data file
    * @param schema_file file containing the schema
    * @param data_file csv file containing the data
-   * @return
+   * @return the number of rows read
    */
   uint32_t ReadTable(const std::string &schema_file, const std::string &data_file);
 
  private:
+  // The index keys of the rows of a chunk, inserted once the table is loaded.
+  struct ChunkKeys {
+    // The slots of the rows.
+    std::vector<storage::TupleSlot> slots_;
+    // For every index of the table, the key of every row, in the order of the slots.
+    std::vector<std::vector<uint64_t>> keys_;
+  };
+
+  // What every thread needs to load a chunk of the data file.
+  struct TableLoad {
+    TableInfo *info_;
+    catalog::table_oid_t table_oid_;
+    common::ManagedPointer<storage::SqlTable> table_;
+    storage::ProjectedRowInitializer pri_;
+    std::vector<uint16_t> table_offsets_;
+    char delimiter_;
+  };
+
+  // Parse and insert the records that start in the given chunk of the data file, given the number of double quotes in
+  // the file before the chunk. The index keys of the rows are added to keys. Returns the number of rows read.
+  uint32_t ReadChunk(const TableLoad &load, const util::File &file, std::size_t file_size, std::size_t chunk,
+                     std::size_t quotes_before, ChunkKeys *keys);
+
+  // Parse a record into a table projected row.
+  void ParseRecord(const TableLoad &load, std::string_view record, storage::ProjectedRow *row, std::string *scratch);
+
+  // Insert parsed rows into the table, and add their index keys to keys.
+  void InsertRows(const TableLoad &load, storage::ProjectedRow *const *rows, uint32_t num_rows,
+                  storage::TupleSlot *slots, ChunkKeys *keys);
+
   // Create table
   catalog::table_oid_t CreateTable(TableInfo *info);
 
@@ -46,11 +97,11 @@ class TableReader {
   void CreateIndexes(TableInfo *info, catalog::table_oid_t table_oid);
 
   // Writes a column according to its type.
-  void WriteTableCol(storage::ProjectedRow *insert_pr, uint16_t col_offset, type::TypeId type, csv::CSVField *field);
+  void WriteTableCol(storage::ProjectedRow *insert_pr, uint16_t col_offset, type::TypeId type, std::string_view field);
 
-  // Write an index entry
+  // Write the index key of a table row into an index projected row
   void WriteIndexEntry(IndexInfo *index_info, storage::ProjectedRow *table_pr,
-                       const std::vector<uint16_t> &table_offsets, const storage::TupleSlot &slot);
+                       const std::vector<uint16_t> &table_offsets, storage::ProjectedRow *index_pr);
 
  private:
   // Postgres NULL string
@@ -58,5 +109,6 @@ class TableReader {
   exec::ExecutionContext *exec_ctx_;
   storage::BlockStore *store_;
   catalog::namespace_oid_t ns_oid_;
+  std::size_t chunk_size_;
 };
 }  // namespace noisepage::execution::sql